@@ -49,6 +49,7 @@ ChassisInstance_s *Chassis_Register(ChassisInitConfig_s *Chassis_config){
 	Chassis_Instance->wheel_radius=Chassis_config->wheel_radius;
 	Chassis_Instance->length_a=Chassis_config->length_a;
 	Chassis_Instance->length_b=Chassis_config->length_b;
+    Chassis_Power_Limit_Init(&Chassis_Instance->power_limit, &Chassis_config->power_config);
     
     // 全向轮/麦轮底盘初始化
     if(Chassis_Instance->type == Omni_Wheel || Chassis_Instance->type == Mecanum_Wheel)
@@ -262,14 +263,161 @@ void Chassis_Mode_Choose(ChassisInstance_s* ChassisAction)
     }
 }
 
-/* 
- * @brief 底盘功率限制函数 (未实现)
- * @note 预留功能，用于防止底盘超功率
- * @date 2025-07-03
+/**
+ * @brief 初始化功率限制器
+ * @param limiter 功率限制器指针
+ * @param config 功率模型配置
+ * @date 2025-12-04
  */
-/*
-static void Chassis_Power_Limit(void)
+void Chassis_Power_Limit_Init(ChassisPowerLimit_s *limiter, const ChassisPowerConfig_s *config)
 {
-    // 待实现功能
+    if (limiter == NULL || config == NULL)
+    {
+        return;
+    }
+    memset(limiter, 0, sizeof(ChassisPowerLimit_s));
+    limiter->config = *config;
+    if (limiter->config.buffer_horizon <= 0.0f)
+    {
+        limiter->config.buffer_horizon = CHASSIS_POWER_BUFFER_HORIZON;
+    }
+    limiter->power_limit = CHASSIS_POWER_LIMIT_DEFAULT;
+    limiter->scale = 1.0f;
+}
+
+/**
+ * @brief 更新功率上限和缓冲能量
+ * @param limiter 功率限制器指针
+ * @param power_limit 底盘功率上限(W)
+ * @param buffer_energy 缓冲能量(J)
+ * @date 2025-12-04
+ */
+void Chassis_Power_Set_Limit(ChassisPowerLimit_s *limiter, float power_limit, float buffer_energy)
+{
+    if (limiter == NULL)
+    {
+        return;
+    }
+    limiter->power_limit = (power_limit > 0.0f) ? power_limit : 0.0f;
+    limiter->buffer_energy = (buffer_energy > 0.0f) ? buffer_energy : 0.0f;
+}
+
+/**
+ * @brief 用实测底盘功率校正模型
+ * @param limiter 功率限制器指针
+ * @param measured_power 实测功率(W)
+ * @date 2025-12-04
+ */
+void Chassis_Power_Update_Measure(ChassisPowerLimit_s *limiter, float measured_power)
+{
+    if (limiter == NULL)
+    {
+        return;
+    }
+    // 只校正模型低估的部分，避免模型高估时放开限制
+    float error = measured_power - (limiter->power_output - limiter->model_offset);
+    if (error < 0.0f)
+    {
+        error = 0.0f;
+    }
+    limiter->model_offset += CHASSIS_POWER_OFFSET_ALPHA * (error - limiter->model_offset);
+}
+
+/**
+ * @brief 底盘功率限制
+ * @param limiter 功率限制器指针
+ * @param current 各轮指令转矩电流(A)，原地修改
+ * @param speed_rpm 各轮实测转子转速(rpm)
+ * @param wheel_cnt 轮子数量
+ * @return 电流缩放系数 [0,1]
+ * @note 耗能轮总功率 P(s) = b·s² + a·s + c，其中 a = Σk_torque·I·n，b = Σk_copper·I²，c = Σk_speed·n²，
+ *       求 P(s) + P_fixed 不超过允许功率的最大 s；允许功率 = 功率上限 + (缓冲能量 - 保留能量) / 释放时间。
+ * @date 2025-12-04
+ */
+float Chassis_Power_Limit(ChassisPowerLimit_s *limiter, float *current, const float *speed_rpm, uint8_t wheel_cnt)
+{
+    if (limiter == NULL || current == NULL || speed_rpm == NULL)
+    {
+        return 1.0f;
+    }
+    if (wheel_cnt > CHASSIS_POWER_MAX_WHEEL)
+    {
+        wheel_cnt = CHASSIS_POWER_MAX_WHEEL;
+    }
+    const ChassisPowerConfig_s *config = &limiter->config;
+
+    // 1. 允许功率：缓冲能量高于保留值时在释放时间内用完，低于保留值时降低功率回充
+    float power_allow = limiter->power_limit + (limiter->buffer_energy - config->buffer_reserve) / config->buffer_horizon;
+    if (power_allow < 0.0f)
+    {
+        power_allow = 0.0f;
+    }
+
+    // 2. 预测各轮功率，制动轮不参与缩放
+    float a = 0.0f, b = 0.0f, c = 0.0f;
+    float power_fixed = config->p_static + limiter->model_offset;
+    uint8_t driving_mask = 0;
+    for (uint8_t i = 0; i < wheel_cnt; i++)
+    {
+        const float torque_term = config->k_torque * current[i] * speed_rpm[i];
+        const float copper_term = config->k_copper * current[i] * current[i];
+        const float speed_term = config->k_speed * speed_rpm[i] * speed_rpm[i];
+        if (torque_term + copper_term + speed_term > 0.0f)
+        {
+            a += torque_term;
+            b += copper_term;
+            c += speed_term;
+            driving_mask |= (uint8_t)(1u << i);
+        }
+    }
+    const float power_predict = a + b + c + power_fixed;
+
+    // 3. 求最大缩放系数
+    float scale = 1.0f;
+    if (power_predict > power_allow)
+    {
+        const float c0 = c + power_fixed - power_allow;
+        if (c0 >= 0.0f)
+        {
+            scale = 0.0f;
+        }
+        else
+        {
+            // b·s² + a·s + c0 = 0 的正根，c0 < 0 时判别式不小于 a²
+            const float root = sqrtf(a * a - 4.0f * b * c0);
+            if (a + root > 1e-6f)
+            {
+                scale = -2.0f * c0 / (a + root);
+            }
+            else if (b > 1e-6f)
+            {
+                scale = (root - a) / (2.0f * b);
+            }
+            else
+            {
+                scale = 0.0f;
+            }
+            if (scale > 1.0f)
+            {
+                scale = 1.0f;
+            }
+            else if (scale < 0.0f)
+            {
+                scale = 0.0f;
+            }
+        }
+        for (uint8_t i = 0; i < wheel_cnt; i++)
+        {
+            if (driving_mask & (1u << i))
+            {
+                current[i] *= scale;
+            }
+        }
+    }
+
+    limiter->power_allow = power_allow;
+    limiter->power_predict = power_predict;
+    limiter->power_output = b * scale * scale + a * scale + c + power_fixed;
+    limiter->scale = scale;
+    return scale;
 }
-*/
\ No newline at end of file
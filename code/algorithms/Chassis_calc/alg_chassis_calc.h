@@ -5,6 +5,11 @@
 #include "bsp_can.h"
 #include "alg_pid.h"
 
+#define CHASSIS_POWER_LIMIT_DEFAULT   45.0f   ///< 未收到裁判系统数据前的功率上限(W)
+#define CHASSIS_POWER_BUFFER_HORIZON  1.0f    ///< 默认缓冲能量释放时间(s)
+#define CHASSIS_POWER_OFFSET_ALPHA    0.1f    ///< 模型校正低通系数
+#define CHASSIS_POWER_MAX_WHEEL       8       ///< 功率限制支持的最大轮子数
+
 /**
  * @brief 底盘电机类型枚举
  */
@@ -46,6 +51,34 @@ typedef struct {
     float absolute_chassis_Vw;    ///< 绝对坐标系下旋转角速度(rad/s)
 }absolute_chassis_speed;
 
+/**
+ * @brief 底盘功率模型与缓冲能量使用配置
+ * @note 单轮输入功率模型 P = k_torque·I·n + k_copper·I² + k_speed·n²，I 为转矩电流(A)，n 为转子转速(rpm)，
+ *       整车功率为各轮之和再加 p_static；系数需用实测的裁判系统功率对指令电流和转速做最小二乘拟合。
+ */
+typedef struct {
+    float k_torque;                         ///< 机械功率系数 W/(A·rpm)，等于转子侧转矩常数(N·m/A)×2π/60
+    float k_copper;                         ///< 铜损系数 W/A²
+    float k_speed;                          ///< 转速相关损耗系数 W/rpm²
+    float p_static;                         ///< 整车静态功耗 W
+    float buffer_reserve;                   ///< 保留不使用的缓冲能量 J
+    float buffer_horizon;                   ///< 缓冲能量释放时间 s，可用缓冲能量在该时间内用完
+}ChassisPowerConfig_s;
+
+/**
+ * @brief 底盘功率限制器
+ */
+typedef struct {
+    ChassisPowerConfig_s config;            ///< 模型与缓冲能量配置
+    float power_limit;                      ///< 底盘功率上限 W
+    float buffer_energy;                    ///< 当前缓冲能量 J
+    float model_offset;                     ///< 实测功率与模型预测差值的低通估计 W
+    float power_allow;                      ///< 本周期允许功率 W
+    float power_predict;                    ///< 限制前预测功率 W
+    float power_output;                     ///< 限制后预测功率 W
+    float scale;                            ///< 耗能轮电流缩放系数 [0,1]
+}ChassisPowerLimit_s;
+
 /**
  * @brief 底盘初始化配置结构体
  */
@@ -60,6 +93,7 @@ typedef struct {
     float chassis_radius;                   ///< 底盘旋转半径(m)
     float gimbal_yaw_zero;                  ///< 云台偏航零点角度(rad)
     float gimbal_yaw_half;                  ///< 云台俯仰零点角度(rad)
+    ChassisPowerConfig_s power_config;      ///< 功率限制配置
 }ChassisInitConfig_s;
 
 /**
@@ -82,6 +116,7 @@ typedef struct {
     DjiMotorInstance_s *chassis_Steering_motor[4]; ///< 舵轮转向电机数组
     float out_speed[4];                     ///< 电机输出速度数组(rpm)
     float out_angle[4];                     ///< 电机输出角度数组(rad)
+    ChassisPowerLimit_s power_limit;        ///< 功率限制器
 }ChassisInstance_s;
 
 /**
@@ -116,4 +151,43 @@ bool Chassis_Calc(ChassisInstance_s *Chassis);
  * @date 2025-07-09
  */
 void Chassis_Mode_Choose(ChassisInstance_s* Chassis);
+
+/**
+ * @brief 初始化功率限制器
+ * @param limiter 功率限制器指针
+ * @param config 功率模型配置
+ * @date 2025-12-04
+ */
+void Chassis_Power_Limit_Init(ChassisPowerLimit_s *limiter, const ChassisPowerConfig_s *config);
+
+/**
+ * @brief 更新功率上限和缓冲能量
+ * @param limiter 功率限制器指针
+ * @param power_limit 底盘功率上限(W)，可手动设置或取裁判系统 robot_status.chassis_power_limit
+ * @param buffer_energy 缓冲能量(J)，可取裁判系统 power_heat.buffer_energy，无裁判系统时传入0
+ * @date 2025-12-04
+ */
+void Chassis_Power_Set_Limit(ChassisPowerLimit_s *limiter, float power_limit, float buffer_energy);
+
+/**
+ * @brief 用实测底盘功率校正模型
+ * @param limiter 功率限制器指针
+ * @param measured_power 实测功率(W)，可取裁判系统 power_heat.chassis_power
+ * @note 可选，按实测功率的更新频率调用
+ * @date 2025-12-04
+ */
+void Chassis_Power_Update_Measure(ChassisPowerLimit_s *limiter, float measured_power);
+
+/**
+ * @brief 底盘功率限制，按比例缩小耗能轮的指令电流使预测功率不超过允许功率
+ * @param limiter 功率限制器指针
+ * @param current 各轮指令转矩电流(A)，原地修改
+ * @param speed_rpm 各轮实测转子转速(rpm)
+ * @param wheel_cnt 轮子数量，不超过 CHASSIS_POWER_MAX_WHEEL
+ * @return 电流缩放系数 [0,1]
+ * @note 每个控制周期在速度环输出之后、发送电流之前调用，无内存分配，复杂度 O(wheel_cnt)。
+ *       制动轮(预测功率不大于0)不缩放，其功率按0计入。
+ * @date 2025-12-04
+ */
+float Chassis_Power_Limit(ChassisPowerLimit_s *limiter, float *current, const float *speed_rpm, uint8_t wheel_cnt);
 #endif
@@ -1,4 +1,13 @@
 #include "alg_crc.h"
+#include "plf_log.h"
+#if defined(USER_HW_CRC)
+#include "crc.h"
+#include "bsp_cache.h"
+#endif
+
+#if !defined(CRC_SLICING)
+#define CRC_SLICING 1
+#endif
 
 /* CRC_CCITT算法实现 */
 
@@ -57,8 +66,465 @@ const uint16_t Crc_ccitt_byte(uint16_t crc, const uint8_t c)
 
 uint16_t Crc_Ccitt_Calculate(uint16_t crc, uint8_t const *buffer, size_t len)
 {
+	return Crc16_Calculate(crc, buffer, len);
+}
+
+/* 切片查找表，第k张表为字节b后接k个0字节的CRC值 */
+static uint8_t crc8_table[CRC_SLICING][256];
+static uint16_t crc16_table[CRC_SLICING][256];
+static uint16_t crc16_false_table[CRC_SLICING][256];
+static uint32_t crc32_table[CRC_SLICING][256];
+static volatile bool crc_table_ready = false;
+
+/**
+ * @brief 小端读取4字节
+ * @param p 数据指针，可不对齐
+ * @return 读取到的值
+ */
+static inline uint32_t Crc_Read_U32(uint8_t const *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 逐位计算反射算法单字节的CRC值
+ * @param poly 反射后的多项式
+ * @param b 字节
+ * @return 单字节CRC值
+ */
+static uint32_t Crc_Reflected_Byte(uint32_t poly, uint8_t b)
+{
+	uint32_t c = b;
+	for (uint8_t i = 0; i < 8; i++)
+		c = (c & 1u) ? (c >> 1) ^ poly : (c >> 1);
+	return c;
+}
+
+/**
+ * @brief 生成查找表
+ * @note 生成过程只写入确定的值，中断中重入只会重复生成，不会得到错误的表
+ */
+static void Crc_Table_Init(void)
+{
+	for (uint32_t b = 0; b < 256; b++)
+	{
+		uint32_t c = (uint32_t)b << 8;
+		for (uint8_t i = 0; i < 8; i++)
+			c = (c & 0x8000u) ? (c << 1) ^ 0x1021u : (c << 1);
+
+		crc8_table[0][b] = (uint8_t)Crc_Reflected_Byte(0x8Cu, (uint8_t)b);
+		crc16_table[0][b] = crc_ccitt_table[b];
+		crc16_false_table[0][b] = (uint16_t)c;
+		crc32_table[0][b] = Crc_Reflected_Byte(0xEDB88320u, (uint8_t)b);
+	}
+	for (uint32_t k = 1; k < CRC_SLICING; k++)
+	{
+		for (uint32_t b = 0; b < 256; b++)
+		{
+			crc8_table[k][b] = crc8_table[0][crc8_table[k - 1][b]];
+			crc16_table[k][b] = (crc16_table[k - 1][b] >> 8) ^ crc16_table[0][crc16_table[k - 1][b] & 0xff];
+			crc16_false_table[k][b] = (uint16_t)((crc16_false_table[k - 1][b] << 8) ^ crc16_false_table[0][crc16_false_table[k - 1][b] >> 8]);
+			crc32_table[k][b] = (crc32_table[k - 1][b] >> 8) ^ crc32_table[0][crc32_table[k - 1][b] & 0xff];
+		}
+	}
+	crc_table_ready = true;
+}
+
+#if defined(USER_HW_CRC)
+/* 硬件CRC单元占用标志 */
+static volatile uint8_t crc_hw_busy = 0;
+
+/**
+ * @brief 将硬件CRC单元配置为CRC-32（字节输入反射，输出反射）
+ */
+static void Crc_Hw_Init(void)
+{
+	hcrc.Instance = CRC;
+	hcrc.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+	hcrc.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+	hcrc.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_BYTE;
+	hcrc.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_ENABLE;
+	hcrc.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+	if (HAL_CRC_Init(&hcrc) != HAL_OK)
+	{
+		Log_Error("Crc_Hw_Init : HAL_CRC_Init failed");
+	}
+}
+
+/**
+ * @brief 尝试占用硬件CRC单元
+ * @return true 占用成功  false 已被占用
+ */
+static inline bool Crc_Hw_Lock(void)
+{
+	return __atomic_exchange_n(&crc_hw_busy, 1u, __ATOMIC_ACQUIRE) == 0u;
+}
+
+/**
+ * @brief 释放硬件CRC单元
+ */
+static inline void Crc_Hw_Unlock(void)
+{
+	__atomic_store_n(&crc_hw_busy, 0u, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief 装载寄存器初值，硬件内部为非反射寄存器，需要位反转
+ * @param crc 反射形式的寄存器值
+ */
+static inline void Crc_Hw_Load(uint32_t crc)
+{
+	CRC->INIT = __RBIT(crc);
+	__HAL_CRC_DR_RESET(&hcrc);
+}
+#endif
+
+/**
+ * @brief 生成软件查找表，启用硬件CRC时同时初始化硬件CRC单元
+ */
+void Crc_Init(void)
+{
+#if defined(USER_HW_CRC)
+	/* 先配置硬件，查找表就绪标志置位后其他上下文才可能使用硬件CRC */
+	static bool crc_hw_ready = false;
+	if (!crc_hw_ready && Crc_Hw_Lock())
+	{
+		Crc_Hw_Init();
+		crc_hw_ready = true;
+		Crc_Hw_Unlock();
+	}
+#endif
+	if (!crc_table_ready)
+		Crc_Table_Init();
+}
+
+/**
+ * @brief 更新CRC8寄存器
+ */
+uint8_t Crc8_Calculate(uint8_t crc, uint8_t const *buffer, size_t len)
+{
+	if (!crc_table_ready)
+		Crc_Init();
+	if (buffer == NULL)
+		return crc;
+#if CRC_SLICING >= 8
+	while (len >= 8)
+	{
+		const uint32_t lo = crc ^ Crc_Read_U32(buffer);
+		const uint32_t hi = Crc_Read_U32(buffer + 4);
+		crc = crc8_table[7][lo & 0xff] ^ crc8_table[6][(lo >> 8) & 0xff] ^
+		      crc8_table[5][(lo >> 16) & 0xff] ^ crc8_table[4][lo >> 24] ^
+		      crc8_table[3][hi & 0xff] ^ crc8_table[2][(hi >> 8) & 0xff] ^
+		      crc8_table[1][(hi >> 16) & 0xff] ^ crc8_table[0][hi >> 24];
+		buffer += 8;
+		len -= 8;
+	}
+#endif
+#if CRC_SLICING >= 4
+	while (len >= 4)
+	{
+		const uint32_t lo = crc ^ Crc_Read_U32(buffer);
+		crc = crc8_table[3][lo & 0xff] ^ crc8_table[2][(lo >> 8) & 0xff] ^
+		      crc8_table[1][(lo >> 16) & 0xff] ^ crc8_table[0][lo >> 24];
+		buffer += 4;
+		len -= 4;
+	}
+#endif
+	while (len--)
+		crc = crc8_table[0][crc ^ *buffer++];
+	return crc;
+}
+
+/**
+ * @brief 更新CRC16寄存器（反射，多项式0x1021）
+ */
+uint16_t Crc16_Calculate(uint16_t crc, uint8_t const *buffer, size_t len)
+{
+	if (!crc_table_ready)
+		Crc_Init();
+	if (buffer == NULL)
+		return crc;
+#if CRC_SLICING >= 8
+	while (len >= 8)
+	{
+		const uint32_t lo = crc ^ Crc_Read_U32(buffer);
+		const uint32_t hi = Crc_Read_U32(buffer + 4);
+		crc = crc16_table[7][lo & 0xff] ^ crc16_table[6][(lo >> 8) & 0xff] ^
+		      crc16_table[5][(lo >> 16) & 0xff] ^ crc16_table[4][lo >> 24] ^
+		      crc16_table[3][hi & 0xff] ^ crc16_table[2][(hi >> 8) & 0xff] ^
+		      crc16_table[1][(hi >> 16) & 0xff] ^ crc16_table[0][hi >> 24];
+		buffer += 8;
+		len -= 8;
+	}
+#endif
+#if CRC_SLICING >= 4
+	while (len >= 4)
+	{
+		const uint32_t lo = crc ^ Crc_Read_U32(buffer);
+		crc = crc16_table[3][lo & 0xff] ^ crc16_table[2][(lo >> 8) & 0xff] ^
+		      crc16_table[1][(lo >> 16) & 0xff] ^ crc16_table[0][lo >> 24];
+		buffer += 4;
+		len -= 4;
+	}
+#endif
 	while (len--)
-		crc = Crc_ccitt_byte(crc, *buffer++);
+		crc = (crc >> 8) ^ crc16_table[0][(crc ^ *buffer++) & 0xff];
 	return crc;
 }
+
+/**
+ * @brief 更新CRC-16/CCITT-FALSE寄存器（不反射，多项式0x1021）
+ */
+uint16_t Crc16_False_Calculate(uint16_t crc, uint8_t const *buffer, size_t len)
+{
+	if (!crc_table_ready)
+		Crc_Init();
+	if (buffer == NULL)
+		return crc;
+#if CRC_SLICING >= 8
+	while (len >= 8)
+	{
+		crc = crc16_false_table[7][buffer[0] ^ (crc >> 8)] ^ crc16_false_table[6][buffer[1] ^ (crc & 0xff)] ^
+		      crc16_false_table[5][buffer[2]] ^ crc16_false_table[4][buffer[3]] ^
+		      crc16_false_table[3][buffer[4]] ^ crc16_false_table[2][buffer[5]] ^
+		      crc16_false_table[1][buffer[6]] ^ crc16_false_table[0][buffer[7]];
+		buffer += 8;
+		len -= 8;
+	}
+#endif
+#if CRC_SLICING >= 4
+	while (len >= 4)
+	{
+		crc = crc16_false_table[3][buffer[0] ^ (crc >> 8)] ^ crc16_false_table[2][buffer[1] ^ (crc & 0xff)] ^
+		      crc16_false_table[1][buffer[2]] ^ crc16_false_table[0][buffer[3]];
+		buffer += 4;
+		len -= 4;
+	}
+#endif
+	while (len--)
+		crc = (uint16_t)((crc << 8) ^ crc16_false_table[0][(crc >> 8) ^ *buffer++]);
+	return crc;
+}
+
+/**
+ * @brief 软件更新CRC32寄存器
+ */
+static uint32_t Crc32_Sw_Calculate(uint32_t crc, uint8_t const *buffer, size_t len)
+{
+#if CRC_SLICING >= 8
+	while (len >= 8)
+	{
+		const uint32_t lo = crc ^ Crc_Read_U32(buffer);
+		const uint32_t hi = Crc_Read_U32(buffer + 4);
+		crc = crc32_table[7][lo & 0xff] ^ crc32_table[6][(lo >> 8) & 0xff] ^
+		      crc32_table[5][(lo >> 16) & 0xff] ^ crc32_table[4][lo >> 24] ^
+		      crc32_table[3][hi & 0xff] ^ crc32_table[2][(hi >> 8) & 0xff] ^
+		      crc32_table[1][(hi >> 16) & 0xff] ^ crc32_table[0][hi >> 24];
+		buffer += 8;
+		len -= 8;
+	}
+#endif
+#if CRC_SLICING >= 4
+	while (len >= 4)
+	{
+		const uint32_t lo = crc ^ Crc_Read_U32(buffer);
+		crc = crc32_table[3][lo & 0xff] ^ crc32_table[2][(lo >> 8) & 0xff] ^
+		      crc32_table[1][(lo >> 16) & 0xff] ^ crc32_table[0][lo >> 24];
+		buffer += 4;
+		len -= 4;
+	}
+#endif
+	while (len--)
+		crc = (crc >> 8) ^ crc32_table[0][(crc ^ *buffer++) & 0xff];
+	return crc;
+}
+
+/**
+ * @brief 更新CRC32寄存器
+ */
+uint32_t Crc32_Calculate(uint32_t crc, uint8_t const *buffer, size_t len)
+{
+	if (!crc_table_ready)
+		Crc_Init();
+	if (buffer == NULL)
+		return crc;
+#if defined(USER_HW_CRC)
+	if (len >= CRC_HW_THRESHOLD && Crc_Hw_Lock())
+	{
+		Crc_Hw_Load(crc);
+		crc = HAL_CRC_Accumulate(&hcrc, (uint32_t *)buffer, (uint32_t)len);
+		Crc_Hw_Unlock();
+		return crc;
+	}
+#endif
+	return Crc32_Sw_Calculate(crc, buffer, len);
+}
+
+#if defined(USER_HW_CRC) && defined(CRC_HW_DMA_HANDLE)
+extern DMA_HandleTypeDef CRC_HW_DMA_HANDLE;
+static CrcHwCallback crc_hw_callback = NULL;
+
+/**
+ * @brief DMA传输完成回调，读取结果并释放硬件CRC单元
+ * @param hdma DMA句柄
+ */
+static void Crc_Hw_Dma_Cplt_Callback(DMA_HandleTypeDef *hdma)
+{
+	(void)hdma;
+	const uint32_t crc = CRC->DR;
+	const CrcHwCallback callback = crc_hw_callback;
+	Crc_Hw_Unlock();
+	if (callback != NULL)
+		callback(crc);
+}
+
+/**
+ * @brief DMA传输错误回调，释放硬件CRC单元
+ * @param hdma DMA句柄
+ */
+static void Crc_Hw_Dma_Error_Callback(DMA_HandleTypeDef *hdma)
+{
+	(void)hdma;
+	Log_Error("Crc32_Hw_Calculate_DMA : DMA transfer error");
+	Crc_Hw_Unlock();
+}
+
+/**
+ * @brief 使用DMA将数据送入硬件CRC单元
+ */
+bool Crc32_Hw_Calculate_DMA(uint32_t crc, uint8_t const *buffer, size_t len, CrcHwCallback callback)
+{
+	if (buffer == NULL || len == 0 || len > 0xFFFFu || callback == NULL)
+	{
+		Log_Error("Crc32_Hw_Calculate_DMA : invalid argument");
+		return false;
+	}
+	if (!crc_table_ready)
+		Crc_Init();
+	if (!Crc_Hw_Lock())
+		return false;
+
+	crc_hw_callback = callback;
+	Crc_Hw_Load(crc);
+	Cache_Clean(buffer, (uint32_t)len);
+	HAL_DMA_RegisterCallback(&CRC_HW_DMA_HANDLE, HAL_DMA_XFER_CPLT_CB_ID, Crc_Hw_Dma_Cplt_Callback);
+	HAL_DMA_RegisterCallback(&CRC_HW_DMA_HANDLE, HAL_DMA_XFER_ERROR_CB_ID, Crc_Hw_Dma_Error_Callback);
+	if (HAL_DMA_Start_IT(&CRC_HW_DMA_HANDLE, (uint32_t)buffer, (uint32_t)&CRC->DR, (uint32_t)len) != HAL_OK)
+	{
+		Log_Error("Crc32_Hw_Calculate_DMA : HAL_DMA_Start_IT failed");
+		Crc_Hw_Unlock();
+		return false;
+	}
+	return true;
+}
+#endif
+
+/**
+ * @brief 校验以CRC8结尾的数据
+ */
+bool Crc8_Verify(uint8_t const *buffer, size_t len)
+{
+	if (buffer == NULL || len <= 1)
+		return false;
+	return Crc8_Calculate(CRC8_INIT, buffer, len - 1) == buffer[len - 1];
+}
+
+/**
+ * @brief 计算CRC8并写入缓冲区最后1字节
+ */
+void Crc8_Append(uint8_t *buffer, size_t len)
+{
+	if (buffer == NULL || len <= 1)
+		return;
+	buffer[len - 1] = Crc8_Calculate(CRC8_INIT, buffer, len - 1);
+}
+
+/**
+ * @brief 校验以CRC16(小端)结尾的数据
+ */
+bool Crc16_Verify(uint8_t const *buffer, size_t len)
+{
+	if (buffer == NULL || len <= 2)
+		return false;
+	const uint16_t crc = Crc16_Calculate(CRC16_INIT, buffer, len - 2);
+	return (crc & 0xff) == buffer[len - 2] && (crc >> 8) == buffer[len - 1];
+}
+
+/**
+ * @brief 计算CRC16并以小端写入缓冲区最后2字节
+ */
+void Crc16_Append(uint8_t *buffer, size_t len)
+{
+	if (buffer == NULL || len <= 2)
+		return;
+	const uint16_t crc = Crc16_Calculate(CRC16_INIT, buffer, len - 2);
+	buffer[len - 2] = (uint8_t)(crc & 0xff);
+	buffer[len - 1] = (uint8_t)(crc >> 8);
+}
+
+/**
+ * @brief 初始化流式计算上下文
+ */
+void Crc_Stream_Init(CrcStream_s *stream, CrcType_e type)
+{
+	if (stream == NULL)
+		return;
+	stream->type = type;
+	switch (type)
+	{
+	case CRC_TYPE_CRC8:
+		stream->crc = CRC8_INIT;
+		break;
+	case CRC_TYPE_CRC16:
+		stream->crc = CRC16_INIT;
+		break;
+	case CRC_TYPE_CRC16_FALSE:
+		stream->crc = CRC16_FALSE_INIT;
+		break;
+	case CRC_TYPE_CRC32:
+		stream->crc = CRC32_INIT;
+		break;
+	default:
+		Log_Error("Crc_Stream_Init : invalid crc type %d", type);
+		stream->type = CRC_TYPE_CRC32;
+		stream->crc = CRC32_INIT;
+		break;
+	}
+}
+
+/**
+ * @brief 向流式计算上下文追加数据
+ */
+void Crc_Stream_Update(CrcStream_s *stream, uint8_t const *buffer, size_t len)
+{
+	if (stream == NULL)
+		return;
+	switch (stream->type)
+	{
+	case CRC_TYPE_CRC8:
+		stream->crc = Crc8_Calculate((uint8_t)stream->crc, buffer, len);
+		break;
+	case CRC_TYPE_CRC16:
+		stream->crc = Crc16_Calculate((uint16_t)stream->crc, buffer, len);
+		break;
+	case CRC_TYPE_CRC16_FALSE:
+		stream->crc = Crc16_False_Calculate((uint16_t)stream->crc, buffer, len);
+		break;
+	case CRC_TYPE_CRC32:
+		stream->crc = Crc32_Calculate(stream->crc, buffer, len);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief 获取流式计算结果
+ */
+uint32_t Crc_Stream_Final(const CrcStream_s *stream)
+{
+	if (stream == NULL)
+		return 0;
+	return (stream->type == CRC_TYPE_CRC32) ? (stream->crc ^ CRC32_XOROUT) : stream->crc;
+}
 /* CRC_CCITT算法实现 */
@@ -1,18 +1,62 @@
 /**
 *   @file alg_crc.h
-*   @brief 
+*   @brief CRC校验和计算
 *   @author Wenxin HU
 *   @date 25-7-13
 *   @version 0.5
 *   @note
 *
-*   @TODO 目前只提供了CRC-CCITT的计算函数,剩余的CRC8和CRC16
+*   @date 25-12-02
+*   @version 0.6
+*   @note 新增 CRC8 / CRC16 / CRC16-FALSE / CRC32：
+*         - 软件实现为查找表切片(slicing-by-N)，N 由 robot_config.h 中的 CRC_SLICING 选择(1/4/8)，
+*           查找表在第一次调用时生成到RAM中，也可以在初始化阶段调用 Crc_Init 提前生成。
+*         - 定义 USER_HW_CRC 后，长度不小于 CRC_HW_THRESHOLD 的 CRC32 交给硬件CRC单元计算，
+*           硬件正在被占用（如中断中重入、DMA计算未完成）时自动回退到软件实现。
+*         - *_Calculate 函数只做寄存器更新(不含初始值和结果异或)，可以分段调用；
+*           完整的校验流程使用 CrcStream_s 流式接口，裁判系统帧校验使用 Crc8/Crc16 的 Verify/Append。
 */
 #ifndef ALG_CRC_H
 #define ALG_CRC_H
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include "robot_config.h"
+
+/* 各算法的初始值与结果异或值 */
+#define CRC8_INIT           0xFFu        // 裁判系统 CRC8 初始值
+#define CRC16_INIT          0xFFFFu      // 裁判系统 CRC16 初始值
+#define CRC16_FALSE_INIT    0xFFFFu      // CRC-16/CCITT-FALSE 初始值
+#define CRC32_INIT          0xFFFFFFFFu  // CRC-32 初始值
+#define CRC32_XOROUT        0xFFFFFFFFu  // CRC-32 结果异或值
+
+/**
+ * @brief CRC算法类型
+ */
+typedef enum
+{
+    CRC_TYPE_CRC8 = 0,      // 多项式0x31，反射输入输出，裁判系统帧头校验
+    CRC_TYPE_CRC16,         // 多项式0x1021，反射输入输出，裁判系统整帧校验（与 Crc_Ccitt_Calculate 相同）
+    CRC_TYPE_CRC16_FALSE,   // 多项式0x1021，不反射，CRC-16/CCITT-FALSE
+    CRC_TYPE_CRC32,         // 多项式0x04C11DB7，反射输入输出，CRC-32/IEEE
+    CRC_TYPE_CNT
+} CrcType_e;
+
+/**
+ * @brief 流式CRC计算上下文
+ */
+typedef struct
+{
+    CrcType_e type;         // 算法类型
+    uint32_t crc;           // 当前寄存器值
+} CrcStream_s;
+
+/**
+ * @brief 生成软件查找表，启用硬件CRC时同时初始化硬件CRC单元
+ * @note 可不调用，第一次计算时会自动执行
+ */
+void Crc_Init(void);
 
 /**
  * @brief 用于计算缓冲区内数据的CRC-CCITT校验和
@@ -23,4 +67,111 @@
  */
 uint16_t Crc_Ccitt_Calculate(uint16_t crc, uint8_t const *buffer, size_t len);
 
+/**
+ * @brief 更新CRC8寄存器
+ * @param crc 上一次的CRC值，首次调用传入 CRC8_INIT
+ * @param buffer 缓冲区指针
+ * @param len 缓冲区长度
+ * @return 更新后的CRC值
+ */
+uint8_t Crc8_Calculate(uint8_t crc, uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 更新CRC16寄存器（反射，多项式0x1021）
+ * @param crc 上一次的CRC值，首次调用传入 CRC16_INIT
+ * @param buffer 缓冲区指针
+ * @param len 缓冲区长度
+ * @return 更新后的CRC值
+ */
+uint16_t Crc16_Calculate(uint16_t crc, uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 更新CRC-16/CCITT-FALSE寄存器（不反射，多项式0x1021）
+ * @param crc 上一次的CRC值，首次调用传入 CRC16_FALSE_INIT
+ * @param buffer 缓冲区指针
+ * @param len 缓冲区长度
+ * @return 更新后的CRC值
+ */
+uint16_t Crc16_False_Calculate(uint16_t crc, uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 更新CRC32寄存器
+ * @param crc 上一次的CRC值，首次调用传入 CRC32_INIT
+ * @param buffer 缓冲区指针
+ * @param len 缓冲区长度
+ * @return 更新后的CRC值，最终结果需异或 CRC32_XOROUT
+ */
+uint32_t Crc32_Calculate(uint32_t crc, uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 校验以CRC8结尾的数据
+ * @param buffer 缓冲区指针，最后1字节为CRC8
+ * @param len 含CRC在内的总长度
+ * @return true 校验通过  false 校验失败
+ */
+bool Crc8_Verify(uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 计算CRC8并写入缓冲区最后1字节
+ * @param buffer 缓冲区指针
+ * @param len 含CRC在内的总长度
+ */
+void Crc8_Append(uint8_t *buffer, size_t len);
+
+/**
+ * @brief 校验以CRC16(小端)结尾的数据
+ * @param buffer 缓冲区指针，最后2字节为CRC16
+ * @param len 含CRC在内的总长度
+ * @return true 校验通过  false 校验失败
+ */
+bool Crc16_Verify(uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 计算CRC16并以小端写入缓冲区最后2字节
+ * @param buffer 缓冲区指针
+ * @param len 含CRC在内的总长度
+ */
+void Crc16_Append(uint8_t *buffer, size_t len);
+
+/**
+ * @brief 初始化流式计算上下文
+ * @param stream 上下文指针
+ * @param type 算法类型
+ */
+void Crc_Stream_Init(CrcStream_s *stream, CrcType_e type);
+
+/**
+ * @brief 向流式计算上下文追加数据
+ * @param stream 上下文指针
+ * @param buffer 缓冲区指针
+ * @param len 缓冲区长度
+ */
+void Crc_Stream_Update(CrcStream_s *stream, uint8_t const *buffer, size_t len);
+
+/**
+ * @brief 获取流式计算结果（已处理结果异或），上下文可继续追加数据
+ * @param stream 上下文指针
+ * @return CRC校验和
+ */
+uint32_t Crc_Stream_Final(const CrcStream_s *stream);
+
+#if defined(USER_HW_CRC) && defined(CRC_HW_DMA_HANDLE)
+/**
+ * @brief 硬件CRC32计算完成回调
+ * @param crc 更新后的CRC值，最终结果需异或 CRC32_XOROUT
+ */
+typedef void (*CrcHwCallback)(uint32_t crc);
+
+/**
+ * @brief 使用DMA将数据送入硬件CRC单元，适用于长缓冲区
+ * @param crc 上一次的CRC值，首次调用传入 CRC32_INIT
+ * @param buffer 缓冲区指针，必须位于DMA可访问的内存（不能在DTCM中）
+ * @param len 缓冲区长度，不超过65535
+ * @param callback 计算完成回调，在DMA中断中执行
+ * @return true 已启动  false 硬件CRC被占用或参数错误
+ * @note 计算完成前不能修改缓冲区
+ */
+bool Crc32_Hw_Calculate_DMA(uint32_t crc, uint8_t const *buffer, size_t len, CrcHwCallback callback);
+#endif
+
 #endif //ALG_CRC_H
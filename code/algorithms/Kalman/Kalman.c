@@ -1,6 +1,510 @@
-#include "arm_math.h"
 #include "Kalman.h"
-#include "math.h"
+#include "arm_math.h"
+#include "plf_log.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#define KALMAN_N KALMAN_MAX_STATE_DIM
+#define KALMAN_M KALMAN_MAX_MEAS_DIM
+
+/**
+ * @brief 置为单位阵
+ * @param A 矩阵 n x n
+ * @param n 维数
+ */
+static void Kalman_Eye(float* A, uint8_t n){
+    memset(A, 0, sizeof(float) * n * n);
+    for (uint8_t i = 0; i < n; i++){
+        A[i * n + i] = 1.0f;
+    }
+}
+
+/**
+ * @brief 对称半正定矩阵原地分解为 A = U D Uᵀ
+ * @param A 输入对称矩阵 n x n（只读上三角），输出 U 的严格上三角 + D 的对角，下三角清零
+ * @param n 维数
+ * @note 从最后一列向前计算，只读取尚未覆盖的上三角元素；D 不为正的列（例如 Q 中的零方差分量）U 取零
+ */
+static void Kalman_Ud_Factor(float* A, uint8_t n){
+    for (uint8_t j = n; j-- > 0;){
+        float d = A[j * n + j];
+        for (uint8_t k = j + 1; k < n; k++){
+            d -= A[k * n + k] * A[j * n + k] * A[j * n + k];
+        }
+        const float d_inv = d > 0.0f ? 1.0f / d : 0.0f;
+        A[j * n + j] = d > 0.0f ? d : 0.0f;
+        for (uint8_t i = 0; i < j; i++){
+            float s = A[i * n + j];
+            for (uint8_t k = j + 1; k < n; k++){
+                s -= A[k * n + k] * A[i * n + k] * A[j * n + k];
+            }
+            A[i * n + j] = s * d_inv;
+        }
+        for (uint8_t i = j + 1; i < n; i++){
+            A[i * n + j] = 0.0f;
+        }
+    }
+}
+
+/**
+ * @brief 由 UD 分解计算完整协方差 P = U D Uᵀ
+ * @param UD U 的严格上三角 + D 的对角
+ * @param P 输出 n x n
+ * @param n 维数
+ */
+static void Kalman_Ud_Expand(const float* UD, float* P, uint8_t n){
+    for (uint8_t i = 0; i < n; i++){
+        for (uint8_t j = i; j < n; j++){
+            // U[j][j] = 1，k < j 的项 U[j][k] 为零
+            float s = i == j ? UD[j * n + j] : UD[i * n + j] * UD[j * n + j];
+            for (uint8_t k = j + 1; k < n; k++){
+                s += UD[i * n + k] * UD[k * n + k] * UD[j * n + k];
+            }
+            P[i * n + j] = s;
+            P[j * n + i] = s;
+        }
+    }
+}
+
+/**
+ * @brief UD 形式的协方差预测（Thornton 加权 Gram-Schmidt）
+ * @param instance 实例指针
+ * @note P' = W Dw Wᵀ，W = [F U, Uq]，Dw = diag(D, Dq)，Q = Uq Dq Uqᵀ；
+ *       对 W 的行按 Dw 加权正交化，直接得到 P' 的 U 和 D，不会出现负的 D
+ */
+static void Kalman_Ud_Predict(KalmanInstance_s* instance){
+    const uint8_t n = instance->state_dim;
+    const uint8_t cols = 2 * n;
+    float* U = instance->P;
+    float W[KALMAN_N * 2 * KALMAN_N];
+    float Dw[2 * KALMAN_N];
+    float Uq[KALMAN_N * KALMAN_N];
+
+    memcpy(Uq, instance->Q, sizeof(float) * n * n);
+    Kalman_Ud_Factor(Uq, n);
+    for (uint8_t i = 0; i < n; i++){
+        float* w = &W[i * cols];
+        for (uint8_t j = 0; j < n; j++){
+            // (F U)[i][j]，U 为单位上三角
+            float s = instance->F[i * n + j];
+            for (uint8_t k = 0; k < j; k++){
+                s += instance->F[i * n + k] * U[k * n + j];
+            }
+            w[j] = s;
+            w[n + j] = i == j ? 1.0f : (i < j ? Uq[i * n + j] : 0.0f);
+        }
+        Dw[i] = U[i * n + i];
+        Dw[n + i] = Uq[i * n + i];
+    }
+
+    for (uint8_t k = n; k-- > 0;){
+        const float* wk = &W[k * cols];
+        float dw_wk[2 * KALMAN_N];
+        float d = 0.0f;
+        for (uint8_t j = 0; j < cols; j++){
+            dw_wk[j] = Dw[j] * wk[j];
+            d += wk[j] * dw_wk[j];
+        }
+        U[k * n + k] = d;
+        const float d_inv = d > 0.0f ? 1.0f / d : 0.0f;
+        for (uint8_t i = 0; i < k; i++){
+            float* wi = &W[i * cols];
+            float s = 0.0f;
+            for (uint8_t j = 0; j < cols; j++){
+                s += wi[j] * dw_wk[j];
+            }
+            const float u = s * d_inv;
+            U[i * n + k] = u;
+            for (uint8_t j = 0; j < cols; j++){
+                wi[j] -= u * wk[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief UD 形式的标量观测更新（Bierman）
+ * @param instance 实例指针
+ * @param h 观测行 n
+ * @param y 新息 z - h x
+ * @param r 观测噪声方差
+ */
+static void Kalman_Ud_Update_Scalar(KalmanInstance_s* instance, const float* h, float y, float r){
+    const uint8_t n = instance->state_dim;
+    float* U = instance->P;
+    float f[KALMAN_N];
+    float v[KALMAN_N];
+    float b[KALMAN_N];
+
+    // f = Uᵀ h，v = D f
+    for (uint8_t j = 0; j < n; j++){
+        float s = h[j];
+        for (uint8_t i = 0; i < j; i++){
+            s += U[i * n + j] * h[i];
+        }
+        f[j] = s;
+        v[j] = U[j * n + j] * s;
+    }
+
+    float alpha = r;
+    for (uint8_t j = 0; j < n; j++){
+        const float alpha_prev = alpha;
+        alpha += f[j] * v[j];
+        const float lambda = -f[j] / alpha_prev;
+        U[j * n + j] *= alpha_prev / alpha;
+        for (uint8_t i = 0; i < j; i++){
+            const float u = U[i * n + j];
+            U[i * n + j] = u + b[i] * lambda;
+            b[i] += v[j] * u;
+        }
+        b[j] = v[j];
+    }
+
+    // alpha 即新息方差 h P hᵀ + r，K = b / alpha
+    const float gain = y / alpha;
+    for (uint8_t i = 0; i < n; i++){
+        instance->x[i] += b[i] * gain;
+    }
+}
+
+/**
+ * @brief 完整协方差的标量观测更新，Joseph 形式按乘积展开，计算量 O(n²)
+ * @param instance 实例指针
+ * @param h 观测行 n
+ * @param y 新息 z - h x
+ * @param r 观测噪声方差
+ * @return true 已更新  false 新息方差不为正
+ */
+static bool Kalman_Full_Update_Scalar(KalmanInstance_s* instance, const float* h, float y, float r){
+    const uint8_t n = instance->state_dim;
+    float* P = instance->P;
+    float PHt[KALMAN_N];
+    float K[KALMAN_N];
+    float Mh[KALMAN_N];
+
+    float s = r;
+    for (uint8_t i = 0; i < n; i++){
+        float acc = 0.0f;
+        for (uint8_t j = 0; j < n; j++){
+            acc += P[i * n + j] * h[j];
+        }
+        PHt[i] = acc;
+        s += h[i] * acc;
+    }
+    if (!(s > 0.0f)){
+        return false;
+    }
+    const float s_inv = 1.0f / s;
+    for (uint8_t i = 0; i < n; i++){
+        K[i] = PHt[i] * s_inv;
+        instance->x[i] += K[i] * y;
+    }
+
+    // M = (I - K hᵀ) P = P - K PHtᵀ
+    for (uint8_t i = 0; i < n; i++){
+        for (uint8_t j = 0; j < n; j++){
+            P[i * n + j] -= K[i] * PHt[j];
+        }
+    }
+    // P = M (I - K hᵀ)ᵀ + r K Kᵀ = M - (M h) Kᵀ + r K Kᵀ
+    for (uint8_t i = 0; i < n; i++){
+        float acc = 0.0f;
+        for (uint8_t j = 0; j < n; j++){
+            acc += P[i * n + j] * h[j];
+        }
+        Mh[i] = acc;
+    }
+    for (uint8_t i = 0; i < n; i++){
+        for (uint8_t j = i; j < n; j++){
+            const float pij = P[i * n + j] - Mh[i] * K[j] + r * K[i] * K[j];
+            const float pji = P[j * n + i] - Mh[j] * K[i] + r * K[j] * K[i];
+            const float p = 0.5f * (pij + pji);
+            P[i * n + j] = p;
+            P[j * n + i] = p;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 初始化卡尔曼滤波实例
+ * @param instance 实例指针
+ * @param config 初始化配置
+ * @return true 成功  false 参数错误或维数超出上限
+ */
+bool Kalman_Init(KalmanInstance_s* instance, const KalmanInitConfig_s* config){
+    if (instance == NULL || config == NULL){
+        Log_Error("Kalman_Init instance or config is NULL");
+        return false;
+    }
+    if (config->state_dim == 0 || config->state_dim > KALMAN_MAX_STATE_DIM
+        || config->meas_dim == 0 || config->meas_dim > KALMAN_MAX_MEAS_DIM
+        || config->input_dim > KALMAN_MAX_INPUT_DIM){
+        Log_Error("Kalman_Init dim %d/%d/%d exceeds KALMAN_MAX_*_DIM", config->state_dim, config->meas_dim,
+                  config->input_dim);
+        return false;
+    }
+    memset(instance, 0, sizeof(KalmanInstance_s));
+    const uint8_t n = config->state_dim;
+    const uint8_t m = config->meas_dim;
+    const uint8_t l = config->input_dim;
+    instance->state_dim = n;
+    instance->meas_dim = m;
+    instance->input_dim = l;
+    instance->cov_form = config->cov_form;
+
+    if (config->F != NULL){
+        memcpy(instance->F, config->F, sizeof(float) * n * n);
+    } else {
+        Kalman_Eye(instance->F, n);
+    }
+    if (config->B != NULL && l > 0){
+        memcpy(instance->B, config->B, sizeof(float) * n * l);
+    }
+    if (config->Q != NULL){
+        memcpy(instance->Q, config->Q, sizeof(float) * n * n);
+    }
+    if (config->H != NULL){
+        memcpy(instance->H, config->H, sizeof(float) * m * n);
+    }
+    if (config->R != NULL){
+        memcpy(instance->R, config->R, sizeof(float) * m * m);
+    } else {
+        Kalman_Eye(instance->R, m);
+    }
+    Kalman_Reset(instance, config->x0, config->P0);
+    return true;
+}
+
+/**
+ * @brief 重置状态和协方差，模型矩阵不变
+ * @param instance 实例指针
+ * @param x0 初始状态，NULL 时置零
+ * @param P0 初始协方差，NULL 时为单位阵
+ */
+void Kalman_Reset(KalmanInstance_s* instance, const float* x0, const float* P0){
+    if (instance == NULL){
+        return;
+    }
+    const uint8_t n = instance->state_dim;
+    if (x0 != NULL){
+        memcpy(instance->x, x0, sizeof(float) * n);
+    } else {
+        memset(instance->x, 0, sizeof(instance->x));
+    }
+    if (P0 != NULL){
+        memcpy(instance->P, P0, sizeof(float) * n * n);
+    } else {
+        Kalman_Eye(instance->P, n);
+    }
+    if (instance->cov_form == KALMAN_COV_UD){
+        Kalman_Ud_Factor(instance->P, n);
+    }
+}
+
+/**
+ * @brief 预测 x = F x + B u，P = F P Fᵀ + Q
+ * @param instance 实例指针
+ * @param u 控制输入 l，NULL 或 input_dim 为 0 时忽略
+ */
+void Kalman_Predict(KalmanInstance_s* instance, const float* u){
+    if (instance == NULL){
+        return;
+    }
+    const uint8_t n = instance->state_dim;
+    const uint8_t l = instance->input_dim;
+    float x_prev[KALMAN_N];
+    arm_matrix_instance_f32 mat_F, mat_x_prev, mat_x;
+    memcpy(x_prev, instance->x, sizeof(float) * n);
+    arm_mat_init_f32(&mat_F, n, n, instance->F);
+    arm_mat_init_f32(&mat_x_prev, n, 1, x_prev);
+    arm_mat_init_f32(&mat_x, n, 1, instance->x);
+    arm_mat_mult_f32(&mat_F, &mat_x_prev, &mat_x);
+    if (u != NULL && l > 0){
+        for (uint8_t i = 0; i < n; i++){
+            float acc = 0.0f;
+            for (uint8_t j = 0; j < l; j++){
+                acc += instance->B[i * l + j] * u[j];
+            }
+            instance->x[i] += acc;
+        }
+    }
+
+    if (instance->cov_form == KALMAN_COV_UD){
+        Kalman_Ud_Predict(instance);
+        return;
+    }
+    float Ft[KALMAN_N * KALMAN_N];
+    float FP[KALMAN_N * KALMAN_N];
+    arm_matrix_instance_f32 mat_Ft, mat_FP, mat_P, mat_Q;
+    arm_mat_init_f32(&mat_Ft, n, n, Ft);
+    arm_mat_init_f32(&mat_FP, n, n, FP);
+    arm_mat_init_f32(&mat_P, n, n, instance->P);
+    arm_mat_init_f32(&mat_Q, n, n, instance->Q);
+    arm_mat_trans_f32(&mat_F, &mat_Ft);
+    arm_mat_mult_f32(&mat_F, &mat_P, &mat_FP);
+    arm_mat_mult_f32(&mat_FP, &mat_Ft, &mat_P);
+    arm_mat_add_f32(&mat_P, &mat_Q, &mat_P);
+}
+
+/**
+ * @brief 向量观测更新
+ * @param instance 实例指针
+ * @param z 观测 m
+ * @return true 已更新  false 新息协方差奇异
+ * @note KALMAN_COV_FULL 时求逆 S 并用 Joseph 形式更新；KALMAN_COV_UD 时等同于 Kalman_Update_Sequential
+ */
+bool Kalman_Update(KalmanInstance_s* instance, const float* z){
+    if (instance == NULL || z == NULL){
+        return false;
+    }
+    if (instance->cov_form == KALMAN_COV_UD){
+        return Kalman_Update_Sequential(instance, z);
+    }
+    const uint8_t n = instance->state_dim;
+    const uint8_t m = instance->meas_dim;
+    float y[KALMAN_M];
+    float Ht[KALMAN_N * KALMAN_M];
+    float PHt[KALMAN_N * KALMAN_M];
+    float S[KALMAN_M * KALMAN_M];
+    float S_inv[KALMAN_M * KALMAN_M];
+    float K[KALMAN_N * KALMAN_M];
+    arm_matrix_instance_f32 mat_H, mat_Ht, mat_P, mat_PHt, mat_S, mat_S_inv, mat_R, mat_K, mat_y;
+    arm_mat_init_f32(&mat_H, m, n, instance->H);
+    arm_mat_init_f32(&mat_Ht, n, m, Ht);
+    arm_mat_init_f32(&mat_P, n, n, instance->P);
+    arm_mat_init_f32(&mat_PHt, n, m, PHt);
+    arm_mat_init_f32(&mat_S, m, m, S);
+    arm_mat_init_f32(&mat_S_inv, m, m, S_inv);
+    arm_mat_init_f32(&mat_R, m, m, instance->R);
+    arm_mat_init_f32(&mat_K, n, m, K);
+    arm_mat_init_f32(&mat_y, m, 1, y);
+
+    // 新息 y = z - H x
+    for (uint8_t i = 0; i < m; i++){
+        float acc = z[i];
+        for (uint8_t j = 0; j < n; j++){
+            acc -= instance->H[i * n + j] * instance->x[j];
+        }
+        y[i] = acc;
+    }
+
+    // S = H P Hᵀ + R，K = P Hᵀ S⁻¹
+    arm_mat_trans_f32(&mat_H, &mat_Ht);
+    arm_mat_mult_f32(&mat_P, &mat_Ht, &mat_PHt);
+    arm_mat_mult_f32(&mat_H, &mat_PHt, &mat_S);
+    arm_mat_add_f32(&mat_S, &mat_R, &mat_S);
+    // arm_mat_inverse_f32 会破坏输入矩阵，S 之后不再使用
+    if (arm_mat_inverse_f32(&mat_S, &mat_S_inv) != ARM_MATH_SUCCESS){
+        return false;
+    }
+    arm_mat_mult_f32(&mat_PHt, &mat_S_inv, &mat_K);
+
+    // x = x + K y
+    for (uint8_t i = 0; i < n; i++){
+        float acc = 0.0f;
+        for (uint8_t j = 0; j < m; j++){
+            acc += K[i * m + j] * y[j];
+        }
+        instance->x[i] += acc;
+    }
+
+    // Joseph 形式 P = (I - K H) P (I - K H)ᵀ + K R Kᵀ，舍入误差下仍保持对称正定
+    float A[KALMAN_N * KALMAN_N];
+    float At[KALMAN_N * KALMAN_N];
+    float AP[KALMAN_N * KALMAN_N];
+    float KR[KALMAN_N * KALMAN_M];
+    float Kt[KALMAN_M * KALMAN_N];
+    float KRKt[KALMAN_N * KALMAN_N];
+    arm_matrix_instance_f32 mat_A, mat_At, mat_AP, mat_KR, mat_Kt, mat_KRKt;
+    arm_mat_init_f32(&mat_A, n, n, A);
+    arm_mat_init_f32(&mat_At, n, n, At);
+    arm_mat_init_f32(&mat_AP, n, n, AP);
+    arm_mat_init_f32(&mat_KR, n, m, KR);
+    arm_mat_init_f32(&mat_Kt, m, n, Kt);
+    arm_mat_init_f32(&mat_KRKt, n, n, KRKt);
+    arm_mat_mult_f32(&mat_K, &mat_H, &mat_A);
+    for (uint16_t i = 0; i < n * n; i++){
+        A[i] = -A[i];
+    }
+    for (uint8_t i = 0; i < n; i++){
+        A[i * n + i] += 1.0f;
+    }
+    arm_mat_trans_f32(&mat_A, &mat_At);
+    arm_mat_trans_f32(&mat_K, &mat_Kt);
+    arm_mat_mult_f32(&mat_A, &mat_P, &mat_AP);
+    arm_mat_mult_f32(&mat_AP, &mat_At, &mat_P);
+    arm_mat_mult_f32(&mat_K, &mat_R, &mat_KR);
+    arm_mat_mult_f32(&mat_KR, &mat_Kt, &mat_KRKt);
+    for (uint8_t i = 0; i < n; i++){
+        for (uint8_t j = i; j < n; j++){
+            // 顺便消除乘法顺序带来的不对称
+            const float p = 0.5f * (instance->P[i * n + j] + instance->P[j * n + i]) + KRKt[i * n + j];
+            instance->P[i * n + j] = p;
+            instance->P[j * n + i] = p;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 单个标量观测更新，用于观测分量不同时到达或观测行随时间变化的情况
+ * @param instance 实例指针
+ * @param h 观测行 n
+ * @param z 观测值
+ * @param r 观测噪声方差，必须 > 0
+ * @return true 已更新  false 新息方差不为正
+ */
+bool Kalman_Update_Scalar(KalmanInstance_s* instance, const float* h, float z, float r){
+    if (instance == NULL || h == NULL || !(r > 0.0f)){
+        return false;
+    }
+    const uint8_t n = instance->state_dim;
+    float y = z;
+    for (uint8_t j = 0; j < n; j++){
+        y -= h[j] * instance->x[j];
+    }
+    if (instance->cov_form == KALMAN_COV_UD){
+        Kalman_Ud_Update_Scalar(instance, h, y, r);
+        return true;
+    }
+    return Kalman_Full_Update_Scalar(instance, h, y, r);
+}
 
-//新建协方差矩阵,矩阵中的每个元素 Σij 表示第 i 个和第 j 个状态变量之间的相关度
+/**
+ * @brief 顺序标量观测更新，按 H 的每一行和 R 的对角元素逐个处理，不需要矩阵求逆
+ * @param instance 实例指针
+ * @param z 观测 m
+ * @return true 全部分量已更新  false 存在新息方差不为正的分量（该分量被跳过）
+ * @note 只使用 R 的对角元素，观测噪声相关时应先去相关或使用 Kalman_Update
+ */
+bool Kalman_Update_Sequential(KalmanInstance_s* instance, const float* z){
+    if (instance == NULL || z == NULL){
+        return false;
+    }
+    const uint8_t n = instance->state_dim;
+    const uint8_t m = instance->meas_dim;
+    bool ok = true;
+    for (uint8_t i = 0; i < m; i++){
+        ok &= Kalman_Update_Scalar(instance, &instance->H[i * n], z[i], instance->R[i * m + i]);
+    }
+    return ok;
+}
 
+/**
+ * @brief 取出完整协方差矩阵，UD 形式下计算 U D Uᵀ
+ * @param instance 实例指针
+ * @param P 输出 n x n
+ */
+void Kalman_Get_Covariance(const KalmanInstance_s* instance, float* P){
+    if (instance == NULL || P == NULL){
+        return;
+    }
+    const uint8_t n = instance->state_dim;
+    if (instance->cov_form == KALMAN_COV_UD){
+        Kalman_Ud_Expand(instance->P, P, n);
+    } else {
+        memcpy(P, instance->P, sizeof(float) * n * n);
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file Kalman.h
+ * @brief 定长线性卡尔曼滤波库：电机速度估计、底盘里程计、目标跟踪等
+ * @note - 每个实例的矩阵都是实例内的定长数组，大小由 robot_config.h 中的
+ *         KALMAN_MAX_STATE_DIM / KALMAN_MAX_MEAS_DIM / KALMAN_MAX_INPUT_DIM 决定，不申请内存；
+ *         实际维数在初始化时给出，矩阵按实际维数行优先紧凑存放，可直接修改 F、B、H、Q、R（例如随 dt 变化的 F）。
+ *       - 模型：x(k) = F x(k-1) + B u(k) + w，z(k) = H x(k) + v，w ~ N(0, Q)，v ~ N(0, R)。
+ *       - 协方差形式：
+ *         KALMAN_COV_FULL 直接保存 P，向量更新使用 Joseph 形式 P = (I-KH) P (I-KH)ᵀ + K R Kᵀ；
+ *         KALMAN_COV_UD   保存 P = U D Uᵀ 的分解（U 为单位上三角，D 为对角），预测用 Thornton 加权 Gram-Schmidt，
+ *                         更新用 Bierman 标量更新，P 在舍入误差下始终保持对称正定，适合条件数大的模型。
+ *       - 顺序标量更新：R 为对角阵时逐个处理观测分量，不需要矩阵求逆，计算量为 O(n²) / 分量；
+ *         UD 形式下的所有更新都走该路径，此时只使用 R 的对角元素。
+ */
+#ifndef KALMAN_H
+#define KALMAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "robot_config.h"
+
+/**
+ * @brief 协方差保存形式
+ */
+typedef enum {
+    KALMAN_COV_FULL = 0,    // 完整协方差矩阵 P
+    KALMAN_COV_UD,          // UD 分解，U 的严格上三角和 D 的对角元素共用 P 的存储
+} KalmanCovForm_e;
+
+/**
+ * @brief 卡尔曼滤波实例
+ */
+typedef struct {
+    uint8_t state_dim;          // 状态维数 n
+    uint8_t meas_dim;           // 观测维数 m
+    uint8_t input_dim;          // 输入维数 l，0 表示没有控制输入
+    KalmanCovForm_e cov_form;   // 协方差保存形式
+
+    float x[KALMAN_MAX_STATE_DIM];                          // 状态 n
+    float P[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];   // 协方差 n x n；UD 形式下为 U(严格上三角) + D(对角)
+    float F[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];   // 状态转移 n x n
+    float B[KALMAN_MAX_STATE_DIM * KALMAN_MAX_INPUT_DIM];   // 输入矩阵 n x l
+    float Q[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];   // 过程噪声 n x n
+    float H[KALMAN_MAX_MEAS_DIM * KALMAN_MAX_STATE_DIM];    // 观测矩阵 m x n
+    float R[KALMAN_MAX_MEAS_DIM * KALMAN_MAX_MEAS_DIM];     // 观测噪声 m x m
+} KalmanInstance_s;
+
+/**
+ * @brief 卡尔曼滤波初始化配置，矩阵均按实际维数行优先存放，NULL 时使用括号中的默认值
+ */
+typedef struct {
+    uint8_t state_dim;          // 状态维数，1 ~ KALMAN_MAX_STATE_DIM
+    uint8_t meas_dim;           // 观测维数，1 ~ KALMAN_MAX_MEAS_DIM
+    uint8_t input_dim;          // 输入维数，0 ~ KALMAN_MAX_INPUT_DIM
+    KalmanCovForm_e cov_form;   // 协方差保存形式
+    const float* F;             // 状态转移（单位阵）
+    const float* B;             // 输入矩阵（零）
+    const float* Q;             // 过程噪声（零）
+    const float* H;             // 观测矩阵（零）
+    const float* R;             // 观测噪声（单位阵）
+    const float* P0;            // 初始协方差（单位阵）
+    const float* x0;            // 初始状态（零）
+} KalmanInitConfig_s;
+
+/**
+ * @brief 初始化卡尔曼滤波实例
+ * @param instance 实例指针
+ * @param config 初始化配置
+ * @return true 成功  false 参数错误或维数超出上限
+ */
+bool Kalman_Init(KalmanInstance_s* instance, const KalmanInitConfig_s* config);
+
+/**
+ * @brief 重置状态和协方差，模型矩阵不变
+ * @param instance 实例指针
+ * @param x0 初始状态，NULL 时置零
+ * @param P0 初始协方差，NULL 时为单位阵
+ */
+void Kalman_Reset(KalmanInstance_s* instance, const float* x0, const float* P0);
+
+/**
+ * @brief 预测 x = F x + B u，P = F P Fᵀ + Q
+ * @param instance 实例指针
+ * @param u 控制输入 l，NULL 或 input_dim 为 0 时忽略
+ */
+void Kalman_Predict(KalmanInstance_s* instance, const float* u);
+
+/**
+ * @brief 向量观测更新
+ * @param instance 实例指针
+ * @param z 观测 m
+ * @return true 已更新  false 新息协方差奇异
+ * @note KALMAN_COV_FULL 时求逆 S 并用 Joseph 形式更新；KALMAN_COV_UD 时等同于 Kalman_Update_Sequential
+ */
+bool Kalman_Update(KalmanInstance_s* instance, const float* z);
+
+/**
+ * @brief 顺序标量观测更新，按 H 的每一行和 R 的对角元素逐个处理，不需要矩阵求逆
+ * @param instance 实例指针
+ * @param z 观测 m
+ * @return true 全部分量已更新  false 存在新息方差不为正的分量（该分量被跳过）
+ * @note 只使用 R 的对角元素，观测噪声相关时应先去相关或使用 Kalman_Update
+ */
+bool Kalman_Update_Sequential(KalmanInstance_s* instance, const float* z);
+
+/**
+ * @brief 单个标量观测更新，用于观测分量不同时到达或观测行随时间变化的情况
+ * @param instance 实例指针
+ * @param h 观测行 n
+ * @param z 观测值
+ * @param r 观测噪声方差，必须 > 0
+ * @return true 已更新  false 新息方差不为正
+ */
+bool Kalman_Update_Scalar(KalmanInstance_s* instance, const float* h, float z, float r);
+
+/**
+ * @brief 取出完整协方差矩阵，UD 形式下计算 U D Uᵀ
+ * @param instance 实例指针
+ * @param P 输出 n x n
+ */
+void Kalman_Get_Covariance(const KalmanInstance_s* instance, float* P);
+
+#endif // KALMAN_H
@@ -0,0 +1,307 @@
+#include "attitude_ekf.h"
+#include "arm_math.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#define EKF_N ATTITUDE_EKF_STATE_DIM
+#define EKF_M ATTITUDE_EKF_MEAS_DIM
+
+/**
+ * @brief 四元数右乘 q ← q ⊗ dq 并归一化
+ * @param q 四元数
+ * @param dq 增量四元数
+ */
+static inline void Attitude_Ekf_Q_Mult(float q[4], const float dq[4]){
+    const float w = q[0] * dq[0] - q[1] * dq[1] - q[2] * dq[2] - q[3] * dq[3];
+    const float x = q[0] * dq[1] + q[1] * dq[0] + q[2] * dq[3] - q[3] * dq[2];
+    const float y = q[0] * dq[2] - q[1] * dq[3] + q[2] * dq[0] + q[3] * dq[1];
+    const float z = q[0] * dq[3] + q[1] * dq[2] - q[2] * dq[1] + q[3] * dq[0];
+    const float recip_norm = 1.0f / sqrtf(w * w + x * x + y * y + z * z);
+    q[0] = w * recip_norm;
+    q[1] = x * recip_norm;
+    q[2] = y * recip_norm;
+    q[3] = z * recip_norm;
+}
+
+/**
+ * @brief 四元数左乘 q ← dq ⊗ q 并归一化
+ * @param q 四元数
+ * @param dq 导航系下的增量四元数
+ */
+static inline void Attitude_Ekf_Q_Left_Mult(float q[4], const float dq[4]){
+    const float p[4] = {q[0], q[1], q[2], q[3]};
+    q[0] = dq[0];
+    q[1] = dq[1];
+    q[2] = dq[2];
+    q[3] = dq[3];
+    Attitude_Ekf_Q_Mult(q, p);
+}
+
+/**
+ * @brief 协方差恢复为初始的对角阵
+ * @param instance 实例指针
+ */
+static void Attitude_Ekf_Reset_Covariance(AttitudeEkfInstance_s* instance){
+    memset(instance->P, 0, sizeof(instance->P));
+    for (uint8_t i = 0; i < 3; i++){
+        instance->P[i * EKF_N + i] = instance->init_angle_var;
+        instance->P[(i + 3) * EKF_N + i + 3] = instance->init_bias_var;
+    }
+}
+
+/**
+ * @brief 初始化姿态 EKF，姿态置为单位四元数、零偏置零
+ * @param instance 实例指针
+ * @param config 初始化配置
+ */
+void Attitude_Ekf_Init(AttitudeEkfInstance_s* instance, const AttitudeEkfInitConfig_s* config){
+    if (instance == NULL || config == NULL){
+        return;
+    }
+    memset(instance, 0, sizeof(AttitudeEkfInstance_s));
+    instance->gyro_var = config->gyro_noise * config->gyro_noise;
+    instance->bias_walk_var = config->bias_walk * config->bias_walk;
+    instance->accel_var = config->accel_noise * config->accel_noise;
+    instance->gravity = config->gravity;
+    instance->chi2_gate = fmaxf(config->chi2_gate, 0.0f);
+    instance->reject_limit = config->reject_limit;
+    instance->init_angle_var = config->init_angle_std * config->init_angle_std;
+    instance->init_bias_var = config->init_bias_std * config->init_bias_std;
+    instance->q[0] = 1.0f;
+    Attitude_Ekf_Reset_Covariance(instance);
+}
+
+/**
+ * @brief 用静止时的加速度计算初始姿态（航向置 0），协方差恢复为初始值
+ * @param instance 实例指针
+ * @param accel 加速度[X, Y, Z]
+ */
+void Attitude_Ekf_Reset(AttitudeEkfInstance_s* instance, const float accel[3]){
+    if (instance == NULL || accel == NULL){
+        return;
+    }
+    const float roll = atan2f(accel[1], accel[2]);
+    const float pitch = atan2f(-accel[0], sqrtf(accel[1] * accel[1] + accel[2] * accel[2]));
+    const float cr2 = cosf(roll * 0.5f), sr2 = sinf(roll * 0.5f);
+    const float cp2 = cosf(pitch * 0.5f), sp2 = sinf(pitch * 0.5f);
+    instance->q[0] = cr2 * cp2;
+    instance->q[1] = sr2 * cp2;
+    instance->q[2] = cr2 * sp2;
+    instance->q[3] = -sr2 * sp2;
+    memset(instance->bias, 0, sizeof(instance->bias));
+    instance->reject_run = 0;
+    Attitude_Ekf_Reset_Covariance(instance);
+}
+
+/**
+ * @brief 预测：积分陀螺仪并传播协方差
+ * @param instance 实例指针
+ * @param gyro 角速度[X, Y, Z] rad/s
+ * @param dt 距上一次预测的时间 s
+ */
+void Attitude_Ekf_Predict(AttitudeEkfInstance_s* instance, const float gyro[3], float dt){
+    if (instance == NULL || gyro == NULL || !(dt > 0.0f)){
+        return;
+    }
+    // 一个周期的转角
+    const float tx = (gyro[0] - instance->bias[0]) * dt;
+    const float ty = (gyro[1] - instance->bias[1]) * dt;
+    const float tz = (gyro[2] - instance->bias[2]) * dt;
+
+    // 机体系到导航系的旋转矩阵，F 使用本周期开始时的姿态
+    const float* q = instance->q;
+    const float r00 = 1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3]);
+    const float r01 = 2.0f * (q[1] * q[2] - q[0] * q[3]);
+    const float r02 = 2.0f * (q[1] * q[3] + q[0] * q[2]);
+    const float r10 = 2.0f * (q[1] * q[2] + q[0] * q[3]);
+    const float r11 = 1.0f - 2.0f * (q[1] * q[1] + q[3] * q[3]);
+    const float r12 = 2.0f * (q[2] * q[3] - q[0] * q[1]);
+    const float r20 = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    const float r21 = 2.0f * (q[2] * q[3] + q[0] * q[1]);
+    const float r22 = 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]);
+
+    // 误差状态转移 F = [[I, -R dt], [0, I]]，导航系误差角不随机体旋转
+    float F[EKF_N * EKF_N] = {
+        1.0f,   0.0f,   0.0f,   -r00 * dt,  -r01 * dt,  -r02 * dt,
+        0.0f,   1.0f,   0.0f,   -r10 * dt,  -r11 * dt,  -r12 * dt,
+        0.0f,   0.0f,   1.0f,   -r20 * dt,  -r21 * dt,  -r22 * dt,
+        0.0f,   0.0f,   0.0f,   1.0f,       0.0f,       0.0f,
+        0.0f,   0.0f,   0.0f,   0.0f,       1.0f,       0.0f,
+        0.0f,   0.0f,   0.0f,   0.0f,       0.0f,       1.0f,
+    };
+
+    // Exp(θ) 的四阶截断：cos(|θ|/2) ≈ 1 - |θ|²/8，sin(|θ|/2)/|θ| ≈ 1/2 - |θ|²/48，1 kHz 下误差远小于 float 精度
+    const float theta2 = tx * tx + ty * ty + tz * tz;
+    const float k = 0.5f - theta2 * (1.0f / 48.0f);
+    const float dq[4] = {1.0f - theta2 * 0.125f, k * tx, k * ty, k * tz};
+    Attitude_Ekf_Q_Mult(instance->q, dq);
+
+    float Ft[EKF_N * EKF_N];
+    float FP[EKF_N * EKF_N];
+    arm_matrix_instance_f32 mat_F, mat_Ft, mat_FP, mat_P;
+    arm_mat_init_f32(&mat_F, EKF_N, EKF_N, F);
+    arm_mat_init_f32(&mat_Ft, EKF_N, EKF_N, Ft);
+    arm_mat_init_f32(&mat_FP, EKF_N, EKF_N, FP);
+    arm_mat_init_f32(&mat_P, EKF_N, EKF_N, instance->P);
+
+    // P = F P Fᵀ + Q，陀螺仪噪声各向同性，转到导航系后仍为对角阵
+    arm_mat_trans_f32(&mat_F, &mat_Ft);
+    arm_mat_mult_f32(&mat_F, &mat_P, &mat_FP);
+    arm_mat_mult_f32(&mat_FP, &mat_Ft, &mat_P);
+    const float q_angle = instance->gyro_var * dt * dt;
+    const float q_bias = instance->bias_walk_var * dt;
+    for (uint8_t i = 0; i < 3; i++){
+        instance->P[i * EKF_N + i] += q_angle;
+        instance->P[(i + 3) * EKF_N + i + 3] += q_bias;
+    }
+
+    // 航向不可观，方差只增不减；按比例缩放第 2 行和第 2 列，限制在初始值以内且保持正定
+    const float yaw_var = instance->P[2 * EKF_N + 2];
+    if (yaw_var > instance->init_angle_var){
+        const float scale = sqrtf(instance->init_angle_var / yaw_var);
+        for (uint8_t i = 0; i < EKF_N; i++){
+            instance->P[2 * EKF_N + i] *= scale;
+            instance->P[i * EKF_N + 2] *= scale;
+        }
+    }
+}
+
+/**
+ * @brief 加速度观测更新
+ * @param instance 实例指针
+ * @param accel 加速度[X, Y, Z]
+ * @return true 已更新  false 被卡方门控拒绝或矩阵奇异
+ */
+bool Attitude_Ekf_Update_Accel(AttitudeEkfInstance_s* instance, const float accel[3]){
+    if (instance == NULL || accel == NULL){
+        return false;
+    }
+    const float* q = instance->q;
+    const float g = instance->gravity;
+
+    // 预测的观测：导航系重力在机体系下的投影
+    const float hx = 2.0f * g * (q[1] * q[3] - q[0] * q[2]);
+    const float hy = 2.0f * g * (q[0] * q[1] + q[2] * q[3]);
+    const float hz = g * (q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]);
+    float r[EKF_M] = {accel[0] - hx, accel[1] - hy, accel[2] - hz};
+
+    // H = [Rᵀ [g]×, 0]，[g]× 第三列为零，航向误差不进入观测；零偏不直接出现在观测中
+    const float r00 = 1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3]);
+    const float r01 = 2.0f * (q[1] * q[2] - q[0] * q[3]);
+    const float r10 = 2.0f * (q[1] * q[2] + q[0] * q[3]);
+    const float r11 = 1.0f - 2.0f * (q[1] * q[1] + q[3] * q[3]);
+    const float r02 = 2.0f * (q[1] * q[3] + q[0] * q[2]);
+    const float r12 = 2.0f * (q[2] * q[3] - q[0] * q[1]);
+    float H[EKF_M * EKF_N] = {
+        g * r10,    -g * r00,   0.0f,   0.0f,   0.0f,   0.0f,
+        g * r11,    -g * r01,   0.0f,   0.0f,   0.0f,   0.0f,
+        g * r12,    -g * r02,   0.0f,   0.0f,   0.0f,   0.0f,
+    };
+    float Ht[EKF_N * EKF_M];
+    float PHt[EKF_N * EKF_M];
+    float S[EKF_M * EKF_M];
+    float S_inv[EKF_M * EKF_M];
+    float S_inv_r[EKF_M];
+    arm_matrix_instance_f32 mat_H, mat_Ht, mat_PHt, mat_S, mat_S_inv, mat_r, mat_S_inv_r, mat_P;
+    arm_mat_init_f32(&mat_H, EKF_M, EKF_N, H);
+    arm_mat_init_f32(&mat_Ht, EKF_N, EKF_M, Ht);
+    arm_mat_init_f32(&mat_PHt, EKF_N, EKF_M, PHt);
+    arm_mat_init_f32(&mat_S, EKF_M, EKF_M, S);
+    arm_mat_init_f32(&mat_S_inv, EKF_M, EKF_M, S_inv);
+    arm_mat_init_f32(&mat_r, EKF_M, 1, r);
+    arm_mat_init_f32(&mat_S_inv_r, EKF_M, 1, S_inv_r);
+    arm_mat_init_f32(&mat_P, EKF_N, EKF_N, instance->P);
+
+    // S = H P Hᵀ + R
+    arm_mat_trans_f32(&mat_H, &mat_Ht);
+    arm_mat_mult_f32(&mat_P, &mat_Ht, &mat_PHt);
+    arm_mat_mult_f32(&mat_H, &mat_PHt, &mat_S);
+    for (uint8_t i = 0; i < EKF_M; i++){
+        S[i * EKF_M + i] += instance->accel_var;
+    }
+    // arm_mat_inverse_f32 会破坏输入矩阵，S 之后不再使用
+    if (arm_mat_inverse_f32(&mat_S, &mat_S_inv) != ARM_MATH_SUCCESS){
+        return false;
+    }
+
+    // 卡方检验：NIS = rᵀ S⁻¹ r，冲击和大加速度机动时新息远大于预期
+    arm_mat_mult_f32(&mat_S_inv, &mat_r, &mat_S_inv_r);
+    instance->nis = r[0] * S_inv_r[0] + r[1] * S_inv_r[1] + r[2] * S_inv_r[2];
+    const bool force = instance->reject_limit != 0 && instance->reject_run >= instance->reject_limit;
+    if (!isfinite(instance->nis) || (instance->chi2_gate > 0.0f && instance->nis > instance->chi2_gate && !force)){
+        instance->reject_cnt++;
+        if (instance->reject_run < UINT16_MAX){
+            instance->reject_run++;
+        }
+        return false;
+    }
+    instance->reject_run = 0;
+    instance->update_cnt++;
+
+    // K = P Hᵀ S⁻¹，δx = K r
+    float K[EKF_N * EKF_M];
+    float Kt[EKF_M * EKF_N];
+    float dx[EKF_N];
+    arm_matrix_instance_f32 mat_K, mat_Kt, mat_dx;
+    arm_mat_init_f32(&mat_K, EKF_N, EKF_M, K);
+    arm_mat_init_f32(&mat_Kt, EKF_M, EKF_N, Kt);
+    arm_mat_init_f32(&mat_dx, EKF_N, 1, dx);
+    arm_mat_mult_f32(&mat_PHt, &mat_S_inv, &mat_K);
+    arm_mat_mult_f32(&mat_K, &mat_r, &mat_dx);
+
+    // Joseph 形式 P = (I - K H) P (I - K H)ᵀ + K R Kᵀ，舍入误差下仍保持对称正定
+    float A[EKF_N * EKF_N];
+    float At[EKF_N * EKF_N];
+    float AP[EKF_N * EKF_N];
+    float KKt[EKF_N * EKF_N];
+    arm_matrix_instance_f32 mat_A, mat_At, mat_AP, mat_KKt;
+    arm_mat_init_f32(&mat_A, EKF_N, EKF_N, A);
+    arm_mat_init_f32(&mat_At, EKF_N, EKF_N, At);
+    arm_mat_init_f32(&mat_AP, EKF_N, EKF_N, AP);
+    arm_mat_init_f32(&mat_KKt, EKF_N, EKF_N, KKt);
+    arm_mat_mult_f32(&mat_K, &mat_H, &mat_A);
+    for (uint8_t i = 0; i < EKF_N * EKF_N; i++){
+        A[i] = -A[i];
+    }
+    for (uint8_t i = 0; i < EKF_N; i++){
+        A[i * EKF_N + i] += 1.0f;
+    }
+    arm_mat_trans_f32(&mat_A, &mat_At);
+    arm_mat_trans_f32(&mat_K, &mat_Kt);
+    arm_mat_mult_f32(&mat_A, &mat_P, &mat_AP);
+    arm_mat_mult_f32(&mat_AP, &mat_At, &mat_P);
+    arm_mat_mult_f32(&mat_K, &mat_Kt, &mat_KKt);
+    for (uint8_t i = 0; i < EKF_N; i++){
+        for (uint8_t j = i; j < EKF_N; j++){
+            // 顺便消除乘法顺序带来的不对称
+            const float p = 0.5f * (instance->P[i * EKF_N + j] + instance->P[j * EKF_N + i]) + instance->accel_var * KKt[i * EKF_N + j];
+            instance->P[i * EKF_N + j] = p;
+            instance->P[j * EKF_N + i] = p;
+        }
+    }
+
+    // 误差注入：q ← [1, δθ/2] ⊗ q，b ← b + δb
+    const float dq[4] = {1.0f, 0.5f * dx[0], 0.5f * dx[1], 0.5f * dx[2]};
+    Attitude_Ekf_Q_Left_Mult(instance->q, dq);
+    for (uint8_t i = 0; i < 3; i++){
+        instance->bias[i] += dx[i + 3];
+    }
+    return true;
+}
+
+/**
+ * @brief 四元数转欧拉角（ZYX 顺序）
+ * @param instance 实例指针
+ * @param euler 输出[roll, pitch, yaw] rad
+ */
+void Attitude_Ekf_Get_Euler(const AttitudeEkfInstance_s* instance, float euler[3]){
+    if (instance == NULL || euler == NULL){
+        return;
+    }
+    const float* q = instance->q;
+    const float sin_pitch = fminf(fmaxf(-2.0f * (q[1] * q[3] - q[0] * q[2]), -1.0f), 1.0f);
+    euler[0] = atan2f(q[0] * q[1] + q[2] * q[3], 0.5f - q[1] * q[1] - q[2] * q[2]);
+    euler[1] = asinf(sin_pitch);
+    euler[2] = atan2f(q[1] * q[2] + q[0] * q[3], 0.5f - q[2] * q[2] - q[3] * q[3]);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file attitude_ekf.h
+ * @brief 姿态 + 陀螺仪零偏的误差状态扩展卡尔曼滤波(ESEKF)
+ * @note - 名义状态为四元数 q（机体系到导航系，q0 为实部）和陀螺仪零偏 b；
+ *         误差状态为机体系小角度 δθ 和零偏误差 δb，协方差 P 为 6x6。
+ *       - 预测：ω = gyro - b，q ← q ⊗ Exp(ω dt)，P ← F P Fᵀ + Q。
+ *       - 加速度更新：观测模型 h = Rᵀ [0, 0, g]，先计算新息的马氏距离平方(NIS)，
+ *         超过卡方门限（冲击、大加速度机动）时丢弃本次观测，否则按 Joseph 形式更新 P 并注入误差状态。
+ *       - 矩阵运算使用 CMSIS-DSP arm_mat_*_f32，矩阵均为实例内或栈上的定长数组，不申请内存。
+ *       - 只有加速度观测时航向不可观，航向零偏只在机体倾斜变化（进动、章动）时部分可观。
+ *       单位：陀螺仪 rad/s，加速度与 gravity 一致。
+ */
+#ifndef ATTITUDE_EKF_H
+#define ATTITUDE_EKF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ATTITUDE_EKF_STATE_DIM 6    // 误差状态维数 [δθ, δb]
+#define ATTITUDE_EKF_MEAS_DIM 3     // 加速度观测维数
+
+/**
+ * @brief 姿态 EKF 实例
+ */
+typedef struct {
+    float q[4];                 // 姿态四元数 [w, x, y, z]
+    float bias[3];              // 陀螺仪零偏 rad/s
+    float P[ATTITUDE_EKF_STATE_DIM * ATTITUDE_EKF_STATE_DIM];  // 误差状态协方差，行优先
+
+    float gyro_var;             // 陀螺仪噪声方差 (rad/s)^2
+    float bias_walk_var;        // 零偏随机游走功率谱密度 (rad/s)^2/s
+    float accel_var;            // 加速度观测噪声方差
+    float gravity;              // 重力加速度
+    float chi2_gate;            // NIS 门限，0 表示不门控
+    uint16_t reject_limit;      // 连续拒绝超过该次数后强制接受一次，0 表示从不强制
+    float init_angle_var;       // 初始姿态方差 rad^2
+    float init_bias_var;        // 初始零偏方差 (rad/s)^2
+
+    float nis;                  // 最近一次加速度更新的 NIS
+    uint16_t reject_run;        // 当前连续拒绝次数
+    uint32_t update_cnt;        // 接受的加速度更新次数
+    uint32_t reject_cnt;        // 被卡方门控拒绝的次数
+} AttitudeEkfInstance_s;
+
+/**
+ * @brief 姿态 EKF 初始化配置
+ */
+typedef struct {
+    float gyro_noise;           // 陀螺仪单次采样噪声标准差 rad/s，例如 0.003
+    float bias_walk;            // 零偏随机游走 rad/s/√s，例如 1e-4
+    float accel_noise;          // 加速度观测噪声标准差，应包含振动等未建模加速度，例如 0.3 m/s^2
+    float gravity;              // 重力加速度，与加速度计单位一致，例如 9.80665
+    float chi2_gate;            // NIS 门限，3 自由度 99% 为 11.34；0 表示不门控
+    uint16_t reject_limit;      // 连续拒绝次数上限，防止滤波发散后永远拒绝观测；0 表示从不强制
+    float init_angle_std;       // 初始姿态标准差 rad，例如 0.1
+    float init_bias_std;        // 初始零偏标准差 rad/s，例如 0.02
+} AttitudeEkfInitConfig_s;
+
+/**
+ * @brief 初始化姿态 EKF，姿态置为单位四元数、零偏置零
+ * @param instance 实例指针
+ * @param config 初始化配置
+ */
+void Attitude_Ekf_Init(AttitudeEkfInstance_s* instance, const AttitudeEkfInitConfig_s* config);
+
+/**
+ * @brief 用静止时的加速度计算初始姿态（航向置 0），协方差恢复为初始值
+ * @param instance 实例指针
+ * @param accel 加速度[X, Y, Z]
+ */
+void Attitude_Ekf_Reset(AttitudeEkfInstance_s* instance, const float accel[3]);
+
+/**
+ * @brief 预测：积分陀螺仪并传播协方差
+ * @param instance 实例指针
+ * @param gyro 角速度[X, Y, Z] rad/s
+ * @param dt 距上一次预测的时间 s
+ */
+void Attitude_Ekf_Predict(AttitudeEkfInstance_s* instance, const float gyro[3], float dt);
+
+/**
+ * @brief 加速度观测更新
+ * @param instance 实例指针
+ * @param accel 加速度[X, Y, Z]
+ * @return true 已更新  false 被卡方门控拒绝或矩阵奇异
+ */
+bool Attitude_Ekf_Update_Accel(AttitudeEkfInstance_s* instance, const float accel[3]);
+
+/**
+ * @brief 四元数转欧拉角（ZYX 顺序）
+ * @param instance 实例指针
+ * @param euler 输出[roll, pitch, yaw] rad
+ */
+void Attitude_Ekf_Get_Euler(const AttitudeEkfInstance_s* instance, float euler[3]);
+
+#endif // ATTITUDE_EKF_H
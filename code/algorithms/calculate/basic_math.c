@@ -64,39 +64,3 @@ void float2byte(float* target, unsigned char* buf, unsigned char beg){
     buf[beg + 2] = point[2];
     buf[beg + 3] = point[3];
 }
-
-/**
- * @brief 斜坡函数初始化
- * @param instance: 斜坡结构体
- * @param frame_period: 两帧之间的间隔时间（单位：毫秒）
- */
-void Ramp_init(RampInstance_s* instance,uint8_t frame_period){
-    instance->frame_period = frame_period;
-}
-
-/**
- * @brief 斜坡函数更新
- * @param instance: 斜坡结构体
- * @param update_value: 更新的目标值
- */
-void Ramp_Update(RampInstance_s* instance, float update_value){
-    instance->start_value = instance->end_value;
-    instance->end_value = update_value;
-    instance->step_value = (instance->end_value - instance->start_value) / (float)instance->frame_period;
-    instance->loop_count = 0;
-}
-/**
- * @brief 斜坡函数读取
- * @param instance: 斜坡结构体
- * @return 当前输出值
- */
-float Ramp_Read(RampInstance_s* instance){
-    if (instance->loop_count < instance->frame_period){
-        instance->output_value += instance->step_value;
-        instance->loop_count++;
-    }
-    else{
-        instance->output_value = instance->end_value;
-    }
-    return instance->output_value;
-}
@@ -14,11 +14,34 @@ static bool CircularQueue_Is_Full(const CircularQueue_s *queue) {
     return (queue->count == queue->capacity);
 }
 
+/* 下标前进 step 个位置并回绕，step 不超过容量 */
+static inline uint16_t CircularQueue_Advance(const CircularQueue_s *queue, const uint16_t index, const uint16_t step) {
+    const uint32_t next = (uint32_t) index + step;
+    return (uint16_t) ((next >= queue->capacity) ? next - queue->capacity : next);
+}
+
+/* 计算元素地址 */
+static inline uint8_t *CircularQueue_Slot(const CircularQueue_s *queue, const uint16_t index) {
+    return (uint8_t *) queue->data + (uint32_t) index * queue->element_size;
+}
+
 /* 获取队列中元素数量 */
 uint16_t CircularQueue_Get_Size(const CircularQueue_s *queue) {
     return queue->count;
 }
 
+/* 获取被覆盖或被拒绝的元素总数 */
+uint32_t CircularQueue_Get_Drop_Count(const CircularQueue_s *queue) {
+    return (queue == NULL) ? 0u : queue->drop_count;
+}
+
+/* 设置队列满时的入队策略 */
+void CircularQueue_Set_Policy(CircularQueue_s *queue, const CircularQueuePolicy_e policy) {
+    if (queue != NULL) {
+        queue->policy = policy;
+    }
+}
+
 /* 创建循环队列 */
 CircularQueue_s *CircularQueue_Create(const uint16_t capacity, const uint16_t element_size) {
     if (capacity == 0 || element_size == 0) {
@@ -45,6 +68,8 @@ CircularQueue_s *CircularQueue_Create(const uint16_t capacity, const uint16_t el
     queue->capacity = capacity;
     queue->element_size = element_size;
     queue->count = 0;
+    queue->policy = CIRCULAR_QUEUE_OVERWRITE;
+    queue->drop_count = 0;
 
     return queue;
 }
@@ -68,7 +93,11 @@ bool CircularQueue_Enqueue(CircularQueue_s *queue, const void *data) {
 
     // 检查队列是否已满
     if (CircularQueue_Is_Full(queue)) {
-        queue->front = (queue->front + 1) % queue->capacity;
+        queue->drop_count++;
+        if (queue->policy == CIRCULAR_QUEUE_REJECT) {
+            return false;
+        }
+        queue->front = CircularQueue_Advance(queue, queue->front, 1);
         queue->count--;
     }
 
@@ -79,7 +108,7 @@ bool CircularQueue_Enqueue(CircularQueue_s *queue, const void *data) {
     memcpy(insert_pos, data, queue->element_size);
 
     // 更新队尾指针和元素计数
-    queue->rear = (queue->rear + 1) % queue->capacity;
+    queue->rear = CircularQueue_Advance(queue, queue->rear, 1);
     queue->count++;
 
     return true;
@@ -103,12 +132,144 @@ bool CircularQueue_Dequeue(CircularQueue_s *queue, void *data) {
     memcpy(data, front_pos, queue->element_size);
 
     // 更新队头指针和元素计数
-    queue->front = (queue->front + 1) % queue->capacity;
+    queue->front = CircularQueue_Advance(queue, queue->front, 1);
     queue->count--;
 
     return true;
 }
 
+/* 批量入队 */
+uint16_t CircularQueue_Enqueue_Bulk(CircularQueue_s *queue, const void *data, uint16_t count) {
+    if (queue == NULL || data == NULL) {
+        Log_Error("CircularQueue_Enqueue_Bulk queue or data is NULL");
+        return 0;
+    }
+
+    const uint8_t *src = (const uint8_t *) data;
+    const uint16_t space = queue->capacity - queue->count;
+    if (count > space) {
+        if (queue->policy == CIRCULAR_QUEUE_REJECT) {
+            // 只写入剩余空间，其余元素丢弃
+            queue->drop_count += count - space;
+            count = space;
+        } else {
+            // 超出容量的部分只保留最新的 capacity 个元素
+            if (count > queue->capacity) {
+                queue->drop_count += count - queue->capacity;
+                src += (uint32_t) (count - queue->capacity) * queue->element_size;
+                count = queue->capacity;
+            }
+            // 覆盖最旧的元素
+            const uint16_t overwrite = count - (queue->capacity - queue->count);
+            if (overwrite > 0) {
+                queue->drop_count += overwrite;
+                queue->front = CircularQueue_Advance(queue, queue->front, overwrite);
+                queue->count -= overwrite;
+            }
+        }
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    // 先写到缓冲区末尾，剩余部分从头写入
+    const uint16_t to_end = queue->capacity - queue->rear;
+    const uint16_t first = (count < to_end) ? count : to_end;
+    memcpy(CircularQueue_Slot(queue, queue->rear), src, (uint32_t) first * queue->element_size);
+    if (count > first) {
+        memcpy(queue->data, src + (uint32_t) first * queue->element_size, (uint32_t) (count - first) * queue->element_size);
+    }
+
+    queue->rear = CircularQueue_Advance(queue, queue->rear, count);
+    queue->count += count;
+
+    return count;
+}
+
+/* 批量出队 */
+uint16_t CircularQueue_Dequeue_Bulk(CircularQueue_s *queue, void *data, uint16_t count) {
+    if (queue == NULL || data == NULL) {
+        return 0;
+    }
+
+    if (count > queue->count) {
+        count = queue->count;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    // 先读到缓冲区末尾，剩余部分从头读取
+    uint8_t *dst = (uint8_t *) data;
+    const uint16_t to_end = queue->capacity - queue->front;
+    const uint16_t first = (count < to_end) ? count : to_end;
+    memcpy(dst, CircularQueue_Slot(queue, queue->front), (uint32_t) first * queue->element_size);
+    if (count > first) {
+        memcpy(dst + (uint32_t) first * queue->element_size, queue->data, (uint32_t) (count - first) * queue->element_size);
+    }
+
+    queue->front = CircularQueue_Advance(queue, queue->front, count);
+    queue->count -= count;
+
+    return count;
+}
+
+/* 获取队头开始的连续可读区域 */
+const void *CircularQueue_Peek_Span(const CircularQueue_s *queue, uint16_t *count) {
+    if (queue == NULL || count == NULL) {
+        return NULL;
+    }
+
+    const uint16_t to_end = queue->capacity - queue->front;
+    *count = (queue->count < to_end) ? queue->count : to_end;
+
+    return (*count == 0) ? NULL : CircularQueue_Slot(queue, queue->front);
+}
+
+/* 丢弃队头元素 */
+void CircularQueue_Skip(CircularQueue_s *queue, uint16_t count) {
+    if (queue == NULL) {
+        return;
+    }
+
+    if (count > queue->count) {
+        count = queue->count;
+    }
+    queue->front = CircularQueue_Advance(queue, queue->front, count);
+    queue->count -= count;
+}
+
+/* 预留队尾开始的连续可写区域 */
+void *CircularQueue_Reserve(CircularQueue_s *queue, uint16_t *count) {
+    if (queue == NULL || count == NULL) {
+        return NULL;
+    }
+
+    const uint16_t space = queue->capacity - queue->count;
+    const uint16_t to_end = queue->capacity - queue->rear;
+    *count = (space < to_end) ? space : to_end;
+
+    return (*count == 0) ? NULL : CircularQueue_Slot(queue, queue->rear);
+}
+
+/* 提交预留区域 */
+void CircularQueue_Commit(CircularQueue_s *queue, uint16_t count) {
+    if (queue == NULL) {
+        return;
+    }
+
+    // 不允许超过预留时的连续空闲区域
+    const uint16_t space = queue->capacity - queue->count;
+    const uint16_t to_end = queue->capacity - queue->rear;
+    const uint16_t limit = (space < to_end) ? space : to_end;
+    if (count > limit) {
+        Log_Error("CircularQueue_Commit count %d exceeds reserved %d", count, limit);
+        count = limit;
+    }
+    queue->rear = CircularQueue_Advance(queue, queue->rear, count);
+    queue->count += count;
+}
+
 
 /* 清空队列 */
 void CircularQueue_Clear(CircularQueue_s *queue) {
@@ -4,6 +4,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// 队列满时的入队策略
+typedef enum{
+    CIRCULAR_QUEUE_OVERWRITE = 0, /* 覆盖最旧的元素（默认） */
+    CIRCULAR_QUEUE_REJECT = 1     /* 拒绝新元素 */
+}CircularQueuePolicy_e;
+
 // 循环队列结构体
 typedef struct{
     void *data;           /* 数据缓冲区 */
@@ -12,26 +18,51 @@ typedef struct{
     uint16_t capacity;    /* 队列容量 */
     uint16_t element_size; /* 每个元素的大小 */
     uint16_t count;       /* 当前元素数量 */
+    CircularQueuePolicy_e policy; /* 队列满时的入队策略 */
+    uint32_t drop_count;  /* 被覆盖或被拒绝的元素总数 */
 }CircularQueue_s;
 
 
 /* 创建循环队列 */
 CircularQueue_s* CircularQueue_Create(uint16_t capacity, uint16_t element_size);
 
-/* 销毁循环队列 */
+/* 销毁循环队列，启用 MEMORY_STATIC_ARENA 时只有最近创建的队列能真正回收内存 */
 void CircularQueue_Destroy(CircularQueue_s* queue);
 
+/* 设置队列满时的入队策略 */
+void CircularQueue_Set_Policy(CircularQueue_s* queue, CircularQueuePolicy_e policy);
+
 /* 入队操作 */
 bool CircularQueue_Enqueue(CircularQueue_s* queue, const void* data);
 
 /* 出队操作 */
 bool CircularQueue_Dequeue(CircularQueue_s* queue, void* data);
 
+/* 批量入队，跨越回绕点时最多两次拷贝，返回实际入队的元素数 */
+uint16_t CircularQueue_Enqueue_Bulk(CircularQueue_s* queue, const void* data, uint16_t count);
+
+/* 批量出队，跨越回绕点时最多两次拷贝，返回实际出队的元素数 */
+uint16_t CircularQueue_Dequeue_Bulk(CircularQueue_s* queue, void* data, uint16_t count);
+
+/* 获取队头开始的连续可读区域，*count 输出元素数（不跨越回绕点），数据仍保留在队列中 */
+const void* CircularQueue_Peek_Span(const CircularQueue_s* queue, uint16_t* count);
+
+/* 丢弃队头的 count 个元素，配合 CircularQueue_Peek_Span 使用 */
+void CircularQueue_Skip(CircularQueue_s* queue, uint16_t count);
+
+/* 预留队尾开始的连续可写区域，*count 输出元素数（不跨越回绕点，不覆盖未读数据） */
+void* CircularQueue_Reserve(CircularQueue_s* queue, uint16_t* count);
+
+/* 提交预留区域中已写入的 count 个元素 */
+void CircularQueue_Commit(CircularQueue_s* queue, uint16_t count);
 
 /* 获取队列中元素数量 */
 uint16_t CircularQueue_Get_Size(const CircularQueue_s* queue);
 
+/* 获取被覆盖或被拒绝的元素总数 */
+uint32_t CircularQueue_Get_Drop_Count(const CircularQueue_s* queue);
+
 /* 清空队列 */
 void CircularQueue_Clear(CircularQueue_s* queue);
 
-#endif //CIRCULAR_QUEUE_H
\ No newline at end of file
+#endif //CIRCULAR_QUEUE_H
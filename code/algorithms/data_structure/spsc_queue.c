@@ -0,0 +1,179 @@
+#include "spsc_queue.h"
+#include <string.h>
+#include "memory_management.h"
+#include "plf_log.h"
+
+/* 读取对端计数（acquire）：之后对缓冲区的访问不会被重排到读取之前 */
+#define SPSC_LOAD_ACQUIRE(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+/* 发布本端计数（release）：之前对缓冲区的访问在发布前全部完成 */
+#define SPSC_STORE_RELEASE(ptr, value)  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+/* 计算元素地址 */
+static inline uint8_t *SpscQueue_Slot(const SpscQueue_s *queue, uint32_t index) {
+    return queue->data + (index & queue->mask) * queue->element_size;
+}
+
+/* 从环形缓冲区的 index 位置开始拷贝 count 个元素到 dst，最多两次 memcpy */
+static void SpscQueue_Copy_Out(const SpscQueue_s *queue, uint32_t index, uint8_t *dst, uint32_t count) {
+    const uint32_t offset = index & queue->mask;
+    const uint32_t first = (count < queue->mask + 1u - offset) ? count : queue->mask + 1u - offset;
+    memcpy(dst, queue->data + offset * queue->element_size, first * queue->element_size);
+    if (count > first) {
+        memcpy(dst + first * queue->element_size, queue->data, (count - first) * queue->element_size);
+    }
+}
+
+/* 从 src 拷贝 count 个元素到环形缓冲区的 index 位置，最多两次 memcpy */
+static void SpscQueue_Copy_In(SpscQueue_s *queue, uint32_t index, const uint8_t *src, uint32_t count) {
+    const uint32_t offset = index & queue->mask;
+    const uint32_t first = (count < queue->mask + 1u - offset) ? count : queue->mask + 1u - offset;
+    memcpy(queue->data + offset * queue->element_size, src, first * queue->element_size);
+    if (count > first) {
+        memcpy(queue->data, src + first * queue->element_size, (count - first) * queue->element_size);
+    }
+}
+
+/* 使用外部缓冲区初始化队列 */
+bool SpscQueue_Init(SpscQueue_s *queue, void *buffer, const uint32_t capacity, const uint16_t element_size) {
+    if (queue == NULL || buffer == NULL || element_size == 0) {
+        Log_Error("SpscQueue_Init queue or buffer is NULL or element_size is 0");
+        return false;
+    }
+    if (capacity < 2u || (capacity & (capacity - 1u)) != 0u || capacity > 0x80000000u) {
+        Log_Error("SpscQueue_Init capacity %d is not a power of 2", capacity);
+        return false;
+    }
+    queue->head = 0;
+    queue->tail = 0;
+    queue->data = buffer;
+    queue->mask = capacity - 1u;
+    queue->element_size = element_size;
+    return true;
+}
+
+/* 创建队列 */
+SpscQueue_s *SpscQueue_Create(const uint32_t capacity, const uint16_t element_size) {
+    if (capacity < 2u || (capacity & (capacity - 1u)) != 0u || element_size == 0) {
+        Log_Error("SpscQueue_Create capacity is not a power of 2 or element_size is 0");
+        return NULL;
+    }
+
+    SpscQueue_s *queue = (SpscQueue_s *) user_malloc(sizeof(SpscQueue_s));
+    if (queue == NULL) {
+        Log_Error("SpscQueue_Create queue malloc fail");
+        return NULL;
+    }
+
+    void *buffer = user_malloc(capacity * element_size);
+    if (buffer == NULL) {
+        Log_Error("SpscQueue_Create queue data malloc fail");
+        user_free(queue);
+        return NULL;
+    }
+
+    SpscQueue_Init(queue, buffer, capacity, element_size);
+    return queue;
+}
+
+/* 入队单个元素 */
+bool SpscQueue_Enqueue(SpscQueue_s *queue, const void *data) {
+    return SpscQueue_Enqueue_Bulk(queue, data, 1u) == 1u;
+}
+
+/* 出队单个元素 */
+bool SpscQueue_Dequeue(SpscQueue_s *queue, void *data) {
+    return SpscQueue_Dequeue_Bulk(queue, data, 1u) == 1u;
+}
+
+/* 批量入队 */
+uint32_t SpscQueue_Enqueue_Bulk(SpscQueue_s *queue, const void *data, uint32_t count) {
+    if (queue == NULL || data == NULL || count == 0u) {
+        return 0u;
+    }
+    const uint32_t head = queue->head;
+    const uint32_t tail = SPSC_LOAD_ACQUIRE(&queue->tail);
+    const uint32_t space = queue->mask + 1u - (head - tail);
+    if (count > space) {
+        count = space;
+    }
+    if (count == 0u) {
+        return 0u;
+    }
+    SpscQueue_Copy_In(queue, head, data, count);
+    SPSC_STORE_RELEASE(&queue->head, head + count);
+    return count;
+}
+
+/* 批量出队 */
+uint32_t SpscQueue_Dequeue_Bulk(SpscQueue_s *queue, void *data, uint32_t count) {
+    if (queue == NULL || data == NULL || count == 0u) {
+        return 0u;
+    }
+    const uint32_t tail = queue->tail;
+    const uint32_t head = SPSC_LOAD_ACQUIRE(&queue->head);
+    const uint32_t size = head - tail;
+    if (count > size) {
+        count = size;
+    }
+    if (count == 0u) {
+        return 0u;
+    }
+    SpscQueue_Copy_Out(queue, tail, data, count);
+    SPSC_STORE_RELEASE(&queue->tail, tail + count);
+    return count;
+}
+
+/* 预留连续可写空间 */
+void *SpscQueue_Reserve(SpscQueue_s *queue, uint32_t *count) {
+    if (queue == NULL || count == NULL) {
+        return NULL;
+    }
+    const uint32_t head = queue->head;
+    const uint32_t tail = SPSC_LOAD_ACQUIRE(&queue->tail);
+    const uint32_t space = queue->mask + 1u - (head - tail);
+    const uint32_t to_end = queue->mask + 1u - (head & queue->mask);
+    *count = (space < to_end) ? space : to_end;
+    return (*count == 0u) ? NULL : SpscQueue_Slot(queue, head);
+}
+
+/* 提交预留空间 */
+void SpscQueue_Commit(SpscQueue_s *queue, const uint32_t count) {
+    if (queue == NULL || count == 0u) {
+        return;
+    }
+    SPSC_STORE_RELEASE(&queue->head, queue->head + count);
+}
+
+/* 获取连续可读空间 */
+const void *SpscQueue_Peek(SpscQueue_s *queue, uint32_t *count) {
+    if (queue == NULL || count == NULL) {
+        return NULL;
+    }
+    const uint32_t tail = queue->tail;
+    const uint32_t head = SPSC_LOAD_ACQUIRE(&queue->head);
+    const uint32_t size = head - tail;
+    const uint32_t to_end = queue->mask + 1u - (tail & queue->mask);
+    *count = (size < to_end) ? size : to_end;
+    return (*count == 0u) ? NULL : SpscQueue_Slot(queue, tail);
+}
+
+/* 释放已读取的元素 */
+void SpscQueue_Release(SpscQueue_s *queue, const uint32_t count) {
+    if (queue == NULL || count == 0u) {
+        return;
+    }
+    SPSC_STORE_RELEASE(&queue->tail, queue->tail + count);
+}
+
+/* 获取队列中元素数量 */
+uint32_t SpscQueue_Get_Size(const SpscQueue_s *queue) {
+    if (queue == NULL) {
+        return 0u;
+    }
+    return SPSC_LOAD_ACQUIRE(&queue->head) - SPSC_LOAD_ACQUIRE(&queue->tail);
+}
+
+/* 获取队列容量 */
+uint32_t SpscQueue_Get_Capacity(const SpscQueue_s *queue) {
+    return (queue == NULL) ? 0u : queue->mask + 1u;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file spsc_queue.h
+ * @brief 单生产者/单消费者无锁环形队列，用于中断与任务之间传递数据
+ * @note 生产者只写 head，消费者只写 tail，两者均为自由增长的32位计数，
+ *       容量为2的幂，下标通过掩码得到；不会覆盖未读数据，队列满时入队失败。
+ *       同一队列只允许一个生产者上下文和一个消费者上下文。
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 单生产者单消费者队列结构体
+typedef struct {
+    volatile uint32_t head __attribute__((aligned(32))); /* 生产者写入计数，独占缓存行 */
+    volatile uint32_t tail __attribute__((aligned(32))); /* 消费者读取计数，独占缓存行 */
+    uint8_t *data __attribute__((aligned(32)));          /* 数据缓冲区 */
+    uint32_t mask;                                       /* 容量 - 1 */
+    uint16_t element_size;                               /* 每个元素的大小 */
+} SpscQueue_s;
+
+/* 使用外部缓冲区初始化队列，capacity 必须为2的幂 */
+bool SpscQueue_Init(SpscQueue_s *queue, void *buffer, uint32_t capacity, uint16_t element_size);
+
+/* 创建队列，capacity 必须为2的幂 */
+SpscQueue_s *SpscQueue_Create(uint32_t capacity, uint16_t element_size);
+
+/* 入队单个元素（生产者），队列满返回 false */
+bool SpscQueue_Enqueue(SpscQueue_s *queue, const void *data);
+
+/* 出队单个元素（消费者），队列空返回 false */
+bool SpscQueue_Dequeue(SpscQueue_s *queue, void *data);
+
+/* 批量入队（生产者），返回实际入队的元素数 */
+uint32_t SpscQueue_Enqueue_Bulk(SpscQueue_s *queue, const void *data, uint32_t count);
+
+/* 批量出队（消费者），返回实际出队的元素数 */
+uint32_t SpscQueue_Dequeue_Bulk(SpscQueue_s *queue, void *data, uint32_t count);
+
+/* 预留连续可写空间（生产者），返回写指针，*count 输出可写元素数（不跨越回绕点） */
+void *SpscQueue_Reserve(SpscQueue_s *queue, uint32_t *count);
+
+/* 提交预留空间中已写入的 count 个元素（生产者） */
+void SpscQueue_Commit(SpscQueue_s *queue, uint32_t count);
+
+/* 获取连续可读空间（消费者），返回读指针，*count 输出可读元素数（不跨越回绕点） */
+const void *SpscQueue_Peek(SpscQueue_s *queue, uint32_t *count);
+
+/* 释放已读取的 count 个元素（消费者） */
+void SpscQueue_Release(SpscQueue_s *queue, uint32_t count);
+
+/* 获取队列中元素数量 */
+uint32_t SpscQueue_Get_Size(const SpscQueue_s *queue);
+
+/* 获取队列容量 */
+uint32_t SpscQueue_Get_Capacity(const SpscQueue_s *queue);
+
+#endif //SPSC_QUEUE_H
@@ -1,322 +1,391 @@
-
 // Date			Author			Notes
 // 29/09/2011	SOH Madgwick    Initial release
 // 02/10/2011	SOH Madgwick	Optimised for reduced CPU load
 //哆啦a梦 2023/3/27 魔改
-//-------------------------------------------------------------------------------------------
-// Header files
-
 #include "MahonyAHRS.h"
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 倒数平方根
+ * @param x 输入，必须 > 0
+ * @return 1 / sqrt(x)
+ * @note Cortex-M7 上 sqrtf 内联为 VSQRT 指令，不经过 arm_sqrt_f32 的函数调用和负数检查。
+ *       不使用 0x5f3759df 位运算近似：其误差恒为负，四元数模长偏小会使 Madgwick 归一化后的梯度方向失真
+ */
+static inline float Ahrs_Inv_Sqrt(float x){
+    return 1.0f / sqrtf(x);
+}
 
-#include "arm_math.h"
-#include "dsp/fast_math_functions.h"
-
-//-------------------------------------------------------------------------------------------
-// Definitions
-//这里都是可以调整的参数
-//---------------------------------------***********************************
-float twoKi;		// 2 * integral gain (Ki)
-float q0, q1, q2, q3;	// quaternion of sensor frame relative to auxiliary frame
-float integralFBx, integralFBy, integralFBz;  // integral error terms scaled by Ki
-float invSampleFreq;
-float roll_mahony, pitch_mahony, yaw_mahony;
-char anglesComputed;
-//*-*-*-**-----------------------------------------------------------------------------
-static float invSqrt(float x)  // if use other platform please use float Mahony_invSqrt(float x)
-{
-	float32_t sqrt_result;
-	arm_sqrt_f32(x, &sqrt_result);
-	return 1.0f / sqrt_result;
+/**
+ * @brief 检查加速度是否可用于修正姿态，可用时给出归一化系数
+ * @param instance 实例指针
+ * @param accel 加速度
+ * @param recip_norm 输出 1 / |accel|
+ * @return true 可用  false 全零或被门控
+ */
+static inline bool Ahrs_Accel_Valid(AhrsInstance_s* instance, const float accel[3], float* recip_norm){
+    const float norm2 = accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2];
+    if (norm2 == 0.0f){
+        return false;
+    }
+    if (norm2 < instance->gate_min2 || norm2 > instance->gate_max2){
+        // 冲击或急加减速时加速度不代表重力方向
+        instance->gated++;
+        return false;
+    }
+    *recip_norm = Ahrs_Inv_Sqrt(norm2);
+    return true;
 }
 
+/**
+ * @brief 磁力计是否可用
+ * @param mag 磁力计，可为NULL
+ * @return true 非NULL且不全为零
+ */
+static inline bool Ahrs_Mag_Valid(const float mag[3]){
+    return mag != NULL && !(mag[0] == 0.0f && mag[1] == 0.0f && mag[2] == 0.0f);
+}
 
-#define twoKpDef	(2.0f * 0.5f)	// 2 * proportional gain
-#define twoKiDef	(2.0f * 0.0f)	// 2 * integral gain
-void Mahony_Init(float sampleFrequency)
-{
-	twoKi = twoKiDef;	// 2 * integral gain (Ki)
-	q0 = 1.0f;
-	q1 = 0.0f;
-	q2 = 0.0f;
-	q3 = 0.0f;
-	integralFBx = 0.0f;
-	integralFBy = 0.0f;
-	integralFBz = 0.0f;
-	anglesComputed = 0;
-	invSampleFreq = 1.0f / sampleFrequency;
+/**
+ * @brief 累加四元数增量并归一化
+ * @param instance 实例指针
+ * @param delta 一个周期的四元数增量
+ */
+static inline void Ahrs_Integrate(AhrsInstance_s* instance, const float delta[4]){
+    float* q = instance->q;
+    for (uint8_t i = 0; i < 4; i++){
+        q[i] += delta[i];
+    }
+    const float recip_norm = Ahrs_Inv_Sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (uint8_t i = 0; i < 4; i++){
+        q[i] *= recip_norm;
+    }
 }
 
+/**
+ * @brief 角速度在一个周期内对应的四元数增量 0.5 * dt * q ⊗ [0, ω]
+ * @param instance 实例指针
+ * @param gx 角速度 X
+ * @param gy 角速度 Y
+ * @param gz 角速度 Z
+ * @param delta 输出四元数增量
+ */
+static inline void Ahrs_Q_Delta(const AhrsInstance_s* instance, float gx, float gy, float gz, float delta[4]){
+    const float* q = instance->q;
+    const float half_dt = 0.5f * instance->dt;
+    // 先乘公共系数，缩短依赖链
+    gx *= half_dt;
+    gy *= half_dt;
+    gz *= half_dt;
+    delta[0] = -q[1] * gx - q[2] * gy - q[3] * gz;
+    delta[1] = q[0] * gx + q[2] * gz - q[3] * gy;
+    delta[2] = q[0] * gy - q[1] * gz + q[3] * gx;
+    delta[3] = q[0] * gz + q[1] * gy - q[2] * gx;
+}
+
+/**
+ * @brief Mahony 更新
+ * @param instance 实例指针
+ * @param gyro 角速度 rad/s
+ * @param a 归一化的加速度，NULL 表示不修正
+ * @param m 归一化的磁力计，NULL 表示不使用
+ */
+static void Ahrs_Mahony(AhrsInstance_s* instance, const float gyro[3], const float a[3], const float m[3]){
+    const float* q = instance->q;
+    float gx = gyro[0];
+    float gy = gyro[1];
+    float gz = gyro[2];
+
+    if (a != NULL){
+        // 估计的重力方向（的一半）
+        const float halfvx = q[1] * q[3] - q[0] * q[2];
+        const float halfvy = q[0] * q[1] + q[2] * q[3];
+        const float halfvz = q[0] * q[0] - 0.5f + q[3] * q[3];
+
+        // 误差为测量方向与估计方向的叉积
+        float halfex = a[1] * halfvz - a[2] * halfvy;
+        float halfey = a[2] * halfvx - a[0] * halfvz;
+        float halfez = a[0] * halfvy - a[1] * halfvx;
+
+        if (m != NULL){
+            const float q0q1 = q[0] * q[1], q0q2 = q[0] * q[2], q0q3 = q[0] * q[3];
+            const float q1q1 = q[1] * q[1], q1q2 = q[1] * q[2], q1q3 = q[1] * q[3];
+            const float q2q2 = q[2] * q[2], q2q3 = q[2] * q[3], q3q3 = q[3] * q[3];
+
+            // 导航系下的地磁方向，水平分量合并到 x 轴
+            const float hx = 2.0f * (m[0] * (0.5f - q2q2 - q3q3) + m[1] * (q1q2 - q0q3) + m[2] * (q1q3 + q0q2));
+            const float hy = 2.0f * (m[0] * (q1q2 + q0q3) + m[1] * (0.5f - q1q1 - q3q3) + m[2] * (q2q3 - q0q1));
+            const float bx = sqrtf(hx * hx + hy * hy);
+            const float bz = 2.0f * (m[0] * (q1q3 - q0q2) + m[1] * (q2q3 + q0q1) + m[2] * (0.5f - q1q1 - q2q2));
+
+            // 估计的地磁方向（的一半）
+            const float halfwx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+            const float halfwy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+            const float halfwz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
+
+            halfex += m[1] * halfwz - m[2] * halfwy;
+            halfey += m[2] * halfwx - m[0] * halfwz;
+            halfez += m[0] * halfwy - m[1] * halfwx;
+        }
 
+        // 积分项只在有观测时更新
+        if (instance->two_ki > 0.0f){
+            instance->integral[0] += instance->two_ki * halfex * instance->dt;
+            instance->integral[1] += instance->two_ki * halfey * instance->dt;
+            instance->integral[2] += instance->two_ki * halfez * instance->dt;
+        }
+        gx += instance->two_kp * halfex;
+        gy += instance->two_kp * halfey;
+        gz += instance->two_kp * halfez;
+    }
+
+    // 积分项相当于陀螺仪零偏估计，门控期间继续补偿；ki 为 0 时积分项已清零
+    if (instance->two_ki > 0.0f){
+        gx += instance->integral[0];
+        gy += instance->integral[1];
+        gz += instance->integral[2];
+    }
+
+    float delta[4];
+    Ahrs_Q_Delta(instance, gx, gy, gz, delta);
+    Ahrs_Integrate(instance, delta);
+}
+
+/**
+ * @brief Madgwick 更新
+ * @param instance 实例指针
+ * @param gyro 角速度 rad/s
+ * @param a 归一化的加速度，NULL 表示不修正
+ * @param m 归一化的磁力计，NULL 表示不使用
+ */
+static void Ahrs_Madgwick(AhrsInstance_s* instance, const float gyro[3], const float a[3], const float m[3]){
+    const float q0 = instance->q[0], q1 = instance->q[1], q2 = instance->q[2], q3 = instance->q[3];
+    float delta[4];
+    Ahrs_Q_Delta(instance, gyro[0], gyro[1], gyro[2], delta);
+
+    if (a != NULL){
+        const float ax = a[0], ay = a[1], az = a[2];
+        float s0, s1, s2, s3;
+        if (m == NULL){
+            // 重力误差函数的梯度
+            const float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+            const float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+            const float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+            const float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+            s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+            s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+            s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+            s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+        } else {
+            // 重力和地磁误差函数的梯度
+            const float mx = m[0], my = m[1], mz = m[2];
+            const float _2q0mx = 2.0f * q0 * mx, _2q0my = 2.0f * q0 * my, _2q0mz = 2.0f * q0 * mz;
+            const float _2q1mx = 2.0f * q1 * mx;
+            const float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+            const float _2q0q2 = 2.0f * q0 * q2, _2q2q3 = 2.0f * q2 * q3;
+            const float q0q0 = q0 * q0, q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+            const float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+            const float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+
+            // 导航系下的地磁方向
+            const float hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 + _2q1 * mz * q3
+                - mx * q2q2 - mx * q3q3;
+            const float hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 + my * q2q2
+                + _2q2 * mz * q3 - my * q3q3;
+            const float _2bx = sqrtf(hx * hx + hy * hy);
+            const float _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 + _2q2 * my * q3
+                - mz * q2q2 + mz * q3q3;
+            const float _4bx = 2.0f * _2bx, _4bz = 2.0f * _2bz;
+
+            // 各误差分量
+            const float fgx = 2.0f * q1q3 - _2q0q2 - ax;
+            const float fgy = 2.0f * q0q1 + _2q2q3 - ay;
+            const float fgz = 1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az;
+            const float fbx = _2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+            const float fby = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+            const float fbz = _2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz;
+
+            s0 = -_2q2 * fgx + _2q1 * fgy - _2bz * q2 * fbx + (-_2bx * q3 + _2bz * q1) * fby + _2bx * q2 * fbz;
+            s1 = _2q3 * fgx + _2q0 * fgy - 4.0f * q1 * fgz + _2bz * q3 * fbx + (_2bx * q2 + _2bz * q0) * fby
+                + (_2bx * q3 - _4bz * q1) * fbz;
+            s2 = -_2q0 * fgx + _2q3 * fgy - 4.0f * q2 * fgz + (-_4bx * q2 - _2bz * q0) * fbx
+                + (_2bx * q1 + _2bz * q3) * fby + (_2bx * q0 - _4bz * q2) * fbz;
+            s3 = _2q1 * fgx + _2q2 * fgy + (-_4bx * q3 + _2bz * q1) * fbx + (-_2bx * q0 + _2bz * q2) * fby
+                + _2bx * q1 * fbz;
+        }
+
+        // 已对准时梯度为零，不需要修正
+        const float s_norm2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (s_norm2 > FLT_MIN){
+            const float k = instance->beta * instance->dt * Ahrs_Inv_Sqrt(s_norm2);
+            delta[0] -= k * s0;
+            delta[1] -= k * s1;
+            delta[2] -= k * s2;
+            delta[3] -= k * s3;
+        }
+    }
 
-float Mahony_invSqrt(float x)
-{
-	float halfx = 0.5f * x;
-	float y = x;
-	long i = *(long*)&y;
-	i = 0x5f3759df - (i>>1);
-	y = *(float*)&i;
-	y = y * (1.5f - (halfx * y * y));
-	y = y * (1.5f - (halfx * y * y));
-	return y;
+    Ahrs_Integrate(instance, delta);
 }
 
-void MahonyAHRSinit(float ax, float ay, float az, float mx, float my, float mz)
-{
-    float recipNorm;
-    float init_yaw, init_pitch, init_roll;
-    float cr2, cp2, cy2, sr2, sp2, sy2;
-    float sin_roll, cos_roll, sin_pitch, cos_pitch;
-    float magX, magY;
-
-    recipNorm = invSqrt(ax * ax + ay * ay + az * az);
-    ax *= recipNorm;
-    ay *= recipNorm;
-    az *= recipNorm;
-
-    if((mx != 0.0f) && (my != 0.0f) && (mz != 0.0f)) 
-    {
-	    recipNorm = invSqrt(mx * mx + my * my + mz * mz);
-	    mx *= recipNorm;
-	    my *= recipNorm;
-	    mz *= recipNorm;
-	}
-
-    init_pitch = atan2f(-ax, az);
-    init_roll = atan2f(ay, az);
-
-    sin_roll  = sinf(init_roll);
-    cos_roll  = cosf(init_roll);
-    cos_pitch = cosf(init_pitch);
-    sin_pitch = sinf(init_pitch);
-
-    if((mx != 0.0f) && (my != 0.0f) && (mz != 0.0f))
-    {
-    	magX = mx * cos_pitch + my * sin_pitch * sin_roll + mz * sin_pitch * cos_roll;
-    	magY = my * cos_roll - mz * sin_roll;
-    	init_yaw  = atan2f(-magY, magX);
+/**
+ * @brief 初始化姿态解算实例，姿态置为单位四元数
+ * @param instance 实例指针
+ * @param config 初始化配置
+ */
+void Ahrs_Init(AhrsInstance_s* instance, const AhrsInitConfig_s* config){
+    if (instance == NULL || config == NULL){
+        return;
     }
-    else
-    {
-    	init_yaw=0.0f;
+    memset(instance, 0, sizeof(AhrsInstance_s));
+    instance->type = config->type;
+    instance->dt = config->sample_freq > 0.0f ? 1.0f / config->sample_freq : 0.0f;
+    Ahrs_Set_Gains(instance, config->kp, config->ki, config->beta);
+
+    if (config->acc_gate > 0.0f && config->gravity > 0.0f){
+        const float min = fmaxf(1.0f - config->acc_gate, 0.0f) * config->gravity;
+        const float max = (1.0f + config->acc_gate) * config->gravity;
+        instance->gate_min2 = min * min;
+        instance->gate_max2 = max * max;
+    } else {
+        instance->gate_min2 = 0.0f;
+        instance->gate_max2 = INFINITY;
     }
+    instance->q[0] = 1.0f;
+}
 
-    cr2 = cosf(init_roll * 0.5f);
-    cp2 = cosf(init_pitch * 0.5f);
-    cy2 = cosf(init_yaw * 0.5f);
-    sr2 = sinf(init_roll * 0.5f);
-    sp2 = sinf(init_pitch * 0.5f);
-    sy2 = sinf(init_yaw * 0.5f);
-
-    q0 = cr2 * cp2 * cy2 + sr2 * sp2 * sy2;
-    q1= sr2 * cp2 * cy2 - cr2 * sp2 * sy2;
-    q2 = cr2 * sp2 * cy2 + sr2 * cp2 * sy2;
-    q3= cr2 * cp2 * sy2 - sr2 * sp2 * cy2;
-
-    // Normalise quaternion
-    recipNorm = Mahony_invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
-    q0 *= recipNorm;
-    q1 *= recipNorm;
-    q2 *= recipNorm;
-    q3 *= recipNorm;
+/**
+ * @brief 修改增益，下一次更新生效
+ * @param instance 实例指针
+ * @param kp Mahony 比例增益
+ * @param ki Mahony 积分增益，置 0 时清除积分项
+ * @param beta Madgwick 梯度步长 rad/s
+ */
+void Ahrs_Set_Gains(AhrsInstance_s* instance, float kp, float ki, float beta){
+    if (instance == NULL){
+        return;
+    }
+    instance->two_kp = 2.0f * fmaxf(kp, 0.0f);
+    instance->two_ki = 2.0f * fmaxf(ki, 0.0f);
+    instance->beta = fmaxf(beta, 0.0f);
+    if (instance->two_ki == 0.0f){
+        // 防止积分饱和后残留
+        memset(instance->integral, 0, sizeof(instance->integral));
+    }
 }
-void Mahony_update(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz)
-{
-	float recipNorm;
-	float q0q0, q0q1, q0q2, q0q3, q1q1, q1q2, q1q3, q2q2, q2q3, q3q3;
-	float hx, hy, bx, bz;
-	float halfvx, halfvy, halfvz, halfwx, halfwy, halfwz;
-	float halfex, halfey, halfez;
-	float qa, qb, qc;
-	// Convert gyroscope degrees/sec to radians/sec
-//	gx *= 0.0174533f;
-//	gy *= 0.0174533f;
-//	gz *= 0.0174533f;
-
-    // Use IMU algorithm if magnetometer measurement invalid (avoids NaN in magnetometer normalisation)
-    if((mx == 0.0f) && (my == 0.0f) && (mz == 0.0f)) {
-        MahonyAHRSupdateIMU(gx, gy, gz, ax, ay, az);
+
+/**
+ * @brief 用静止时的加速度（和磁力计）直接计算初始姿态，避免上电后缓慢收敛
+ * @param instance 实例指针
+ * @param accel 加速度[X, Y, Z]
+ * @param mag 磁力计[X, Y, Z]，NULL 或全零时航向置 0
+ */
+void Ahrs_Reset(AhrsInstance_s* instance, const float accel[3], const float mag[3]){
+    if (instance == NULL || accel == NULL){
         return;
     }
+    const float roll = atan2f(accel[1], accel[2]);
+    const float pitch = atan2f(-accel[0], sqrtf(accel[1] * accel[1] + accel[2] * accel[2]));
+    float yaw = 0.0f;
+
+    const float sin_roll = sinf(roll), cos_roll = cosf(roll);
+    const float sin_pitch = sinf(pitch), cos_pitch = cosf(pitch);
+    if (Ahrs_Mag_Valid(mag)){
+        // 倾斜补偿后的水平地磁分量
+        const float mag_x = mag[0] * cos_pitch + mag[1] * sin_pitch * sin_roll + mag[2] * sin_pitch * cos_roll;
+        const float mag_y = mag[1] * cos_roll - mag[2] * sin_roll;
+        yaw = atan2f(-mag_y, mag_x);
+    }
 
-	// Compute feedback only if accelerometer measurement valid
-	// (avoids NaN in accelerometer normalisation)
-	if(!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))) {
-
-		// Normalise accelerometer measurement
-		recipNorm = invSqrt(ax * ax + ay * ay + az * az);
-		ax *= recipNorm;
-		ay *= recipNorm;
-		az *= recipNorm;
-
-		// Normalise magnetometer measurement
-		recipNorm = invSqrt(mx * mx + my * my + mz * mz);
-		mx *= recipNorm;
-		my *= recipNorm;
-		mz *= recipNorm;
-
-		// Auxiliary variables to avoid repeated arithmetic
-		q0q0 = q0 * q0;
-		q0q1 = q0 * q1;
-		q0q2 = q0 * q2;
-		q0q3 = q0 * q3;
-		q1q1 = q1 * q1;
-		q1q2 = q1 * q2;
-		q1q3 = q1 * q3;
-		q2q2 = q2 * q2;
-		q2q3 = q2 * q3;
-		q3q3 = q3 * q3;
-
-		// Reference direction of Earth's magnetic field
-		hx = 2.0f * (mx * (0.5f - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
-		hy = 2.0f * (mx * (q1q2 + q0q3) + my * (0.5f - q1q1 - q3q3) + mz * (q2q3 - q0q1));
-		bx = sqrtf(hx * hx + hy * hy);
-		bz = 2.0f * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (0.5f - q1q1 - q2q2));
-
-		// Estimated direction of gravity and magnetic field
-		halfvx = q1q3 - q0q2;
-		halfvy = q0q1 + q2q3;
-		halfvz = q0q0 - 0.5f + q3q3;
-		halfwx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
-		halfwy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
-		halfwz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
-
-		// Error is sum of cross product between estimated direction
-		// and measured direction of field vectors
-		halfex = (ay * halfvz - az * halfvy) + (my * halfwz - mz * halfwy);
-		halfey = (az * halfvx - ax * halfvz) + (mz * halfwx - mx * halfwz);
-		halfez = (ax * halfvy - ay * halfvx) + (mx * halfwy - my * halfwx);
-
-		// Compute and apply integral feedback if enabled
-		if(twoKi > 0.0f) {
-			// integral error scaled by Ki
-			integralFBx += twoKi * halfex * invSampleFreq;
-			integralFBy += twoKi * halfey * invSampleFreq;
-			integralFBz += twoKi * halfez * invSampleFreq;
-			gx += integralFBx;	// apply integral feedback
-			gy += integralFBy;
-			gz += integralFBz;
-		} else {
-			integralFBx = 0.0f;	// prevent integral windup
-			integralFBy = 0.0f;
-			integralFBz = 0.0f;
-		}
-
-		// Apply proportional feedback
-		gx += twoKpDef * halfex;
-		gy += twoKpDef * halfey;
-		gz += twoKpDef * halfez;
-	}
-
-	// Integrate rate of change of quaternion
-	gx *= (0.5f * invSampleFreq);		// pre-multiply common factors
-	gy *= (0.5f * invSampleFreq);
-	gz *= (0.5f * invSampleFreq);
-	qa = q0;
-	qb = q1;
-	qc = q2;
-	q0 += (-qb * gx - qc * gy - q3 * gz);
-	q1 += (qa * gx + qc * gz - q3 * gy);
-	q2 += (qa * gy - qb * gz + q3 * gx);
-	q3 += (qa * gz + qb * gy - qc * gx);
-
-	// Normalise quaternion
-	recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
-	q0 *= recipNorm;
-	q1 *= recipNorm;
-	q2 *= recipNorm;
-	q3 *= recipNorm;
-	anglesComputed = 0;
+    const float cr2 = cosf(roll * 0.5f), sr2 = sinf(roll * 0.5f);
+    const float cp2 = cosf(pitch * 0.5f), sp2 = sinf(pitch * 0.5f);
+    const float cy2 = cosf(yaw * 0.5f), sy2 = sinf(yaw * 0.5f);
+    instance->q[0] = cr2 * cp2 * cy2 + sr2 * sp2 * sy2;
+    instance->q[1] = sr2 * cp2 * cy2 - cr2 * sp2 * sy2;
+    instance->q[2] = cr2 * sp2 * cy2 + sr2 * cp2 * sy2;
+    instance->q[3] = cr2 * cp2 * sy2 - sr2 * sp2 * cy2;
+    memset(instance->integral, 0, sizeof(instance->integral));
 }
-//---------------------------------------------------------------------------------------------------
-// IMU algorithm update
-
-void MahonyAHRSupdateIMU(float gx, float gy, float gz, float ax, float ay, float az) {
-    float recipNorm;
-    float halfvx, halfvy, halfvz;
-    float halfex, halfey, halfez;
-    float qa, qb, qc;
-
-    // Compute feedback only if accelerometer measurement valid (avoids NaN in accelerometer normalisation)
-    if(!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))) {
-
-        // Normalise accelerometer measurement
-        recipNorm = invSqrt(ax * ax + ay * ay + az * az);
-        ax *= recipNorm;
-        ay *= recipNorm;
-        az *= recipNorm;
-
-        // Estimated direction of gravity and vector perpendicular to magnetic flux
-        halfvx = q1 * q3 - q0 * q2;
-        halfvy = q0 * q1 + q2 * q3;
-        halfvz = q0 * q0 - 0.5f + q3 * q3;
-
-        // Error is sum of cross product between estimated and measured direction of gravity
-        halfex = (ay * halfvz - az * halfvy);
-        halfey = (az * halfvx - ax * halfvz);
-        halfez = (ax * halfvy - ay * halfvx);
-
-        // Compute and apply integral feedback if enabled
-        if(twoKi > 0.0f) {
-            integralFBx += twoKi * halfex  * invSampleFreq;	// integral error scaled by Ki
-            integralFBy += twoKi * halfey  * invSampleFreq;
-            integralFBz += twoKi * halfez  * invSampleFreq;
-            gx += integralFBx;	// apply integral feedback
-            gy += integralFBy;
-            gz += integralFBz;
+
+/**
+ * @brief 9 轴更新
+ * @param instance 实例指针
+ * @param gyro 角速度[X, Y, Z] rad/s
+ * @param accel 加速度[X, Y, Z]，全零时只积分陀螺仪
+ * @param mag 磁力计[X, Y, Z]，NULL 或全零时按 6 轴更新
+ */
+void Ahrs_Update(AhrsInstance_s* instance, const float gyro[3], const float accel[3], const float mag[3]){
+    if (instance == NULL || gyro == NULL || accel == NULL){
+        return;
+    }
+    float a[3];
+    float m[3];
+    const float* a_ptr = NULL;
+    const float* m_ptr = NULL;
+    float recip_norm;
+
+    if (Ahrs_Accel_Valid(instance, accel, &recip_norm)){
+        for (uint8_t i = 0; i < 3; i++){
+            a[i] = accel[i] * recip_norm;
         }
-        else {
-            integralFBx = 0.0f;	// prevent integral windup
-            integralFBy = 0.0f;
-            integralFBz = 0.0f;
+        a_ptr = a;
+        if (Ahrs_Mag_Valid(mag)){
+            recip_norm = Ahrs_Inv_Sqrt(mag[0] * mag[0] + mag[1] * mag[1] + mag[2] * mag[2]);
+            for (uint8_t i = 0; i < 3; i++){
+                m[i] = mag[i] * recip_norm;
+            }
+            m_ptr = m;
         }
-
-        // Apply proportional feedback
-        gx += twoKpDef * halfex;
-        gy += twoKpDef * halfey;
-        gz += twoKpDef * halfez;
     }
 
-    // Integrate rate of change of quaternion
-    gx *= (0.5f *   invSampleFreq);		// pre-multiply common factors
-    gy *= (0.5f  * invSampleFreq);
-    gz *= (0.5f  * invSampleFreq);
-    qa = q0;
-    qb = q1;
-    qc = q2;
-    q0 += (-qb * gx - qc * gy - q3 * gz);
-    q1 += (qa * gx + qc * gz - q3 * gy);
-    q2 += (qa * gy - qb * gz + q3 * gx);
-    q3 += (qa * gz + qb * gy - qc * gx);
-
-    // Normalise quaternion
-    recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
-    q0 *= recipNorm;
-    q1 *= recipNorm;
-    q2 *= recipNorm;
-    q3 *= recipNorm;
+    if (instance->type == AHRS_MADGWICK){
+        Ahrs_Madgwick(instance, gyro, a_ptr, m_ptr);
+    } else {
+        Ahrs_Mahony(instance, gyro, a_ptr, m_ptr);
+    }
 }
 
-void Mahony_computeAngles()
-{
-	arm_atan2_f32(q0*q1 + q2*q3, 0.5f - q1*q1 - q2*q2,&roll_mahony);
-	roll_mahony *= 57.29578f;  
-	pitch_mahony =57.29578f * asinf(-2.0f * (q1*q3 - q0*q2));
-	arm_atan2_f32(q1*q2 + q0*q3, 0.5f - q2*q2 - q3*q3,&yaw_mahony); 
-	yaw_mahony *=57.29578f;
-	anglesComputed = 1;
-}
-float getRoll() {
-	if (!anglesComputed) Mahony_computeAngles();
-	return roll_mahony;
+/**
+ * @brief 6 轴更新
+ * @param instance 实例指针
+ * @param gyro 角速度[X, Y, Z] rad/s
+ * @param accel 加速度[X, Y, Z]，全零时只积分陀螺仪
+ */
+void Ahrs_Update_Imu(AhrsInstance_s* instance, const float gyro[3], const float accel[3]){
+    Ahrs_Update(instance, gyro, accel, NULL);
 }
-float getPitch() {
-	if (!anglesComputed) Mahony_computeAngles();
-	return pitch_mahony;
+
+/**
+ * @brief 同一时刻的多个 IMU 各自做 6 轴更新
+ * @param instances 实例数组
+ * @param gyro 各 IMU 的角速度 rad/s
+ * @param accel 各 IMU 的加速度
+ * @param n IMU 个数
+ */
+void Ahrs_Update_Imu_Batch(AhrsInstance_s* instances, const float gyro[][3], const float accel[][3], uint8_t n){
+    if (instances == NULL || gyro == NULL || accel == NULL){
+        return;
+    }
+    for (uint8_t i = 0; i < n; i++){
+        Ahrs_Update(&instances[i], gyro[i], accel[i], NULL);
+    }
 }
-float getYaw() {
-	if (!anglesComputed) Mahony_computeAngles();
-	return yaw_mahony;
+
+/**
+ * @brief 四元数转欧拉角（ZYX 顺序）
+ * @param instance 实例指针
+ * @param euler 输出[roll, pitch, yaw] rad
+ */
+void Ahrs_Get_Euler(const AhrsInstance_s* instance, float euler[3]){
+    if (instance == NULL || euler == NULL){
+        return;
+    }
+    const float* q = instance->q;
+    const float sin_pitch = fminf(fmaxf(-2.0f * (q[1] * q[3] - q[0] * q[2]), -1.0f), 1.0f);
+    euler[0] = atan2f(q[0] * q[1] + q[2] * q[3], 0.5f - q[1] * q[1] - q[2] * q[2]);
+    euler[1] = asinf(sin_pitch);
+    euler[2] = atan2f(q[1] * q[2] + q[0] * q[3], 0.5f - q[2] * q[2] - q[3] * q[3]);
 }
-//============================================================================================
-// END OF CODE
-//============================================================================================
@@ -1,26 +1,113 @@
-//=============================================================================================
-// MahonyAHRS.h
-//=============================================================================================
-//
-// Madgwick's implementation of Mayhony's AHRS algorithm.
-// See: http://www.x-io.co.uk/open-source-imu-and-ahrs-algorithms/
-//
-// Date			Author			Notes
-// 29/09/2011	SOH Madgwick    Initial release
-// 02/10/2011	SOH Madgwick	Optimised for reduced CPU load
-//
-//=============================================================================================
-#ifndef MahonyAHRS_h
-#define MahonyAHRS_h
-void Mahony_update(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz);
-void Mahony_Init(float sampleFrequency);
-void MahonyAHRSupdateIMU(float gx, float gy, float gz, float ax, float ay, float az);
-void Mahony_computeAngles(void);
-void MahonyAHRSinit(float ax, float ay, float az, float mx, float my, float mz);
-float getRoll(void);
-float getPitch(void);
-float getYaw(void);
-float getRollRadians(void);
-float getPitchRadians(void);
-float getYawRadians(void);
-#endif
+/**
+ * @file MahonyAHRS.h
+ * @brief 姿态解算(AHRS)：Mahony 互补滤波 / Madgwick 梯度下降，实例化、增益可在运行时修改
+ * @note 算法来自 SOH Madgwick 的开源实现 (http://www.x-io.co.uk/open-source-imu-and-ahrs-algorithms/)。
+ *       - 每个实例保存自己的四元数、积分项和增益，多个 IMU 各用一个实例，可用 Ahrs_Update_Imu_Batch 一次更新。
+ *       - 加速度计门控：加速度模长偏离 gravity 超过 acc_gate 比例时（冲击、急加减速）只积分陀螺仪，
+ *         不用加速度修正姿态，同时冻结 Mahony 积分项。
+ *       - 磁力计为 NULL 或全零时退化为 6 轴更新。
+ *       - 归一化直接使用 sqrtf（M7 上为 VSQRT 指令），不经过 arm_sqrt_f32。
+ *       单位：陀螺仪 rad/s，加速度计任意（门控时与 gravity 一致），四元数为机体系到导航系(q0 为实部)。
+ */
+#ifndef MAHONY_AHRS_H
+#define MAHONY_AHRS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 滤波算法
+ */
+typedef enum {
+    AHRS_MAHONY = 0,    // Mahony 互补滤波，PI 修正陀螺仪
+    AHRS_MADGWICK,      // Madgwick 梯度下降
+} AhrsType_e;
+
+/**
+ * @brief 姿态解算实例
+ */
+typedef struct {
+    AhrsType_e type;    // 滤波算法
+    float two_kp;       // Mahony：2 * 比例增益
+    float two_ki;       // Mahony：2 * 积分增益
+    float beta;         // Madgwick：梯度步长 rad/s
+    float dt;           // 采样周期 s
+    float gate_min2;    // 加速度模长平方下限，门控关闭时为 0
+    float gate_max2;    // 加速度模长平方上限，门控关闭时为无穷大
+
+    float q[4];         // 姿态四元数 [w, x, y, z]
+    float integral[3];  // Mahony 积分项 rad/s
+    uint32_t gated;     // 因加速度门控跳过修正的次数
+} AhrsInstance_s;
+
+/**
+ * @brief 姿态解算初始化配置
+ */
+typedef struct {
+    AhrsType_e type;    // 滤波算法
+    float kp;           // Mahony 比例增益，例如 0.5
+    float ki;           // Mahony 积分增益，0 表示不估计零偏
+    float beta;         // Madgwick 梯度步长 rad/s，例如 0.1
+    float sample_freq;  // 采样频率 Hz，必须 > 0
+    float gravity;      // 静止时加速度模长，与加速度计单位一致，例如 9.80665
+    float acc_gate;     // 加速度模长相对 gravity 的允许偏差比例，例如 0.15；0 表示不门控
+} AhrsInitConfig_s;
+
+/**
+ * @brief 初始化姿态解算实例，姿态置为单位四元数
+ * @param instance 实例指针
+ * @param config 初始化配置
+ */
+void Ahrs_Init(AhrsInstance_s* instance, const AhrsInitConfig_s* config);
+
+/**
+ * @brief 修改增益，下一次更新生效
+ * @param instance 实例指针
+ * @param kp Mahony 比例增益
+ * @param ki Mahony 积分增益，置 0 时清除积分项
+ * @param beta Madgwick 梯度步长 rad/s
+ */
+void Ahrs_Set_Gains(AhrsInstance_s* instance, float kp, float ki, float beta);
+
+/**
+ * @brief 用静止时的加速度（和磁力计）直接计算初始姿态，避免上电后缓慢收敛
+ * @param instance 实例指针
+ * @param accel 加速度[X, Y, Z]
+ * @param mag 磁力计[X, Y, Z]，NULL 或全零时航向置 0
+ */
+void Ahrs_Reset(AhrsInstance_s* instance, const float accel[3], const float mag[3]);
+
+/**
+ * @brief 6 轴更新
+ * @param instance 实例指针
+ * @param gyro 角速度[X, Y, Z] rad/s
+ * @param accel 加速度[X, Y, Z]，全零时只积分陀螺仪
+ */
+void Ahrs_Update_Imu(AhrsInstance_s* instance, const float gyro[3], const float accel[3]);
+
+/**
+ * @brief 9 轴更新
+ * @param instance 实例指针
+ * @param gyro 角速度[X, Y, Z] rad/s
+ * @param accel 加速度[X, Y, Z]，全零时只积分陀螺仪
+ * @param mag 磁力计[X, Y, Z]，NULL 或全零时按 6 轴更新
+ */
+void Ahrs_Update(AhrsInstance_s* instance, const float gyro[3], const float accel[3], const float mag[3]);
+
+/**
+ * @brief 同一时刻的多个 IMU 各自做 6 轴更新
+ * @param instances 实例数组
+ * @param gyro 各 IMU 的角速度 rad/s
+ * @param accel 各 IMU 的加速度
+ * @param n IMU 个数
+ */
+void Ahrs_Update_Imu_Batch(AhrsInstance_s* instances, const float gyro[][3], const float accel[][3], uint8_t n);
+
+/**
+ * @brief 四元数转欧拉角（ZYX 顺序）
+ * @param instance 实例指针
+ * @param euler 输出[roll, pitch, yaw] rad
+ */
+void Ahrs_Get_Euler(const AhrsInstance_s* instance, float euler[3]);
+
+#endif // MAHONY_AHRS_H
@@ -0,0 +1,443 @@
+/**
+ * @file memory_management.c
+ * @author Adonis Jin
+ * @brief 静态内存子系统实现：线性内存区、定长块内存池和 DMA 内存区
+ * @version 1.1
+ * @date 2025-11-30
+ */
+
+#include "memory_management.h"
+#include <string.h>
+#include <inttypes.h>
+#include "main.h"
+#include "plf_log.h"
+
+/* 临界区，分配可能发生在中断和任务中 */
+#define MEMORY_ENTER_CRITICAL()  uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define MEMORY_EXIT_CRITICAL()   __set_PRIMASK(primask)
+
+/* 将 x 向上对齐到 align，align 必须为2的幂 */
+#define MEMORY_ALIGN_UP(x, align) (((x) + ((align) - 1u)) & ~((align) - 1u))
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+#if defined MEMORY_STATIC_ARENA
+static uint8_t memory_heap_buf[MEMORY_HEAP_SIZE] __attribute__((aligned(MEMORY_ALIGN)));
+#endif
+static MemoryArena_s memory_heap;
+static bool memory_heap_init_flag = false;
+
+#if defined(MEMORY_AXISRAM_SIZE) && (MEMORY_AXISRAM_SIZE > 0)
+__attribute__((section(".axisram"), aligned(MEMORY_ALIGN))) static uint8_t memory_axisram_buf[MEMORY_AXISRAM_SIZE];
+#endif
+#if defined(MEMORY_RAM_D1_SIZE) && (MEMORY_RAM_D1_SIZE > 0)
+__attribute__((section(".ram_d1"), aligned(MEMORY_ALIGN))) static uint8_t memory_ram_d1_buf[MEMORY_RAM_D1_SIZE];
+#endif
+static MemoryArena_s memory_region[MEMORY_REGION_CNT];
+static bool memory_region_init_flag = false;
+
+static uint8_t memory_pool_idx = 0;
+static MemoryPool_s* memory_pool_instance[MEMORY_POOL_MAX_REGISTER_CNT];
+
+/* 线性内存区 ---------------------------------------------------------------*/
+
+/**
+ * @brief 初始化线性内存区
+ * @param arena 内存区指针
+ * @param topic_name 实例名称
+ * @param base 存储区起始地址
+ * @param size 存储区大小
+ */
+void Memory_Arena_Init(MemoryArena_s* arena, char* topic_name, void* base, uint32_t size){
+    if (arena == NULL){
+        return;
+    }
+    memset(arena, 0, sizeof(MemoryArena_s));
+    arena->topic_name = topic_name;
+    arena->base = base;
+    arena->size = (base == NULL) ? 0u : size;
+}
+
+/**
+ * @brief 从线性内存区分配
+ * @param arena 内存区指针
+ * @param size 分配大小
+ * @param align 对齐字节数，必须为2的幂
+ * @return 分配到的地址，空间不足返回NULL
+ */
+void* Memory_Arena_Alloc(MemoryArena_s* arena, uint32_t size, uint32_t align){
+    if (arena == NULL || size == 0u || align == 0u || (align & (align - 1u)) != 0u){
+        return NULL;
+    }
+    void* ptr = NULL;
+    MEMORY_ENTER_CRITICAL();
+    const uintptr_t address = (uintptr_t)(arena->base + arena->offset);
+    const uint32_t start = arena->offset + (uint32_t)((align - (address & (align - 1u))) & (align - 1u));
+    if (start <= arena->size && size <= arena->size - start){
+        ptr = arena->base + start;
+        // 回退记录满时丢弃最旧的一条
+        if (arena->undo_cnt == MEMORY_ARENA_ROLLBACK_DEPTH){
+            memmove(&arena->undo_offset[0], &arena->undo_offset[1], (MEMORY_ARENA_ROLLBACK_DEPTH - 1u) * sizeof(uint32_t));
+            memmove(&arena->undo_ptr[0], &arena->undo_ptr[1], (MEMORY_ARENA_ROLLBACK_DEPTH - 1u) * sizeof(void*));
+            arena->undo_cnt--;
+        }
+        arena->undo_offset[arena->undo_cnt] = arena->offset;
+        arena->undo_ptr[arena->undo_cnt] = ptr;
+        arena->undo_cnt++;
+        arena->offset = start + size;
+        arena->alloc_cnt++;
+        if (arena->offset > arena->peak){
+            arena->peak = arena->offset;
+        }
+    }
+    else{
+        arena->fail_cnt++;
+    }
+    MEMORY_EXIT_CRITICAL();
+    return ptr;
+}
+
+/**
+ * @brief 回退线性内存区最近一次分配，连续调用可按 LIFO 顺序回退最近 MEMORY_ARENA_ROLLBACK_DEPTH 次分配
+ * @param arena 内存区指针
+ * @param ptr 待释放地址
+ * @return true 回退成功  false ptr 不是最近一次未回退的分配
+ */
+bool Memory_Arena_Rollback(MemoryArena_s* arena, const void* ptr){
+    if (arena == NULL || ptr == NULL){
+        return false;
+    }
+    bool result = false;
+    MEMORY_ENTER_CRITICAL();
+    if (arena->undo_cnt > 0u && ptr == arena->undo_ptr[arena->undo_cnt - 1u]){
+        arena->undo_cnt--;
+        arena->offset = arena->undo_offset[arena->undo_cnt];
+        result = true;
+    }
+    MEMORY_EXIT_CRITICAL();
+    return result;
+}
+
+/**
+ * @brief 复位线性内存区，之前分配的所有对象失效
+ * @param arena 内存区指针
+ */
+void Memory_Arena_Reset(MemoryArena_s* arena){
+    if (arena == NULL){
+        return;
+    }
+    MEMORY_ENTER_CRITICAL();
+    arena->offset = 0u;
+    arena->undo_cnt = 0u;
+    MEMORY_EXIT_CRITICAL();
+}
+
+/* 定长块内存池 -------------------------------------------------------------*/
+
+/**
+ * @brief 初始化定长块内存池
+ * @param pool 内存池指针
+ * @param topic_name 实例名称
+ * @param base 块存储区起始地址，需按 MEMORY_ALIGN 对齐
+ * @param free_map 空闲位图存储区，MEMORY_POOL_MAP_WORDS(block_cnt) 个字
+ * @param block_size 单个块大小，会向上对齐到 MEMORY_ALIGN
+ * @param block_cnt 块数量
+ * @return true 初始化成功  false 参数错误
+ */
+bool Memory_Pool_Init(MemoryPool_s* pool, char* topic_name, void* base, uint32_t* free_map,
+                      uint32_t block_size, uint16_t block_cnt){
+    if (pool == NULL || base == NULL || free_map == NULL || block_size == 0u || block_cnt == 0u){
+        Log_Error("Memory_Pool_Init: %s Invalid Parameter", topic_name == NULL ? "NULL" : topic_name);
+        return false;
+    }
+    if (((uintptr_t)base & (MEMORY_ALIGN - 1u)) != 0u){
+        Log_Error("Memory_Pool_Init: %s base is not %u bytes aligned", topic_name, (unsigned int)MEMORY_ALIGN);
+        return false;
+    }
+    memset(pool, 0, sizeof(MemoryPool_s));
+    pool->topic_name = topic_name;
+    pool->base = base;
+    pool->block_size = MEMORY_ALIGN_UP(block_size, MEMORY_ALIGN);
+    pool->block_cnt = block_cnt;
+    pool->free_map = free_map;
+    // 全部块空闲，最后一个字中超出块数的位保持为 0
+    memset(free_map, 0xFF, MEMORY_POOL_MAP_WORDS(block_cnt) * sizeof(uint32_t));
+    if ((block_cnt & 31u) != 0u){
+        free_map[block_cnt / 32u] = (1u << (block_cnt & 31u)) - 1u;
+    }
+    // 倒序串联空闲链表，使首次分配得到第0块
+    for (uint16_t i = block_cnt; i > 0u; i--){
+        void** block = (void**)(pool->base + (uint32_t)(i - 1u) * pool->block_size);
+        *block = pool->free_list;
+        pool->free_list = block;
+    }
+    if (memory_pool_idx < MEMORY_POOL_MAX_REGISTER_CNT){
+        memory_pool_instance[memory_pool_idx++] = pool;
+    }
+    return true;
+}
+
+/**
+ * @brief 创建定长块内存池，块存储区从初始化内存区中分配
+ * @param topic_name 实例名称
+ * @param block_size 单个块大小
+ * @param block_cnt 块数量
+ * @return 内存池指针，失败返回NULL
+ */
+MemoryPool_s* Memory_Pool_Create(char* topic_name, uint32_t block_size, uint16_t block_cnt){
+    MemoryPool_s* pool = Memory_Malloc(sizeof(MemoryPool_s));
+    if (pool == NULL){
+        Log_Error("Memory_Pool_Create: %s Instance Malloc Failed", topic_name);
+        return NULL;
+    }
+    uint32_t* free_map = Memory_Malloc(MEMORY_POOL_MAP_WORDS(block_cnt) * sizeof(uint32_t));
+    void* base = (free_map != NULL) ? Memory_Malloc(MEMORY_ALIGN_UP(block_size, MEMORY_ALIGN) * block_cnt) : NULL;
+    if (base == NULL){
+        Log_Error("Memory_Pool_Create: %s Block Malloc Failed", topic_name);
+        // 按分配的相反顺序释放，内存区可以回退
+        Memory_Free(free_map);
+        Memory_Free(pool);
+        return NULL;
+    }
+    if (!Memory_Pool_Init(pool, topic_name, base, free_map, block_size, block_cnt)){
+        Memory_Free(base);
+        Memory_Free(free_map);
+        Memory_Free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+/**
+ * @brief 从内存池分配一个块
+ * @param pool 内存池指针
+ * @return 块地址，内存池耗尽返回NULL
+ */
+void* Memory_Pool_Alloc(MemoryPool_s* pool){
+    if (pool == NULL){
+        return NULL;
+    }
+    MEMORY_ENTER_CRITICAL();
+    void** block = pool->free_list;
+    if (block != NULL){
+        const uint32_t idx = (uint32_t)((uint8_t*)block - pool->base) / pool->block_size;
+        pool->free_map[idx / 32u] &= ~(1u << (idx & 31u));
+        pool->free_list = *block;
+        pool->used++;
+        if (pool->used > pool->peak){
+            pool->peak = pool->used;
+        }
+    }
+    else{
+        pool->fail_cnt++;
+    }
+    MEMORY_EXIT_CRITICAL();
+    return block;
+}
+
+/**
+ * @brief 将块归还内存池
+ * @param pool 内存池指针
+ * @param ptr 块地址
+ * @return true 归还成功  false ptr 不属于该内存池
+ */
+bool Memory_Pool_Free(MemoryPool_s* pool, void* ptr){
+    if (pool == NULL || ptr == NULL){
+        return false;
+    }
+    const uint32_t offset = (uint32_t)((uint8_t*)ptr - pool->base);
+    if ((uint8_t*)ptr < pool->base || offset >= pool->block_size * pool->block_cnt || offset % pool->block_size != 0u){
+        return false;
+    }
+    const uint32_t idx = offset / pool->block_size;
+    const uint32_t bit = 1u << (idx & 31u);
+    MEMORY_ENTER_CRITICAL();
+    // 块已空闲或没有已分配的块时为重复释放，不能再链入空闲链表
+    const bool valid = ((pool->free_map[idx / 32u] & bit) == 0u) && (pool->used > 0u);
+    if (valid){
+        pool->free_map[idx / 32u] |= bit;
+        *(void**)ptr = pool->free_list;
+        pool->free_list = ptr;
+        pool->used--;
+    }
+    MEMORY_EXIT_CRITICAL();
+    if (!valid){
+        Log_Error("Memory_Pool_Free: %s block %" PRIu32 " double free", pool->topic_name, idx);
+        return false;
+    }
+    return true;
+}
+
+/* 初始化期对象 -------------------------------------------------------------*/
+
+/**
+ * @brief 初始化内存区首次使用时初始化
+ */
+static void Memory_Heap_Init(void){
+#if defined MEMORY_STATIC_ARENA
+    Memory_Arena_Init(&memory_heap, "HEAP", memory_heap_buf, MEMORY_HEAP_SIZE);
+#else
+    Memory_Arena_Init(&memory_heap, "HEAP", NULL, 0u);
+#endif
+    memory_heap_init_flag = true;
+}
+
+/**
+ * @brief 初始化期对象分配，按 MEMORY_ALIGN 对齐
+ * @param size 分配大小
+ * @return 分配到的地址，失败返回NULL
+ */
+void* Memory_Malloc(uint32_t size){
+    if (!memory_heap_init_flag){
+        Memory_Heap_Init();
+    }
+    void* ptr = Memory_Arena_Alloc(&memory_heap, size, MEMORY_ALIGN);
+    if (ptr == NULL){
+        Log_Error("Memory_Malloc: %" PRIu32 " bytes Failed, HEAP used %" PRIu32 " / %" PRIu32,
+                  size, memory_heap.offset, memory_heap.size);
+    }
+    return ptr;
+}
+
+/**
+ * @brief 释放 Memory_Malloc 分配的对象
+ * @param ptr 待释放地址，可为NULL
+ * @note 按分配的相反顺序释放最近 MEMORY_ARENA_ROLLBACK_DEPTH 次分配时可以真正回收，其余释放无法回收，
+ *       计入 leak_cnt 并输出错误；运行期反复创建/销毁的对象应使用 Memory_Pool
+ */
+void Memory_Free(void* ptr){
+    if (ptr == NULL){
+        return;
+    }
+    if ((uint8_t*)ptr < memory_heap.base || (uint8_t*)ptr >= memory_heap.base + memory_heap.size){
+        Log_Warning("Memory_Free: %p is not allocated by Memory_Malloc", ptr);
+        return;
+    }
+    if (!Memory_Arena_Rollback(&memory_heap, ptr)){
+        memory_heap.leak_cnt++;
+        Log_Error("Memory_Free: %p can not be reclaimed, HEAP leak count %" PRIu32, ptr, memory_heap.leak_cnt);
+    }
+}
+
+/* DMA 内存区 ---------------------------------------------------------------*/
+
+/**
+ * @brief DMA 内存区首次使用时初始化
+ */
+static void Memory_Region_Init(void){
+#if defined(MEMORY_AXISRAM_SIZE) && (MEMORY_AXISRAM_SIZE > 0)
+    Memory_Arena_Init(&memory_region[MEMORY_REGION_AXISRAM], "AXISRAM", memory_axisram_buf, MEMORY_AXISRAM_SIZE);
+#else
+    Memory_Arena_Init(&memory_region[MEMORY_REGION_AXISRAM], "AXISRAM", NULL, 0u);
+#endif
+#if defined(MEMORY_RAM_D1_SIZE) && (MEMORY_RAM_D1_SIZE > 0)
+    Memory_Arena_Init(&memory_region[MEMORY_REGION_RAM_D1], "RAM_D1", memory_ram_d1_buf, MEMORY_RAM_D1_SIZE);
+#else
+    Memory_Arena_Init(&memory_region[MEMORY_REGION_RAM_D1], "RAM_D1", NULL, 0u);
+#endif
+    memory_region_init_flag = true;
+}
+
+/**
+ * @brief 从 DMA 可访问的内存区分配
+ * @param region 内存区选择
+ * @param size 分配大小，向上补齐到 MEMORY_ALIGN，保证缓冲区独占缓存行
+ * @return 分配到的地址，按 MEMORY_ALIGN 对齐，失败返回NULL
+ */
+void* Memory_Region_Malloc(MemoryRegion_e region, uint32_t size){
+    if (region >= MEMORY_REGION_CNT){
+        Log_Error("Memory_Region_Malloc: Invalid Region %d", (int)region);
+        return NULL;
+    }
+    if (!memory_region_init_flag){
+        Memory_Region_Init();
+    }
+    void* ptr = Memory_Arena_Alloc(&memory_region[region], MEMORY_ALIGN_UP(size, MEMORY_ALIGN), MEMORY_ALIGN);
+    if (ptr == NULL){
+        Log_Error("Memory_Region_Malloc: %s %" PRIu32 " bytes Failed, used %" PRIu32 " / %" PRIu32, memory_region[region].topic_name,
+                  size, memory_region[region].offset, memory_region[region].size);
+    }
+    return ptr;
+}
+
+/**
+ * @brief 释放 Memory_Region_Malloc 分配的缓冲区
+ * @param region 分配时的内存区
+ * @param ptr 待释放地址，可为NULL
+ * @note 与 Memory_Free 相同，只有按相反顺序释放最近的分配时能真正回收，用于注册失败时的清理
+ */
+void Memory_Region_Free(MemoryRegion_e region, void* ptr){
+    if (ptr == NULL || region >= MEMORY_REGION_CNT || !memory_region_init_flag){
+        return;
+    }
+    MemoryArena_s* arena = &memory_region[region];
+    if ((uint8_t*)ptr < arena->base || (uint8_t*)ptr >= arena->base + arena->size){
+        Log_Warning("Memory_Region_Free: %p is not allocated from %s", ptr, arena->topic_name);
+        return;
+    }
+    if (!Memory_Arena_Rollback(arena, ptr)){
+        arena->leak_cnt++;
+        Log_Error("Memory_Region_Free: %p can not be reclaimed, %s leak count %" PRIu32, ptr, arena->topic_name, arena->leak_cnt);
+    }
+}
+
+/**
+ * @brief 获取内存区实例，用于读取统计信息
+ * @param region 内存区选择
+ * @return 内存区指针，该内存区未启用返回NULL
+ */
+const MemoryArena_s* Memory_Region_Get(MemoryRegion_e region){
+    if (region >= MEMORY_REGION_CNT){
+        return NULL;
+    }
+    if (!memory_region_init_flag){
+        Memory_Region_Init();
+    }
+    if (memory_region[region].size == 0u){
+        return NULL;
+    }
+    return &memory_region[region];
+}
+
+/**
+ * @brief 获取初始化内存区实例，用于读取统计信息
+ * @return 内存区指针
+ */
+const MemoryArena_s* Memory_Heap_Get(void){
+    if (!memory_heap_init_flag){
+        Memory_Heap_Init();
+    }
+    return &memory_heap;
+}
+
+/* 统计 ---------------------------------------------------------------------*/
+
+/**
+ * @brief 输出单个线性内存区的统计信息
+ * @param arena 内存区指针
+ */
+static void Memory_Log_Arena(const MemoryArena_s* arena){
+    if (arena == NULL || arena->size == 0u){
+        return;
+    }
+    Log_Information("Memory %s: used %" PRIu32 " / %" PRIu32 ", peak %" PRIu32 ", alloc %" PRIu32
+                    ", fail %" PRIu32 ", leak %" PRIu32,
+                    arena->topic_name, arena->offset, arena->size, arena->peak,
+                    arena->alloc_cnt, arena->fail_cnt, arena->leak_cnt);
+}
+
+/**
+ * @brief 输出所有内存区和内存池的使用量、峰值和失败次数
+ */
+void Memory_Log_Stat(void){
+    Memory_Log_Arena(Memory_Heap_Get());
+    for (uint8_t i = 0; i < MEMORY_REGION_CNT; i++){
+        Memory_Log_Arena(Memory_Region_Get((MemoryRegion_e)i));
+    }
+    for (uint8_t i = 0; i < memory_pool_idx; i++){
+        const MemoryPool_s* pool = memory_pool_instance[i];
+        Log_Information("Memory Pool %s: used %u / %u, peak %u, block %" PRIu32 " bytes, fail %" PRIu32,
+                        pool->topic_name, pool->used, pool->block_cnt, pool->peak,
+                        pool->block_size, pool->fail_cnt);
+    }
+}
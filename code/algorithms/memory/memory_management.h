@@ -11,13 +11,217 @@
  * 使用方法：
  *   - 在需要动态内存分配的地方，直接调用 user_malloc。
  *   - user_malloc 会根据平台自动映射到对应的分配函数。
+ *
+ * @date 2025-11-30
+ * @version 1.1
+ * @note 新增静态内存子系统（定义 MEMORY_STATIC_ARENA 启用）：
+ *   - 初始化期对象：user_malloc 映射为 Memory_Malloc，从线性(bump)内存区分配，O(1)，按缓存行对齐，无碎片。
+ *     user_free 可以按 LIFO 顺序回退最近 MEMORY_ARENA_ROLLBACK_DEPTH 次分配（用于注册失败时的清理），
+ *     其余释放无法回收，计入 leak_cnt 并输出错误。
+ *   - 运行期对象：使用 MemoryPool_s 定长块内存池，O(1) 分配/释放。
+ *   - DMA 缓冲区：Memory_Region_Malloc 从 .axisram / .ram_d1 段内的内存区分配，
+ *     起始地址和长度都补齐到缓存行，可以安全地配合 bsp_cache 的失效操作。
+ *   - Memory_Log_Stat 输出各内存区和内存池的使用量与峰值。
  */
 
 #ifndef MEMORY_MANAGEMENT_H
 #define MEMORY_MANAGEMENT_H
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "robot_config.h"
 
+/**
+ * @brief 默认对齐字节数，等于 Cortex-M7 D-Cache 行大小
+ */
+#define MEMORY_ALIGN 32u
+
+/**
+ * @brief 可注册到统计列表的内存池最大数量
+ */
+#define MEMORY_POOL_MAX_REGISTER_CNT 8
+
+/**
+ * @brief 线性内存区可按 LIFO 顺序回退的最近分配次数
+ */
+#define MEMORY_ARENA_ROLLBACK_DEPTH 4
+
+/**
+ * @brief 内存池空闲位图所需的字数，每块 1 位
+ */
+#define MEMORY_POOL_MAP_WORDS(block_cnt) (((uint32_t)(block_cnt) + 31u) / 32u)
+
+/**
+ * @brief 线性(bump)内存区
+ * @note 只能整体复位，适合初始化阶段分配、永不释放的对象
+ */
+typedef struct {
+    char* topic_name;       // 实例名称
+    uint8_t* base;          // 内存区起始地址
+    uint32_t size;          // 内存区大小
+    uint32_t offset;        // 当前已分配到的偏移
+    uint32_t peak;          // 偏移的历史峰值
+    uint32_t undo_offset[MEMORY_ARENA_ROLLBACK_DEPTH]; // 最近几次分配前的偏移，用于回退
+    void* undo_ptr[MEMORY_ARENA_ROLLBACK_DEPTH];       // 最近几次分配返回的地址，末尾为最近一次
+    uint8_t undo_cnt;       // 可回退的分配次数
+    uint32_t alloc_cnt;     // 分配次数
+    uint32_t fail_cnt;      // 分配失败次数
+    uint32_t leak_cnt;      // 无法回收的释放次数
+} MemoryArena_s;
+
+/**
+ * @brief 定长块内存池
+ * @note 空闲块通过块内首字作为单链表串联，分配和释放均为 O(1)；
+ *       空闲位图记录每块是否空闲，释放时用于检测重复释放
+ */
+typedef struct {
+    char* topic_name;       // 实例名称
+    uint8_t* base;          // 块存储区起始地址
+    uint32_t block_size;    // 单个块大小（已按 MEMORY_ALIGN 对齐）
+    uint16_t block_cnt;     // 块数量
+    uint16_t used;          // 当前已用块数
+    uint16_t peak;          // 已用块数的历史峰值
+    uint32_t fail_cnt;      // 分配失败次数
+    void* free_list;        // 空闲块链表头
+    uint32_t* free_map;     // 空闲位图，第 i 位为 1 表示第 i 块空闲
+} MemoryPool_s;
+
+/**
+ * @brief DMA 可访问的内存区选择
+ */
+typedef enum {
+    MEMORY_REGION_AXISRAM = 0, // .axisram 段
+    MEMORY_REGION_RAM_D1 = 1,  // .ram_d1 段
+    MEMORY_REGION_CNT
+} MemoryRegion_e;
+
+/**
+ * @brief 初始化线性内存区
+ * @param arena 内存区指针
+ * @param topic_name 实例名称
+ * @param base 存储区起始地址
+ * @param size 存储区大小
+ */
+void Memory_Arena_Init(MemoryArena_s* arena, char* topic_name, void* base, uint32_t size);
+
+/**
+ * @brief 从线性内存区分配
+ * @param arena 内存区指针
+ * @param size 分配大小
+ * @param align 对齐字节数，必须为2的幂
+ * @return 分配到的地址，空间不足返回NULL
+ */
+void* Memory_Arena_Alloc(MemoryArena_s* arena, uint32_t size, uint32_t align);
+
+/**
+ * @brief 回退线性内存区最近一次分配，连续调用可按 LIFO 顺序回退最近 MEMORY_ARENA_ROLLBACK_DEPTH 次分配
+ * @param arena 内存区指针
+ * @param ptr 待释放地址
+ * @return true 回退成功  false ptr 不是最近一次分配
+ */
+bool Memory_Arena_Rollback(MemoryArena_s* arena, const void* ptr);
+
+/**
+ * @brief 复位线性内存区，之前分配的所有对象失效
+ * @param arena 内存区指针
+ */
+void Memory_Arena_Reset(MemoryArena_s* arena);
+
+/**
+ * @brief 初始化定长块内存池
+ * @param pool 内存池指针
+ * @param topic_name 实例名称
+ * @param base 块存储区起始地址，需按 MEMORY_ALIGN 对齐
+ * @param free_map 空闲位图存储区，MEMORY_POOL_MAP_WORDS(block_cnt) 个字
+ * @param block_size 单个块大小，会向上对齐到 MEMORY_ALIGN
+ * @param block_cnt 块数量
+ * @return true 初始化成功  false 参数错误
+ */
+bool Memory_Pool_Init(MemoryPool_s* pool, char* topic_name, void* base, uint32_t* free_map,
+                      uint32_t block_size, uint16_t block_cnt);
+
+/**
+ * @brief 创建定长块内存池，块存储区和空闲位图从初始化内存区中分配
+ * @param topic_name 实例名称
+ * @param block_size 单个块大小
+ * @param block_cnt 块数量
+ * @return 内存池指针，失败返回NULL
+ */
+MemoryPool_s* Memory_Pool_Create(char* topic_name, uint32_t block_size, uint16_t block_cnt);
+
+/**
+ * @brief 从内存池分配一个块
+ * @param pool 内存池指针
+ * @return 块地址，内存池耗尽返回NULL
+ */
+void* Memory_Pool_Alloc(MemoryPool_s* pool);
+
+/**
+ * @brief 将块归还内存池
+ * @param pool 内存池指针
+ * @param ptr 块地址
+ * @return true 归还成功  false ptr 不属于该内存池或该块已空闲（重复释放）
+ */
+bool Memory_Pool_Free(MemoryPool_s* pool, void* ptr);
+
+/**
+ * @brief 初始化期对象分配，按 MEMORY_ALIGN 对齐
+ * @param size 分配大小
+ * @return 分配到的地址，失败返回NULL
+ */
+void* Memory_Malloc(uint32_t size);
+
+/**
+ * @brief 释放 Memory_Malloc 分配的对象
+ * @param ptr 待释放地址，可为NULL
+ * @note 按分配的相反顺序释放最近 MEMORY_ARENA_ROLLBACK_DEPTH 次分配时可以真正回收，其余释放无法回收，
+ *       计入 leak_cnt 并输出错误；运行期反复创建/销毁的对象应使用 Memory_Pool
+ */
+void Memory_Free(void* ptr);
+
+/**
+ * @brief 从 DMA 可访问的内存区分配
+ * @param region 内存区选择
+ * @param size 分配大小，向上补齐到 MEMORY_ALIGN，保证缓冲区独占缓存行
+ * @return 分配到的地址，按 MEMORY_ALIGN 对齐，失败返回NULL
+ */
+void* Memory_Region_Malloc(MemoryRegion_e region, uint32_t size);
+
+/**
+ * @brief 释放 Memory_Region_Malloc 分配的缓冲区
+ * @param region 分配时的内存区
+ * @param ptr 待释放地址，可为NULL
+ * @note 与 Memory_Free 相同，只有按相反顺序释放最近的分配时能真正回收，用于注册失败时的清理
+ */
+void Memory_Region_Free(MemoryRegion_e region, void* ptr);
+
+/**
+ * @brief 获取内存区实例，用于读取统计信息
+ * @param region 内存区选择
+ * @return 内存区指针，该内存区未启用返回NULL
+ */
+const MemoryArena_s* Memory_Region_Get(MemoryRegion_e region);
+
+/**
+ * @brief 获取初始化内存区实例，用于读取统计信息
+ * @return 内存区指针
+ */
+const MemoryArena_s* Memory_Heap_Get(void);
+
+/**
+ * @brief 输出所有内存区和内存池的使用量、峰值和失败次数
+ */
+void Memory_Log_Stat(void);
+
+#if defined MEMORY_STATIC_ARENA
+/**
+ * @brief 静态内存子系统下的内存分配接口
+ * user_malloc 映射为 Memory_Malloc。
+ */
+#define user_malloc Memory_Malloc
+#define user_free   Memory_Free
+#else
+
 #if defined FREERTOS
 #include "cmsis_os.h"
 /**
@@ -29,6 +233,7 @@
 #endif
 
 #if defined BARE_METAL
+#include <stdlib.h>
 /**
  * @brief 裸机平台下的内存分配接口
  *
@@ -38,4 +243,6 @@
 #define user_free   free
 #endif
 
+#endif
+
 #endif // MEMORY_MANAGEMENT_H
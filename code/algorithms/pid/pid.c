@@ -6,6 +6,7 @@
 #include <math.h>
 #include "plf_log.h"
 #include "memory_management.h"
+#include "robot_config.h"
 #include "string.h"
 
 // ==================== 积分计算函数 ====================
@@ -111,6 +112,62 @@ float derivative_trapezoidal(PidInstance_s* instance, float error)
     }
 }
 
+// ==================== 静态内存池 ====================
+
+#if defined PID_STATIC_POOL
+/**
+ * @brief PID内存池槽位，按32字节(Cortex-M7 D-Cache行)对齐，避免相邻实例共享缓存行
+ */
+typedef struct {
+    PidInstance_s instance;
+} __attribute__((aligned(MEMORY_ALIGN))) PidPoolSlot_s;
+
+static PidPoolSlot_s pid_pool_buf[PID_POOL_SIZE];     // 实例槽位
+static uint32_t pid_pool_map[MEMORY_POOL_MAP_WORDS(PID_POOL_SIZE)]; // 空闲位图
+static MemoryPool_s pid_pool;                         // 定长块内存池
+static bool pid_pool_init_flag = false;
+
+/**
+ * @brief 从内存池中取出一个PID实例，O(1)
+ * @return PID实例指针，内存池耗尽返回NULL
+ */
+static PidInstance_s* Pid_Pool_Alloc(void)
+{
+    if (!pid_pool_init_flag) {
+        pid_pool_init_flag = Memory_Pool_Init(&pid_pool, "PID", pid_pool_buf, pid_pool_map,
+                                              sizeof(PidPoolSlot_s), PID_POOL_SIZE);
+    }
+    return Memory_Pool_Alloc(&pid_pool);
+}
+#endif
+
+/**
+ * @brief 获取PID实例占用情况
+ * @param used 当前已占用的实例数，可为NULL
+ * @param peak 已占用实例数的历史峰值，可为NULL
+ * @return 内存池容量，未启用 PID_STATIC_POOL 时返回0
+ */
+uint16_t Pid_Pool_Usage(uint16_t* used, uint16_t* peak)
+{
+#if defined PID_STATIC_POOL
+    if (used != NULL) {
+        *used = pid_pool.used;
+    }
+    if (peak != NULL) {
+        *peak = pid_pool.peak;
+    }
+    return PID_POOL_SIZE;
+#else
+    if (used != NULL) {
+        *used = 0;
+    }
+    if (peak != NULL) {
+        *peak = 0;
+    }
+    return 0;
+#endif
+}
+
 // ==================== 主要PID函数 ====================
 
 /**
@@ -138,11 +195,19 @@ PidInstance_s* Pid_Register(PidInitConfig_s* config)
         return NULL;
     }
     
+#if defined PID_STATIC_POOL
+    PidInstance_s* instance = Pid_Pool_Alloc();
+    if (instance == NULL) {
+        Log_Error("Pid_Register: %s Pid Pool exhausted (PID_POOL_SIZE=%d)", config->topic_name, PID_POOL_SIZE);
+        return NULL;
+    }
+#else
     PidInstance_s* instance = (PidInstance_s*)user_malloc(sizeof(PidInstance_s));
     if (instance == NULL) {
         Log_Error("Pid_Register: %s Memory_Alloc failed", config->topic_name);
         return NULL;
     }
+#endif
     
     // 清零内存
     memset(instance, 0, sizeof(PidInstance_s));
@@ -209,7 +274,13 @@ void Pid_Unregister(PidInstance_s* instance)
 {
     if (instance != NULL) {
         Log_Information("Pid_Unregister: %s unregistered", instance->topic_name);
+#if defined PID_STATIC_POOL
+        if (!Memory_Pool_Free(&pid_pool, instance)) {
+            Log_Error("Pid_Unregister: %s is not in Pid Pool or already unregistered", instance->topic_name);
+        }
+#else
         user_free(instance);
+#endif
     }
 }
 
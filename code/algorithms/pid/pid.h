@@ -6,7 +6,7 @@
 // - 支持多种积分和微分数值方法 (前向欧拉、后向欧拉、梯形公式)
 // - 函数指针优化，避免运行时switch判断
 // - 默认启用抗积分饱和机制
-// - 动态内存管理，支持多实例
+// - 动态内存管理，支持多实例 (定义 PID_STATIC_POOL 时改为静态内存池分配)
 // - 微分滤波器支持
 //
 
@@ -100,6 +100,7 @@ void Pid_SetLimits(PidInstance_s* instance, float min_output, float max_output);
 void Pid_Reset(PidInstance_s* instance);                // 重置PID状态
 float Pid_Update(PidInstance_s* instance, float setpoint, float measurement);    // PID计算更新
 void Pid_SetGains(PidInstance_s* instance, float Kp, float Ki, float Kd);       // 动态调整增益
+uint16_t Pid_Pool_Usage(uint16_t* used, uint16_t* peak);  // 获取PID内存池占用情况，返回容量
 
 // 积分计算函数
 float integral_forward_euler(PidInstance_s* instance, float error);
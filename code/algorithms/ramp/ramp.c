@@ -0,0 +1,356 @@
+#include "ramp.h"
+#include <math.h>
+#include <stddef.h>
+#include "bsp_dwt.h"
+
+/* 五次多项式 s(u) = 10u^3 - 15u^4 + 6u^5 的速度、加速度、加加速度峰值系数 */
+#define RAMP_S_CURVE_VEL_PEAK   1.875f
+#define RAMP_S_CURVE_ACC_PEAK   5.7735027f
+#define RAMP_S_CURVE_JERK_PEAK  60.0f
+/* S 曲线起点速度、加速度不为零时，峰值由采样检查，不满足则按比例延长时长 */
+#define RAMP_S_CURVE_SAMPLES    32
+#define RAMP_S_CURVE_STRETCH    1.1f
+#define RAMP_S_CURVE_MAX_ITER   32
+#define RAMP_S_CURVE_TOLERANCE  1.001f
+
+/**
+ * @brief 梯形速度规划：起点速度为 start_vel，终点静止
+ * @note 先以 max_acc 从起点速度变到巡航速度，再匀速，最后以 max_acc 减速到零。
+ *       巡航方向取刹停后剩余位移的方向，因此反向运动或来不及刹停时会先减速再折返。
+ * @param instance 斜坡实例指针
+ * @param delta 起点到终点的位移
+ */
+static void Ramp_Plan_Trapezoid(RampInstance_s* instance, float delta){
+    const float vel = instance->max_vel;
+    const float acc = instance->max_acc;
+    const float v0 = instance->start_vel;
+    const float stop = v0 * fabsf(v0) / (2.0f * acc);
+    const float dir = (delta - stop > 0.0f || (delta == stop && v0 > 0.0f)) ? 1.0f : -1.0f;
+    // 在巡航方向为正的坐标系内计算
+    const float d = dir * delta;
+    const float u0 = dir * v0;
+    float peak = sqrtf(fmaxf(acc * d + 0.5f * u0 * u0, 0.0f));
+    if (vel > 0.0f && peak > vel){
+        peak = vel;
+    }
+    if (peak <= 0.0f){
+        return;
+    }
+    const float t1 = fabsf(peak - u0) / acc;
+    const float t3 = peak / acc;
+    const float cruise = d - 0.5f * (u0 + peak) * t1 - 0.5f * peak * t3;
+    instance->t_acc = t1;
+    instance->t_dec = t3;
+    instance->peak_vel = dir * peak;
+    instance->duration = t1 + fmaxf(cruise, 0.0f) / peak + t3;
+}
+
+/**
+ * @brief 按给定时长求解 S 曲线五次多项式的高次项系数
+ * @param instance 斜坡实例指针
+ * @param total 时长 s
+ */
+static void Ramp_S_Curve_Solve(RampInstance_s* instance, float total){
+    const float h = instance->end_value - instance->start_value;
+    const float v0 = instance->start_vel;
+    const float a0 = instance->start_acc;
+    const float t2 = total * total;
+    const float t3 = t2 * total;
+    instance->coeff[0] = (20.0f * h - 12.0f * v0 * total - 3.0f * a0 * t2) / (2.0f * t3);
+    instance->coeff[1] = (-30.0f * h + 16.0f * v0 * total + 3.0f * a0 * t2) / (2.0f * t3 * total);
+    instance->coeff[2] = (12.0f * h - 6.0f * v0 * total - a0 * t2) / (2.0f * t3 * t2);
+}
+
+/**
+ * @brief 检查当前系数下 S 曲线的速度、加速度、加加速度是否不超过限制
+ * @param instance 斜坡实例指针
+ * @param total 时长 s
+ * @return 1 不超限
+ */
+static int Ramp_S_Curve_Within_Limits(const RampInstance_s* instance, float total){
+    const float v0 = instance->start_vel;
+    const float a0 = instance->start_acc;
+    const float c3 = instance->coeff[0];
+    const float c4 = instance->coeff[1];
+    const float c5 = instance->coeff[2];
+    // 起点已超限时无法满足，以起点值为限
+    const float vel_limit = fmaxf(instance->max_vel, fabsf(v0)) * RAMP_S_CURVE_TOLERANCE;
+    const float acc_limit = fmaxf(instance->max_acc, fabsf(a0)) * RAMP_S_CURVE_TOLERANCE;
+    const float jerk_limit = instance->max_jerk * RAMP_S_CURVE_TOLERANCE;
+    for (int i = 0; i <= RAMP_S_CURVE_SAMPLES; i++){
+        const float t = total * (float)i / (float)RAMP_S_CURVE_SAMPLES;
+        const float vel = v0 + t * (a0 + t * (3.0f * c3 + t * (4.0f * c4 + t * 5.0f * c5)));
+        const float acc = a0 + t * (6.0f * c3 + t * (12.0f * c4 + t * 20.0f * c5));
+        const float jerk = 6.0f * c3 + t * (24.0f * c4 + t * 60.0f * c5);
+        if ((instance->max_vel > 0.0f && fabsf(vel) > vel_limit) ||
+            (instance->max_acc > 0.0f && fabsf(acc) > acc_limit) ||
+            (instance->max_jerk > 0.0f && fabsf(jerk) > jerk_limit)){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief S 曲线规划：起点接续当前速度、加速度，终点静止
+ * @note 起点静止时取满足全部限制的解析最短时长；否则从各限制给出的下界开始逐步延长到不超限为止
+ * @param instance 斜坡实例指针
+ * @param dist 起点到终点的距离
+ */
+static void Ramp_Plan_S_Curve(RampInstance_s* instance, float dist){
+    const float vel = instance->max_vel;
+    const float acc = instance->max_acc;
+    const float jerk = instance->max_jerk;
+    const float v0 = fabsf(instance->start_vel);
+    const float a0 = fabsf(instance->start_acc);
+    float t = 0.0f;
+    if (v0 <= 0.0f && a0 <= 0.0f){
+        if (vel > 0.0f){
+            t = RAMP_S_CURVE_VEL_PEAK * dist / vel;
+        }
+        if (acc > 0.0f){
+            t = fmaxf(t, sqrtf(RAMP_S_CURVE_ACC_PEAK * dist / acc));
+        }
+        if (jerk > 0.0f){
+            t = fmaxf(t, cbrtf(RAMP_S_CURVE_JERK_PEAK * dist / jerk));
+        }
+        if (t > 0.0f){
+            Ramp_S_Curve_Solve(instance, t);
+            instance->duration = t;
+        }
+        return;
+    }
+
+    if (vel > 0.0f){
+        t = dist / vel;
+    }
+    if (acc > 0.0f){
+        t = fmaxf(t, fmaxf(sqrtf(dist / acc), v0 / acc));
+    }
+    if (jerk > 0.0f){
+        t = fmaxf(t, fmaxf(cbrtf(dist / jerk), a0 / jerk));
+    }
+    if (t <= 0.0f){
+        return;
+    }
+    for (int i = 0; i < RAMP_S_CURVE_MAX_ITER; i++){
+        Ramp_S_Curve_Solve(instance, t);
+        if (Ramp_S_Curve_Within_Limits(instance, t)){
+            break;
+        }
+        t *= RAMP_S_CURVE_STRETCH;
+    }
+    Ramp_S_Curve_Solve(instance, t);
+    instance->duration = t;
+}
+
+/**
+ * @brief 根据起点、终点、起点速度和限制计算当前段的时长
+ * @param instance 斜坡实例指针
+ */
+static void Ramp_Plan(RampInstance_s* instance){
+    const float delta = instance->end_value - instance->start_value;
+    const float dist = fabsf(delta);
+    const float vel = instance->max_vel;
+    instance->duration = 0.0f;
+    instance->t_acc = 0.0f;
+    instance->t_dec = 0.0f;
+    instance->peak_vel = 0.0f;
+
+    switch (instance->profile){
+        case RAMP_TRAPEZOID:
+            if (instance->max_acc > 0.0f){
+                Ramp_Plan_Trapezoid(instance, delta);
+            } else if (vel > 0.0f){
+                // 未限制加速度时与匀速相同
+                instance->duration = dist / vel;
+            }
+            break;
+
+        case RAMP_LINEAR:
+            if (vel > 0.0f){
+                instance->duration = dist / vel;
+            }
+            break;
+
+        case RAMP_S_CURVE:
+            Ramp_Plan_S_Curve(instance, dist);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 计算当前段 elapsed 时刻的位置、速度和加速度
+ * @param instance 斜坡实例指针
+ */
+static void Ramp_Evaluate(RampInstance_s* instance){
+    const float t = instance->elapsed;
+    const float total = instance->duration;
+    if (t >= total){
+        instance->output_value = instance->end_value;
+        instance->output_vel = 0.0f;
+        instance->output_acc = 0.0f;
+        return;
+    }
+    const float delta = instance->end_value - instance->start_value;
+
+    if (instance->profile == RAMP_TRAPEZOID && instance->max_acc > 0.0f){
+        const float v0 = instance->start_vel;
+        const float t1 = instance->t_acc;
+        const float t3 = instance->t_dec;
+        if (t < t1){
+            const float acc = (instance->peak_vel - v0) / t1;
+            instance->output_acc = acc;
+            instance->output_vel = v0 + acc * t;
+            instance->output_value = instance->start_value + (v0 + 0.5f * acc * t) * t;
+        } else if (t < total - t3){
+            instance->output_acc = 0.0f;
+            instance->output_vel = instance->peak_vel;
+            instance->output_value = instance->start_value + 0.5f * (v0 + instance->peak_vel) * t1
+                                   + instance->peak_vel * (t - t1);
+        } else {
+            const float acc = instance->peak_vel / t3;
+            const float remain = total - t;
+            instance->output_acc = -acc;
+            instance->output_vel = acc * remain;
+            instance->output_value = instance->end_value - 0.5f * acc * remain * remain;
+        }
+    } else if (instance->profile == RAMP_S_CURVE){
+        const float v0 = instance->start_vel;
+        const float a0 = instance->start_acc;
+        const float c3 = instance->coeff[0];
+        const float c4 = instance->coeff[1];
+        const float c5 = instance->coeff[2];
+        instance->output_value = instance->start_value + t * (v0 + t * (0.5f * a0 + t * (c3 + t * (c4 + t * c5))));
+        instance->output_vel = v0 + t * (a0 + t * (3.0f * c3 + t * (4.0f * c4 + t * 5.0f * c5)));
+        instance->output_acc = a0 + t * (6.0f * c3 + t * (12.0f * c4 + t * 20.0f * c5));
+    } else {
+        instance->output_acc = 0.0f;
+        instance->output_vel = delta / total;
+        instance->output_value = instance->start_value + instance->output_vel * t;
+    }
+}
+
+/**
+ * @brief 斜坡初始化
+ * @param instance 斜坡实例指针
+ * @param config 初始化配置
+ */
+void Ramp_Init(RampInstance_s* instance, const RampInitConfig_s* config){
+    if (instance == NULL || config == NULL){
+        return;
+    }
+    instance->profile = config->profile;
+    instance->max_vel = config->max_vel;
+    instance->max_acc = config->max_acc;
+    instance->max_jerk = config->max_jerk;
+    Ramp_Reset(instance, config->init_value);
+}
+
+/**
+ * @brief 立即将输出设为指定值并停止运动
+ * @param instance 斜坡实例指针
+ * @param value 输出值
+ */
+void Ramp_Reset(RampInstance_s* instance, float value){
+    if (instance == NULL){
+        return;
+    }
+    instance->start_value = value;
+    instance->end_value = value;
+    instance->start_vel = 0.0f;
+    instance->start_acc = 0.0f;
+    instance->duration = 0.0f;
+    instance->t_acc = 0.0f;
+    instance->t_dec = 0.0f;
+    instance->peak_vel = 0.0f;
+    instance->elapsed = 0.0f;
+    instance->output_value = value;
+    instance->output_vel = 0.0f;
+    instance->output_acc = 0.0f;
+    instance->last_cycle = Dwt_Get_Cycle();
+}
+
+/**
+ * @brief 更新目标值，目标改变时从当前输出值和速度重新规划，不重置计时
+ * @note last_cycle 只由 Ramp_Read 推进，每周期先更新目标再读取时，
+ *       上次读取到本次读取之间的时间仍计入新的一段
+ * @param instance 斜坡实例指针
+ * @param target 目标值
+ */
+void Ramp_Update(RampInstance_s* instance, float target){
+    if (instance == NULL || target == instance->end_value){
+        return;
+    }
+    instance->start_value = instance->output_value;
+    instance->start_vel = instance->output_vel;
+    instance->start_acc = instance->output_acc;
+    instance->end_value = target;
+    instance->elapsed = 0.0f;
+    Ramp_Plan(instance);
+    if (instance->duration <= 0.0f){
+        instance->output_value = target;
+        instance->output_vel = 0.0f;
+        instance->output_acc = 0.0f;
+    }
+}
+
+/**
+ * @brief 按给定时间步长推进，不读取 DWT
+ * @param instance 斜坡实例指针
+ * @param dt 时间步长 s
+ * @return 当前输出值
+ */
+float Ramp_Step(RampInstance_s* instance, float dt){
+    if (instance == NULL){
+        return 0.0f;
+    }
+    if (instance->elapsed < instance->duration){
+        instance->elapsed += (dt > 0.0f) ? dt : 0.0f;
+        Ramp_Evaluate(instance);
+    }
+    return instance->output_value;
+}
+
+/**
+ * @brief 按 DWT 计时推进并读取输出
+ * @param instance 斜坡实例指针
+ * @return 当前输出值
+ */
+float Ramp_Read(RampInstance_s* instance){
+    if (instance == NULL){
+        return 0.0f;
+    }
+    const uint32_t now = Dwt_Get_Cycle();
+    const float dt = Dwt_Cycle_To_S(now - instance->last_cycle);
+    instance->last_cycle = now;
+    return Ramp_Step(instance, dt);
+}
+
+/**
+ * @brief 多个斜坡共用同一时间戳推进，适用于多轴同步输出
+ * @param instances 斜坡实例指针数组
+ * @param output 输出值数组，可为NULL
+ * @param count 实例数量
+ */
+void Ramp_Read_Batch(RampInstance_s* const instances[], float* output, uint8_t count){
+    if (instances == NULL){
+        return;
+    }
+    const uint32_t now = Dwt_Get_Cycle();
+    for (uint8_t i = 0; i < count; i++){
+        RampInstance_s* instance = instances[i];
+        if (instance == NULL){
+            continue;
+        }
+        const float dt = Dwt_Cycle_To_S(now - instance->last_cycle);
+        instance->last_cycle = now;
+        const float value = Ramp_Step(instance, dt);
+        if (output != NULL){
+            output[i] = value;
+        }
+    }
+}
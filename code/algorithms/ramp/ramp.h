@@ -0,0 +1,108 @@
+/**
+ * @file ramp.h
+ * @brief 基于时间戳的斜坡/轨迹发生器
+ * @note 输出按 DWT 计时的实际经过时间推进，与调用周期无关，任务调度抖动不会使斜坡变形。
+ *       每次目标改变时从当前输出值和输出速度重新规划一段到目标处静止的轨迹，运动中改变目标时速度连续：
+ *       - RAMP_LINEAR     匀速，时长 = 距离 / max_vel，速度直接跳变
+ *       - RAMP_TRAPEZOID  梯形速度，受 max_vel、max_acc 限制，距离不足时退化为三角形，
+ *                         当前速度朝反方向或来不及刹停时先减速再折返
+ *       - RAMP_S_CURVE    五次多项式，起点接续当前速度、加速度，终点速度、加速度为零，
+ *                         速度、加速度、加加速度均不超过限制(起点已超限时以起点值为限)
+ *       限制值 <= 0 表示不限制。两次 Ramp_Read 的间隔不能超过 DWT 溢出周期(480MHz 时约 8.9s)。
+ */
+#ifndef RAMP_H
+#define RAMP_H
+
+#include <stdint.h>
+
+/**
+ * @brief 轨迹类型
+ */
+typedef enum {
+    RAMP_LINEAR = 0,        // 匀速
+    RAMP_TRAPEZOID = 1,     // 梯形速度
+    RAMP_S_CURVE = 2        // 五次多项式 S 曲线
+} RampProfile_e;
+
+/**
+ * @brief 斜坡实例结构体
+ */
+typedef struct {
+    RampProfile_e profile;  // 轨迹类型
+    float max_vel;          // 最大速度，单位/s
+    float max_acc;          // 最大加速度，单位/s^2
+    float max_jerk;         // 最大加加速度，单位/s^3，仅 S 曲线使用
+
+    float start_value;      // 当前段起点
+    float end_value;        // 当前段终点(目标值)
+    float duration;         // 当前段总时长 s
+    float start_vel;        // 当前段起点速度
+    float start_acc;        // 当前段起点加速度，仅 S 曲线使用
+    float t_acc;            // 梯形第一段(起点速度到巡航速度)时长 s
+    float t_dec;            // 梯形减速段时长 s
+    float peak_vel;         // 梯形巡航速度，带符号
+    float coeff[3];         // S 曲线 t^3、t^4、t^5 项系数
+    float elapsed;          // 当前段已运行时间 s
+    uint32_t last_cycle;    // 上次推进时的 DWT 计数值
+
+    float output_value;     // 输出值
+    float output_vel;       // 输出速度，可作为前馈
+    float output_acc;       // 输出加速度
+} RampInstance_s;
+
+/**
+ * @brief 斜坡初始化配置
+ */
+typedef struct {
+    RampProfile_e profile;  // 轨迹类型
+    float max_vel;          // 最大速度，单位/s
+    float max_acc;          // 最大加速度，单位/s^2，梯形和 S 曲线使用
+    float max_jerk;         // 最大加加速度，单位/s^3，S 曲线使用
+    float init_value;       // 初始输出值
+} RampInitConfig_s;
+
+/**
+ * @brief 斜坡初始化
+ * @param instance 斜坡实例指针
+ * @param config 初始化配置
+ */
+void Ramp_Init(RampInstance_s* instance, const RampInitConfig_s* config);
+
+/**
+ * @brief 立即将输出设为指定值并停止运动
+ * @param instance 斜坡实例指针
+ * @param value 输出值
+ */
+void Ramp_Reset(RampInstance_s* instance, float value);
+
+/**
+ * @brief 更新目标值，目标改变时从当前输出值和速度重新规划，不重置计时
+ * @param instance 斜坡实例指针
+ * @param target 目标值
+ */
+void Ramp_Update(RampInstance_s* instance, float target);
+
+/**
+ * @brief 按给定时间步长推进，不读取 DWT
+ * @param instance 斜坡实例指针
+ * @param dt 时间步长 s
+ * @return 当前输出值
+ */
+float Ramp_Step(RampInstance_s* instance, float dt);
+
+/**
+ * @brief 按 DWT 计时推进并读取输出
+ * @param instance 斜坡实例指针
+ * @return 当前输出值
+ */
+float Ramp_Read(RampInstance_s* instance);
+
+/**
+ * @brief 多个斜坡共用同一时间戳推进，适用于多轴同步输出
+ * @param instances 斜坡实例指针数组
+ * @param output 输出值数组，可为NULL
+ * @param count 实例数量
+ */
+void Ramp_Read_Batch(RampInstance_s* const instances[], float* output, uint8_t count);
+
+#endif // RAMP_H
@@ -0,0 +1,219 @@
+#include "otg.h"
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+/**
+ * @brief 单轴运动状态
+ */
+typedef struct {
+    float p;    // 位置
+    float v;    // 速度
+    float a;    // 加速度
+} OtgState_s;
+
+/**
+ * @brief 以恒定加加速度运动一段时间
+ * @param s 状态
+ * @param j 加加速度
+ * @param t 时间
+ */
+static inline void Otg_Segment(OtgState_s* s, float j, float t){
+    s->p += t * (s->v + t * (0.5f * s->a + t * j * (1.0f / 6.0f)));
+    s->v += t * (s->a + 0.5f * t * j);
+    s->a += t * j;
+}
+
+/**
+ * @brief 沿时间最优速度曲线运动，到达目标速度后匀速
+ * @param s 状态
+ * @param v_target 目标速度
+ * @param t 运动时间
+ * @param max_acc 最大加速度
+ * @param max_jerk 最大加加速度
+ * @note 速度曲线：加加速度 +J 到加速度 ap，保持 ap，加加速度 -J 到加速度为零（方向按需取反），ap <= max_acc
+ */
+static void Otg_Vel_Profile(OtgState_s* s, float v_target, float t, float max_acc, float max_jerk){
+    // 先把加速度降到零时的速度决定方向
+    const float v_zero_acc = s->v + s->a * fabsf(s->a) / (2.0f * max_jerk);
+    const float dir = (v_target >= v_zero_acc) ? 1.0f : -1.0f;
+    const float a0 = dir * s->a;
+    const float dv = dir * (v_target - s->v);
+
+    float peak = sqrtf(fmaxf(max_jerk * dv + 0.5f * a0 * a0, 0.0f));
+    float t_hold = 0.0f;
+    if (peak > max_acc){
+        peak = max_acc;
+        t_hold = fmaxf((dv - max_acc * max_acc / max_jerk + 0.5f * a0 * a0 / max_jerk) / max_acc, 0.0f);
+    }
+    const float t_rise = fmaxf((peak - a0) / max_jerk, 0.0f);
+
+    float step = fminf(t, t_rise);
+    Otg_Segment(s, dir * max_jerk, step);
+    t -= step;
+    step = fminf(t, t_hold);
+    Otg_Segment(s, 0.0f, step);
+    t -= step;
+    if (t <= 0.0f){
+        return;
+    }
+    const float t_fall = fmaxf(dir * s->a / max_jerk, 0.0f);
+    if (t < t_fall){
+        Otg_Segment(s, -dir * max_jerk, t);
+        return;
+    }
+    Otg_Segment(s, -dir * max_jerk, t_fall);
+    t -= t_fall;
+    // 曲线结束，消除累计误差后匀速
+    s->v = v_target;
+    s->a = 0.0f;
+    if (v_target != 0.0f){
+        s->p += v_target * t;
+    }
+}
+
+/**
+ * @brief 按时间最优刹车曲线把速度和加速度都降到零后停下的位置
+ * @param s 状态
+ * @param max_acc 最大加速度
+ * @param max_jerk 最大加加速度
+ * @return 停止位置
+ */
+static float Otg_Stop_Position(const OtgState_s* s, float max_acc, float max_jerk){
+    OtgState_s stop = *s;
+    Otg_Vel_Profile(&stop, 0.0f, FLT_MAX, max_acc, max_jerk);
+    return stop.p;
+}
+
+/**
+ * @brief 初始化轨迹生成器
+ * @param instance 实例指针
+ * @param config 初始化配置
+ */
+void Otg_Init(OtgInstance_s* instance, const OtgInitConfig_s* config){
+    if (instance == NULL || config == NULL){
+        return;
+    }
+    Otg_Set_Limits(instance, config->max_vel, config->max_acc, config->max_jerk);
+    instance->target = config->init_pos;
+    Otg_Reset(instance, config->init_pos, 0.0f, 0.0f);
+}
+
+/**
+ * @brief 设置当前状态，例如使能电机时从实际位置和速度开始
+ * @param instance 实例指针
+ * @param pos 位置
+ * @param vel 速度
+ * @param acc 加速度
+ */
+void Otg_Reset(OtgInstance_s* instance, float pos, float vel, float acc){
+    if (instance == NULL){
+        return;
+    }
+    instance->pos = pos;
+    instance->error = pos - instance->target;
+    instance->vel = vel;
+    instance->acc = acc;
+    instance->jerk = 0.0f;
+    instance->reached = 0;
+}
+
+/**
+ * @brief 修改限制，下一周期生效
+ * @param instance 实例指针
+ * @param max_vel 最大速度
+ * @param max_acc 最大加速度
+ * @param max_jerk 最大加加速度
+ */
+void Otg_Set_Limits(OtgInstance_s* instance, float max_vel, float max_acc, float max_jerk){
+    if (instance == NULL){
+        return;
+    }
+    // 限制必须为正，否则无法刹停
+    instance->max_vel = fmaxf(max_vel, FLT_MIN);
+    instance->max_acc = fmaxf(max_acc, FLT_MIN);
+    instance->max_jerk = fmaxf(max_jerk, FLT_MIN);
+    instance->reached = 0;
+}
+
+/**
+ * @brief 设置目标位置，下一周期按新目标重新规划
+ * @param instance 实例指针
+ * @param target 目标位置
+ */
+void Otg_Set_Target(OtgInstance_s* instance, float target){
+    if (instance == NULL || target == instance->target){
+        return;
+    }
+    instance->target = target;
+    instance->error = instance->pos - target;
+    instance->reached = 0;
+}
+
+/**
+ * @brief 推进一个控制周期
+ * @param instance 实例指针
+ * @param dt 周期 s
+ * @return 位置设定值
+ */
+float Otg_Update(OtgInstance_s* instance, float dt){
+    if (instance == NULL){
+        return 0.0f;
+    }
+    if (instance->reached || dt <= 0.0f){
+        return instance->pos;
+    }
+    const float max_jerk = instance->max_jerk;
+
+    // 剩余误差小于一个周期内能产生的运动量时直接停在目标处，速度、加速度的跳变不超过限制
+    const float eps_a = max_jerk * dt;
+    const float eps_v = fminf(eps_a, instance->max_acc) * dt;
+    const float eps_p = eps_v * dt;
+    if (fabsf(instance->error) <= eps_p && fabsf(instance->vel) <= eps_v && fabsf(instance->acc) <= eps_a){
+        instance->error = 0.0f;
+        instance->pos = instance->target;
+        instance->vel = 0.0f;
+        instance->acc = 0.0f;
+        instance->jerk = 0.0f;
+        instance->reached = 1;
+        return instance->pos;
+    }
+
+    // 换算到目标位于原点、需要运动的方向为正的坐标系
+    OtgState_s s = {instance->error, instance->vel, instance->acc};
+    const float dir = (Otg_Stop_Position(&s, instance->max_acc, max_jerk) <= 0.0f) ? 1.0f : -1.0f;
+    s.p *= dir;
+    s.v *= dir;
+    s.a *= dir;
+
+    // 先沿加速曲线运动 t_acc，再沿刹车曲线运动剩余时间；取仍能停在目标处的最大 t_acc
+    // 沿刹车曲线运动不改变停止位置，停止位置随 t_acc 单调增加
+    const float last_acc = s.a;
+    OtgState_s next = s;
+    Otg_Vel_Profile(&next, instance->max_vel, dt, instance->max_acc, max_jerk);
+    if (Otg_Stop_Position(&next, instance->max_acc, max_jerk) > 0.0f){
+        float lo = 0.0f;
+        float hi = dt;
+        for (uint8_t i = 0; i < OTG_SEARCH_ITER; i++){
+            const float mid = 0.5f * (lo + hi);
+            next = s;
+            Otg_Vel_Profile(&next, instance->max_vel, mid, instance->max_acc, max_jerk);
+            if (Otg_Stop_Position(&next, instance->max_acc, max_jerk) <= 0.0f){
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        next = s;
+        Otg_Vel_Profile(&next, instance->max_vel, lo, instance->max_acc, max_jerk);
+        Otg_Vel_Profile(&next, 0.0f, dt - lo, instance->max_acc, max_jerk);
+    }
+    s = next;
+
+    instance->jerk = dir * (s.a - last_acc) / dt;
+    instance->error = dir * s.p;
+    instance->pos = instance->target + instance->error;
+    instance->vel = dir * s.v;
+    instance->acc = dir * s.a;
+    return instance->pos;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file otg.h
+ * @brief 加加速度受限的在线轨迹生成器(Online Trajectory Generator)
+ * @note 每个控制周期从当前状态(位置、速度、加速度)出发重新决策，目标可以随时改变。
+ *       每个周期内先沿受速度限制的加速曲线运动 t_acc，再沿刹车曲线运动剩余时间，
+ *       t_acc 取仍能以 max_jerk、max_acc 刹停在目标处的最大值，周期内的切换点精确计算，
+ *       静止到静止时即为时间最优的七段 S 曲线。
+ *       加加速度只取 0 和 ±max_jerk，速度、加速度不超过限制（初始状态可行时）。
+ *       每次更新的计算量固定（二分次数固定为 OTG_SEARCH_ITER），不分配内存。
+ *       输出的 vel、acc 可作为速度环和力矩前馈。位置必须是连续量，yaw 等角度需要先展开。
+ */
+#ifndef OTG_H
+#define OTG_H
+
+#include <stdint.h>
+
+#define OTG_SEARCH_ITER 16  // 每周期二分搜索切换时刻的次数
+
+/**
+ * @brief 轨迹生成器实例结构体
+ */
+typedef struct {
+    float max_vel;      // 最大速度，单位/s
+    float max_acc;      // 最大加速度，单位/s^2
+    float max_jerk;     // 最大加加速度，单位/s^3
+
+    float target;       // 目标位置
+    float error;        // 位置设定值 - 目标位置，在目标附近保持精度
+
+    float pos;          // 位置设定值
+    float vel;          // 速度设定值(前馈)
+    float acc;          // 加速度设定值(前馈)
+    float jerk;         // 本周期平均加加速度
+    uint8_t reached;    // 已停在目标位置
+} OtgInstance_s;
+
+/**
+ * @brief 轨迹生成器初始化配置
+ */
+typedef struct {
+    float max_vel;      // 最大速度，单位/s，必须 > 0
+    float max_acc;      // 最大加速度，单位/s^2，必须 > 0
+    float max_jerk;     // 最大加加速度，单位/s^3，必须 > 0
+    float init_pos;     // 初始位置，同时作为初始目标
+} OtgInitConfig_s;
+
+/**
+ * @brief 初始化轨迹生成器
+ * @param instance 实例指针
+ * @param config 初始化配置
+ */
+void Otg_Init(OtgInstance_s* instance, const OtgInitConfig_s* config);
+
+/**
+ * @brief 设置当前状态，例如使能电机时从实际位置和速度开始
+ * @param instance 实例指针
+ * @param pos 位置
+ * @param vel 速度
+ * @param acc 加速度
+ */
+void Otg_Reset(OtgInstance_s* instance, float pos, float vel, float acc);
+
+/**
+ * @brief 修改限制，下一周期生效
+ * @param instance 实例指针
+ * @param max_vel 最大速度
+ * @param max_acc 最大加速度
+ * @param max_jerk 最大加加速度
+ */
+void Otg_Set_Limits(OtgInstance_s* instance, float max_vel, float max_acc, float max_jerk);
+
+/**
+ * @brief 设置目标位置，下一周期按新目标重新规划
+ * @param instance 实例指针
+ * @param target 目标位置
+ */
+void Otg_Set_Target(OtgInstance_s* instance, float target);
+
+/**
+ * @brief 推进一个控制周期
+ * @param instance 实例指针
+ * @param dt 周期 s
+ * @return 位置设定值
+ */
+float Otg_Update(OtgInstance_s* instance, float dt);
+
+#endif // OTG_H
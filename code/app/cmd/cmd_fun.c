@@ -1,34 +1,76 @@
 #include "cmd_fun.h"
-#include "fs_i6x.h"
+#include "remote_control.h"
 #include "basic_math.h"
 #include "cmsis_os.h"
 #include "bmi088.h"
+#include "imu_calib.h"
 #include "bsp_dwt.h"
 #include "plf_log.h"
+#include "memory_management.h"
+#include "robot_config.h"
 RcCmd_s rc_cmd;
-I6xInstance_s* i6x;
+RcInstance_s* rc;
 float accel_data[3];
 float gyro_data[3];
 float temperature;
-extern Bmi088Instance_s *bmi088_Instance;
+Bmi088Instance_s* imu;
+ImuCalib_s* imu_calib;
+static Bmi088Sample_s imu_samples[BMI088_SAMPLE_QUEUE_LEN * BMI088_SAMPLE_TYPE_CNT];
 void USER_CMD_Init(void)
 {
     Log_Init();
     Dwt_Init();
-    BMI088_init();
-    // i6x = I6x_Register(&huart5);
+    Bmi088InitConfig_s imu_config;
+    Bmi088_Default_Config(&imu_config, SPI_IMU_HANDLE);
+    imu = Bmi088_Register(&imu_config);
+    if (imu != NULL && !Bmi088_Start_Sampling(imu)){
+        Log_Error("IMU Start Sampling Failed");
+    }
+    if (imu != NULL){
+        // 上电静止采集陀螺仪零偏，之后静止时跟踪零偏温漂
+        ImuCalibInitConfig_s calib_config = {.imu = imu, .boot_gyro_calib = true, .temp_tracking = true};
+        imu_calib = Imu_Calib_Register(&calib_config);
+    }
+    // 失控保护时开关全部为 RC_SW_UP，即 CMD_DISABLE
+    RcInitConfig_s rc_config = {.type = RC_DEFAULT_TYPE, .huart = &RC_UART_HANDLE};
+    rc = Rc_Register(&rc_config);
+    Memory_Log_Stat();
+}
+
+/**
+ * @brief 取出 IMU 中断采样的样本，保存每个传感器最新的校准后物理量，同时推进校准
+ */
+static void Imu_Read(void){
+    if (imu_calib == NULL){
+        return;
+    }
+    const uint32_t n = Bmi088_Pop_Samples(imu, imu_samples, BMI088_SAMPLE_QUEUE_LEN * BMI088_SAMPLE_TYPE_CNT);
+    for (uint32_t i = 0; i < n; i++){
+        const Bmi088Sample_s* sample = &imu_samples[i];
+        if (sample->type == BMI088_SAMPLE_GYRO){
+            Imu_Calib_Correct_Sample(imu_calib, sample, gyro_data);
+        } else {
+            Imu_Calib_Correct_Sample(imu_calib, sample, accel_data);
+            temperature = sample->temperate;
+        }
+        Imu_Calib_Feed_Sample(imu_calib, sample);
+    }
 }
 
 void Cmd_Read(void){
-    rc_cmd.data.x_val = Ramp_Read(&i6x->data.rc_data.x_ramp);
-    rc_cmd.data.y_val = Ramp_Read(&i6x->data.rc_data.y_ramp);
-    rc_cmd.data.pitch_pos = Ramp_Read(&i6x->data.rc_data.pitch_ramp);
-    rc_cmd.data.yaw_pos = Ramp_Read(&i6x->data.rc_data.yaw_ramp);
-    rc_cmd.data.fine_yaw_pos = Ramp_Read(&i6x->data.rc_data.fine_yaw);
-    rc_cmd.data.fine_pitch_pos = Ramp_Read(&i6x->data.rc_data.fine_pitch);
-    rc_cmd.state.cmd_state = i6x->data.sw.b;
-    rc_cmd.state.chassis_state = i6x->data.sw.c;
-    rc_cmd.state.gimbal_state = i6x->data.sw.d;
+    const RcCommand_s* cmd = Rc_Get_Command(rc);
+    if (cmd == NULL){
+        return;
+    }
+    rc_cmd.data.x_val = cmd->axis[RC_AXIS_RIGHT_X] * CMD_JOY_TO_VAL;
+    rc_cmd.data.y_val = cmd->axis[RC_AXIS_RIGHT_Y] * CMD_JOY_TO_VAL;
+    rc_cmd.data.pitch_pos = cmd->axis[RC_AXIS_LEFT_Y] * CMD_JOY_TO_RAD;
+    rc_cmd.data.yaw_pos = cmd->axis[RC_AXIS_LEFT_X] * CMD_JOY_TO_RAD;
+    rc_cmd.data.fine_yaw_pos = cmd->axis[RC_AXIS_AUX_B] * CMD_JOY_TO_RAD;
+    rc_cmd.data.fine_pitch_pos = cmd->axis[RC_AXIS_AUX_A] * CMD_JOY_TO_RAD;
+    rc_cmd.state.cmd_state = (CmdState_e)cmd->sw[RC_SWITCH_ENABLE];
+    rc_cmd.state.chassis_state = (ChassisState_e)cmd->sw[RC_SWITCH_CHASSIS];
+    rc_cmd.state.gimbal_state = (GimbalState_e)cmd->sw[RC_SWITCH_GIMBAL];
 }
 
 /* USER CODE BEGIN Header_cmd_task */
@@ -44,8 +86,8 @@ void Cmd_Read(void){
     /* Infinite loop */
     for(;;)
     {
-        Bmi088_read(gyro_data, accel_data, &temperature);
-        // Cmd_Read();
+        Imu_Read();
+        Cmd_Read();
         osDelay(1);
     }
     /* USER CODE END cmd_task */
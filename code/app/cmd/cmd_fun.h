@@ -2,6 +2,8 @@
 #define CMD_FUN_H
 #include "basic_math.h"
 
+#define CMD_JOY_TO_VAL 660.0f   // 摇杆满偏对应的速度指令
+#define CMD_JOY_TO_RAD 2.6447f  // 摇杆满偏对应的角度指令，单位rad (660 * PI / 784)
 
 typedef enum{
     CMD_DISABLE = 0,
@@ -1,7 +1,7 @@
 /**
  * @file bmi088.c
  * @brief BMI088 6轴IMU传感器驱动实现文件
- * @details 实现BMI088加速度计和陀螺仪的初始化、配置和数据读取功能
+ * @details 实现BMI088加速度计和陀螺仪的初始化、配置、自测试和数据读取功能
  * @author Embedded Framework Team
  * @date 2025
  * @version 1.0
@@ -15,175 +15,107 @@
 #include "plf_log.h"
 #include "string.h"
 #include "robot_config.h"
+#include "bsp_dwt.h"
 
-/* ========================= 全局变量定义 ========================= */
+/* ========================= 宏定义 ========================= */
 
-float BMI088_ACCEL_SEN = BMI088_ACCEL_3G_SEN; /**< 加速度计灵敏度系数 */
-float BMI088_GYRO_SEN = BMI088_GYRO_2000_SEN; /**< 陀螺仪灵敏度系数 */
-static Bmi088Instance_s* bmi088; /**< BMI088实例指针 */
+#define BMI088_ENTER_CRITICAL()  uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define BMI088_EXIT_CRITICAL()   __set_PRIMASK(primask)
 
-/* ========================= 私有函数实现 ========================= */
+/* 加速度计突发读取：地址 + 空字节 + 0x12~0x23（加速度、传感器时间、温度） */
+#define BMI088_ACCEL_BURST_LEN (2u + BMI088_TEMP_L - BMI088_ACCEL_XOUT_L + 1u)
+/* 陀螺仪突发读取：地址 + 0x02~0x07 */
+#define BMI088_GYRO_BURST_LEN  (1u + 6u)
 
-/**
- * @brief BMI088微秒级延时函数
- * @param us 要延时的微秒数
- * @details 使用SysTick定时器实现精确的微秒级延时
- * @note 基于480MHz系统时钟计算
- */
-static void BMI088_delay_us(uint16_t us)
-{
-    uint32_t ticks = 0; // 需要的时钟周期数
-    uint32_t told = 0; // 上一次的计数值
-    uint32_t tnow = 0; // 当前的计数值
-    uint32_t tcnt = 0; // 累计的时钟周期
-    uint32_t reload = 0; // 重载值
+/* 加速度计读取长度阶段：地址 + 空字节 + 0x22~0x25（温度、FIFO 长度） */
+#define BMI088_FIFO_ACCEL_LEVEL_LEN (2u + BMI088_ACC_FIFO_LENGTH_1 - BMI088_TEMP_M + 1u)
+/* 陀螺仪读取长度阶段：地址 + FIFO_STATUS */
+#define BMI088_FIFO_GYRO_LEVEL_LEN  2u
+/* 数据阶段缓冲区：地址(+空字节) + 整个 FIFO */
+#define BMI088_FIFO_ACCEL_BUF_LEN   (2u + BMI088_ACC_FIFO_SIZE)
+#define BMI088_FIFO_GYRO_BUF_LEN    (1u + BMI088_GYRO_FIFO_SIZE * BMI088_GYRO_FIFO_FRAME_LEN)
+/* 帧周期估计：低通系数，单次测量与标称值偏差上限 */
+#define BMI088_FIFO_PERIOD_GAIN     0.1f
+#define BMI088_FIFO_PERIOD_TOL      0.05f
 
-    reload = SysTick->LOAD; // 获取SysTick重载值
-    ticks = us * 480; // 计算需要的时钟周期(480MHz)
-    told = SysTick->VAL; // 获取当前计数值
+/* 自测试在 ±24g 下进行，1LSB = 24000mg / 32768 */
+#define BMI088_SELF_TEST_MG_PER_LSB (24000.0f / 32768.0f)
 
-    while (1)
-    {
-        tnow = SysTick->VAL; // 获取新的计数值
-        if (tnow != told)
-        {
-            if (tnow < told) // 正常递减
-            {
-                tcnt += told - tnow;
-            }
-            else // 发生溢出
-            {
-                tcnt += reload - tnow + told;
-            }
-            told = tnow;
-            if (tcnt >= ticks) // 达到目标时钟周期
-            {
-                break;
-            }
-        }
-    }
-}
+/* ========================= 配置选项表 ========================= */
 
 /**
- * @brief BMI088毫秒级延时函数
- * @param ms 要延时的毫秒数
- * @details 延时指定毫秒数，通过微秒延时实现
+ * @brief 配置选项：寄存器值及其对应的灵敏度或输出数据率
  */
-static void BMI088_delay_ms(uint16_t ms)
+typedef struct
 {
-    while (ms--)
-    {
-        BMI088_delay_us(1000); // 调用微秒延时实现毫秒延时
-    }
-}
+    uint8_t reg;    /**< 写入寄存器的值 */
+    float value;    /**< 量程选项为灵敏度，输出数据率选项为频率(Hz) */
+} Bmi088Option_s;
 
-/**
- * @brief BMI088内部注册函数
- * @param config BMI088初始化配置结构体指针
- * @return BMI088实例指针，注册成功返回实例指针，失败返回NULL
- * @details 根据配置参数创建BMI088实例，并注册加速度计和陀螺仪SPI接口
- */
-Bmi088Instance_s* Bmi088_Internal_Register(Bmi088InitConfig_s* config)
+/** 加速度计量程，按 Bmi088AccelRange_e 排列 */
+static const Bmi088Option_s bmi088_accel_range[BMI088_ACCEL_RANGE_CNT] =
 {
-    if (config == NULL)
-    {
-        Log_Error("Bmi088_Internal_Register : config is NULL");
-        return NULL;
-    }
-
-    // 分配内存给BMI088实例
-    Bmi088Instance_s* instance = user_malloc(sizeof(Bmi088Instance_s));
-    if (instance == NULL)
-    {
-        Log_Error("Bmi088_Internal_Register : instance Malloc Failed");
-        return NULL;
-    }
-
-    memset(instance, 0, sizeof(Bmi088Instance_s));
-
-    // 注册加速度计和陀螺仪SPI接口
-    instance->accel = Spi_Register(&config->accel);
-    instance->gyro = Spi_Register(&config->gyro);
-
-    if (instance->accel == NULL || instance->gyro == NULL)
-    {
-        Log_Error("Bmi088_Internal_Register : Spi_accel or Spi_gyro Malloc Failed");
-        user_free(instance);
-        return NULL;
-    }
-
-    return instance;
-}
+    {BMI088_ACC_RANGE_3G, BMI088_ACCEL_3G_SEN},
+    {BMI088_ACC_RANGE_6G, BMI088_ACCEL_6G_SEN},
+    {BMI088_ACC_RANGE_12G, BMI088_ACCEL_12G_SEN},
+    {BMI088_ACC_RANGE_24G, BMI088_ACCEL_24G_SEN},
+};
 
-/**
- * @brief BMI088注册函数
- * @param spi_handle_number SPI句柄编号
- * @return BMI088实例指针，注册成功返回实例指针，失败返回NULL
- * @details 使用默认配置参数创建BMI088实例，自动配置加速度计和陀螺仪SPI接口
- */
-Bmi088Instance_s* Bmi088_Register(uint8_t spi_handle_number)
+/** 加速度计输出数据率，按 Bmi088AccelOdr_e 排列 */
+static const Bmi088Option_s bmi088_accel_odr[BMI088_ACCEL_ODR_CNT] =
 {
-    // 分配配置结构体内存
-    Bmi088InitConfig_s* config = user_malloc(sizeof(Bmi088InitConfig_s));
-    if (config == NULL)
-    {
-        Log_Error("Bmi088_Register : config is NULL");
-        return NULL;
-    }
-
-    memset(config, 0, sizeof(Bmi088InitConfig_s));
-
-    // 配置加速度计SPI参数
-    config->accel.topic_name = "BMI088_ACCEL_SPI";
-    config->accel.spi_handle_number = spi_handle_number;
-    config->accel.mode = BLOCK_MODE;
-    config->accel.timeout = 1000;
-    config->accel.cs_port = ACC_CS_GPIO_Port;
-    config->accel.cs_pin = ACC_CS_Pin;
-
-    // 配置陀螺仪SPI参数
-    config->gyro.topic_name = "BMI088_GYRO_SPI";
-    config->gyro.spi_handle_number = spi_handle_number;
-    config->gyro.mode = BLOCK_MODE;
-    config->gyro.timeout = 1000;
-    config->gyro.cs_port = GYRO_CS_GPIO_Port;
-    config->gyro.cs_pin = GYRO_CS_Pin;
-
-    // 分配实例内存
-    Bmi088Instance_s* instance = user_malloc(sizeof(Bmi088Instance_s));
-    if (instance == NULL)
-    {
-        Log_Error("Bmi088_Register : instance Malloc Failed");
-        user_free(config);
-        return NULL;
-    }
+    {BMI088_ACC_12_5_HZ, 12.5f},
+    {BMI088_ACC_25_HZ, 25.0f},
+    {BMI088_ACC_50_HZ, 50.0f},
+    {BMI088_ACC_100_HZ, 100.0f},
+    {BMI088_ACC_200_HZ, 200.0f},
+    {BMI088_ACC_400_HZ, 400.0f},
+    {BMI088_ACC_800_HZ, 800.0f},
+    {BMI088_ACC_1600_HZ, 1600.0f},
+};
 
-    memset(instance, 0, sizeof(Bmi088Instance_s));
+/** 加速度计带宽，按 Bmi088AccelBwp_e 排列 */
+static const uint8_t bmi088_accel_bwp[BMI088_ACCEL_BWP_CNT] =
+{
+    BMI088_ACC_OSR4,
+    BMI088_ACC_OSR2,
+    BMI088_ACC_NORMAL,
+};
 
-    // 注册加速度计和陀螺仪SPI接口
-    instance->accel = Spi_Register(&config->accel);
-    instance->gyro = Spi_Register(&config->gyro);
+/** 陀螺仪量程，按 Bmi088GyroRange_e 排列 */
+static const Bmi088Option_s bmi088_gyro_range[BMI088_GYRO_RANGE_CNT] =
+{
+    {BMI088_GYRO_2000, BMI088_GYRO_2000_SEN},
+    {BMI088_GYRO_1000, BMI088_GYRO_1000_SEN},
+    {BMI088_GYRO_500, BMI088_GYRO_500_SEN},
+    {BMI088_GYRO_250, BMI088_GYRO_250_SEN},
+    {BMI088_GYRO_125, BMI088_GYRO_125_SEN},
+};
 
-    if (instance->accel == NULL || instance->gyro == NULL)
-    {
-        Log_Error("Bmi088_Register : Spi_accel or Spi_gyro Malloc Failed");
-        user_free(instance);
-        user_free(config);
-        return NULL;
-    }
+/** 陀螺仪输出数据率和带宽，按 Bmi088GyroOdr_e 排列 */
+static const Bmi088Option_s bmi088_gyro_odr[BMI088_GYRO_ODR_CNT] =
+{
+    {BMI088_GYRO_2000_532_HZ, 2000.0f},
+    {BMI088_GYRO_2000_230_HZ, 2000.0f},
+    {BMI088_GYRO_1000_116_HZ, 1000.0f},
+    {BMI088_GYRO_400_47_HZ, 400.0f},
+    {BMI088_GYRO_200_23_HZ, 200.0f},
+    {BMI088_GYRO_100_12_HZ, 100.0f},
+    {BMI088_GYRO_200_64_HZ, 200.0f},
+    {BMI088_GYRO_100_32_HZ, 100.0f},
+};
 
-    user_free(config); // 释放配置结构体内存
-    return instance;
-}
+/* ========================= 私有函数实现 ========================= */
 
 /**
  * @brief 读取BMI088加速度计寄存器数据
+ * @param bmi088 BMI088实例指针
  * @param reg 寄存器地址
  * @param rx_buf 存储读取数据的缓冲区
  * @param len 读取的数据长度
  * @details BMI088要求在不释放CS的情况下连续读取，读取时需要设置读取位(0x80)
  */
-static void Accel_Read(const uint8_t reg, uint8_t* rx_buf, const uint8_t len)
+static void Accel_Read(Bmi088Instance_s* bmi088, const uint8_t reg, uint8_t* rx_buf, const uint8_t len)
 {
     uint8_t tx_buf[8] = {0};
     tx_buf[0] = reg | 0x80; // 设置读取位
@@ -192,11 +124,12 @@ static void Accel_Read(const uint8_t reg, uint8_t* rx_buf, const uint8_t len)
 
 /**
  * @brief 读取BMI088陀螺仪寄存器数据
+ * @param bmi088 BMI088实例指针
  * @param reg 寄存器地址
  * @param rx_buf 存储读取数据的缓冲区
  * @details BMI088要求在不释放CS的情况下连续读取，读取时需要设置读取位(0x80)
  */
-static void Gyro_Read(uint8_t reg, uint8_t* rx_buf)
+static void Gyro_Read(Bmi088Instance_s* bmi088, uint8_t reg, uint8_t* rx_buf)
 {
     uint8_t tx_buf[9] = {0};
     tx_buf[0] = reg | 0x80; // 设置读取位
@@ -205,11 +138,12 @@ static void Gyro_Read(uint8_t reg, uint8_t* rx_buf)
 
 /**
  * @brief 写入BMI088加速度计单个寄存器
+ * @param bmi088 BMI088实例指针
  * @param reg 寄存器地址
  * @param data 写入的数据
  * @details 向加速度计的指定寄存器写入一个字节的数据
  */
-static void Accel_Write_Single_Reg(const uint8_t reg, const uint8_t data)
+static void Accel_Write_Single_Reg(Bmi088Instance_s* bmi088, const uint8_t reg, const uint8_t data)
 {
     uint8_t tx_buf[2] = {reg, data}; // 组装发送数据：寄存器地址+数据
     Spi_Transmit(bmi088->accel, tx_buf, 2);
@@ -217,11 +151,12 @@ static void Accel_Write_Single_Reg(const uint8_t reg, const uint8_t data)
 
 /**
  * @brief 写入BMI088陀螺仪单个寄存器
+ * @param bmi088 BMI088实例指针
  * @param reg 寄存器地址
  * @param data 写入的数据
  * @details 向陀螺仪的指定寄存器写入一个字节的数据
  */
-static void Gyro_Write_Single_Reg(const uint8_t reg, const uint8_t data)
+static void Gyro_Write_Single_Reg(Bmi088Instance_s* bmi088, const uint8_t reg, const uint8_t data)
 {
     uint8_t tx_buf[2] = {reg, data}; // 组装发送数据：寄存器地址+数据
     Spi_Transmit(bmi088->gyro, tx_buf, 2);
@@ -229,11 +164,12 @@ static void Gyro_Write_Single_Reg(const uint8_t reg, const uint8_t data)
 
 /**
  * @brief 读取BMI088加速度计单个寄存器
+ * @param bmi088 BMI088实例指针
  * @param reg 寄存器地址
  * @return 读取到的寄存器值
  * @details 从加速度计的指定寄存器读取一个字节的数据
  */
-static uint8_t Accel_Read_Single_Reg(const uint8_t reg)
+static uint8_t Accel_Read_Single_Reg(Bmi088Instance_s* bmi088, const uint8_t reg)
 {
     uint8_t tx_buf[3] = {0};
     tx_buf[0] = reg | 0x80; // 设置读取位
@@ -244,11 +180,12 @@ static uint8_t Accel_Read_Single_Reg(const uint8_t reg)
 
 /**
  * @brief 读取BMI088陀螺仪单个寄存器
+ * @param bmi088 BMI088实例指针
  * @param reg 寄存器地址
  * @return 读取到的寄存器值
  * @details 从陀螺仪的指定寄存器读取一个字节的数据
  */
-static uint8_t Gyro_Read_Single_Reg(uint8_t reg)
+static uint8_t Gyro_Read_Single_Reg(Bmi088Instance_s* bmi088, uint8_t reg)
 {
     uint8_t tx_buf[3] = {0};
     uint8_t rx_buf[3] = {0};
@@ -257,77 +194,87 @@ static uint8_t Gyro_Read_Single_Reg(uint8_t reg)
     return rx_buf[1]; // 返回第2个字节（实际数据）
 }
 
-
-/* ========================= 配置数据表 ========================= */
-
 /**
- * @brief BMI088加速度计初始化寄存器配置表
- * @details 每一行包含：[寄存器地址, 配置值, 错误代码]
- *          用于加速度计的初始化配置和错误检测
+ * @brief 解析三轴数据（低字节在前，高字节在后）
+ * @param buf 数据起始地址
+ * @param xyz 原始值[X, Y, Z]
  */
-static uint8_t write_BMI088_accel_reg_data_error[BMI088_WRITE_ACCEL_REG_NUM][3] =
+static inline void Bmi088_Parse_Xyz(const uint8_t* buf, int16_t xyz[3])
 {
-    {BMI088_ACC_PWR_CTRL, BMI088_ACC_ENABLE_ACC_ON, BMI088_ACC_PWR_CTRL_ERROR}, // 电源控制：开启加速度计
-    {BMI088_ACC_PWR_CONF, BMI088_ACC_PWR_ACTIVE_MODE, BMI088_ACC_PWR_CONF_ERROR}, // 电源配置：活跃模式
-    {BMI088_ACC_CONF, BMI088_ACC_NORMAL | BMI088_ACC_800_HZ | BMI088_ACC_CONF_MUST_Set, BMI088_ACC_CONF_ERROR},
-    // 加速度计配置：正常模式+800Hz采样率
-    {BMI088_ACC_RANGE, BMI088_ACC_RANGE_3G, BMI088_ACC_RANGE_ERROR}, // 量程配置：±3g
+    for (uint8_t i = 0; i < 3; i++)
     {
-        BMI088_INT1_IO_CTRL, BMI088_ACC_INT1_IO_ENABLE | BMI088_ACC_INT1_GPIO_PP | BMI088_ACC_INT1_GPIO_LOW,
-        // INT1中断配置：使能+推挑输出+低电平有效
-        BMI088_INT1_IO_CTRL_ERROR
-    },
-    {BMI088_INT_MAP_DATA, BMI088_ACC_INT1_DRDY_INTERRUPT, BMI088_INT_MAP_DATA_ERROR} // 中断映射：数据就绪中断映射到INT1
+        xyz[i] = (int16_t)(buf[i * 2 + 1] << 8 | buf[i * 2]);
+    }
+}
 
-};
 /**
- * @brief BMI088陀螺仪初始化寄存器配置表
- * @details 每一行包含：[寄存器地址, 配置值, 错误代码]
- *          用于陀螺仪的初始化配置和错误检测
+ * @brief 解析温度数据（11 位补码）并转换为摄氏度
+ * @param msb 温度高字节(TEMP_MSB)
+ * @param lsb 温度低字节(TEMP_LSB)
+ * @return 温度（℃）
  */
-static uint8_t write_BMI088_gyro_reg_data_error[BMI088_WRITE_GYRO_REG_NUM][3] =
+static inline float Bmi088_Parse_Temp(uint8_t msb, uint8_t lsb)
 {
-    {BMI088_GYRO_RANGE, BMI088_GYRO_2000, BMI088_GYRO_RANGE_ERROR}, // 量程配置：±2000°/s
-    {BMI088_GYRO_BANDWIDTH, BMI088_GYRO_1000_116_HZ | BMI088_GYRO_BANDWIDTH_MUST_Set, BMI088_GYRO_BANDWIDTH_ERROR},
-    // 带宽配置：1000Hz ODR + 116Hz带宽
-    {BMI088_GYRO_LPM1, BMI088_GYRO_NORMAL_MODE, BMI088_GYRO_LPM1_ERROR}, // 电源模式：正常模式
-    {BMI088_GYRO_CTRL, BMI088_DRDY_ON, BMI088_GYRO_CTRL_ERROR}, // 控制寄存器：开启数据就绪
+    int16_t temp_raw = (int16_t)(msb << 3 | lsb >> 5);
+    if (temp_raw > 1023)
     {
-        BMI088_GYRO_INT3_INT4_IO_CONF, BMI088_GYRO_INT3_GPIO_PP | BMI088_GYRO_INT3_GPIO_LOW, // INT3中断配置：推挑输出+低电平有效
-        BMI088_GYRO_INT3_INT4_IO_CONF_ERROR
-    },
-    {BMI088_GYRO_INT3_INT4_IO_MAP, BMI088_GYRO_DRDY_IO_INT3, BMI088_GYRO_INT3_INT4_IO_MAP_ERROR} // 中断映射：数据就绪中断映射到INT3
-
-};
+        temp_raw -= 2048;
+    }
+    return (float)temp_raw * BMI088_TEMP_FACTOR + BMI088_TEMP_OFFSET;
+}
 
 /* ========================= 初始化函数 ========================= */
 
 /**
  * @brief BMI088加速度计初始化函数
+ * @param bmi088 BMI088实例指针
  * @return 错误码，BMI088_NO_ERROR表示成功，其他值表示对应错误
- * @details 初始化BMI088加速度计，包括芯片ID检查、软复位和寄存器配置
+ * @details 初始化BMI088加速度计，包括芯片ID检查、软复位，按实例配置写入寄存器并逐个读回校验
  */
-static uint8_t bmi088_accel_init(void)
+static uint8_t bmi088_accel_init(Bmi088Instance_s* bmi088)
 {
+    const Bmi088InitConfig_s* config = &bmi088->config;
     uint8_t write_reg_num = 0; // 寄存器编号计数器
     uint8_t res = 0; // 读取结果存储
 
-    // 第一次读取芯片ID（可能不成功）
-    res = Accel_Read_Single_Reg(BMI088_ACC_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    /**
+     * 加速度计初始化寄存器配置表
+     * 每一行包含：[寄存器地址, 配置值, 错误代码]
+     */
+    const uint8_t write_BMI088_accel_reg_data_error[BMI088_WRITE_ACCEL_REG_NUM][3] =
+    {
+        {BMI088_ACC_PWR_CTRL, BMI088_ACC_ENABLE_ACC_ON, BMI088_ACC_PWR_CTRL_ERROR}, // 电源控制：开启加速度计
+        {BMI088_ACC_PWR_CONF, BMI088_ACC_PWR_ACTIVE_MODE, BMI088_ACC_PWR_CONF_ERROR}, // 电源配置：活跃模式
+        {
+            BMI088_ACC_CONF,
+            bmi088_accel_bwp[config->accel_bwp] | bmi088_accel_odr[config->accel_odr].reg | BMI088_ACC_CONF_MUST_Set,
+            BMI088_ACC_CONF_ERROR
+        }, // 加速度计配置：带宽+输出数据率
+        {BMI088_ACC_RANGE, bmi088_accel_range[config->accel_range].reg, BMI088_ACC_RANGE_ERROR}, // 量程配置
+        {
+            BMI088_INT1_IO_CTRL, BMI088_ACC_INT1_IO_ENABLE | BMI088_ACC_INT1_GPIO_PP | BMI088_ACC_INT1_GPIO_LOW,
+            // INT1中断配置：使能+推挽输出+低电平有效
+            BMI088_INT1_IO_CTRL_ERROR
+        },
+        {BMI088_INT_MAP_DATA, BMI088_ACC_INT1_DRDY_INTERRUPT, BMI088_INT_MAP_DATA_ERROR} // 中断映射：数据就绪中断映射到INT1
+    };
+
+    // 第一次读取芯片ID（上电后第一次读取将加速度计切换到SPI模式，结果无效）
+    res = Accel_Read_Single_Reg(bmi088, BMI088_ACC_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
     // 第二次读取芯片ID（确保成功）
-    res = Accel_Read_Single_Reg(BMI088_ACC_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Accel_Read_Single_Reg(bmi088, BMI088_ACC_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
     // 执行软复位
-    Accel_Write_Single_Reg(BMI088_ACC_SOFTRESET, BMI088_ACC_SOFTRESET_VALUE);
-    BMI088_delay_ms(BMI088_LONG_DELAY_TIME); // 等待复位完成
+    Accel_Write_Single_Reg(bmi088, BMI088_ACC_SOFTRESET, BMI088_ACC_SOFTRESET_VALUE);
+    Dwt_delay_ms(BMI088_LONG_DELAY_TIME); // 等待复位完成
 
     // 复位后再次读取芯片ID进行验证
-    res = Accel_Read_Single_Reg(BMI088_ACC_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
-    res = Accel_Read_Single_Reg(BMI088_ACC_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Accel_Read_Single_Reg(bmi088, BMI088_ACC_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Accel_Read_Single_Reg(bmi088, BMI088_ACC_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
     // 检查芯片ID是否正确
     if (res != BMI088_ACC_CHIP_ID_VALUE)
@@ -339,13 +286,13 @@ static uint8_t bmi088_accel_init(void)
     for (write_reg_num = 0; write_reg_num < BMI088_WRITE_ACCEL_REG_NUM; write_reg_num++)
     {
         // 写入配置值
-        Accel_Write_Single_Reg(write_BMI088_accel_reg_data_error[write_reg_num][0],
+        Accel_Write_Single_Reg(bmi088, write_BMI088_accel_reg_data_error[write_reg_num][0],
                                write_BMI088_accel_reg_data_error[write_reg_num][1]);
-        BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
         // 读回验证配置是否成功
-        res = Accel_Read_Single_Reg(write_BMI088_accel_reg_data_error[write_reg_num][0]);
-        BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+        res = Accel_Read_Single_Reg(bmi088, write_BMI088_accel_reg_data_error[write_reg_num][0]);
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
         // 检查配置是否正确
         if (res != write_BMI088_accel_reg_data_error[write_reg_num][1])
@@ -358,30 +305,52 @@ static uint8_t bmi088_accel_init(void)
 
 /**
  * @brief BMI088陀螺仪初始化函数
+ * @param bmi088 BMI088实例指针
  * @return 错误码，BMI088_NO_ERROR表示成功，其他值表示对应错误
- * @details 初始化BMI088陀螺仪，包括芯片ID检查、软复位和寄存器配置
+ * @details 初始化BMI088陀螺仪，包括芯片ID检查、软复位，按实例配置写入寄存器并逐个读回校验
  */
-static uint8_t bmi088_gyro_init(void)
+static uint8_t bmi088_gyro_init(Bmi088Instance_s* bmi088)
 {
+    const Bmi088InitConfig_s* config = &bmi088->config;
     uint8_t write_reg_num = 0; // 寄存器编号计数器
     uint8_t res = 0; // 读取结果存储
 
+    /**
+     * 陀螺仪初始化寄存器配置表
+     * 每一行包含：[寄存器地址, 配置值, 错误代码]
+     */
+    const uint8_t write_BMI088_gyro_reg_data_error[BMI088_WRITE_GYRO_REG_NUM][3] =
+    {
+        {BMI088_GYRO_RANGE, bmi088_gyro_range[config->gyro_range].reg, BMI088_GYRO_RANGE_ERROR}, // 量程配置
+        {
+            BMI088_GYRO_BANDWIDTH, bmi088_gyro_odr[config->gyro_odr].reg | BMI088_GYRO_BANDWIDTH_MUST_Set,
+            BMI088_GYRO_BANDWIDTH_ERROR
+        }, // 带宽配置：输出数据率+带宽
+        {BMI088_GYRO_LPM1, BMI088_GYRO_NORMAL_MODE, BMI088_GYRO_LPM1_ERROR}, // 电源模式：正常模式
+        {BMI088_GYRO_CTRL, BMI088_DRDY_ON, BMI088_GYRO_CTRL_ERROR}, // 控制寄存器：开启数据就绪
+        {
+            BMI088_GYRO_INT3_INT4_IO_CONF, BMI088_GYRO_INT3_GPIO_PP | BMI088_GYRO_INT3_GPIO_LOW, // INT3中断配置：推挽输出+低电平有效
+            BMI088_GYRO_INT3_INT4_IO_CONF_ERROR
+        },
+        {BMI088_GYRO_INT3_INT4_IO_MAP, BMI088_GYRO_DRDY_IO_INT3, BMI088_GYRO_INT3_INT4_IO_MAP_ERROR} // 中断映射：数据就绪中断映射到INT3
+    };
+
     // 第一次读取芯片ID（可能不成功）
-    res = Gyro_Read_Single_Reg(BMI088_GYRO_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Gyro_Read_Single_Reg(bmi088, BMI088_GYRO_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
     // 第二次读取芯片ID（确保成功）
-    res = Gyro_Read_Single_Reg(BMI088_GYRO_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Gyro_Read_Single_Reg(bmi088, BMI088_GYRO_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
     // 执行软复位
-    Gyro_Write_Single_Reg(BMI088_GYRO_SOFTRESET, BMI088_GYRO_SOFTRESET_VALUE);
-    BMI088_delay_ms(BMI088_LONG_DELAY_TIME); // 等待复位完成
+    Gyro_Write_Single_Reg(bmi088, BMI088_GYRO_SOFTRESET, BMI088_GYRO_SOFTRESET_VALUE);
+    Dwt_delay_ms(BMI088_LONG_DELAY_TIME); // 等待复位完成
 
     // 复位后再次读取芯片ID进行验证
-    res = Gyro_Read_Single_Reg(BMI088_GYRO_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
-    res = Gyro_Read_Single_Reg(BMI088_GYRO_CHIP_ID);
-    BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Gyro_Read_Single_Reg(bmi088, BMI088_GYRO_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    res = Gyro_Read_Single_Reg(bmi088, BMI088_GYRO_CHIP_ID);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
     // 检查芯片ID是否正确
     if (res != BMI088_GYRO_CHIP_ID_VALUE)
@@ -393,13 +362,13 @@ static uint8_t bmi088_gyro_init(void)
     for (write_reg_num = 0; write_reg_num < BMI088_WRITE_GYRO_REG_NUM; write_reg_num++)
     {
         // 写入配置值
-        Gyro_Write_Single_Reg(write_BMI088_gyro_reg_data_error[write_reg_num][0],
+        Gyro_Write_Single_Reg(bmi088, write_BMI088_gyro_reg_data_error[write_reg_num][0],
                               write_BMI088_gyro_reg_data_error[write_reg_num][1]);
-        BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
         // 读回验证配置是否成功
-        res = Gyro_Read_Single_Reg(write_BMI088_gyro_reg_data_error[write_reg_num][0]);
-        BMI088_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+        res = Gyro_Read_Single_Reg(bmi088, write_BMI088_gyro_reg_data_error[write_reg_num][0]);
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
 
         // 检查配置是否正确
         if (res != write_BMI088_gyro_reg_data_error[write_reg_num][1])
@@ -411,69 +380,1000 @@ static uint8_t bmi088_gyro_init(void)
     return BMI088_NO_ERROR; // 初始化成功
 }
 
+/* ========================= 自测试 ========================= */
+
+/**
+ * @brief 加速度计自测试
+ * @param bmi088 BMI088实例指针
+ * @return BMI088_NO_ERROR 通过  BMI088_SELF_TEST_ACCEL_ERROR 失败
+ * @details 按数据手册：±24g、1600Hz，分别施加正负激励各读取一次，各轴差值需超过阈值。
+ *          结束后加速度计处于自测试配置，需要软复位重新初始化
+ */
+static uint8_t Bmi088_Accel_Self_Test(Bmi088Instance_s* bmi088)
+{
+    static const uint8_t signal[2] = {BMI088_ACC_SELF_TEST_POSITIVE_SIGNAL, BMI088_ACC_SELF_TEST_NEGATIVE_SIGNAL};
+    static const float limit[3] = {BMI088_ACCEL_SELF_TEST_X_MG, BMI088_ACCEL_SELF_TEST_Y_MG, BMI088_ACCEL_SELF_TEST_Z_MG};
+    int16_t raw[2][3] = {0};
+    uint8_t buf[8] = {0};
+
+    Accel_Write_Single_Reg(bmi088, BMI088_ACC_RANGE, BMI088_ACC_RANGE_24G);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    Accel_Write_Single_Reg(bmi088, BMI088_ACC_CONF, BMI088_ACC_NORMAL | BMI088_ACC_1600_HZ | BMI088_ACC_CONF_MUST_Set);
+    Dwt_delay_ms(BMI088_SELF_TEST_SETTLE_TIME);
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        Accel_Write_Single_Reg(bmi088, BMI088_ACC_SELF_TEST, signal[i]);
+        Dwt_delay_ms(BMI088_SELF_TEST_SIGNAL_TIME);
+        Accel_Read(bmi088, BMI088_ACCEL_XOUT_L, buf, 6);
+        Bmi088_Parse_Xyz(&buf[2], raw[i]);
+    }
+    Accel_Write_Single_Reg(bmi088, BMI088_ACC_SELF_TEST, BMI088_ACC_SELF_TEST_OFF);
+    Dwt_delay_ms(BMI088_SELF_TEST_SIGNAL_TIME);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        const float diff = (float)(raw[0][i] - raw[1][i]) * BMI088_SELF_TEST_MG_PER_LSB;
+        if (diff < limit[i])
+        {
+            Log_Error("Bmi088_Accel_Self_Test : axis %d diff %d mg", i, (int)diff);
+            return BMI088_SELF_TEST_ACCEL_ERROR;
+        }
+    }
+    return BMI088_NO_ERROR;
+}
+
+/**
+ * @brief 陀螺仪内置自测试(BIST)
+ * @param bmi088 BMI088实例指针
+ * @return BMI088_NO_ERROR 通过  BMI088_SELF_TEST_GYRO_ERROR 失败或超时
+ */
+static uint8_t Bmi088_Gyro_Self_Test(Bmi088Instance_s* bmi088)
+{
+    Gyro_Write_Single_Reg(bmi088, BMI088_GYRO_SELF_TEST, BMI088_GYRO_TRIG_BIST);
+    for (uint8_t ms = 0; ms < BMI088_GYRO_BIST_TIMEOUT; ms++)
+    {
+        Dwt_delay_ms(1);
+        const uint8_t res = Gyro_Read_Single_Reg(bmi088, BMI088_GYRO_SELF_TEST);
+        if (res & BMI088_GYRO_BIST_RDY)
+        {
+            if (res & BMI088_GYRO_BIST_FAIL)
+            {
+                Log_Error("Bmi088_Gyro_Self_Test : BIST failed");
+                return BMI088_SELF_TEST_GYRO_ERROR;
+            }
+            return BMI088_NO_ERROR;
+        }
+    }
+    Log_Error("Bmi088_Gyro_Self_Test : BIST timeout");
+    return BMI088_SELF_TEST_GYRO_ERROR;
+}
+
 /* ========================= 公共接口函数 ========================= */
 
 /**
- * @brief BMI088传感器初始化函数
- * @return 错误码，BMI088_NO_ERROR表示成功，其他值表示对应错误
- * @details 初始化BMI088传感器，包括SPI接口注册、加速度计和陀螺仪初始化
+ * @brief 填写板载 BMI088 的默认配置
+ * @param config 配置结构体指针
+ * @param spi_handle_number SPI句柄编号
  */
-uint8_t BMI088_init(void)
+void Bmi088_Default_Config(Bmi088InitConfig_s* config, uint8_t spi_handle_number)
 {
-    uint8_t error = BMI088_NO_ERROR; // 错误代码累加器
+    memset(config, 0, sizeof(Bmi088InitConfig_s));
 
-    // 注册BMI088实例
-    bmi088 = Bmi088_Register(SPI_IMU_HANDLE);
-    if (bmi088 == NULL)
+    // 配置加速度计SPI参数
+    config->accel.topic_name = "BMI088_ACCEL_SPI";
+    config->accel.spi_handle_number = spi_handle_number;
+    config->accel.mode = BLOCK_MODE;
+    config->accel.timeout = 1000;
+    config->accel.cs_port = ACC_CS_GPIO_Port;
+    config->accel.cs_pin = ACC_CS_Pin;
+
+    // 配置陀螺仪SPI参数
+    config->gyro.topic_name = "BMI088_GYRO_SPI";
+    config->gyro.spi_handle_number = spi_handle_number;
+    config->gyro.mode = BLOCK_MODE;
+    config->gyro.timeout = 1000;
+    config->gyro.cs_port = GYRO_CS_GPIO_Port;
+    config->gyro.cs_pin = GYRO_CS_Pin;
+
+    // 中断引脚
+    config->accel_int_port = ACC_INT_GPIO_Port;
+    config->accel_int_pin = ACC_INT_Pin;
+    config->gyro_int_port = GYRO_INT_GPIO_Port;
+    config->gyro_int_pin = GYRO_INT_Pin;
+
+    // 量程和输出数据率
+    config->accel_range = BMI088_ACCEL_RANGE_3G;
+    config->accel_odr = BMI088_ACCEL_ODR_800HZ;
+    config->accel_bwp = BMI088_ACCEL_BWP_NORMAL;
+    config->gyro_range = BMI088_GYRO_RANGE_2000DPS;
+    config->gyro_odr = BMI088_GYRO_ODR_1000HZ_BW_116HZ;
+    config->self_test = false;
+}
+
+/**
+ * @brief 是否已启动中断采样，启动后两个样本队列都已创建
+ * @param bmi088 BMI088实例指针
+ * @return true 已启动
+ */
+static inline bool Bmi088_Sampling_Started(const Bmi088Instance_s* bmi088)
+{
+    return bmi088->queue[BMI088_SAMPLE_ACCEL] != NULL;
+}
+
+/**
+ * @brief 注册失败时按分配的相反顺序注销 SPI 设备并释放实例，归还 SPI 槽位和内存
+ * @param instance BMI088实例指针
+ */
+static void Bmi088_Register_Rollback(Bmi088Instance_s* instance)
+{
+    if (instance->gyro != NULL)
     {
-        return BMI088_NO_SENSOR;
+        Spi_Unregister(instance->gyro);
+    }
+    if (instance->accel != NULL)
+    {
+        Spi_Unregister(instance->accel);
     }
+    user_free(instance);
+}
+
+/**
+ * @brief BMI088注册函数
+ * @param config 初始化配置结构体指针
+ * @return BMI088实例指针，注册成功返回实例指针，失败返回NULL
+ * @details 根据配置参数创建BMI088实例，注册加速度计和陀螺仪SPI接口，初始化传感器并按需执行自测试
+ */
+Bmi088Instance_s* Bmi088_Register(Bmi088InitConfig_s* config)
+{
+    if (config == NULL)
+    {
+        Log_Error("Bmi088_Register : config is NULL");
+        return NULL;
+    }
+    if (config->accel_range >= BMI088_ACCEL_RANGE_CNT || config->accel_odr >= BMI088_ACCEL_ODR_CNT ||
+        config->accel_bwp >= BMI088_ACCEL_BWP_CNT || config->gyro_range >= BMI088_GYRO_RANGE_CNT ||
+        config->gyro_odr >= BMI088_GYRO_ODR_CNT)
+    {
+        Log_Error("Bmi088_Register : range or odr is invalid");
+        return NULL;
+    }
+
+    // 分配实例内存
+    Bmi088Instance_s* instance = user_malloc(sizeof(Bmi088Instance_s));
+    if (instance == NULL)
+    {
+        Log_Error("Bmi088_Register : instance Malloc Failed");
+        return NULL;
+    }
+
+    memset(instance, 0, sizeof(Bmi088Instance_s));
+    instance->config = *config;
+
+    // 注册加速度计和陀螺仪SPI接口，寄存器读写使用阻塞模式
+    instance->config.accel.mode = BLOCK_MODE;
+    instance->config.gyro.mode = BLOCK_MODE;
+    instance->accel = Spi_Register(&instance->config.accel);
+    instance->gyro = Spi_Register(&instance->config.gyro);
+
+    if (instance->accel == NULL || instance->gyro == NULL)
+    {
+        Log_Error("Bmi088_Register : Spi_accel or Spi_gyro Malloc Failed");
+        Bmi088_Register_Rollback(instance);
+        return NULL;
+    }
+
+    instance->accel_sen = bmi088_accel_range[config->accel_range].value;
+    instance->gyro_sen = bmi088_gyro_range[config->gyro_range].value;
 
     // 初始化加速度计和陀螺仪
-    error |= bmi088_accel_init(); // 加速度计初始化
-    error |= bmi088_gyro_init(); // 陀螺仪初始化
+    uint8_t error = bmi088_accel_init(instance);
+    error |= bmi088_gyro_init(instance);
+    if (error == BMI088_NO_ERROR && config->self_test)
+    {
+        error = Bmi088_Self_Test(instance);
+    }
+    if (error != BMI088_NO_ERROR)
+    {
+        Log_Error("Bmi088_Register : %s init error 0x%02X", config->accel.topic_name, error);
+        Bmi088_Register_Rollback(instance);
+        return NULL;
+    }
 
-    return error; // 返回累加错误代码
+    Log_Passing("BMI088 Register");
+    return instance;
 }
 
+/**
+ * @brief BMI088自测试
+ * @param bmi088 BMI088实例指针
+ * @return BMI088_NO_ERROR 通过，否则为失败的错误码组合
+ * @details 依次进行加速度计自测试和陀螺仪内置自测试，完成后按实例配置重新初始化
+ */
+uint8_t Bmi088_Self_Test(Bmi088Instance_s* bmi088)
+{
+    if (bmi088 == NULL)
+    {
+        return BMI088_NO_SENSOR;
+    }
+    // 中断采样启动后总线由 DMA 读取占用，且寄存器已改为采样配置
+    if (Bmi088_Sampling_Started(bmi088))
+    {
+        Log_Error("Bmi088_Self_Test : sampling is running");
+        return BMI088_SELF_TEST_ACCEL_ERROR | BMI088_SELF_TEST_GYRO_ERROR;
+    }
+
+    uint8_t error = Bmi088_Accel_Self_Test(bmi088);
+    error |= Bmi088_Gyro_Self_Test(bmi088);
+
+    // 自测试修改了量程和输出数据率，复位后恢复实例配置
+    error |= bmi088_accel_init(bmi088);
+    error |= bmi088_gyro_init(bmi088);
+    return error;
+}
 
 /**
- * @brief 读取BMI088传感器数据
- * @param gyro 陀螺仪数据数组[X, Y, Z]（°/s）
- * @param accel 加速度计数据数组[X, Y, Z]（g）
+ * @brief 读取BMI088原始数据
+ * @param bmi088 BMI088实例指针
+ * @param gyro 陀螺仪原始值[X, Y, Z]
+ * @param accel 加速度计原始值[X, Y, Z]
  * @param temperate 温度数据指针（℃）
- * @details 从 BMI088 读取陀螺仪、加速度计和温度数据，并转换为物理单位
+ * @return true 成功  false 启动中断采样后不可用，或陀螺仪芯片ID校验失败，gyro 未更新
+ * @details 物理量 = 原始值 * gyro_sen / accel_sen，校准模块在此基础上合并零偏和比例修正
  */
-void Bmi088_read(float gyro[3], float accel[3], float* temperate)
+bool Bmi088_Read_Raw(Bmi088Instance_s* bmi088, int16_t gyro[3], int16_t accel[3], float* temperate)
 {
     uint8_t accel_buf[8] = {0}; // 加速度计数据缓冲区
     uint8_t gyro_buf[9] = {0}; // 陀螺仪数据缓冲区
+    bool ok = false;
 
-    // 读取加速度计数据（从 X 轴低字节开始，连续读取 6 个字节）
-    Accel_Read(BMI088_ACCEL_XOUT_L, accel_buf, 6);
-
-    // 解析加速度计数据（低字节在前，高字节在后）
-    for (uint8_t i = 0; i < 3; i++)
+    // 中断采样启动后总线由 DMA 读取占用
+    if (bmi088 == NULL || Bmi088_Sampling_Started(bmi088))
     {
-        accel[i] = BMI088_ACCEL_SEN * (float)(int16_t)(accel_buf[i * 2 + 3] << 8 | accel_buf[i * 2 + 2]);
+        return false;
     }
 
+    // 读取加速度计数据（从 X 轴低字节开始，连续读取 6 个字节）
+    Accel_Read(bmi088, BMI088_ACCEL_XOUT_L, accel_buf, 6);
+    Bmi088_Parse_Xyz(&accel_buf[2], accel);
+
     // 读取陀螺仪数据（从芯片ID寄存器开始，连续读取 9 个字节）
-    Gyro_Read(BMI088_GYRO_CHIP_ID, gyro_buf);
+    Gyro_Read(bmi088, BMI088_GYRO_CHIP_ID, gyro_buf);
 
     // 验证陀螺仪芯片ID后解析数据
     if (gyro_buf[1] == BMI088_GYRO_CHIP_ID_VALUE)
     {
-        // 解析陀螺仪数据（低字节在前，高字节在后）
-        for (uint8_t i = 0; i < 3; i++)
+        Bmi088_Parse_Xyz(&gyro_buf[3], gyro);
+        ok = true;
+    }
+
+    // 读取温度数据（从温度高字节开始，连续读取 2 个字节）
+    Accel_Read(bmi088, BMI088_TEMP_M, accel_buf, 2);
+    *temperate = Bmi088_Parse_Temp(accel_buf[2], accel_buf[3]);
+    return ok;
+}
+
+/**
+ * @brief 读取BMI088传感器数据
+ * @param bmi088 BMI088实例指针
+ * @param gyro 陀螺仪数据数组[X, Y, Z]（rad/s）
+ * @param accel 加速度计数据数组[X, Y, Z]（m/s^2）
+ * @param temperate 温度数据指针（℃）
+ * @return true 成功  false 读取失败，gyro 未更新
+ * @details 从 BMI088 读取陀螺仪、加速度计和温度数据，并按实例灵敏度转换为物理单位
+ */
+bool Bmi088_Read(Bmi088Instance_s* bmi088, float gyro[3], float accel[3], float* temperate)
+{
+    int16_t gyro_raw[3] = {0};
+    int16_t accel_raw[3] = {0};
+    if (bmi088 == NULL || Bmi088_Sampling_Started(bmi088))
+    {
+        return false;
+    }
+    const bool gyro_ok = Bmi088_Read_Raw(bmi088, gyro_raw, accel_raw, temperate);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        accel[i] = bmi088->accel_sen * (float)accel_raw[i];
+        if (gyro_ok)
+        {
+            gyro[i] = bmi088->gyro_sen * (float)gyro_raw[i];
+        }
+    }
+    return gyro_ok;
+}
+
+/* ========================= 中断采样 ========================= */
+
+/**
+ * @brief 数据就绪中断回调，记录时刻并提交读取任务
+ * @param gpio GPIO 实例指针
+ */
+static void Bmi088_Drdy_Callback(GpioInstance_s* gpio)
+{
+    const uint32_t cycle = Dwt_Get_Cycle();
+    Bmi088Instance_s* instance = gpio->parent_ptr;
+    const uint8_t type = (gpio == instance->drdy[BMI088_SAMPLE_GYRO]) ? BMI088_SAMPLE_GYRO : BMI088_SAMPLE_ACCEL;
+    SpiJob_s* job = &instance->job[type];
+
+    BMI088_ENTER_CRITICAL();
+    const SpiJobState_e state = job->state;
+    if (state != SPI_JOB_ACTIVE)
+    {
+        // 排队中的任务还未开始读取，读到的将是本次数据，时刻一并更新
+        instance->drdy_cycle[type] = cycle;
+    }
+    BMI088_EXIT_CRITICAL();
+
+    if (state != SPI_JOB_IDLE)
+    {
+        // 上一次读取尚未完成，跳过一个样本
+        instance->stat.drdy_overrun++;
+        return;
+    }
+    if (!Spi_Submit(job))
+    {
+        instance->stat.spi_error++;
+    }
+}
+
+/**
+ * @brief 样本放入所属传感器的队列并计数
+ * @param instance BMI088实例指针
+ * @param sample 样本
+ */
+static inline void Bmi088_Push_Sample(Bmi088Instance_s* instance, const Bmi088Sample_s* sample)
+{
+    if (SpscQueue_Enqueue(instance->queue[sample->type], sample))
+    {
+        instance->stat.sample_cnt[sample->type]++;
+    }
+    else
+    {
+        instance->stat.queue_full++;
+    }
+}
+
+/**
+ * @brief 突发读取完成回调，解析数据并放入样本队列
+ * @param job 读取任务指针
+ * @param success 传输是否成功
+ */
+static void Bmi088_Job_Callback(SpiJob_s* job, bool success)
+{
+    Bmi088Instance_s* instance = job->parent_ptr;
+    const uint8_t type = (job == &instance->job[BMI088_SAMPLE_GYRO]) ? BMI088_SAMPLE_GYRO : BMI088_SAMPLE_ACCEL;
+    if (!success)
+    {
+        instance->stat.spi_error++;
+        return;
+    }
+
+    const uint8_t* rx = job->rx;
+    Bmi088Sample_s sample = {0};
+    sample.cycle = instance->drdy_cycle[type];
+    sample.type = type;
+    if (type == BMI088_SAMPLE_ACCEL)
+    {
+        // 加速度计读取时第 2 个字节为空字节
+        Bmi088_Parse_Xyz(&rx[2], sample.data);
+        sample.temperate = Bmi088_Parse_Temp(rx[2 + BMI088_TEMP_M - BMI088_ACCEL_XOUT_L],
+                                             rx[2 + BMI088_TEMP_L - BMI088_ACCEL_XOUT_L]);
+    }
+    else
+    {
+        Bmi088_Parse_Xyz(&rx[1], sample.data);
+    }
+    Bmi088_Push_Sample(instance, &sample);
+}
+
+/**
+ * @brief 分配读取任务缓冲区和样本队列，切换到 DMA 模式并注册中断引脚
+ * @param bmi088 BMI088实例指针
+ * @param buf_len 各传感器收发缓冲区长度，同时作为初始读取长度
+ * @param reg 各传感器初始读取的起始寄存器
+ * @param gpio_callback 中断引脚回调
+ * @param job_callback 读取任务完成回调
+ * @return true 成功  false 资源分配失败
+ */
+static bool Bmi088_Sampling_Setup(Bmi088Instance_s* bmi088,
+                                  const uint16_t buf_len[BMI088_SAMPLE_TYPE_CNT],
+                                  const uint8_t reg[BMI088_SAMPLE_TYPE_CNT],
+                                  void (*gpio_callback)(GpioInstance_s* gpio),
+                                  void (*job_callback)(SpiJob_s* job, bool success))
+{
+    SpiInstance_s* const device[BMI088_SAMPLE_TYPE_CNT] = {bmi088->accel, bmi088->gyro};
+    for (uint8_t type = 0; type < BMI088_SAMPLE_TYPE_CNT; type++)
+    {
+        uint8_t* tx = Memory_Region_Malloc(MEMORY_REGION_AXISRAM, buf_len[type]);
+        uint8_t* rx = Memory_Region_Malloc(MEMORY_REGION_AXISRAM, buf_len[type]);
+        if (tx == NULL || rx == NULL)
         {
-            gyro[i] = BMI088_GYRO_SEN * (float)(int16_t)(gyro_buf[i * 2 + 4] << 8 | gyro_buf[i * 2 + 3]);
+            Log_Error("Bmi088_Sampling_Setup : DMA buffer Malloc Failed");
+            return false;
         }
+        memset(tx, 0, buf_len[type]);
+        tx[0] = reg[type] | 0x80; // 设置读取位
+
+        SpiJob_s* job = &bmi088->job[type];
+        memset(job, 0, sizeof(SpiJob_s));
+        job->device = device[type];
+        job->tx = tx;
+        job->rx = rx;
+        job->len = buf_len[type];
+        job->callback = job_callback;
+        job->parent_ptr = bmi088;
     }
 
-    // 读取温度数据（从温度高字节开始，连续读取 2 个字节）
-    Accel_Read(BMI088_TEMP_M, accel_buf, 2);
+    // 两个传感器可能位于不同总线，完成中断可以互相抢占，每个传感器一个队列保证单生产者
+    SpscQueue_s* queue[BMI088_SAMPLE_TYPE_CNT];
+    for (uint8_t type = 0; type < BMI088_SAMPLE_TYPE_CNT; type++)
+    {
+        queue[type] = SpscQueue_Create(BMI088_SAMPLE_QUEUE_LEN, sizeof(Bmi088Sample_s));
+        if (queue[type] == NULL)
+        {
+            Log_Error("Bmi088_Sampling_Setup : queue Malloc Failed");
+            return false;
+        }
+    }
+
+    // 先切换到 DMA 模式，再打开中断
+    bmi088->accel->mode = DMA_MODE;
+    bmi088->gyro->mode = DMA_MODE;
+    bmi088->queue[BMI088_SAMPLE_GYRO] = queue[BMI088_SAMPLE_GYRO];
+    bmi088->queue[BMI088_SAMPLE_ACCEL] = queue[BMI088_SAMPLE_ACCEL];
+
+    GpioInitConfig_s gpio_config = {0};
+    gpio_config.topic_name = "BMI088_ACCEL_INT";
+    gpio_config.port = bmi088->config.accel_int_port;
+    gpio_config.pin = bmi088->config.accel_int_pin;
+    gpio_config.callback = gpio_callback;
+    gpio_config.parent_ptr = bmi088;
+    bmi088->drdy[BMI088_SAMPLE_ACCEL] = Gpio_Register(&gpio_config);
+
+    gpio_config.topic_name = "BMI088_GYRO_INT";
+    gpio_config.port = bmi088->config.gyro_int_port;
+    gpio_config.pin = bmi088->config.gyro_int_pin;
+    bmi088->drdy[BMI088_SAMPLE_GYRO] = Gpio_Register(&gpio_config);
+
+    if (bmi088->drdy[BMI088_SAMPLE_ACCEL] == NULL || bmi088->drdy[BMI088_SAMPLE_GYRO] == NULL)
+    {
+        Log_Error("Bmi088_Sampling_Setup : interrupt gpio Register Failed");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 启动数据就绪中断采样
+ * @param bmi088 BMI088实例指针
+ * @return true 成功  false 未配置中断引脚或资源分配失败
+ */
+bool Bmi088_Start_Sampling(Bmi088Instance_s* bmi088)
+{
+    static const uint16_t burst_len[BMI088_SAMPLE_TYPE_CNT] = {BMI088_ACCEL_BURST_LEN, BMI088_GYRO_BURST_LEN};
+    static const uint8_t burst_reg[BMI088_SAMPLE_TYPE_CNT] = {BMI088_ACCEL_XOUT_L, BMI088_GYRO_X_L};
+
+    if (bmi088 == NULL || bmi088->config.accel_int_port == NULL || bmi088->config.gyro_int_port == NULL)
+    {
+        Log_Error("Bmi088_Start_Sampling : interrupt pin is not configured");
+        return false;
+    }
+    if (Bmi088_Sampling_Started(bmi088))
+    {
+        return true;
+    }
+    if (!Bmi088_Sampling_Setup(bmi088, burst_len, burst_reg, Bmi088_Drdy_Callback, Bmi088_Job_Callback))
+    {
+        return false;
+    }
+    Log_Passing("BMI088 Sampling Start");
+    return true;
+}
+
+/* ========================= FIFO 采样 ========================= */
+
+/**
+ * @brief FIFO 读取阶段
+ */
+enum
+{
+    BMI088_FIFO_PHASE_LEVEL = 0,    // 读取 FIFO 长度（加速度计同时读取温度）
+    BMI088_FIFO_PHASE_DATA = 1,     // 突发读取全部帧
+    BMI088_FIFO_PHASE_CLEAR = 2     // 陀螺仪溢出后写 FIFO_CONFIG_1 清除溢出标志
+};
+
+/**
+ * @brief FIFO 模式加速度计配置表
+ * @details 每一行包含：[寄存器地址, 配置值, 错误代码]，覆盖初始化配置表中的中断映射，输出数据率沿用实例配置
+ */
+static const uint8_t bmi088_accel_fifo_reg[][3] =
+{
+    {BMI088_ACC_FIFO_WTM_0, (BMI088_FIFO_ACCEL_WTM * BMI088_ACC_FIFO_ACC_FRAME_LEN) & 0xFF, BMI088_ACC_FIFO_CONFIG_ERROR},
+    {BMI088_ACC_FIFO_WTM_1, (BMI088_FIFO_ACCEL_WTM * BMI088_ACC_FIFO_ACC_FRAME_LEN) >> 8, BMI088_ACC_FIFO_CONFIG_ERROR},
+    {BMI088_ACC_FIFO_CONFIG_0, BMI088_ACC_FIFO_STREAM_MODE, BMI088_ACC_FIFO_CONFIG_ERROR}, // 流模式
+    {BMI088_ACC_FIFO_CONFIG_1, BMI088_ACC_FIFO_ACC_EN, BMI088_ACC_FIFO_CONFIG_ERROR}, // 加速度数据写入FIFO
+    {BMI088_INT_MAP_DATA, BMI088_ACC_INT1_FWM_INTERRUPT, BMI088_INT_MAP_DATA_ERROR} // 中断映射：FIFO水印中断映射到INT1
+};
+
+/**
+ * @brief FIFO 模式陀螺仪配置表
+ * @details 每一行包含：[寄存器地址, 配置值, 错误代码]，写 FIFO_CONFIG_1 同时清空 FIFO
+ */
+static const uint8_t bmi088_gyro_fifo_reg[][3] =
+{
+    {BMI088_GYRO_FIFO_CONFIG_0, BMI088_FIFO_GYRO_WTM, BMI088_GYRO_FIFO_CONFIG_ERROR}, // 水印帧数
+    {BMI088_GYRO_FIFO_CONFIG_1, BMI088_GYRO_FIFO_MODE, BMI088_GYRO_FIFO_CONFIG_ERROR}, // FIFO模式
+    {BMI088_GYRO_FIFO_WM_EN, BMI088_GYRO_FIFO_WM_ENABLE, BMI088_GYRO_FIFO_CONFIG_ERROR}, // 使能水印中断
+    {BMI088_GYRO_CTRL, BMI088_GYRO_FIFO_ON, BMI088_GYRO_CTRL_ERROR}, // 控制寄存器：关闭数据就绪、开启FIFO中断
+    {BMI088_GYRO_INT3_INT4_IO_MAP, BMI088_GYRO_FIFO_IO_INT3, BMI088_GYRO_INT3_INT4_IO_MAP_ERROR} // 中断映射：FIFO中断映射到INT3
+};
+
+/**
+ * @brief 写入 FIFO 配置表并读回验证，最后清空加速度计 FIFO
+ * @param bmi088 BMI088实例指针
+ * @return 错误码，BMI088_NO_ERROR表示成功
+ */
+static uint8_t Bmi088_Fifo_Config(Bmi088Instance_s* bmi088)
+{
+    for (uint8_t i = 0; i < sizeof(bmi088_accel_fifo_reg) / sizeof(bmi088_accel_fifo_reg[0]); i++)
+    {
+        Accel_Write_Single_Reg(bmi088, bmi088_accel_fifo_reg[i][0], bmi088_accel_fifo_reg[i][1]);
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+        if (Accel_Read_Single_Reg(bmi088, bmi088_accel_fifo_reg[i][0]) != bmi088_accel_fifo_reg[i][1])
+        {
+            return bmi088_accel_fifo_reg[i][2];
+        }
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    }
+    for (uint8_t i = 0; i < sizeof(bmi088_gyro_fifo_reg) / sizeof(bmi088_gyro_fifo_reg[0]); i++)
+    {
+        Gyro_Write_Single_Reg(bmi088, bmi088_gyro_fifo_reg[i][0], bmi088_gyro_fifo_reg[i][1]);
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+        if (Gyro_Read_Single_Reg(bmi088, bmi088_gyro_fifo_reg[i][0]) != bmi088_gyro_fifo_reg[i][1])
+        {
+            return bmi088_gyro_fifo_reg[i][2];
+        }
+        Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    }
+    // 丢弃切换到 FIFO 配置前写入的帧
+    Accel_Write_Single_Reg(bmi088, BMI088_ACC_SOFTRESET, BMI088_ACC_FIFO_FLUSH_VALUE);
+    Dwt_delay_us(BMI088_COM_WAIT_SENSOR_TIME);
+    return BMI088_NO_ERROR;
+}
+
+static void Bmi088_Fifo_Finish(Bmi088Instance_s* instance, uint8_t type);
+
+/**
+ * @brief 提交读取 FIFO 长度的任务
+ * @param instance BMI088实例指针
+ * @param type 传感器类型
+ */
+static void Bmi088_Fifo_Read_Level(Bmi088Instance_s* instance, uint8_t type)
+{
+    SpiJob_s* job = &instance->job[type];
+    uint8_t* tx = (uint8_t*)job->tx;
+    instance->fifo[type].phase = BMI088_FIFO_PHASE_LEVEL;
+    tx[1] = 0; // 清除阶段写入的数据
+    if (type == BMI088_SAMPLE_ACCEL)
+    {
+        tx[0] = BMI088_TEMP_M | 0x80;
+        job->len = BMI088_FIFO_ACCEL_LEVEL_LEN;
+    }
+    else
+    {
+        tx[0] = BMI088_GYRO_FIFO_STATUS | 0x80;
+        job->len = BMI088_FIFO_GYRO_LEVEL_LEN;
+    }
+    if (!Spi_Submit(job))
+    {
+        instance->stat.spi_error++;
+        Bmi088_Fifo_Finish(instance, type);
+    }
+}
+
+/**
+ * @brief 结束一次读取，读取过程中来过水印中断则立即再读一次
+ * @param instance BMI088实例指针
+ * @param type 传感器类型
+ */
+static void Bmi088_Fifo_Finish(Bmi088Instance_s* instance, uint8_t type)
+{
+    Bmi088Fifo_s* fifo = &instance->fifo[type];
+    bool again = false;
+
+    BMI088_ENTER_CRITICAL();
+    if (fifo->irq_pending)
+    {
+        // 该中断可能由本次已读走的帧触发，不能用来校准
+        fifo->irq_pending = false;
+        fifo->irq_cycle = fifo->pending_cycle;
+        fifo->anchor_ok = false;
+        again = true;
+    }
+    else
+    {
+        fifo->busy = false;
+    }
+    BMI088_EXIT_CRITICAL();
+
+    if (again)
+    {
+        Bmi088_Fifo_Read_Level(instance, type);
+    }
+}
+
+/**
+ * @brief FIFO 水印中断回调，记录时刻并开始读取
+ * @param gpio GPIO 实例指针
+ */
+static void Bmi088_Fifo_Irq_Callback(GpioInstance_s* gpio)
+{
+    const uint32_t cycle = Dwt_Get_Cycle();
+    Bmi088Instance_s* instance = gpio->parent_ptr;
+    const uint8_t type = (gpio == instance->drdy[BMI088_SAMPLE_GYRO]) ? BMI088_SAMPLE_GYRO : BMI088_SAMPLE_ACCEL;
+    Bmi088Fifo_s* fifo = &instance->fifo[type];
+    bool start = false;
+
+    BMI088_ENTER_CRITICAL();
+    if (fifo->busy)
+    {
+        // 数据仍在 FIFO 中，本次读取结束后再读
+        fifo->irq_pending = true;
+        fifo->pending_cycle = cycle;
+    }
+    else
+    {
+        fifo->busy = true;
+        fifo->irq_cycle = cycle;
+        fifo->anchor_ok = true;
+        start = true;
+    }
+    BMI088_EXIT_CRITICAL();
+
+    if (start)
+    {
+        Bmi088_Fifo_Read_Level(instance, type);
+    }
+}
+
+/**
+ * @brief 推算本批第一帧的时刻并更新帧周期估计
+ * @param fifo FIFO 状态
+ * @param frames 本批帧数
+ * @param wtm 水印帧数
+ * @param oldest_lost 流模式溢出，最旧的帧被覆盖
+ * @return 第一帧的 DWT 时刻
+ * @details 由新水印中断触发且最旧的帧未丢失时，第 wtm 帧就是触发中断的帧，以中断时刻校准；
+ *          流模式溢出时触发帧已被覆盖，以读取长度的时刻作为最后一帧的时刻；其余情况接着上一帧推算。
+ */
+static uint32_t Bmi088_Fifo_Timebase(Bmi088Fifo_s* fifo, uint16_t frames, uint16_t wtm, bool oldest_lost)
+{
+    if (oldest_lost || (fifo->frame_index == 0 && (!fifo->anchor_ok || frames < wtm)))
+    {
+        fifo->anchor_valid = false;
+        return fifo->level_cycle - (uint32_t)((float)(frames - 1) * fifo->period + 0.5f);
+    }
+    if (!fifo->anchor_ok || frames < wtm)
+    {
+        return fifo->last_cycle + (uint32_t)(fifo->period + 0.5f);
+    }
+
+    const uint32_t anchor_index = fifo->frame_index + wtm - 1;
+    const uint32_t anchor_cycle = fifo->irq_cycle;
+    if (fifo->anchor_valid && anchor_index != fifo->anchor_index)
+    {
+        const float measured = (float)(anchor_cycle - fifo->anchor_cycle) / (float)(anchor_index - fifo->anchor_index);
+        const float tol = fifo->period_nominal * BMI088_FIFO_PERIOD_TOL;
+        if (measured > fifo->period_nominal - tol && measured < fifo->period_nominal + tol)
+        {
+            fifo->period += (measured - fifo->period) * BMI088_FIFO_PERIOD_GAIN;
+        }
+    }
+    fifo->anchor_index = anchor_index;
+    fifo->anchor_cycle = anchor_cycle;
+    fifo->anchor_valid = true;
+    return anchor_cycle - (uint32_t)((float)(wtm - 1) * fifo->period + 0.5f);
+}
+
+/**
+ * @brief 解析加速度计 FIFO 数据并放入样本队列
+ * @param instance BMI088实例指针
+ * @param data FIFO 数据
+ * @param len 数据长度
+ */
+static void Bmi088_Fifo_Parse_Accel(Bmi088Instance_s* instance, const uint8_t* data, uint16_t len)
+{
+    Bmi088Fifo_s* fifo = &instance->fifo[BMI088_SAMPLE_ACCEL];
+
+    // 第一遍：统计加速度帧数，检查跳帧
+    uint16_t frames = 0;
+    uint16_t end = 0;
+    while (end < len)
+    {
+        const uint8_t header = data[end] & BMI088_ACC_FIFO_HEADER_MASK;
+        uint8_t frame_len = 0;
+        switch (header)
+        {
+            case BMI088_ACC_FIFO_FRAME_ACC: frame_len = BMI088_ACC_FIFO_ACC_FRAME_LEN; frames++; break;
+            case BMI088_ACC_FIFO_FRAME_SKIP: frame_len = 2; fifo->overflow = true; break;
+            case BMI088_ACC_FIFO_FRAME_TIME: frame_len = 4; break;
+            case BMI088_ACC_FIFO_FRAME_CONFIG:
+            case BMI088_ACC_FIFO_FRAME_DROP: frame_len = 2; break;
+            default: break;
+        }
+        if (frame_len == 0 || end + frame_len > len)
+        {
+            // 读空后的填充字节或损坏的帧头，丢弃剩余数据
+            if (data[end] != BMI088_ACC_FIFO_FRAME_EMPTY)
+            {
+                instance->stat.fifo_frame_error++;
+            }
+            break;
+        }
+        end += frame_len;
+    }
+    if (fifo->overflow)
+    {
+        instance->stat.fifo_overflow++;
+    }
+    if (frames == 0)
+    {
+        return;
+    }
+
+    // 第二遍：按帧推算时刻并入队
+    const uint32_t first = Bmi088_Fifo_Timebase(fifo, frames, BMI088_FIFO_ACCEL_WTM, fifo->overflow);
+    Bmi088Sample_s sample = {0};
+    sample.type = BMI088_SAMPLE_ACCEL;
+    sample.temperate = fifo->temperate;
+    uint16_t k = 0;
+    for (uint16_t pos = 0; pos < end;)
+    {
+        if ((data[pos] & BMI088_ACC_FIFO_HEADER_MASK) != BMI088_ACC_FIFO_FRAME_ACC)
+        {
+            pos += ((data[pos] & BMI088_ACC_FIFO_HEADER_MASK) == BMI088_ACC_FIFO_FRAME_TIME) ? 4 : 2;
+            continue;
+        }
+        Bmi088_Parse_Xyz(&data[pos + 1], sample.data);
+        sample.cycle = first + (uint32_t)((float)k * fifo->period + 0.5f);
+        Bmi088_Push_Sample(instance, &sample);
+        pos += BMI088_ACC_FIFO_ACC_FRAME_LEN;
+        k++;
+    }
+    fifo->last_cycle = sample.cycle;
+    fifo->frame_index += frames;
+}
 
-    // 解析温度数据（只使用 11 位数据）并转换为摄氏度
-    *temperate = (float)(int16_t)(accel_buf[2] << 3 | accel_buf[3] >> 5) * BMI088_TEMP_FACTOR + BMI088_TEMP_OFFSET;
+/**
+ * @brief 解析陀螺仪 FIFO 数据并放入样本队列
+ * @param instance BMI088实例指针
+ * @param data FIFO 数据
+ * @param frames 帧数
+ */
+static void Bmi088_Fifo_Parse_Gyro(Bmi088Instance_s* instance, const uint8_t* data, uint16_t frames)
+{
+    Bmi088Fifo_s* fifo = &instance->fifo[BMI088_SAMPLE_GYRO];
+    const uint32_t first = Bmi088_Fifo_Timebase(fifo, frames, BMI088_FIFO_GYRO_WTM, false);
+    if (fifo->overflow)
+    {
+        // FIFO 模式溢出时保留的是最旧的帧，本批时刻有效，之后的帧序号不再连续
+        fifo->anchor_valid = false;
+    }
+    Bmi088Sample_s sample = {0};
+    sample.type = BMI088_SAMPLE_GYRO;
+    for (uint16_t k = 0; k < frames; k++)
+    {
+        Bmi088_Parse_Xyz(&data[k * BMI088_GYRO_FIFO_FRAME_LEN], sample.data);
+        sample.cycle = first + (uint32_t)((float)k * fifo->period + 0.5f);
+        Bmi088_Push_Sample(instance, &sample);
+    }
+    fifo->last_cycle = sample.cycle;
+    fifo->frame_index += frames;
+}
+
+/**
+ * @brief FIFO 读取任务完成回调，推进读取阶段
+ * @param job 读取任务指针
+ * @param success 传输是否成功
+ */
+static void Bmi088_Fifo_Job_Callback(SpiJob_s* job, bool success)
+{
+    Bmi088Instance_s* instance = job->parent_ptr;
+    const uint8_t type = (job == &instance->job[BMI088_SAMPLE_GYRO]) ? BMI088_SAMPLE_GYRO : BMI088_SAMPLE_ACCEL;
+    Bmi088Fifo_s* fifo = &instance->fifo[type];
+    uint8_t* tx = (uint8_t*)job->tx;
+    const uint8_t* rx = job->rx;
+
+    if (!success)
+    {
+        // 数据仍在 FIFO 中，下一次水印中断时读出
+        instance->stat.spi_error++;
+        Bmi088_Fifo_Finish(instance, type);
+        return;
+    }
+
+    switch (fifo->phase)
+    {
+        case BMI088_FIFO_PHASE_LEVEL:
+            fifo->level_cycle = Dwt_Get_Cycle();
+            if (type == BMI088_SAMPLE_ACCEL)
+            {
+                fifo->temperate = Bmi088_Parse_Temp(rx[2], rx[3]);
+                fifo->level = (uint16_t)(rx[4] | (rx[5] & BMI088_ACC_FIFO_LENGTH_1_MASK) << 8);
+                fifo->level = fifo->level > BMI088_ACC_FIFO_SIZE ? BMI088_ACC_FIFO_SIZE : fifo->level;
+                // 流模式下 FIFO 已满说明最旧的帧已被覆盖，跳帧帧也可能要到下一次读取才出现
+                fifo->overflow = fifo->level + BMI088_ACC_FIFO_ACC_FRAME_LEN > BMI088_ACC_FIFO_SIZE;
+                tx[0] = BMI088_ACC_FIFO_DATA | 0x80;
+                job->len = 2 + fifo->level;
+            }
+            else
+            {
+                fifo->level = rx[1] & BMI088_GYRO_FIFO_COUNT_MASK;
+                fifo->level = fifo->level > BMI088_GYRO_FIFO_SIZE ? BMI088_GYRO_FIFO_SIZE : fifo->level;
+                fifo->overflow = (rx[1] & BMI088_GYRO_FIFO_OVERRUN) != 0;
+                tx[0] = BMI088_GYRO_FIFO_DATA | 0x80;
+                job->len = 1 + fifo->level * BMI088_GYRO_FIFO_FRAME_LEN;
+            }
+            if (fifo->level == 0)
+            {
+                Bmi088_Fifo_Finish(instance, type);
+                return;
+            }
+            fifo->phase = BMI088_FIFO_PHASE_DATA;
+            break;
+
+        case BMI088_FIFO_PHASE_DATA:
+            if (type == BMI088_SAMPLE_ACCEL)
+            {
+                Bmi088_Fifo_Parse_Accel(instance, &rx[2], fifo->level);
+                Bmi088_Fifo_Finish(instance, type);
+                return;
+            }
+            Bmi088_Fifo_Parse_Gyro(instance, &rx[1], fifo->level);
+            if (!fifo->overflow)
+            {
+                Bmi088_Fifo_Finish(instance, type);
+                return;
+            }
+            // FIFO 模式溢出后停止写入，需重新写 FIFO_CONFIG_1
+            instance->stat.fifo_overflow++;
+            tx[0] = BMI088_GYRO_FIFO_CONFIG_1;
+            tx[1] = BMI088_GYRO_FIFO_MODE;
+            job->len = 2;
+            fifo->phase = BMI088_FIFO_PHASE_CLEAR;
+            break;
+
+        default:
+            Bmi088_Fifo_Finish(instance, type);
+            return;
+    }
+
+    if (!Spi_Submit(job))
+    {
+        instance->stat.spi_error++;
+        Bmi088_Fifo_Finish(instance, type);
+    }
+}
+
+/**
+ * @brief 启动 FIFO 水印中断采样
+ * @param bmi088 BMI088实例指针
+ * @return true 成功  false 未配置中断引脚、DWT 未初始化、FIFO 寄存器配置失败或资源分配失败
+ */
+bool Bmi088_Start_Fifo_Sampling(Bmi088Instance_s* bmi088)
+{
+    static const uint16_t buf_len[BMI088_SAMPLE_TYPE_CNT] = {BMI088_FIFO_ACCEL_BUF_LEN, BMI088_FIFO_GYRO_BUF_LEN};
+    static const uint8_t level_reg[BMI088_SAMPLE_TYPE_CNT] = {BMI088_TEMP_M, BMI088_GYRO_FIFO_STATUS};
+
+    if (bmi088 == NULL || bmi088->config.accel_int_port == NULL || bmi088->config.gyro_int_port == NULL)
+    {
+        Log_Error("Bmi088_Start_Fifo_Sampling : interrupt pin is not configured");
+        return false;
+    }
+    if (Bmi088_Sampling_Started(bmi088))
+    {
+        return true;
+    }
+    const float s_per_cycle = Dwt_Cycle_To_S(1);
+    if (s_per_cycle <= 0.0f)
+    {
+        Log_Error("Bmi088_Start_Fifo_Sampling : DWT is not initialized");
+        return false;
+    }
+
+    const uint8_t error = Bmi088_Fifo_Config(bmi088);
+    if (error != BMI088_NO_ERROR)
+    {
+        Log_Error("Bmi088_Start_Fifo_Sampling : FIFO config error %d", error);
+        return false;
+    }
+
+    const float odr[BMI088_SAMPLE_TYPE_CNT] =
+    {
+        bmi088_accel_odr[bmi088->config.accel_odr].value,
+        bmi088_gyro_odr[bmi088->config.gyro_odr].value
+    };
+    for (uint8_t type = 0; type < BMI088_SAMPLE_TYPE_CNT; type++)
+    {
+        Bmi088Fifo_s* fifo = &bmi088->fifo[type];
+        memset(fifo, 0, sizeof(Bmi088Fifo_s));
+        fifo->period_nominal = 1.0f / (s_per_cycle * odr[type]);
+        fifo->period = fifo->period_nominal;
+    }
+    if (!Bmi088_Sampling_Setup(bmi088, buf_len, level_reg, Bmi088_Fifo_Irq_Callback, Bmi088_Fifo_Job_Callback))
+    {
+        return false;
+    }
+    Log_Passing("BMI088 FIFO Sampling Start");
+    return true;
+}
+
+/**
+ * @brief 取出中断采样得到的样本
+ * @param bmi088 BMI088实例指针
+ * @param samples 样本输出数组
+ * @param max 最多取出的样本数
+ * @return 实际取出的样本数，两个传感器的样本按时刻归并
+ */
+uint32_t Bmi088_Pop_Samples(Bmi088Instance_s* bmi088, Bmi088Sample_s* samples, uint32_t max)
+{
+    if (bmi088 == NULL || !Bmi088_Sampling_Started(bmi088) || samples == NULL)
+    {
+        return 0;
+    }
+    uint32_t n = 0;
+    while (n < max)
+    {
+        // 每轮取两个队列当前的连续可读段归并，段读完或输出满后释放，再取下一段
+        uint32_t avail[BMI088_SAMPLE_TYPE_CNT];
+        const Bmi088Sample_s* head[BMI088_SAMPLE_TYPE_CNT];
+        uint32_t used[BMI088_SAMPLE_TYPE_CNT] = {0};
+        for (uint8_t type = 0; type < BMI088_SAMPLE_TYPE_CNT; type++)
+        {
+            head[type] = SpscQueue_Peek(bmi088->queue[type], &avail[type]);
+        }
+        if (avail[BMI088_SAMPLE_ACCEL] == 0 && avail[BMI088_SAMPLE_GYRO] == 0)
+        {
+            break;
+        }
+        while (n < max && used[BMI088_SAMPLE_ACCEL] < avail[BMI088_SAMPLE_ACCEL] &&
+               used[BMI088_SAMPLE_GYRO] < avail[BMI088_SAMPLE_GYRO])
+        {
+            const Bmi088Sample_s* accel = &head[BMI088_SAMPLE_ACCEL][used[BMI088_SAMPLE_ACCEL]];
+            const Bmi088Sample_s* gyro = &head[BMI088_SAMPLE_GYRO][used[BMI088_SAMPLE_GYRO]];
+            // DWT 计数回绕，按有符号差比较先后
+            const uint8_t type = ((int32_t)(accel->cycle - gyro->cycle) <= 0) ? BMI088_SAMPLE_ACCEL : BMI088_SAMPLE_GYRO;
+            samples[n++] = (type == BMI088_SAMPLE_ACCEL) ? *accel : *gyro;
+            used[type]++;
+        }
+        // 只剩一个传感器有数据时直接复制；另一个段读完但队列未空时先释放，下一轮重新归并
+        for (uint8_t type = 0; type < BMI088_SAMPLE_TYPE_CNT; type++)
+        {
+            const uint8_t other = (uint8_t)(BMI088_SAMPLE_TYPE_CNT - 1u - type);
+            if (avail[other] == 0)
+            {
+                while (n < max && used[type] < avail[type])
+                {
+                    samples[n++] = head[type][used[type]++];
+                }
+            }
+            SpscQueue_Release(bmi088->queue[type], used[type]);
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief 获取中断采样统计
+ * @param bmi088 BMI088实例指针
+ * @return 统计信息指针，未启动采样返回NULL
+ */
+const Bmi088SampleStat_s* Bmi088_Get_Sample_Stat(const Bmi088Instance_s* bmi088)
+{
+    if (bmi088 == NULL || !Bmi088_Sampling_Started(bmi088))
+    {
+        return NULL;
+    }
+    return &bmi088->stat;
 }
@@ -1,7 +1,10 @@
 /**
  * @file bmi088.h
  * @brief BMI088 6轴IMU传感器驱动头文件
- * @details 定义BMI088传感器的数据结构、函数接口和相关配置
+ * @details 定义BMI088传感器的数据结构、函数接口和相关配置。
+ *          每个 BMI088 是一个实例，量程、输出数据率和带宽在注册时选择，灵敏度随实例保存；
+ *          不同实例可以位于不同 SPI 总线、使用不同的中断引脚。
+ *          延时使用 bsp_dwt，注册前需调用 Dwt_Init。
  * @author Embedded Framework Team
  * @date 2025
  * @version 1.0
@@ -13,46 +16,285 @@
 /* ========================= 头文件包含 ========================= */
 
 #include "stdint.h"
+#include "stdbool.h"
 #include "bsp_spi.h"
+#include "bsp_gpio.h"
+#include "spsc_queue.h"
+
+/* ========================= 宏定义 ========================= */
+
+#define BMI088_SAMPLE_QUEUE_LEN 128u /**< 每个传感器的中断采样队列容量，2的幂，按消费周期内该传感器最多到达的样本数配置 */
+
+#define BMI088_FIFO_ACCEL_WTM 8u     /**< FIFO 采样时加速度计水印帧数，1600Hz 下约 200Hz 中断 */
+#define BMI088_FIFO_GYRO_WTM 10u     /**< FIFO 采样时陀螺仪水印帧数，2000Hz 下 200Hz 中断 */
+
+#if BMI088_FIFO_ACCEL_WTM == 0 || BMI088_FIFO_ACCEL_WTM > 100 || BMI088_FIFO_GYRO_WTM == 0 || BMI088_FIFO_GYRO_WTM > 100
+#error "BMI088 FIFO watermark must be 1..100 frames"
+#endif
+#if BMI088_FIFO_ACCEL_WTM * 2u > BMI088_SAMPLE_QUEUE_LEN || BMI088_FIFO_GYRO_WTM * 2u > BMI088_SAMPLE_QUEUE_LEN
+#error "BMI088_SAMPLE_QUEUE_LEN must hold at least two FIFO batches of each sensor"
+#endif
 
 /* ========================= 数据结构定义 ========================= */
 
 /**
- * @brief BMI088实例结构体
- * @details 包含BMI088传感器的加速度计和陀螺仪SPI接口实例
+ * @brief 加速度计量程
+ */
+typedef enum
+{
+    BMI088_ACCEL_RANGE_3G = 0,  /**< ±3g */
+    BMI088_ACCEL_RANGE_6G,      /**< ±6g */
+    BMI088_ACCEL_RANGE_12G,     /**< ±12g */
+    BMI088_ACCEL_RANGE_24G,     /**< ±24g */
+    BMI088_ACCEL_RANGE_CNT
+} Bmi088AccelRange_e;
+
+/**
+ * @brief 加速度计输出数据率
+ */
+typedef enum
+{
+    BMI088_ACCEL_ODR_12_5HZ = 0,
+    BMI088_ACCEL_ODR_25HZ,
+    BMI088_ACCEL_ODR_50HZ,
+    BMI088_ACCEL_ODR_100HZ,
+    BMI088_ACCEL_ODR_200HZ,
+    BMI088_ACCEL_ODR_400HZ,
+    BMI088_ACCEL_ODR_800HZ,
+    BMI088_ACCEL_ODR_1600HZ,
+    BMI088_ACCEL_ODR_CNT
+} Bmi088AccelOdr_e;
+
+/**
+ * @brief 加速度计带宽（过采样），NORMAL 带宽最高，OSR4 最低
+ */
+typedef enum
+{
+    BMI088_ACCEL_BWP_OSR4 = 0,
+    BMI088_ACCEL_BWP_OSR2,
+    BMI088_ACCEL_BWP_NORMAL,
+    BMI088_ACCEL_BWP_CNT
+} Bmi088AccelBwp_e;
+
+/**
+ * @brief 陀螺仪量程
+ */
+typedef enum
+{
+    BMI088_GYRO_RANGE_2000DPS = 0,  /**< ±2000°/s */
+    BMI088_GYRO_RANGE_1000DPS,      /**< ±1000°/s */
+    BMI088_GYRO_RANGE_500DPS,       /**< ±500°/s */
+    BMI088_GYRO_RANGE_250DPS,       /**< ±250°/s */
+    BMI088_GYRO_RANGE_125DPS,       /**< ±125°/s */
+    BMI088_GYRO_RANGE_CNT
+} Bmi088GyroRange_e;
+
+/**
+ * @brief 陀螺仪输出数据率和带宽，两者由同一个寄存器决定
+ */
+typedef enum
+{
+    BMI088_GYRO_ODR_2000HZ_BW_532HZ = 0,
+    BMI088_GYRO_ODR_2000HZ_BW_230HZ,
+    BMI088_GYRO_ODR_1000HZ_BW_116HZ,
+    BMI088_GYRO_ODR_400HZ_BW_47HZ,
+    BMI088_GYRO_ODR_200HZ_BW_23HZ,
+    BMI088_GYRO_ODR_100HZ_BW_12HZ,
+    BMI088_GYRO_ODR_200HZ_BW_64HZ,
+    BMI088_GYRO_ODR_100HZ_BW_32HZ,
+    BMI088_GYRO_ODR_CNT
+} Bmi088GyroOdr_e;
+
+/**
+ * @brief 采样类型
+ */
+typedef enum
+{
+    BMI088_SAMPLE_ACCEL = 0, /**< 加速度计样本，同时带温度 */
+    BMI088_SAMPLE_GYRO = 1,  /**< 陀螺仪样本 */
+    BMI088_SAMPLE_TYPE_CNT
+} Bmi088SampleType_e;
+
+/**
+ * @brief 中断采样得到的一个样本
  */
 typedef struct
 {
-    SpiInstance_s* accel;  /**< 加速度计SPI接口实例指针 */
-    SpiInstance_s* gyro;   /**< 陀螺仪SPI接口实例指针 */
-} Bmi088Instance_s;
+    uint32_t cycle;     /**< 数据就绪中断时刻，DWT周期计数 */
+    int16_t data[3];    /**< 原始值[X, Y, Z] */
+    uint8_t type;       /**< Bmi088SampleType_e */
+    float temperate;    /**< 温度（℃），仅加速度计样本有效 */
+} Bmi088Sample_s;
+
+/**
+ * @brief 中断采样统计
+ */
+typedef struct
+{
+    uint32_t sample_cnt[BMI088_SAMPLE_TYPE_CNT]; /**< 入队样本数 */
+    uint32_t drdy_overrun;  /**< 上一次数据就绪尚未读取完成时又来新的数据就绪，有一个样本被跳过 */
+    uint32_t queue_full;    /**< 队列满丢弃的样本数 */
+    uint32_t spi_error;     /**< SPI 启动失败或传输错误次数 */
+    uint32_t fifo_overflow; /**< 读取时发现 FIFO 溢出的批次数，溢出时有帧丢失 */
+    uint32_t fifo_frame_error; /**< 无法解析的 FIFO 帧头次数，该次读取的剩余数据被丢弃 */
+} Bmi088SampleStat_s;
+
+/**
+ * @brief FIFO 采样状态，每个传感器一份
+ * @details 帧时刻 = 水印中断时刻 + (帧序号 - 触发水印的帧序号) * 帧周期，
+ *          帧周期由相邻两次水印中断的时间差和帧数差低通估计，补偿传感器时钟与 CPU 时钟的偏差
+ */
+typedef struct
+{
+    volatile bool busy;             /**< 正在读取（长度 -> 数据 -> 清除溢出） */
+    volatile bool irq_pending;      /**< 读取过程中又来水印中断，读取完成后再读一次 */
+    volatile uint32_t irq_cycle;    /**< 本次读取对应的水印中断时刻 */
+    volatile uint32_t pending_cycle;/**< 读取过程中到来的水印中断时刻 */
+    bool anchor_ok;                 /**< 本次读取由新的水印中断触发，可以用中断时刻校准 */
+    uint8_t phase;                  /**< 读取阶段 */
+    uint16_t level;                 /**< 本次读取的字节数(加速度计)或帧数(陀螺仪) */
+    bool overflow;                  /**< 本次读取前 FIFO 已溢出 */
+    uint32_t level_cycle;           /**< 读取 FIFO 长度完成的时刻 */
+    float period;                   /**< 帧周期估计，DWT周期数 */
+    float period_nominal;           /**< 标称帧周期，DWT周期数 */
+    uint32_t frame_index;           /**< 已读取的帧总数 */
+    uint32_t anchor_index;          /**< 上一次校准的帧序号 */
+    uint32_t anchor_cycle;          /**< 上一次校准的时刻 */
+    bool anchor_valid;              /**< anchor_* 有效 */
+    uint32_t last_cycle;            /**< 最后一帧的时刻 */
+    float temperate;                /**< 加速度计：最近读取的温度（℃） */
+} Bmi088Fifo_s;
 
 /**
  * @brief BMI088初始化配置结构体
- * @details 包含BMI088传感器初始化所需的SPI配置参数
+ * @details SPI 配置中的 mode 会被忽略：寄存器读写使用阻塞模式，启动中断采样后切换为 DMA 模式
  */
 typedef struct
 {
-    SpiInitConfig_s accel; /**< 加速度计SPI初始化配置 */
-    SpiInitConfig_s gyro;  /**< 陀螺仪SPI初始化配置 */
+    SpiInitConfig_s accel;          /**< 加速度计SPI初始化配置 */
+    SpiInitConfig_s gyro;           /**< 陀螺仪SPI初始化配置 */
+    GPIO_TypeDef* accel_int_port;   /**< 加速度计 INT1 引脚，不使用中断采样可为NULL */
+    uint16_t accel_int_pin;
+    GPIO_TypeDef* gyro_int_port;    /**< 陀螺仪 INT3 引脚，不使用中断采样可为NULL */
+    uint16_t gyro_int_pin;
+    Bmi088AccelRange_e accel_range; /**< 加速度计量程 */
+    Bmi088AccelOdr_e accel_odr;     /**< 加速度计输出数据率 */
+    Bmi088AccelBwp_e accel_bwp;     /**< 加速度计带宽 */
+    Bmi088GyroRange_e gyro_range;   /**< 陀螺仪量程 */
+    Bmi088GyroOdr_e gyro_odr;       /**< 陀螺仪输出数据率和带宽 */
+    bool self_test;                 /**< 注册时执行自测试，约 150ms，需保持静止 */
 } Bmi088InitConfig_s;
 
+/**
+ * @brief BMI088实例结构体
+ * @details 包含BMI088传感器的加速度计和陀螺仪SPI接口实例、量程配置，以及中断采样状态
+ */
+typedef struct
+{
+    SpiInstance_s* accel;  /**< 加速度计SPI接口实例指针 */
+    SpiInstance_s* gyro;   /**< 陀螺仪SPI接口实例指针 */
+    Bmi088InitConfig_s config;      /**< 注册时的配置 */
+    float accel_sen;                /**< 加速度计灵敏度，m/s^2 每LSB */
+    float gyro_sen;                 /**< 陀螺仪灵敏度，rad/s 每LSB */
+
+    /* 中断采样，Bmi088_Start_Sampling / Bmi088_Start_Fifo_Sampling 之后有效 */
+    GpioInstance_s* drdy[BMI088_SAMPLE_TYPE_CNT];    /**< 数据就绪/FIFO水印中断引脚(INT1/INT3) */
+    SpiJob_s job[BMI088_SAMPLE_TYPE_CNT];            /**< 突发读取任务，缓冲区由 Memory_Region_Malloc 分配 */
+    volatile uint32_t drdy_cycle[BMI088_SAMPLE_TYPE_CNT]; /**< 读取任务对应的数据就绪时刻 */
+    Bmi088Fifo_s fifo[BMI088_SAMPLE_TYPE_CNT];       /**< FIFO 采样状态，Bmi088_Start_Fifo_Sampling 之后有效 */
+    SpscQueue_s* queue[BMI088_SAMPLE_TYPE_CNT];      /**< 样本队列，每个传感器一个，由各自的 SPI 完成中断生产，任务消费 */
+    Bmi088SampleStat_s stat;        /**< 采样统计 */
+} Bmi088Instance_s;
+
 /* ========================= 函数声明 ========================= */
 
 /**
- * @brief BMI088传感器初始化函数
- * @return 错误码，BMI088_NO_ERROR表示成功，其他值表示对应错误
- * @details 初始化BMI088传感器，包括SPI接口注册、加速度计和陀螺仪初始化
+ * @brief 填写板载 BMI088 的默认配置
+ * @param config 配置结构体指针
+ * @param spi_handle_number SPI句柄编号
+ * @details 片选和中断引脚使用 CubeMX 标签 ACC_CS / GYRO_CS / ACC_INT / GYRO_INT，
+ *          加速度计 ±3g、800Hz、NORMAL 带宽，陀螺仪 ±2000°/s、1000Hz/116Hz，不执行自测试
  */
-uint8_t BMI088_init(void);
+void Bmi088_Default_Config(Bmi088InitConfig_s* config, uint8_t spi_handle_number);
+
+/**
+ * @brief BMI088注册函数
+ * @param config 初始化配置结构体指针
+ * @return BMI088实例指针，注册成功返回实例指针，SPI注册、芯片ID、寄存器配置或自测试失败返回NULL
+ * @details 软复位后按配置写入寄存器并逐个读回校验，需在 Dwt_Init 之后调用
+ */
+Bmi088Instance_s* Bmi088_Register(Bmi088InitConfig_s* config);
+
+/**
+ * @brief BMI088自测试
+ * @param bmi088 BMI088实例指针
+ * @return BMI088_NO_ERROR 通过；否则为 BMI088_SELF_TEST_ACCEL_ERROR / BMI088_SELF_TEST_GYRO_ERROR 的组合，
+ *         或重新初始化失败的错误码
+ * @details 加速度计在 ±24g 下施加正负静电激励，检查各轴差值；陀螺仪运行内置自测试(BIST)。
+ *          完成后软复位并按实例配置重新初始化。耗时约 150ms，需保持静止，只能在启动中断采样之前调用。
+ */
+uint8_t Bmi088_Self_Test(Bmi088Instance_s* bmi088);
+
+/**
+ * @brief 读取BMI088原始数据
+ * @param bmi088 BMI088实例指针
+ * @param gyro 陀螺仪原始值[X, Y, Z]
+ * @param accel 加速度计原始值[X, Y, Z]
+ * @param temperate 温度数据指针（℃）
+ * @return true 成功  false 启动中断采样后不可用，或陀螺仪芯片ID校验失败，gyro 未更新
+ * @details 物理量 = 原始值 * gyro_sen / accel_sen，校准模块在此基础上合并零偏和比例修正
+ */
+bool Bmi088_Read_Raw(Bmi088Instance_s* bmi088, int16_t gyro[3], int16_t accel[3], float* temperate);
 
 /**
  * @brief 读取BMI088传感器数据
- * @param gyro 陀螺仪数据数组[X, Y, Z]（°/s）
- * @param accel 加速度计数据数组[X, Y, Z]（g）
+ * @param bmi088 BMI088实例指针
+ * @param gyro 陀螺仪数据数组[X, Y, Z]（rad/s）
+ * @param accel 加速度计数据数组[X, Y, Z]（m/s^2）
  * @param temperate 温度数据指针（℃）
- * @details 从BMI088读取陀螺仪、加速度计和温度数据，并转换为物理单位
+ * @return true 成功  false 读取失败，gyro 未更新
+ * @details 从BMI088读取陀螺仪、加速度计和温度数据，并按实例灵敏度转换为物理单位
+ */
+bool Bmi088_Read(Bmi088Instance_s* bmi088, float gyro[3], float accel[3], float* temperate);
+
+/**
+ * @brief 启动数据就绪中断采样
+ * @param bmi088 BMI088实例指针
+ * @return true 成功  false 未配置中断引脚或资源分配失败
+ * @details 加速度计 INT1、陀螺仪 INT3 的数据就绪中断记录 DWT 时刻并提交一次 DMA 突发读取任务，
+ *          读取完成后在 SPI 中断中解析并放入样本队列；两个读取任务优先级相同，由 SPI 任务队列按就绪先后执行。
+ *          之后不能再使用 Bmi088_Read_Raw / Bmi088_Read。
+ *          CubeMX 中需将中断引脚配置为下降沿外部中断，SPI 配置收发 DMA。
+ */
+bool Bmi088_Start_Sampling(Bmi088Instance_s* bmi088);
+
+/**
+ * @brief 启动 FIFO 水印中断采样
+ * @param bmi088 BMI088实例指针
+ * @return true 成功  false 未配置中断引脚、DWT 未初始化、FIFO 寄存器配置失败或资源分配失败
+ * @details 加速度计和陀螺仪按实例配置的输出数据率写入硬件 FIFO，达到 BMI088_FIFO_ACCEL_WTM / BMI088_FIFO_GYRO_WTM
+ *          帧后由 INT1 / INT3 触发中断；中断中先读取 FIFO 长度，再用一次 DMA 突发读取全部帧，
+ *          解析后按帧推算 DWT 时刻放入样本队列，每批帧只需一次中断和两次 SPI 传输。
+ *          FIFO 溢出计入 fifo_overflow，溢出后的第一批样本以读取长度的时刻为准重新对时。
+ *          高输出数据率（如陀螺仪 2000Hz）建议使用该模式；与 Bmi088_Start_Sampling 二选一。
+ */
+bool Bmi088_Start_Fifo_Sampling(Bmi088Instance_s* bmi088);
+
+/**
+ * @brief 取出中断采样得到的样本
+ * @param bmi088 BMI088实例指针
+ * @param samples 样本输出数组
+ * @param max 最多取出的样本数
+ * @return 实际取出的样本数，两个传感器的样本按时刻归并
+ * @note 每个实例只能在一个任务中调用
+ */
+uint32_t Bmi088_Pop_Samples(Bmi088Instance_s* bmi088, Bmi088Sample_s* samples, uint32_t max);
+
+/**
+ * @brief 获取中断采样统计
+ * @param bmi088 BMI088实例指针
+ * @return 统计信息指针，未启动采样返回NULL
  */
-void Bmi088_read(float gyro[3], float accel[3], float* temperate);
+const Bmi088SampleStat_s* Bmi088_Get_Sample_Stat(const Bmi088Instance_s* bmi088);
 
 #endif // BMI088_H
@@ -60,6 +60,33 @@
 #define BMI088_TEMP_L 0x23                          /**< 温度数据低字节 */
 /** @} */
 
+/** @defgroup BMI088_ACCEL_FIFO_REGISTERS 加速度计FIFO寄存器
+ * @brief FIFO 共 1024 字节，每帧以 1 字节帧头开始
+ * @{
+ */
+#define BMI088_ACC_FIFO_LENGTH_0 0x24               /**< FIFO字节数低字节 */
+#define BMI088_ACC_FIFO_LENGTH_1 0x25               /**< FIFO字节数高字节 */
+#define BMI088_ACC_FIFO_LENGTH_1_MASK 0x3F          /**< FIFO字节数高字节有效位 */
+#define BMI088_ACC_FIFO_DATA 0x26                   /**< FIFO数据寄存器 */
+#define BMI088_ACC_FIFO_WTM_0 0x46                  /**< FIFO水印字节数低字节 */
+#define BMI088_ACC_FIFO_WTM_1 0x47                  /**< FIFO水印字节数高字节 */
+#define BMI088_ACC_FIFO_CONFIG_0 0x48               /**< FIFO配置寄存器0 */
+#define BMI088_ACC_FIFO_STREAM_MODE 0x02            /**< 流模式，满后覆盖最旧数据 */
+#define BMI088_ACC_FIFO_CONFIG_1 0x49               /**< FIFO配置寄存器1 */
+#define BMI088_ACC_FIFO_ACC_EN 0x50                 /**< 加速度数据写入FIFO（bit4 必须为1） */
+#define BMI088_ACC_FIFO_FLUSH_VALUE 0xB0            /**< 写入 BMI088_ACC_SOFTRESET 清空FIFO */
+#define BMI088_ACC_FIFO_SIZE 1024                   /**< FIFO容量（字节） */
+
+#define BMI088_ACC_FIFO_HEADER_MASK 0xFC            /**< 帧头类型掩码，低 2 位为中断标记 */
+#define BMI088_ACC_FIFO_FRAME_ACC 0x84              /**< 加速度帧，帧头后 6 字节数据 */
+#define BMI088_ACC_FIFO_FRAME_SKIP 0x40             /**< 跳帧帧，帧头后 1 字节为溢出丢失的帧数 */
+#define BMI088_ACC_FIFO_FRAME_TIME 0x44             /**< 传感器时间帧，帧头后 3 字节 */
+#define BMI088_ACC_FIFO_FRAME_CONFIG 0x48           /**< 配置改变帧，帧头后 1 字节 */
+#define BMI088_ACC_FIFO_FRAME_DROP 0x50             /**< 丢弃帧，帧头后 1 字节 */
+#define BMI088_ACC_FIFO_FRAME_EMPTY 0x80            /**< 读取超出 FIFO 长度时返回的填充字节 */
+#define BMI088_ACC_FIFO_ACC_FRAME_LEN 7             /**< 加速度帧长度（字节） */
+/** @} */
+
 /** @defgroup BMI088_ACCEL_CONFIG_REGISTERS 加速度计配置寄存器
  * @{
  */
@@ -129,6 +156,8 @@
 #define BMI088_ACC_INT2_DRDY_INTERRUPT (0x1 << BMI088_ACC_INT2_DRDY_INTERRUPT_SHFITS)  /**< INT2数据就绪中断 */
 #define BMI088_ACC_INT1_DRDY_INTERRUPT_SHFITS 0x2   /**< INT1数据就绪中断位偏移 */
 #define BMI088_ACC_INT1_DRDY_INTERRUPT (0x1 << BMI088_ACC_INT1_DRDY_INTERRUPT_SHFITS)  /**< INT1数据就绪中断 */
+#define BMI088_ACC_INT1_FWM_INTERRUPT_SHFITS 0x0    /**< INT1 FIFO水印中断位偏移 */
+#define BMI088_ACC_INT1_FWM_INTERRUPT (0x1 << BMI088_ACC_INT1_FWM_INTERRUPT_SHFITS)    /**< INT1 FIFO水印中断 */
 
 /** @defgroup BMI088_ACCEL_SELF_TEST 加速度计自测试
  * @{
@@ -179,6 +208,25 @@
 #define BMI088_GYRO_DYDR_SHFITS 0x7                 /**< 陀螺仪数据就绪位偏移 */
 #define BMI088_GYRO_DYDR (0x1 << BMI088_GYRO_DYDR_SHFITS)  /**< 陀螺仪数据就绪标志 */
 
+/** @defgroup BMI088_GYRO_FIFO_REGISTERS 陀螺仪FIFO寄存器
+ * @brief FIFO 共 100 帧，三轴数据时每帧 6 字节，无帧头
+ * @{
+ */
+#define BMI088_GYRO_FIFO_STATUS 0x0E                /**< FIFO状态寄存器 */
+#define BMI088_GYRO_FIFO_OVERRUN 0x80               /**< FIFO溢出标志，写 FIFO_CONFIG_1 清除 */
+#define BMI088_GYRO_FIFO_COUNT_MASK 0x7F            /**< FIFO帧数 */
+#define BMI088_GYRO_FIFO_WM_EN 0x1E                 /**< FIFO水印中断使能寄存器 */
+#define BMI088_GYRO_FIFO_WM_ENABLE 0x88             /**< 使能水印中断 */
+#define BMI088_GYRO_FIFO_WM_DISABLE 0x08            /**< 关闭水印中断 */
+#define BMI088_GYRO_FIFO_CONFIG_0 0x3D              /**< FIFO水印帧数 */
+#define BMI088_GYRO_FIFO_CONFIG_1 0x3E              /**< FIFO模式，写入同时清空FIFO */
+#define BMI088_GYRO_FIFO_MODE 0x40                  /**< FIFO模式，满后停止写入并置溢出标志 */
+#define BMI088_GYRO_FIFO_STREAM_MODE 0x80           /**< 流模式，满后覆盖最旧数据 */
+#define BMI088_GYRO_FIFO_DATA 0x3F                  /**< FIFO数据寄存器 */
+#define BMI088_GYRO_FIFO_SIZE 100                   /**< FIFO容量（帧） */
+#define BMI088_GYRO_FIFO_FRAME_LEN 6                /**< 帧长度（字节） */
+/** @} */
+
 /** @defgroup BMI088_GYRO_RANGE_CONFIG 陀螺仪量程配置
  * @{
  */
@@ -222,6 +270,7 @@
 #define BMI088_GYRO_CTRL 0x15                       /**< 陀螺仪控制寄存器 */
 #define BMI088_DRDY_OFF 0x00                        /**< 关闭数据就绪功能 */
 #define BMI088_DRDY_ON 0x80                         /**< 开启数据就绪功能 */
+#define BMI088_GYRO_FIFO_ON 0x40                    /**< 开启FIFO中断功能 */
 
 /** @defgroup BMI088_GYRO_INT_CONFIG 陀螺仪中断配置
  * @{
@@ -246,6 +295,8 @@
 #define BMI088_GYRO_DRDY_IO_INT3 0x01               /**< 数据就绪中断输出到INT3 */
 #define BMI088_GYRO_DRDY_IO_INT4 0x80               /**< 数据就绪中断输出到INT4 */
 #define BMI088_GYRO_DRDY_IO_BOTH (BMI088_GYRO_DRDY_IO_INT3 | BMI088_GYRO_DRDY_IO_INT4)  /**< 数据就绪中断输出到两个引脚 */
+#define BMI088_GYRO_FIFO_IO_INT3 0x04               /**< FIFO中断输出到INT3 */
+#define BMI088_GYRO_FIFO_IO_INT4 0x20               /**< FIFO中断输出到INT4 */
 /** @} */
 
 /** @defgroup BMI088_GYRO_SELF_TEST 陀螺仪自测试
@@ -296,35 +347,30 @@
  */
 #define BMI088_LONG_DELAY_TIME 80                   /**< 长延时时间(毫秒) */
 #define BMI088_COM_WAIT_SENSOR_TIME 150             /**< 通信等待传感器时间(微秒) */
+#define BMI088_SELF_TEST_SETTLE_TIME 3              /**< 自测试前配置生效时间(毫秒)，数据手册要求 >2ms */
+#define BMI088_SELF_TEST_SIGNAL_TIME 60             /**< 自测试激励生效时间(毫秒)，数据手册要求 >50ms */
+#define BMI088_GYRO_BIST_TIMEOUT 20                 /**< 陀螺仪内置自测试等待上限(毫秒) */
 /** @} */
 
-
-/** @defgroup BMI088_I2C_ADDRESSES I2C地址定义
+/** @defgroup BMI088_SELF_TEST_LIMITS 加速度计自测试阈值
+ * @brief ±24g 量程下正负激励的差值下限 (mg)
  * @{
  */
-#define BMI088_ACCEL_IIC_ADDRESSE (0x18 << 1)       /**< 加速度计I2C地址 */
-#define BMI088_GYRO_IIC_ADDRESSE (0x68 << 1)        /**< 陀螺仪I2C地址 */
+#define BMI088_ACCEL_SELF_TEST_X_MG 1000.0f         /**< X轴差值下限 */
+#define BMI088_ACCEL_SELF_TEST_Y_MG 1000.0f         /**< Y轴差值下限 */
+#define BMI088_ACCEL_SELF_TEST_Z_MG 500.0f          /**< Z轴差值下限 */
 /** @} */
 
-/** @defgroup BMI088_DEFAULT_RANGE_CONFIG 默认量程配置
- * @brief 选择使用的默认量程，只能选择一个
+
+/** @defgroup BMI088_I2C_ADDRESSES I2C地址定义
  * @{
  */
-#define BMI088_ACCEL_RANGE_3G                       /**< 使用加速度计±3g量程 */
-//#define BMI088_ACCEL_RANGE_6G                     /**< 使用加速度计±6g量程 */
-//#define BMI088_ACCEL_RANGE_12G                    /**< 使用加速度计±12g量程 */
-//#define BMI088_ACCEL_RANGE_24G                    /**< 使用加速度计±24g量程 */
-
-#define BMI088_GYRO_RANGE_2000                      /**< 使用陀螺仪±2000°/s量程 */
-//#define BMI088_GYRO_RANGE_1000                    /**< 使用陀螺仪±1000°/s量程 */
-//#define BMI088_GYRO_RANGE_500                     /**< 使用陀螺仪±500°/s量程 */
-//#define BMI088_GYRO_RANGE_250                     /**< 使用陀螺仪±250°/s量程 */
-//#define BMI088_GYRO_RANGE_125                     /**< 使用陀螺仪±125°/s量程 */
+#define BMI088_ACCEL_IIC_ADDRESSE (0x18 << 1)       /**< 加速度计I2C地址 */
+#define BMI088_GYRO_IIC_ADDRESSE (0x68 << 1)        /**< 陀螺仪I2C地址 */
 /** @} */
 
-
 /** @defgroup BMI088_ACCEL_SENSITIVITY 加速度计灵敏度系数
- * @brief 不同量程下的加速度计灵敏度系数 (g/LSB)
+ * @brief 不同量程下的加速度计灵敏度系数 (m/s^2/LSB)
  * @{
  */
 #define BMI088_ACCEL_3G_SEN 0.0008974358974f        /**< ±3g量程灵敏度 */
@@ -335,7 +381,7 @@
 
 
 /** @defgroup BMI088_GYRO_SENSITIVITY 陀螺仪灵敏度系数
- * @brief 不同量程下的陀螺仪灵敏度系数 (°/s/LSB)
+ * @brief 不同量程下的陀螺仪灵敏度系数 (rad/s/LSB)
  * @{
  */
 #define BMI088_GYRO_2000_SEN 0.00106526443603169529841533860381f   /**< ±2000°/s量程灵敏度 */
@@ -406,6 +452,10 @@ enum
     BMI088_GYRO_INT3_INT4_IO_CONF_ERROR = 0x0C,    /**< 陀螺仪INT3/INT4 IO配置错误 */
     BMI088_GYRO_INT3_INT4_IO_MAP_ERROR = 0x0D,     /**< 陀螺仪INT3/INT4 IO映射错误 */
 
+    /* FIFO 配置错误代码 */
+    BMI088_ACC_FIFO_CONFIG_ERROR = 0x0E,           /**< 加速度计FIFO配置错误 */
+    BMI088_GYRO_FIFO_CONFIG_ERROR = 0x0F,          /**< 陀螺仪FIFO配置错误 */
+
     /* 自测试错误代码 */
     BMI088_SELF_TEST_ACCEL_ERROR = 0x80,           /**< 加速度计自测试失败 */
     BMI088_SELF_TEST_GYRO_ERROR = 0x40,            /**< 陀螺仪自测试失败 */
@@ -0,0 +1,84 @@
+#include "bsp_cache.h"
+#include <stddef.h>
+#include "main.h"
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+/**
+ * @brief 判断 D-Cache 是否已使能
+ * @return 1 已使能  0 未使能
+ */
+static inline uint32_t Cache_Is_Enabled(void){
+    return (SCB->CCR & SCB_CCR_DC_Msk) != 0U;
+}
+
+/**
+ * @brief 将区间扩展到完整的缓存行
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ * @param line_addr 输出：对齐后的起始地址
+ * @return 对齐后的长度
+ */
+static inline int32_t Cache_Line_Range(const void* addr, uint32_t len, uint32_t** line_addr){
+    const uint32_t start = (uint32_t)addr & ~(CACHE_LINE_SIZE - 1u);
+    const uint32_t end = ((uint32_t)addr + len + CACHE_LINE_SIZE - 1u) & ~(CACHE_LINE_SIZE - 1u);
+    *line_addr = (uint32_t*)start;
+    return (int32_t)(end - start);
+}
+#endif
+
+/**
+ * @brief 将缓冲区写回内存，DMA 发送前调用
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ */
+void Cache_Clean(const void* addr, uint32_t len){
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (addr == NULL || len == 0u || !Cache_Is_Enabled()){
+        return;
+    }
+    uint32_t* line_addr;
+    const int32_t line_len = Cache_Line_Range(addr, len, &line_addr);
+    SCB_CleanDCache_by_Addr(line_addr, line_len);
+#else
+    (void)addr;
+    (void)len;
+#endif
+}
+
+/**
+ * @brief 使缓冲区对应的缓存行失效，DMA 接收完成后调用
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ */
+void Cache_Invalidate(void* addr, uint32_t len){
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (addr == NULL || len == 0u || !Cache_Is_Enabled()){
+        return;
+    }
+    uint32_t* line_addr;
+    const int32_t line_len = Cache_Line_Range(addr, len, &line_addr);
+    SCB_InvalidateDCache_by_Addr(line_addr, line_len);
+#else
+    (void)addr;
+    (void)len;
+#endif
+}
+
+/**
+ * @brief 写回并失效缓冲区，DMA 接收开始前调用，防止脏行被换出覆盖 DMA 数据
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ */
+void Cache_Clean_Invalidate(void* addr, uint32_t len){
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (addr == NULL || len == 0u || !Cache_Is_Enabled()){
+        return;
+    }
+    uint32_t* line_addr;
+    const int32_t line_len = Cache_Line_Range(addr, len, &line_addr);
+    SCB_CleanInvalidateDCache_by_Addr(line_addr, line_len);
+#else
+    (void)addr;
+    (void)len;
+#endif
+}
@@ -0,0 +1,38 @@
+/**
+ * @file bsp_cache.h
+ * @brief D-Cache 区间维护函数，供 DMA 收发前后调用
+ * @note DMA 缓冲区必须按32字节对齐且长度补齐到32字节(可用 Memory_Region_Malloc 分配)，
+ *       否则失效操作会丢弃与其共享缓存行的其他变量的修改
+ */
+#ifndef BSP_CACHE_H
+#define BSP_CACHE_H
+
+#include <stdint.h>
+
+/**
+ * @brief D-Cache 行大小
+ */
+#define CACHE_LINE_SIZE 32u
+
+/**
+ * @brief 将缓冲区写回内存，DMA 发送前调用
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ */
+void Cache_Clean(const void* addr, uint32_t len);
+
+/**
+ * @brief 使缓冲区对应的缓存行失效，DMA 接收完成后调用
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ */
+void Cache_Invalidate(void* addr, uint32_t len);
+
+/**
+ * @brief 写回并失效缓冲区，DMA 接收开始前调用，防止脏行被换出覆盖 DMA 数据
+ * @param addr 缓冲区地址
+ * @param len 缓冲区长度
+ */
+void Cache_Clean_Invalidate(void* addr, uint32_t len);
+
+#endif // BSP_CACHE_H
@@ -4,6 +4,8 @@
 
 // HCLK 频率 Hz
 static uint32_t hclk_freq = 0;
+// 每个计数值对应的秒数
+static float s_per_count = 0.0f;
 // 每微秒、每毫秒和每秒的计数值
 static uint32_t per_us_count = 0;
 static uint32_t per_ms_count = 0;
@@ -20,6 +22,7 @@ void Dwt_Init(void){
     per_s_count = hclk_freq;
     per_ms_count = hclk_freq / 1000u;
     per_us_count = hclk_freq / 1000000u;
+    s_per_count = 1.0f / (float)hclk_freq;
     // 启用DWT计数器
     CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
     // DWT计数器清零并启动
@@ -36,13 +39,8 @@ void Dwt_delay_us(const uint16_t us){
     const uint32_t start_tick = DWT->CYCCNT;
     // 计算延时所需的计数值
     const uint32_t delay_ticks = us * per_us_count;
-    const uint32_t target_tick = start_tick + delay_ticks;
-    // 处理计数器溢出情况
-    if (start_tick > target_tick){
-        while (DWT->CYCCNT <= UINT32_MAX);
-    }
-    // 等待直到达到目标计数值
-    while (DWT->CYCCNT < target_tick);
+    // 无符号差值在计数器溢出时仍然正确
+    while (DWT->CYCCNT - start_tick < delay_ticks);
 }
 
 /**
@@ -50,15 +48,38 @@ void Dwt_delay_us(const uint16_t us){
  * @param ms 延时毫秒数
  */
 void Dwt_delay_ms(const uint16_t ms){
-    // 获取当前DWT计数值
-    const uint32_t start_tick = DWT->CYCCNT;
-    // 计算延时所需的计数值
-    const uint32_t delay_ticks = ms * per_ms_count;
-    const uint32_t target_tick = start_tick + delay_ticks;
-    // 处理计数器溢出情况
-    if (start_tick > target_tick){
-        while (DWT->CYCCNT <= UINT32_MAX);
+    // 逐毫秒等待，避免长延时的计数值超过一个计数周期
+    for (uint16_t i = 0; i < ms; i++){
+        const uint32_t start_tick = DWT->CYCCNT;
+        while (DWT->CYCCNT - start_tick < per_ms_count);
+    }
+}
+
+/**
+ * @brief 获取DWT计数值
+ * @return 当前CPU周期计数
+ */
+uint32_t Dwt_Get_Cycle(void){
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief 将CPU周期数换算为微秒
+ * @param cycle 周期数
+ * @return 微秒数，Dwt_Init 之前调用返回0
+ */
+uint32_t Dwt_Cycle_To_Us(const uint32_t cycle){
+    if (per_us_count == 0u){
+        return 0u;
     }
-    // 等待直到达到目标计数值
-    while (DWT->CYCCNT < target_tick);
-}
\ No newline at end of file
+    return cycle / per_us_count;
+}
+
+/**
+ * @brief 将CPU周期数换算为秒
+ * @param cycle 周期数
+ * @return 秒数，不截断小数部分，Dwt_Init 之前调用返回0
+ */
+float Dwt_Cycle_To_S(const uint32_t cycle){
+    return (float)cycle * s_per_count;
+}
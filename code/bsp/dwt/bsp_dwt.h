@@ -20,4 +20,24 @@ void Dwt_delay_us(const uint16_t us);
  */
 
 void Dwt_delay_ms(const uint16_t ms);
+
+/**
+ * @brief 获取DWT计数值
+ * @return 当前CPU周期计数，约每 2^32 / HCLK 秒溢出一次，做差时按无符号数相减即可
+ */
+uint32_t Dwt_Get_Cycle(void);
+
+/**
+ * @brief 将CPU周期数换算为微秒
+ * @param cycle 周期数
+ * @return 微秒数，Dwt_Init 之前调用返回0
+ */
+uint32_t Dwt_Cycle_To_Us(uint32_t cycle);
+
+/**
+ * @brief 将CPU周期数换算为秒
+ * @param cycle 周期数
+ * @return 秒数，不截断小数部分，Dwt_Init 之前调用返回0
+ */
+float Dwt_Cycle_To_S(uint32_t cycle);
 #endif /* BSP_DWT_H */
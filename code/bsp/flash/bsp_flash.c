@@ -0,0 +1,93 @@
+#include "bsp_flash.h"
+#include <string.h>
+#include "main.h"
+#include "bsp_cache.h"
+#include "plf_log.h"
+
+#define FLASH_WORD_SIZE (FLASH_NB_32BITWORD_IN_FLASHWORD * 4u) // 最小编程单位，字节
+
+/**
+ * @brief 擦除 addr 所在的扇区
+ * @param addr 扇区起始地址
+ * @return true 成功  false 地址不是扇区起始地址或擦除失败
+ */
+bool Flash_Erase_Sector(uint32_t addr){
+    FLASH_EraseInitTypeDef erase = {0};
+    uint32_t bank_base = FLASH_BANK1_BASE;
+    erase.Banks = FLASH_BANK_1;
+#if defined(DUAL_BANK)
+    if (addr >= FLASH_BANK2_BASE){
+        bank_base = FLASH_BANK2_BASE;
+        erase.Banks = FLASH_BANK_2;
+    }
+#endif
+    if (addr < bank_base || (addr - bank_base) % FLASH_SECTOR_SIZE != 0u || addr >= FLASH_END){
+        Log_Error("Flash_Erase_Sector 0x%08x is not a sector address", addr);
+        return false;
+    }
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = (addr - bank_base) / FLASH_SECTOR_SIZE;
+    erase.NbSectors = 1;
+#if defined(FLASH_CR_PSIZE)
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+#endif
+
+    uint32_t sector_error = 0;
+    HAL_FLASH_Unlock();
+    const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+    // 丢弃 D-Cache 中该扇区的旧内容
+    Cache_Invalidate((void*)addr, FLASH_SECTOR_SIZE);
+    if (status != HAL_OK){
+        Log_Error("Flash_Erase_Sector 0x%08x failed", addr);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 编程一段数据
+ * @param addr 目标地址，必须按 flash word 对齐且已擦除
+ * @param data 数据指针
+ * @param len 数据长度，按 flash word 向上补齐
+ * @return true 成功  false 失败
+ */
+bool Flash_Program(uint32_t addr, const void* data, uint32_t len){
+    if (data == NULL || addr % FLASH_WORD_SIZE != 0u){
+        Log_Error("Flash_Program 0x%08x must be flash word aligned", addr);
+        return false;
+    }
+    // HAL 按字读取源数据，先拷贝到对齐的缓冲区
+    uint32_t word[FLASH_NB_32BITWORD_IN_FLASHWORD];
+    const uint8_t* src = data;
+    bool ok = true;
+    HAL_FLASH_Unlock();
+    for (uint32_t offset = 0; offset < len; offset += FLASH_WORD_SIZE){
+        const uint32_t n = (len - offset < FLASH_WORD_SIZE) ? len - offset : FLASH_WORD_SIZE;
+        memset(word, 0xFF, sizeof(word));
+        memcpy(word, src + offset, n);
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, addr + offset, (uint32_t)word) != HAL_OK){
+            ok = false;
+            break;
+        }
+    }
+    HAL_FLASH_Lock();
+    Cache_Invalidate((void*)addr, len);
+    if (!ok){
+        Log_Error("Flash_Program 0x%08x failed", addr);
+    }
+    return ok;
+}
+
+/**
+ * @brief 读取一段数据
+ * @param addr 源地址
+ * @param data 数据指针
+ * @param len 数据长度
+ */
+void Flash_Read(uint32_t addr, void* data, uint32_t len){
+    if (data == NULL){
+        return;
+    }
+    memcpy(data, (const void*)addr, len);
+}
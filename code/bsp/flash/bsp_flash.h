@@ -0,0 +1,38 @@
+/**
+ * @file bsp_flash.h
+ * @brief 片内 Flash 扇区擦除与编程，用于保存校准参数等少量掉电数据
+ * @note H7 以 flash word(FLASH_NB_32BITWORD_IN_FLASHWORD * 4 字节)为最小编程单位，
+ *       同一个 flash word 擦除后只能编程一次；编程长度不足时用 0xFF 补齐。
+ *       擦除扇区期间同一个 bank 上的取指会被阻塞（约 1~2s），只能在初始化或停机状态下调用。
+ */
+#ifndef BSP_FLASH_H
+#define BSP_FLASH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 擦除 addr 所在的扇区
+ * @param addr 扇区起始地址
+ * @return true 成功  false 地址不是扇区起始地址或擦除失败
+ */
+bool Flash_Erase_Sector(uint32_t addr);
+
+/**
+ * @brief 编程一段数据
+ * @param addr 目标地址，必须按 flash word 对齐且已擦除
+ * @param data 数据指针
+ * @param len 数据长度，按 flash word 向上补齐
+ * @return true 成功  false 失败
+ */
+bool Flash_Program(uint32_t addr, const void* data, uint32_t len);
+
+/**
+ * @brief 读取一段数据
+ * @param addr 源地址
+ * @param data 数据指针
+ * @param len 数据长度
+ */
+void Flash_Read(uint32_t addr, void* data, uint32_t len);
+
+#endif // BSP_FLASH_H
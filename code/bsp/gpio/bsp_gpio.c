@@ -5,6 +5,10 @@
 #include "stdbool.h"
 #include "plf_log.h"
 
+/* 私有变量 -----------------------------------------------------------------*/
+
+static GpioInstance_s* gpio_exti_instances[GPIO_EXTI_LINE_CNT] = {NULL}; // 按 EXTI 线号索引
+
 /* 私有函数原型 -------------------------------------------------------------*/
 
 /* 函数定义 ------------------------------------------------------------------*/
@@ -37,8 +41,27 @@ static bool Gpio_Register_Check(GpioInitConfig_s *config)
         Log_Error("Gpio Register Failed: pin is 0");
         return false;
     }
+    if (config->callback != NULL)
+    {
+        if ((config->pin & (config->pin - 1u)) != 0)
+        {
+            Log_Error("Gpio Register Failed: %s exti pin must be a single pin", config->topic_name);
+            return false;
+        }
+        if (gpio_exti_instances[__builtin_ctz(config->pin)] != NULL)
+        {
+            Log_Error("Gpio Register Failed: %s exti line is occupied", config->topic_name);
+            return false;
+        }
+    }
     return true;
 }
+
+/**
+ * @brief GPIO 注册函数
+ * @param config GPIO 初始化配置结构体指针
+ * @return GpioInstance_s* GPIO 实例指针
+ */
 GpioInstance_s * Gpio_Register(GpioInitConfig_s *config)
 {
     if ((Gpio_Register_Check(config)) == false)
@@ -56,6 +79,10 @@ GpioInstance_s * Gpio_Register(GpioInitConfig_s *config)
     instance->pin = config->pin;
     instance->callback = config->callback;
     instance->parent_ptr = config->parent_ptr;
+    if (instance->callback != NULL)
+    {
+        gpio_exti_instances[__builtin_ctz(instance->pin)] = instance;
+    }
     return instance;
 }
 
@@ -73,4 +100,21 @@ void Gpio_Set(GpioInstance_s *instance){
  */
 void Gpio_Reset(GpioInstance_s *instance){
     HAL_GPIO_WritePin(instance->port,instance->pin,GPIO_PIN_RESET);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief GPIO 外部中断回调，按 EXTI 线号分发到注册的实例
+ * @param GPIO_Pin 触发中断的引脚
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin == 0)
+    {
+        return;
+    }
+    GpioInstance_s* instance = gpio_exti_instances[__builtin_ctz(GPIO_Pin)];
+    if (instance != NULL)
+    {
+        instance->callback(instance);
+    }
+}
@@ -2,6 +2,8 @@
 #define BSP_GPIO_H
 #include "gpio.h"
 
+#define GPIO_EXTI_LINE_CNT 16   // EXTI0~15，每条线只能对应一个引脚
+
 typedef struct GpioInstance{
     char *topic_name;
     GPIO_TypeDef* port;
@@ -14,7 +16,7 @@ typedef struct {
     char *topic_name;
     GPIO_TypeDef* port;
     uint16_t pin;
-    void(*callback)(struct GpioInstance*);
+    void(*callback)(struct GpioInstance*);    // 外部中断回调，不为NULL时注册到对应 EXTI 线，在中断中调用
     void *parent_ptr;
 }GpioInitConfig_s;
 
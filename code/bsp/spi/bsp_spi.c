@@ -3,10 +3,10 @@
  * @author Adonis Jin
  * @date 2025-08-08
  * @version 1.0.0
- * @note 对CS引脚的操作需要在调用 SPI 传输函数前后手动进行
- *       本文件只提供Spi_Cs_ReadPinState函数用于读取CS引脚状态
- *                 Spi_cs_high函数用于拉高CS引脚
- *                 Spi_cs_low函数用于拉低CS引脚
+ * @note CS 引脚由驱动管理，传输函数内部拉低、传输完成后拉高。
+ *       每条总线有一个传输任务(SpiJob_s)队列：Spi_Submit 提交的任务按优先级排队，
+ *       由上一个任务的 DMA/IT 完成中断直接启动下一个，总线上的多个设备之间无需等待任务调度。
+ *       阻塞传输只能在总线空闲时进行，总线被异步任务占用时返回 false。
  */
 
 /* 包含文件 ------------------------------------------------------------------*/
@@ -17,62 +17,57 @@
 #include "plf_log.h"
 #include "memory_management.h"
 #include "robot_config.h"
+#include "bsp_cache.h"
+
+#define SPI_ENTER_CRITICAL()  uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define SPI_EXIT_CRITICAL()   __set_PRIMASK(primask)
+
 /* 私有变量 -----------------------------------------------------------------*/
 
 static SpiInstance_s* spi_instances[SPI_DEVICE_CNT] = {NULL};
 static uint8_t spi_idx = 0;
+static SpiBus_s spi_buses[SPI_BUS_CNT] = {0};
+static SpiJob_s spi_blocking_job = {0}; // 阻塞传输占用总线时的占位任务
 
 
 /**
  * @brief 选择spi端口指针
  * @param spi_handle_number spi端口号
- * @return 对应端口的指针
+ * @return 对应端口的指针，端口号无效或未启用返回NULL
  */
 SPI_HandleTypeDef* Spi_handle_Select(uint8_t spi_handle_number)
 {
-    if (spi_handle_number == 0)
-    {
-        Log_Error("Spi_handle_Select : Invalid SPI handle number: zero");
-        return NULL;
-    }
     switch (spi_handle_number)
     {
-    case 1:
-        {
 #if defined(USER_SPI1)
-            return &hspi1;
+    case 1:
+        return &hspi1;
 #endif
-        }
+#if defined(USER_SPI2)
     case 2:
-        {
-#if defined (USER_SPI2)
-            return &hspi2;
+        return &hspi2;
 #endif
-        }
+#if defined(USER_SPI3)
     case 3:
-        {
-#if defined (USER_SPI3)
-            return &hspi3;
+        return &hspi3;
 #endif
-        }
+#if defined(USER_SPI4)
     case 4:
-        {
-#if defined (USER_SPI4)
-            return &hspi4;
+        return &hspi4;
 #endif
-        }
+#if defined(USER_SPI5)
     case 5:
-        {
-#if defined (USER_SPI5)
-            return &hspi5;
+        return &hspi5;
+#endif
+#if defined(USER_SPI6)
+    case 6:
+        return &hspi6;
 #endif
-        }
     default:
-        {
-            Log_Error("Spi_handle_Select : Invalid SPI handle number");
-            return NULL;
-        }
+        break;
     }
+    Log_Error("Spi_handle_Select : SPI%d is invalid or not enabled", spi_handle_number);
+    return NULL;
 }
 
 /**
@@ -92,6 +87,11 @@ static bool Spi_Register_Check(SpiInitConfig_s* config)
         Log_Error("Spi_Register_Check: topic_name is NULL");
         return false;
     }
+    if (config->spi_handle_number == 0 || config->spi_handle_number > SPI_BUS_CNT)
+    {
+        Log_Error("Spi_Register_Check: %s spi_handle_number is invalid", config->topic_name);
+        return false;
+    }
     return true;
 }
 
@@ -107,6 +107,16 @@ SpiInstance_s* Spi_Register(SpiInitConfig_s* config)
     {
         return NULL;
     }
+    if (spi_idx >= SPI_DEVICE_CNT)
+    {
+        Log_Error("Spi_Register: %s exceeds SPI_DEVICE_CNT", config->topic_name);
+        return NULL;
+    }
+    SPI_HandleTypeDef* spi_handle = Spi_handle_Select(config->spi_handle_number);
+    if (spi_handle == NULL)
+    {
+        return NULL;
+    }
     SpiInstance_s* instance = user_malloc(sizeof(SpiInstance_s));
     if (instance == NULL)
     {
@@ -115,58 +125,360 @@ SpiInstance_s* Spi_Register(SpiInitConfig_s* config)
     }
     memset(instance, 0, sizeof(SpiInstance_s));
     instance->topic_name = config->topic_name;
-    instance->spi_handle = Spi_handle_Select(config->spi_handle_number);
+    instance->spi_handle = spi_handle;
+    instance->bus = &spi_buses[config->spi_handle_number - 1];
+    instance->bus->spi_handle = spi_handle;
     instance->mode = config->mode;
     instance->cs_port = config->cs_port;
     instance->cs_pin = config->cs_pin;
     instance->timeout = config->timeout;
+    instance->callback = config->callback;
+    instance->parent_ptr = config->parent_ptr;
     spi_instances[spi_idx++] = instance;
     return instance;
 }
 
 /**
- * @brief SPI 发送数据函数
+ * @brief SPI 实例注销函数
  * @param instance SPI 实例指针
- * @param tx_data 发送数据指针
- * @param tx_len 发送数据长度
+ * @return true-- 注销成功   false-- 实例未注册或仍有任务在总线上
  */
-void Spi_Transmit(SpiInstance_s* instance, uint8_t* tx_data, uint16_t tx_len)
+bool Spi_Unregister(SpiInstance_s* instance)
 {
-    if (instance == NULL || tx_data == NULL || tx_len == 0)
+    if (instance == NULL)
     {
-        Log_Error("Spi_Transmit Fail : Invalid Parameter");
-        return;
+        return false;
+    }
+    uint8_t idx = 0;
+    while (idx < spi_idx && spi_instances[idx] != instance)
+    {
+        idx++;
+    }
+    if (idx == spi_idx)
+    {
+        Log_Error("Spi_Unregister: %s is not registered", instance->topic_name);
+        return false;
+    }
+    SPI_ENTER_CRITICAL();
+    bool in_use = (instance->bus->active != NULL && instance->bus->active->device == instance);
+    for (SpiJob_s* job = instance->bus->head; job != NULL && !in_use; job = job->next)
+    {
+        in_use = (job->device == instance);
+    }
+    if (!in_use)
+    {
+        // 保持注册顺序，后注册的实例前移
+        for (; idx + 1 < spi_idx; idx++)
+        {
+            spi_instances[idx] = spi_instances[idx + 1];
+        }
+        spi_instances[--spi_idx] = NULL;
+    }
+    SPI_EXIT_CRITICAL();
+    if (in_use)
+    {
+        Log_Error("Spi_Unregister: %s still has jobs on the bus", instance->topic_name);
+        return false;
     }
+    user_free(instance);
+    return true;
+}
+
+/**
+ * @brief 拉低 CS 引脚
+ * @param instance SPI 实例指针
+ */
+static inline void Spi_Cs_Low(SpiInstance_s* instance)
+{
     if (instance->cs_port != NULL)
     {
         HAL_GPIO_WritePin(instance->cs_port, instance->cs_pin, GPIO_PIN_RESET);
     }
-    switch (instance->mode)
+}
+
+/**
+ * @brief 拉高 CS 引脚
+ * @param instance SPI 实例指针
+ */
+static inline void Spi_Cs_High(SpiInstance_s* instance)
+{
+    if (instance->cs_port != NULL)
+    {
+        HAL_GPIO_WritePin(instance->cs_port, instance->cs_pin, GPIO_PIN_SET);
+    }
+}
+
+/**
+ * @brief 取出优先级最高的排队任务作为当前任务，需在临界区内调用
+ * @param bus 总线指针
+ * @return 新的当前任务，没有排队任务时返回NULL并释放总线
+ */
+static SpiJob_s* Spi_Bus_Pop(SpiBus_s* bus)
+{
+    SpiJob_s* job = bus->head;
+    if (job != NULL)
+    {
+        bus->head = job->next;
+        bus->queued--;
+        job->next = NULL;
+        job->state = SPI_JOB_ACTIVE;
+    }
+    bus->active = job;
+    return job;
+}
+
+/**
+ * @brief 启动任务的硬件传输
+ * @param job 任务指针
+ * @return true 已启动  false 启动失败，CS 已释放
+ */
+static bool Spi_Job_Start(SpiJob_s* job)
+{
+    SpiInstance_s* device = job->device;
+    uint8_t* tx = (uint8_t*)job->tx;
+    HAL_StatusTypeDef status;
+    Spi_Cs_Low(device);
+    if (device->mode == DMA_MODE)
     {
-    case BLOCK_MODE:
+        Cache_Clean(job->tx, job->len);
+        if (job->rx != NULL)
         {
-            HAL_SPI_Transmit(instance->spi_handle, tx_data, tx_len, SPI_TIMEOUT_MS);
-            break;
+            Cache_Clean_Invalidate(job->rx, job->len);
+            status = HAL_SPI_TransmitReceive_DMA(device->spi_handle, tx, job->rx, job->len);
         }
-    case DMA_MODE:
+        else
         {
-            HAL_SPI_Transmit_DMA(instance->spi_handle, tx_data, tx_len);
-            break;
+            status = HAL_SPI_Transmit_DMA(device->spi_handle, tx, job->len);
         }
-    case IT_MODE:
+    }
+    else
+    {
+        if (job->rx != NULL)
         {
-            HAL_SPI_Transmit_IT(instance->spi_handle, tx_data, tx_len);
-            break;
+            status = HAL_SPI_TransmitReceive_IT(device->spi_handle, tx, job->rx, job->len);
         }
-    default:
+        else
         {
-            Log_Error("Spi_Transmit Fail : Invalid Transfer Mode");
+            status = HAL_SPI_Transmit_IT(device->spi_handle, tx, job->len);
         }
     }
-    if (instance->cs_port != NULL)
+    if (status != HAL_OK)
     {
-        HAL_GPIO_WritePin(instance->cs_port, instance->cs_pin, GPIO_PIN_SET);
+        Spi_Cs_High(device);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 结束当前任务并取出下一个
+ * @param bus 总线指针
+ * @param job 结束的任务，CS 已释放
+ * @param success 传输是否成功
+ * @return 下一个任务，没有时返回NULL
+ * @note 回调时 job 仍是总线的当前任务，回调中重新提交的任务会排队而不会抢占
+ */
+static SpiJob_s* Spi_Bus_Finish(SpiBus_s* bus, SpiJob_s* job, bool success)
+{
+    if (success)
+    {
+        bus->stat.job_cnt++;
+    }
+    else
+    {
+        bus->stat.error_cnt++;
+    }
+    job->state = SPI_JOB_IDLE;
+    if (job->callback != NULL)
+    {
+        job->callback(job, success);
+    }
+    SPI_ENTER_CRITICAL();
+    SpiJob_s* next = Spi_Bus_Pop(bus);
+    SPI_EXIT_CRITICAL();
+    return next;
+}
+
+/**
+ * @brief 启动总线的当前任务，启动失败时依次启动后续任务
+ * @param bus 总线指针
+ * @param job 当前任务，可为NULL
+ */
+static void Spi_Bus_Run(SpiBus_s* bus, SpiJob_s* job)
+{
+    while (job != NULL)
+    {
+        if (Spi_Job_Start(job))
+        {
+            return;
+        }
+        job = Spi_Bus_Finish(bus, job, false);
+    }
+}
+
+/**
+ * @brief 提交异步传输任务
+ * @param job 任务指针，需填好 device、tx、rx、len、priority、callback
+ * @return true 已启动或已排队  false 参数错误或任务尚未完成
+ */
+bool Spi_Submit(SpiJob_s* job)
+{
+    if (job == NULL || job->device == NULL || job->tx == NULL || job->len == 0)
+    {
+        Log_Error("Spi_Submit : Invalid Parameter");
+        return false;
+    }
+    SpiBus_s* bus = job->device->bus;
+    bool start = false;
+
+    SPI_ENTER_CRITICAL();
+    if (job->state != SPI_JOB_IDLE)
+    {
+        SPI_EXIT_CRITICAL();
+        return false;
+    }
+    job->next = NULL;
+    if (bus->active == NULL)
+    {
+        job->state = SPI_JOB_ACTIVE;
+        bus->active = job;
+        start = true;
     }
+    else
+    {
+        // 插入到优先级不低于它的任务之后
+        SpiJob_s** link = &bus->head;
+        while (*link != NULL && (*link)->priority >= job->priority)
+        {
+            link = &(*link)->next;
+        }
+        job->next = *link;
+        *link = job;
+        job->state = SPI_JOB_QUEUED;
+        bus->queued++;
+        if (bus->queued > bus->stat.max_queued)
+        {
+            bus->stat.max_queued = bus->queued;
+        }
+    }
+    SPI_EXIT_CRITICAL();
+
+    if (start)
+    {
+        Spi_Bus_Run(bus, job);
+    }
+    return true;
+}
+
+/**
+ * @brief 为阻塞传输占用总线
+ * @param bus 总线指针
+ * @return true 成功  false 总线上有异步任务
+ */
+static bool Spi_Bus_Claim(SpiBus_s* bus)
+{
+    SPI_ENTER_CRITICAL();
+    const bool idle = (bus->active == NULL);
+    if (idle)
+    {
+        bus->active = &spi_blocking_job;
+    }
+    else
+    {
+        bus->stat.busy_reject++;
+    }
+    SPI_EXIT_CRITICAL();
+    return idle;
+}
+
+/**
+ * @brief 阻塞传输结束，启动期间排队的任务
+ * @param bus 总线指针
+ */
+static void Spi_Bus_Release(SpiBus_s* bus)
+{
+    SPI_ENTER_CRITICAL();
+    SpiJob_s* next = Spi_Bus_Pop(bus);
+    SPI_EXIT_CRITICAL();
+    Spi_Bus_Run(bus, next);
+}
+
+/**
+ * @brief 设备内部任务完成，转发到设备回调
+ * @param job 任务指针
+ * @param success 传输是否成功
+ */
+static void Spi_Instance_Job_Callback(SpiJob_s* job, bool success)
+{
+    SpiInstance_s* instance = job->parent_ptr;
+    if (instance->callback != NULL)
+    {
+        instance->callback(instance, success);
+    }
+}
+
+/**
+ * @brief 阻塞传输或提交设备内部任务
+ * @param instance SPI 实例指针
+ * @param tx_data 发送数据指针
+ * @param rx_data 接收数据指针，可为NULL
+ * @param len 数据长度
+ * @param timeout 阻塞模式超时时间
+ * @return true 成功  false 失败
+ */
+static bool Spi_Transfer(SpiInstance_s* instance, uint8_t* tx_data, uint8_t* rx_data, uint16_t len, uint32_t timeout)
+{
+    if (instance->mode != BLOCK_MODE)
+    {
+        SpiJob_s* job = &instance->job;
+        if (job->state != SPI_JOB_IDLE)
+        {
+            return false;
+        }
+        job->device = instance;
+        job->tx = tx_data;
+        job->rx = rx_data;
+        job->len = len;
+        job->priority = 0;
+        job->callback = Spi_Instance_Job_Callback;
+        job->parent_ptr = instance;
+        return Spi_Submit(job);
+    }
+
+    if (!Spi_Bus_Claim(instance->bus))
+    {
+        return false;
+    }
+    Spi_Cs_Low(instance);
+    HAL_StatusTypeDef status;
+    if (rx_data != NULL)
+    {
+        status = HAL_SPI_TransmitReceive(instance->spi_handle, tx_data, rx_data, len, timeout);
+    }
+    else
+    {
+        status = HAL_SPI_Transmit(instance->spi_handle, tx_data, len, timeout);
+    }
+    Spi_Cs_High(instance);
+    Spi_Bus_Release(instance->bus);
+    return status == HAL_OK;
+}
+
+/**
+ * @brief SPI 发送数据函数
+ * @param instance SPI 实例指针
+ * @param tx_data 发送数据指针
+ * @param tx_len 发送数据长度
+ * @return true 阻塞模式下传输完成 / DMA、IT 模式下已提交  false 参数错误、总线占用或传输失败
+ */
+bool Spi_Transmit(SpiInstance_s* instance, uint8_t* tx_data, uint16_t tx_len)
+{
+    if (instance == NULL || tx_data == NULL || tx_len == 0)
+    {
+        Log_Error("Spi_Transmit Fail : Invalid Parameter");
+        return false;
+    }
+    return Spi_Transfer(instance, tx_data, NULL, tx_len, SPI_TIMEOUT_MS);
 }
 
 /**
@@ -176,42 +488,84 @@ void Spi_Transmit(SpiInstance_s* instance, uint8_t* tx_data, uint16_t tx_len)
  * @param rx_data 接收数据指针
  * @param len 数据长度
  * @param timeout 超时时间
+ * @return true 阻塞模式下传输完成 / DMA、IT 模式下已提交  false 参数错误、总线占用或传输失败
  */
-void Spi_TransmitReceive(SpiInstance_s* instance, uint8_t* tx_data, uint8_t* rx_data, uint16_t len, uint16_t timeout)
+bool Spi_TransmitReceive(SpiInstance_s* instance, uint8_t* tx_data, uint8_t* rx_data, uint16_t len, uint16_t timeout)
 {
     if (instance == NULL || tx_data == NULL || rx_data == NULL || len == 0)
     {
         Log_Error("Spi_TransmitReceive : Invalid Parameter");
-        return;
+        return false;
     }
-    if (instance->cs_port != NULL)
+    return Spi_Transfer(instance, tx_data, rx_data, len, timeout);
+}
+
+/**
+ * @brief 获取设备所在总线的统计信息
+ * @param instance SPI 实例指针
+ * @return 统计信息指针
+ */
+const SpiBusStat_s* Spi_Get_Bus_Stat(const SpiInstance_s* instance)
+{
+    if (instance == NULL)
     {
-        HAL_GPIO_WritePin(instance->cs_port, instance->cs_pin, GPIO_PIN_RESET);
+        return NULL;
     }
-    switch (instance->mode)
+    return &instance->bus->stat;
+}
+
+/**
+ * @brief 当前异步任务传输结束，释放 CS 并启动下一个任务
+ * @param hspi SPI 句柄指针
+ * @param success 传输是否成功
+ */
+static void Spi_Transfer_Done(SPI_HandleTypeDef* hspi, bool success)
+{
+    for (uint8_t i = 0; i < SPI_BUS_CNT; i++)
     {
-    case BLOCK_MODE:
-        {
-            HAL_SPI_TransmitReceive(instance->spi_handle, tx_data, rx_data, len, timeout);
-            break;
-        }
-    case DMA_MODE:
+        SpiBus_s* bus = &spi_buses[i];
+        if (bus->spi_handle != hspi)
         {
-            HAL_SPI_TransmitReceive_DMA(instance->spi_handle, tx_data, rx_data, len);
-            break;
+            continue;
         }
-    case IT_MODE:
+        SpiJob_s* job = bus->active;
+        if (job == NULL || job == &spi_blocking_job)
         {
-            HAL_SPI_TransmitReceive_IT(instance->spi_handle, tx_data, rx_data, len);
-            break;
+            return;
         }
-    default:
+        Spi_Cs_High(job->device);
+        if (job->rx != NULL && job->device->mode == DMA_MODE)
         {
-            Log_Error("Spi_TransmitReceive Fail : Invalid Transfer Mode");
+            Cache_Invalidate(job->rx, job->len);
         }
+        Spi_Bus_Run(bus, Spi_Bus_Finish(bus, job, success));
+        return;
     }
-    if (instance->cs_port != NULL)
-    {
-        HAL_GPIO_WritePin(instance->cs_port, instance->cs_pin, GPIO_PIN_SET);
-    }
+}
+
+/**
+ * @brief SPI 发送完成回调
+ * @param hspi SPI 句柄指针
+ */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    Spi_Transfer_Done(hspi, true);
+}
+
+/**
+ * @brief SPI 收发完成回调
+ * @param hspi SPI 句柄指针
+ */
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    Spi_Transfer_Done(hspi, true);
+}
+
+/**
+ * @brief SPI 错误回调，以失败结束当前任务
+ * @param hspi SPI 句柄指针
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{
+    Spi_Transfer_Done(hspi, false);
 }
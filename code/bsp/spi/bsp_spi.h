@@ -3,10 +3,10 @@
  * @author Adonis Jin
  * @date 2025-08-08
  * @version 1.0.0
- * @note 对CS引脚的操作需要在调用 SPI 传输函数前后手动进行
- *       本文件只提供Spi_Cs_ReadPinState函数用于读取CS引脚状态
- *                 Spi_cs_high函数用于拉高CS引脚
- *                 Spi_cs_low函数用于拉低CS引脚
+ * @note CS 引脚由驱动管理，传输函数内部拉低、传输完成后拉高。
+ *       每条总线有一个传输任务(SpiJob_s)队列：Spi_Submit 提交的任务按优先级排队，
+ *       由上一个任务的 DMA/IT 完成中断直接启动下一个，总线上的多个设备之间无需等待任务调度。
+ *       阻塞传输只能在总线空闲时进行，总线被异步任务占用时返回 false。
  */
 
 #ifndef BSP_SPI_H
@@ -19,15 +19,67 @@
 #include "bsp_typedef.h"
 #include "bsp_gpio.h"
 #define SPI_DEVICE_CNT   10
+#define SPI_BUS_CNT      6      // SPI1~SPI6
 #define  SPI_TIMEOUT_MS 1000
 
+struct SpiInstance_s;
+
+/**
+ * @brief 传输任务状态
+ */
+typedef enum {
+    SPI_JOB_IDLE = 0,       // 未提交或已完成，可以修改和重新提交
+    SPI_JOB_QUEUED = 1,     // 排队中
+    SPI_JOB_ACTIVE = 2      // 传输中
+} SpiJobState_e;
+
+/**
+ * @brief 异步传输任务，由调用者分配，提交后到完成回调之前不能修改
+ */
+typedef struct SpiJob_s {
+    struct SpiInstance_s* device;   // 目标设备，决定 CS 引脚、总线和 DMA/IT 方式
+    const uint8_t* tx;              // 发送数据，不能为NULL
+    uint8_t* rx;                    // 接收缓冲区，为NULL时只发送
+    uint16_t len;                   // 传输长度
+    uint8_t priority;               // 优先级，越大越先执行，同优先级先进先出
+    volatile SpiJobState_e state;   // 任务状态，由驱动维护
+    void (*callback)(struct SpiJob_s* job, bool success); // 完成回调，在中断中调用，可以在回调中重新提交
+    void* parent_ptr;               // 提交任务的父模块指针
+    struct SpiJob_s* next;          // 队列链表，由驱动维护
+} SpiJob_s;
+
+/**
+ * @brief 总线统计
+ */
+typedef struct {
+    uint32_t job_cnt;       // 完成的异步任务数
+    uint32_t error_cnt;     // 启动失败或传输错误的异步任务数
+    uint32_t busy_reject;   // 总线被占用导致阻塞传输失败的次数
+    uint8_t max_queued;     // 排队任务数峰值
+} SpiBusStat_s;
+
+/**
+ * @brief SPI 总线，同一外设上的所有设备共用
+ */
+typedef struct {
+    SPI_HandleTypeDef* spi_handle;
+    SpiJob_s* active;               // 正在传输的任务，总线空闲时为NULL
+    SpiJob_s* head;                 // 排队任务链表，按优先级从高到低
+    uint8_t queued;                 // 排队任务数
+    SpiBusStat_s stat;              // 统计
+} SpiBus_s;
+
 typedef struct SpiInstance_s{
     char* topic_name;
-    TransferMode_e mode;
+    TransferMode_e mode;            // 传输方式，异步任务在 DMA_MODE 下使用 DMA，其余模式使用中断
     SPI_HandleTypeDef* spi_handle;
+    SpiBus_s* bus;                  // 所在总线
     GPIO_TypeDef* cs_port;
     uint16_t cs_pin;
     uint16_t timeout;
+    SpiJob_s job;                   // DMA/IT 模式下 Spi_Transmit / Spi_TransmitReceive 使用的内部任务
+    void (*callback)(struct SpiInstance_s* instance, bool success); // DMA/IT 模式下内部任务完成回调，在中断中调用，可为NULL
+    void* parent_ptr;           // 使用SPI外设的父模块指针
 }SpiInstance_s;
 typedef struct{
     char* topic_name;
@@ -36,12 +88,14 @@ typedef struct{
     GPIO_TypeDef* cs_port;
     uint16_t cs_pin;
     uint16_t timeout;
+    void (*callback)(struct SpiInstance_s* instance, bool success); // DMA/IT 模式下内部任务完成回调，在中断中调用，可为NULL
+    void* parent_ptr;           // 使用SPI外设的父模块指针
 }SpiInitConfig_s;
 
 /**
  * @brief 选择spi端口指针
  * @param spi_handle_number spi端口号
- * @return 对应端口的指针
+ * @return 对应端口的指针，端口号无效或未启用返回NULL
  */
 SPI_HandleTypeDef* Spi_handle_Select(uint8_t spi_handle_number);
 /**
@@ -51,14 +105,32 @@ SPI_HandleTypeDef* Spi_handle_Select(uint8_t spi_handle_number);
  * @return instance 指针 -- 注册成功   NULL-- 注册失败
  */
 SpiInstance_s* Spi_Register(SpiInitConfig_s* config);
+/**
+ * @brief SPI 实例注销函数，用于上层模块注册失败时归还设备槽位
+ * @param instance SPI 实例指针
+ * @return true-- 注销成功   false-- 实例未注册或仍有任务在总线上
+ * @note 按注册的相反顺序注销时，user_free 可以回退实例内存
+ */
+bool Spi_Unregister(SpiInstance_s* instance);
+
+/**
+ * @brief 提交异步传输任务
+ * @param job 任务指针，需填好 device、tx、rx、len、priority、callback
+ * @return true 已启动或已排队  false 参数错误或任务尚未完成
+ * @note 可在中断中调用。DMA 模式设备的缓冲区需由 Memory_Region_Malloc 分配。
+ *       启动失败的任务以 success = false 调用回调，不影响后续任务。
+ */
+bool Spi_Submit(SpiJob_s* job);
 
 /**
  * @brief SPI 发送数据函数
  * @param instance SPI 实例指针
  * @param tx_data 发送数据指针
  * @param tx_len 发送数据长度
+ * @return true 阻塞模式下传输完成 / DMA、IT 模式下已提交  false 参数错误、总线占用或传输失败
+ * @note DMA、IT 模式下通过内部任务异步传输，完成前缓冲区不能修改，完成后调用 callback
  */
-void Spi_Transmit(SpiInstance_s* instance, uint8_t* tx_data, uint16_t tx_len);
+bool Spi_Transmit(SpiInstance_s* instance, uint8_t* tx_data, uint16_t tx_len);
 /**
  * @brief SPI 发送接收数据函数
  * @param instance SPI 实例指针
@@ -66,6 +138,16 @@ void Spi_Transmit(SpiInstance_s* instance, uint8_t* tx_data, uint16_t tx_len);
  * @param rx_data 接收数据指针
  * @param len 数据长度
  * @param timeout 超时
+ * @return true 阻塞模式下传输完成 / DMA、IT 模式下已提交  false 参数错误、总线占用或传输失败
+ * @note DMA、IT 模式下通过内部任务异步传输，完成前缓冲区不能修改，完成后调用 callback；
+ *       DMA 模式的缓冲区需由 Memory_Region_Malloc 分配
+ */
+bool Spi_TransmitReceive(SpiInstance_s * instance, uint8_t* tx_data, uint8_t* rx_data, uint16_t len,uint16_t timeout);
+
+/**
+ * @brief 获取设备所在总线的统计信息
+ * @param instance SPI 实例指针
+ * @return 统计信息指针
  */
-void Spi_TransmitReceive(SpiInstance_s * instance, uint8_t* tx_data, uint8_t* rx_data, uint16_t len,uint16_t timeout);
-#endif //BSP_SPI_H
\ No newline at end of file
+const SpiBusStat_s* Spi_Get_Bus_Stat(const SpiInstance_s* instance);
+#endif //BSP_SPI_H
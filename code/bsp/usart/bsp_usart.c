@@ -4,9 +4,40 @@
 
 #include "plf_log.h"
 #include "memory_management.h"
+#include "bsp_cache.h"
+#include "bsp_dwt.h"
 
-uint8_t usart_idx = 0;
-UsartInstance_s* usart_instance[USART_MAX_REGISTER_CNT];
+#define USART_ENTER_CRITICAL()  uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define USART_EXIT_CRITICAL()   __set_PRIMASK(primask)
+
+static uint8_t usart_idx = 0;
+/* 按外设基地址索引的实例表，中断回调中 O(1) 查找 */
+static UsartInstance_s* usart_port_table[USART_PORT_TABLE_SIZE];
+
+/**
+ * @brief 由外设基地址计算实例表下标
+ * @param huart UART句柄指针
+ * @return 实例表下标
+ * @note  H7 各 USART/UART/LPUART 外设基地址的 bit[14:10] 互不相同
+ *        (USART1 4, USART6 5, UART9 6, USART10 7, USART2~UART5 17~20, UART7 30, UART8 31, LPUART1 3)，
+ *        可直接作为下标，注册时再检查冲突
+ */
+static inline uint32_t Usart_Port_Index(const UART_HandleTypeDef* huart){
+    return ((uint32_t)huart->Instance >> 10) & (USART_PORT_TABLE_SIZE - 1u);
+}
+
+/**
+ * @brief 查找UART句柄对应的实例
+ * @param huart UART句柄指针
+ * @return 实例指针，未注册返回NULL
+ */
+static inline UsartInstance_s* Usart_Find(const UART_HandleTypeDef* huart){
+    UsartInstance_s* instance = usart_port_table[Usart_Port_Index(huart)];
+    if (instance == NULL || instance->huart_handle != huart){
+        return NULL;
+    }
+    return instance;
+}
 
 /**
   * @brief  USART Rx DMA 双缓冲区初始化
@@ -18,6 +49,7 @@ UsartInstance_s* usart_instance[USART_MAX_REGISTER_CNT];
   * @note   在调用此函数之前，确保 huart 和 DMA 已正确初始化。
   *         此函数配置 USART 接收模式为 IDLE，并启用 DMA 双缓冲区模式。
   *         当接收到数据时，DMA 会自动在两个缓冲区之间切换。
+  *         缓冲区需按32字节对齐并独占缓存行（使用 Memory_Region_Malloc 分配），启动前会写回并失效 D-Cache。
   */
 static void USART_RxDMA_MultiBuffer_Init(UART_HandleTypeDef *huart, uint8_t *DstAddress,
                                          uint8_t *SecondMemAddress, uint8_t DataLength) {
@@ -34,6 +66,9 @@ static void USART_RxDMA_MultiBuffer_Init(UART_HandleTypeDef *huart, uint8_t *Dst
 
     __HAL_DMA_DISABLE(huart->hdmarx);
 
+    Cache_Clean_Invalidate(DstAddress, (uint32_t)DataLength * 2);
+    Cache_Clean_Invalidate(SecondMemAddress, (uint32_t)DataLength * 2);
+
     HAL_DMAEx_MultiBufferStart(huart->hdmarx, (uint32_t)&huart->Instance->RDR, (uint32_t)DstAddress, (uint32_t)SecondMemAddress, (uint32_t)DataLength * 2);
 }
 void Usart_RxDMA_DoubleBuffer_Init( UsartInstance_s * instance){
@@ -42,7 +77,234 @@ void Usart_RxDMA_DoubleBuffer_Init( UsartInstance_s * instance){
                                  instance->second_rx_buf,
                                  instance->rx_len);
 }
+void Usart_RxDMA_Circular_Init(UsartInstance_s * instance){
+    UART_HandleTypeDef* huart = instance->huart_handle;
+    const uint16_t ring_size = (uint16_t)instance->rx_len * 2;
+
+    if (huart->hdmarx == NULL || huart->hdmarx->Init.Mode != DMA_CIRCULAR){
+        Log_Error("%s Rx DMA is not configured as circular", instance->topic_name);
+        return;
+    }
+    instance->rx_mode = USART_RX_CIRCULAR;
+    instance->rx_pos = 0;
+    Cache_Clean_Invalidate(instance->first_rx_buf, ring_size);
+    // ReceiveToIdle 会同时打开半满/全满中断，事件回调的 Size 即 DMA 在环形缓冲区中的写指针
+    if (HAL_UARTEx_ReceiveToIdle_DMA(huart, instance->first_rx_buf, ring_size) != HAL_OK){
+        Log_Error("%s Rx DMA start failed", instance->topic_name);
+    }
+}
+
+/**
+ * @brief 分发一段新接收的数据
+ * @param instance USART实例指针
+ * @param data 数据段指针
+ * @param len 数据段长度
+ */
+static void Usart_Rx_Deliver(UsartInstance_s* instance, const uint8_t* data, uint16_t len){
+    Cache_Invalidate((void*)data, len);
+    if (instance->framer != NULL){
+        Usart_Framer_Feed(instance->framer, data, len);
+    } else if (instance->usart_rx_span_callback != NULL){
+        instance->usart_rx_span_callback(instance, data, len);
+    }
+}
+
+/**
+ * @brief 循环模式事件处理，把读指针推进到 DMA 写指针
+ * @param instance USART实例指针
+ * @param pos DMA 写指针，即 HAL 事件回调中的 Size
+ */
+static void Usart_RxDMA_Circular_Event(UsartInstance_s* instance, uint16_t pos){
+    const uint16_t ring_size = (uint16_t)instance->rx_len * 2;
+    const uint16_t rx_pos = instance->rx_pos;
+
+    if (pos == rx_pos){
+        return;
+    }
+    if (pos > rx_pos){
+        Usart_Rx_Deliver(instance, instance->first_rx_buf + rx_pos, pos - rx_pos);
+    } else {
+        // 写指针已回绕，先处理到缓冲区末尾的部分
+        Usart_Rx_Deliver(instance, instance->first_rx_buf + rx_pos, ring_size - rx_pos);
+        if (pos > 0){
+            Usart_Rx_Deliver(instance, instance->first_rx_buf, pos);
+        }
+    }
+    instance->rx_pos = (pos == ring_size) ? 0 : pos;
+}
+uint8_t* Usart_RxDMA_Swap_Buffer(UsartInstance_s * instance, uint16_t* len){
+    DMA_HandleTypeDef* hdma = instance->huart_handle->hdmarx;
+    DMA_Stream_TypeDef* stream = (DMA_Stream_TypeDef*)hdma->Instance;
+    uint8_t* filled_buf;
+
+    __HAL_DMA_DISABLE(hdma);
+    while ((stream->CR & DMA_SxCR_EN) != RESET){
+        // CT 位只能在数据流关闭后修改
+    }
+    if (len != NULL){
+        *len = (uint16_t)((uint32_t)instance->rx_len * 2 - __HAL_DMA_GET_COUNTER(hdma));
+    }
+    if ((stream->CR & DMA_SxCR_CT) == RESET){
+        stream->CR |= DMA_SxCR_CT;
+        filled_buf = instance->first_rx_buf;
+    } else {
+        stream->CR &= ~(DMA_SxCR_CT);
+        filled_buf = instance->second_rx_buf;
+    }
+    __HAL_DMA_SET_COUNTER(hdma, (uint32_t)instance->rx_len * 2);
+    __HAL_DMA_ENABLE(hdma);
+    return filled_buf;
+}
+/**
+ * @brief 启动发送队列中最长的一段连续数据，调用者需处于临界区
+ * @param instance USART实例指针
+ */
+static void Usart_Tx_Kick(UsartInstance_s* instance){
+    UsartTxQueue_s* queue = instance->tx_queue;
+    if (queue->inflight != 0 || queue->head == queue->tail){
+        return;
+    }
+    const uint32_t offset = queue->tail & queue->mask;
+    const uint32_t to_end = queue->mask + 1u - offset;
+    const uint32_t pending = queue->head - queue->tail;
+    const uint16_t len = (uint16_t)((pending < to_end) ? pending : to_end);
+    HAL_StatusTypeDef status;
+
+    if (instance->mode == DMA_MODE){
+        Cache_Clean(queue->buf + offset, len);
+        status = HAL_UART_Transmit_DMA(instance->huart_handle, queue->buf + offset, len);
+    } else {
+        status = HAL_UART_Transmit_IT(instance->huart_handle, queue->buf + offset, len);
+    }
+    if (status == HAL_OK){
+        queue->inflight = len;
+    }
+}
+
+/**
+ * @brief 发送完成，释放已发送的数据并记录每帧延迟，在发送完成中断中调用
+ * @param instance USART实例指针
+ */
+static void Usart_Tx_Complete(UsartInstance_s* instance){
+    UsartTxQueue_s* queue = instance->tx_queue;
+    const uint32_t now = Dwt_Get_Cycle();
+
+    USART_ENTER_CRITICAL();
+    queue->tail += queue->inflight;
+    queue->stat.byte_cnt += queue->inflight;
+    queue->inflight = 0;
+    // 结束位置已发送的帧出队，帧结束位置与 tail 均为无符号写入计数，按差值比较以处理溢出
+    while (queue->frame_tail != queue->frame_head){
+        const uint8_t slot = queue->frame_tail & (USART_TX_FRAME_QUEUE_LEN - 1u);
+        if ((int32_t)(queue->tail - queue->frame_end[slot]) < 0){
+            break;
+        }
+        const uint32_t latency = Dwt_Cycle_To_Us(now - queue->frame_time[slot]);
+        queue->stat.last_latency_us = latency;
+        if (latency > queue->stat.max_latency_us){
+            queue->stat.max_latency_us = latency;
+        }
+        queue->stat.frame_cnt++;
+        queue->frame_tail++;
+    }
+    queue->stat.depth = (uint16_t)(queue->head - queue->tail);
+    Usart_Tx_Kick(instance);
+    USART_EXIT_CRITICAL();
+}
+
+bool Usart_Transmit(UsartInstance_s* instance, const uint8_t* data, const uint16_t len){
+    const UsartTxSegment_s segment = {data, len};
+    return Usart_Transmit_Gather(instance, &segment, 1);
+}
+
+bool Usart_Transmit_Gather(UsartInstance_s* instance, const UsartTxSegment_s* segments, const uint8_t segment_cnt){
+    if (instance == NULL || segments == NULL || segment_cnt == 0){
+        return false;
+    }
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < segment_cnt; i++){
+        if (segments[i].data == NULL && segments[i].len != 0){
+            return false;
+        }
+        total += segments[i].len;
+    }
+    if (total == 0){
+        return false;
+    }
+
+    if (instance->mode == BLOCK_MODE || instance->tx_queue == NULL){
+        if (instance->mode != BLOCK_MODE){
+            Log_Error("%s Tx queue is not configured", instance->topic_name);
+            return false;
+        }
+        for (uint8_t i = 0; i < segment_cnt; i++){
+            if (segments[i].len != 0 &&
+                HAL_UART_Transmit(instance->huart_handle, segments[i].data, segments[i].len, USART_TX_BLOCK_TIMEOUT) != HAL_OK){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    UsartTxQueue_s* queue = instance->tx_queue;
+    const uint32_t capacity = queue->mask + 1u;
+    USART_ENTER_CRITICAL();
+    // 整帧入队或整帧丢弃，不发送半帧
+    if (total > capacity - (queue->head - queue->tail) ||
+        (uint8_t)(queue->frame_head - queue->frame_tail) >= USART_TX_FRAME_QUEUE_LEN){
+        queue->stat.drop_cnt++;
+        USART_EXIT_CRITICAL();
+        return false;
+    }
+    for (uint8_t i = 0; i < segment_cnt; i++){
+        const uint32_t offset = queue->head & queue->mask;
+        const uint32_t first = (segments[i].len < capacity - offset) ? segments[i].len : capacity - offset;
+        memcpy(queue->buf + offset, segments[i].data, first);
+        if (segments[i].len > first){
+            memcpy(queue->buf, segments[i].data + first, segments[i].len - first);
+        }
+        queue->head += segments[i].len;
+    }
+    const uint8_t slot = queue->frame_head & (USART_TX_FRAME_QUEUE_LEN - 1u);
+    queue->frame_end[slot] = queue->head;
+    queue->frame_time[slot] = Dwt_Get_Cycle();
+    queue->frame_head++;
+    queue->stat.depth = (uint16_t)(queue->head - queue->tail);
+    if (queue->stat.depth > queue->stat.max_depth){
+        queue->stat.max_depth = queue->stat.depth;
+    }
+    Usart_Tx_Kick(instance);
+    USART_EXIT_CRITICAL();
+    return true;
+}
+
+const UsartTxStat_s* Usart_Tx_Get_Stat(const UsartInstance_s* instance){
+    if (instance == NULL || instance->tx_queue == NULL){
+        return NULL;
+    }
+    return &instance->tx_queue->stat;
+}
+
 UsartInstance_s* Usart_Register(const UsartInitConfig_s *config){
+    if (config == NULL || config->huart_handle == NULL){
+        Log_Error("Usart_Register config or huart_handle is NULL");
+        return NULL;
+    }
+    if (usart_idx >= USART_MAX_REGISTER_CNT){
+        Log_Error("%s Usart Register Count Exceeded", config->topic_name);
+        return NULL;
+    }
+    const uint32_t port = Usart_Port_Index(config->huart_handle);
+    if (usart_port_table[port] != NULL){
+        Log_Error("%s Usart Port Already Registered by %s", config->topic_name, usart_port_table[port]->topic_name);
+        return NULL;
+    }
+
+    if (config->tx_buf != NULL &&
+        (config->tx_buf_size == 0 || (config->tx_buf_size & (config->tx_buf_size - 1u)) != 0)){
+        Log_Error("%s tx_buf_size %d must be a power of 2", config->topic_name, config->tx_buf_size);
+        return NULL;
+    }
 
     UsartInstance_s *instance = user_malloc(sizeof(UsartInstance_s));
     if(instance == NULL){
@@ -52,31 +314,121 @@ UsartInstance_s* Usart_Register(const UsartInitConfig_s *config){
     memset(instance, 0, sizeof(UsartInstance_s));
     instance->topic_name = config->topic_name;
     instance->huart_handle = config->huart_handle;
+    instance->mode = config->mode;
+    instance->direction = config->direction;
     instance->rx_len = config->rx_len;
     instance->tx_len = config->tx_len;
     instance->first_rx_buf = config->first_rx_buf;
     instance->second_rx_buf = config->second_rx_buf;
+    instance->rx_mode = config->rx_mode;
 
     instance->usart_module_callback = config->usart_module_callback;
+    instance->usart_rx_span_callback = config->usart_rx_span_callback;
+    instance->framer = config->framer;
     instance->parent_ptr = config->parent_ptr;
-    usart_instance[usart_idx++] = instance;
+    if (config->tx_buf != NULL){
+        instance->tx_queue = user_malloc(sizeof(UsartTxQueue_s));
+        if (instance->tx_queue == NULL){
+            Log_Error("%s Tx Queue Malloc Failed", config->topic_name);
+            user_free(instance);
+            return NULL;
+        }
+        memset(instance->tx_queue, 0, sizeof(UsartTxQueue_s));
+        instance->tx_queue->buf = config->tx_buf;
+        instance->tx_queue->mask = config->tx_buf_size - 1u;
+    }
+    usart_port_table[port] = instance;
+    usart_idx++;
     return instance;
 }
 
+const UsartRxStat_s* Usart_Rx_Get_Stat(const UsartInstance_s* instance){
+    if (instance == NULL){
+        return NULL;
+    }
+    return &instance->rx_stat;
+}
+
+/**
+ * @brief 接收事件分发
+ * @param instance USART实例指针
+ * @param Size HAL 事件回调的 Size
+ */
+static void Usart_Rx_Dispatch(UsartInstance_s* instance, uint16_t Size){
+    // circular mode: HT / TC / IDLE all report the DMA write position, the stream keeps running
+    if (instance->rx_mode == USART_RX_CIRCULAR)
+    {
+        Usart_RxDMA_Circular_Event(instance, Size);
+        return;
+    }
+    // drop stale cache lines so the callback sees what DMA wrote
+    Cache_Invalidate(instance->first_rx_buf, (uint32_t)instance->rx_len * 2);
+    Cache_Invalidate(instance->second_rx_buf, (uint32_t)instance->rx_len * 2);
+    // feed the framer with the buffer that has just been filled
+    if (instance->framer != NULL)
+    {
+        uint16_t len = 0;
+        uint8_t* rx_buf = Usart_RxDMA_Swap_Buffer(instance, &len);
+        Usart_Framer_Feed(instance->framer, rx_buf, len);
+    }
+    // call the callback function if it is not NULL
+    else if (instance->usart_module_callback != NULL)
+    {
+        instance->usart_module_callback(instance, Size);
+    }
+}
+
 // ReSharper disable once CppParameterMayBeConstPtrOrRef
 // ReSharper disable once CppParameterNeverUsed
 // ReSharper disable once CppParameterMayBeConst
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
-    for (uint8_t i = 0; i < usart_idx; ++i)
-    { // find the instance which is being handled
-        if (huart == usart_instance[i]->huart_handle)
-        { // call the callback function if it is not NULL
-            if (usart_instance[i]->usart_module_callback != NULL)
-            {
-                usart_instance[i]->usart_module_callback(usart_instance[i], Size);
-            }
-            return; // break the loop
-        }
+    UsartInstance_s* instance = Usart_Find(huart);
+    if (instance == NULL)
+    {
+        return;
+    }
+    const uint32_t start = Dwt_Get_Cycle();
+    Usart_Rx_Dispatch(instance, Size);
+    const uint32_t cycle = Dwt_Get_Cycle() - start;
+    instance->rx_stat.event_cnt++;
+    if (cycle > instance->rx_stat.max_callback_cycle)
+    {
+        instance->rx_stat.max_callback_cycle = cycle;
+    }
+}
+
+// ReSharper disable once CppParameterMayBeConstPtrOrRef
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    UsartInstance_s* instance = Usart_Find(huart);
+    if (instance == NULL)
+    {
+        return;
+    }
+    instance->rx_stat.error_cnt++;
+    // HAL aborts DMA reception on overrun / noise / framing errors, restart it
+    if (instance->first_rx_buf == NULL)
+    {
+        return;
+    }
+    if (instance->rx_mode == USART_RX_CIRCULAR)
+    {
+        Usart_RxDMA_Circular_Init(instance);
+    }
+    else
+    {
+        Usart_RxDMA_DoubleBuffer_Init(instance);
+    }
+}
+
+// ReSharper disable once CppParameterMayBeConstPtrOrRef
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    UsartInstance_s* instance = Usart_Find(huart);
+    // release the sent span and start the next one
+    if (instance != NULL && instance->tx_queue != NULL)
+    {
+        Usart_Tx_Complete(instance);
     }
 }
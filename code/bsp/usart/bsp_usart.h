@@ -2,9 +2,69 @@
 #define BSP_USART_H
 #include "bsp_typedef.h"
 #include <stdint.h>
+#include <stdbool.h>
 #include "usart.h"
+#include "bsp_usart_framer.h"
 
 #define USART_MAX_REGISTER_CNT 10
+#define USART_PORT_TABLE_SIZE 32        // 实例表大小，按外设基地址 bit[14:10] 索引
+#define USART_TX_FRAME_QUEUE_LEN 16     // 每个串口发送队列中最多排队的帧数，2的幂
+#define USART_TX_BLOCK_TIMEOUT 10       // 阻塞模式发送超时时间，单位ms
+
+/**
+ * @brief DMA接收模式
+ */
+typedef enum {
+    USART_RX_DOUBLE_BUFFER = 0,     // 双缓冲模式，空闲中断时停止数据流并切换缓冲区
+    USART_RX_CIRCULAR = 1           // 循环模式，半满/全满/空闲事件推进读指针，数据流不停止
+} UsartRxMode_e;
+
+/**
+ * @brief 发送数据段，一帧可以由多段组成（如帧头+数据+CRC），入队时依次拷贝到发送缓冲区
+ */
+typedef struct {
+    const uint8_t* data;                                        // 数据段指针
+    uint16_t len;                                               // 数据段长度
+} UsartTxSegment_s;
+
+/**
+ * @brief 发送统计
+ */
+typedef struct {
+    uint32_t frame_cnt;                                         // 已发送完成的帧数
+    uint32_t byte_cnt;                                          // 已发送完成的字节数
+    uint32_t drop_cnt;                                          // 队列满被拒绝的帧数
+    uint16_t depth;                                             // 当前排队字节数
+    uint16_t max_depth;                                         // 排队字节数峰值
+    uint32_t last_latency_us;                                   // 最近一帧从入队到发送完成的时间，单位us
+    uint32_t max_latency_us;                                    // 入队到发送完成时间的峰值，单位us
+} UsartTxStat_s;
+
+/**
+ * @brief 接收统计
+ */
+typedef struct {
+    uint32_t event_cnt;                                         // 接收事件次数（空闲、半满、全满）
+    uint32_t error_cnt;                                         // 串口错误次数（溢出、噪声、帧错误），每次都会重启接收
+    uint32_t max_callback_cycle;                                // 接收事件处理（含分帧和模块回调）的最长耗时，DWT周期，用 Dwt_Cycle_To_Us 换算
+} UsartRxStat_s;
+
+/**
+ * @brief 发送队列：字节环形缓冲区 + 帧描述环，帧按入队顺序连续存放，DMA 每次发送缓冲区中最长的连续一段
+ */
+typedef struct {
+    uint8_t* buf;                                               // 发送缓冲区，位于DMA可访问的内存
+    uint32_t mask;                                              // 发送缓冲区大小 - 1
+    uint32_t head;                                              // 写入计数
+    uint32_t tail;                                              // 已发送完成计数
+    uint16_t inflight;                                          // 正在发送的字节数，0 表示空闲
+    uint32_t frame_end[USART_TX_FRAME_QUEUE_LEN];               // 每帧结束位置（写入计数）
+    uint32_t frame_time[USART_TX_FRAME_QUEUE_LEN];              // 每帧入队时刻，DWT周期
+    uint8_t frame_head;                                         // 帧描述写入计数
+    uint8_t frame_tail;                                         // 帧描述完成计数
+    UsartTxStat_s stat;                                         // 发送统计
+} UsartTxQueue_s;
+
 typedef struct UsartInstance_s {
     char *topic_name;                                           // 实例名称
     TransferMode_e mode;                                        // 传输模式
@@ -14,7 +74,13 @@ typedef struct UsartInstance_s {
     CommunicationMode_e direction;                                  // 传输方向
     uint8_t tx_len;                                             // 发送数据长度
     uint8_t rx_len;                                             // 接收数据长度
+    UsartRxMode_e rx_mode;                                      // DMA接收模式
+    uint16_t rx_pos;                                            // 循环模式下的读指针
     void (*usart_module_callback)(struct UsartInstance_s *,uint16_t Size);    // 回调函数
+    void (*usart_rx_span_callback)(struct UsartInstance_s *, const uint8_t* data, uint16_t len); // 循环模式数据段回调
+    UsartFramer_s* framer;                                      // 分帧器，不为NULL时接收数据交给分帧器，不再调用回调函数
+    UsartTxQueue_s* tx_queue;                                   // 发送队列，未配置 tx_buf 时为NULL
+    UsartRxStat_s rx_stat;                                      // 接收统计
     void *parent_ptr;                                           // 使用USART外设的父模块指针
 } UsartInstance_s;
 
@@ -23,14 +89,72 @@ typedef struct {
     UART_HandleTypeDef* huart_handle;
     TransferMode_e mode;                                        // 传输模式
     CommunicationMode_e direction;                                  // 传输方向
-    uint8_t* first_rx_buf;                                 // 第一个接收缓冲区
-    uint8_t* second_rx_buf;                                // 第二个接收缓冲区
+    uint8_t* first_rx_buf;                                 // 第一个接收缓冲区，长度 rx_len * 2，需由 Memory_Region_Malloc 分配
+    uint8_t* second_rx_buf;                                // 第二个接收缓冲区，长度 rx_len * 2，需由 Memory_Region_Malloc 分配
     uint8_t tx_len;                                             // 发送数据长度
+    uint8_t* tx_buf;                                            // 发送缓冲区，DMA_MODE 下需由 Memory_Region_Malloc 分配，可为NULL
+    uint16_t tx_buf_size;                                       // 发送缓冲区大小，2的幂
     uint8_t rx_len;                                             // 接收数据长度
-    void (*usart_module_callback)(UsartInstance_s *,uint16_t Size);    // 回调函数
+    UsartRxMode_e rx_mode;                                      // DMA接收模式，循环模式只使用 first_rx_buf，DMA 需在 CubeMX 中配置为 Circular
+    void (*usart_module_callback)(UsartInstance_s *,uint16_t Size);    // 回调函数，双缓冲模式使用
+    void (*usart_rx_span_callback)(UsartInstance_s *, const uint8_t* data, uint16_t len); // 数据段回调，循环模式使用，data 直接指向DMA缓冲区
+    UsartFramer_s* framer;                                      // 分帧器，可为NULL
     void *parent_ptr;                                           // 使用USART外设的父模块指针
 } UsartInitConfig_s;
+/**
+ * @brief 注册USART实例
+ * @param config 初始化配置
+ * @return 实例指针，配置错误、超过 USART_MAX_REGISTER_CNT 或同一外设重复注册时返回NULL
+ */
 UsartInstance_s* Usart_Register(const UsartInitConfig_s *config);
 void Usart_RxDMA_DoubleBuffer_Init(UsartInstance_s * instance);
+/**
+ * @brief 以循环模式启动 DMA 接收
+ * @param instance USART实例指针
+ * @note  环形缓冲区为 first_rx_buf，长度 rx_len * 2。半满、全满和空闲事件都会把读指针到 DMA 写指针之间的
+ *        新数据以 (ptr, len) 交给分帧器或 usart_rx_span_callback，数据跨越缓冲区末尾时分两段回调。
+ *        数据段直接指向DMA缓冲区，回调必须在 DMA 写满半个缓冲区之前处理完。
+ */
+void Usart_RxDMA_Circular_Init(UsartInstance_s * instance);
+/**
+ * @brief 空闲中断后切换 DMA 双缓冲区并重新开始接收
+ * @param instance USART实例指针
+ * @param len 输出刚接收完成的缓冲区中的数据长度（数据流停止后读取，包含空闲中断之后到达的字节）
+ * @return 刚接收完成的缓冲区
+ */
+uint8_t* Usart_RxDMA_Swap_Buffer(UsartInstance_s * instance, uint16_t* len);
+
+/**
+ * @brief 发送一帧数据，非阻塞
+ * @param instance USART实例指针
+ * @param data 数据指针，入队时拷贝，返回后即可复用
+ * @param len 数据长度
+ * @return true 已入队  false 队列空间不足或参数错误，整帧丢弃
+ */
+bool Usart_Transmit(UsartInstance_s* instance, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief 发送由多个数据段组成的一帧，非阻塞
+ * @param instance USART实例指针
+ * @param segments 数据段数组，入队时依次拷贝，调用者无需先拼接到同一个缓冲区
+ * @param segment_cnt 数据段数量
+ * @return true 已入队  false 队列空间不足或参数错误，整帧丢弃
+ * @note  DMA_MODE / IT_MODE 下由发送完成中断驱动队列，可在任务和中断中调用；BLOCK_MODE 下直接阻塞发送
+ */
+bool Usart_Transmit_Gather(UsartInstance_s* instance, const UsartTxSegment_s* segments, uint8_t segment_cnt);
+
+/**
+ * @brief 获取接收统计
+ * @param instance USART实例指针
+ * @return 接收统计指针
+ */
+const UsartRxStat_s* Usart_Rx_Get_Stat(const UsartInstance_s* instance);
+
+/**
+ * @brief 获取发送统计
+ * @param instance USART实例指针
+ * @return 发送统计指针，未配置发送队列时返回NULL
+ */
+const UsartTxStat_s* Usart_Tx_Get_Stat(const UsartInstance_s* instance);
 
 #endif
@@ -0,0 +1,269 @@
+#include "bsp_usart_framer.h"
+
+#include <string.h>
+
+#include "plf_log.h"
+#include "memory_management.h"
+
+/**
+ * @brief 帧头匹配结果
+ */
+typedef enum {
+    FRAMER_MATCH = 0,       // 匹配
+    FRAMER_NO_MATCH = 1,    // 不匹配
+    FRAMER_NEED_MORE = 2    // 数据不足，已有部分匹配
+} FramerMatch_e;
+
+/**
+ * @brief 读取环形缓冲区中相对 tail 偏移 offset 的字节
+ */
+static inline uint8_t Framer_Peek(const UsartFramer_s* framer, uint32_t offset) {
+    return framer->ring[(framer->tail + offset) & framer->mask];
+}
+
+/**
+ * @brief 丢弃 tail 处的 n 个字节
+ */
+static inline void Framer_Skip(UsartFramer_s* framer, uint32_t n) {
+    framer->tail += n;
+    framer->delimiter_scan = 0;
+}
+
+/**
+ * @brief 检查 tail 处是否为帧头
+ * @param framer 分帧器指针
+ * @param size 缓冲区中的数据量
+ * @return 匹配结果
+ */
+static FramerMatch_e Framer_Match_Header(const UsartFramer_s* framer, uint32_t size) {
+    const uint8_t header_len = framer->desc.header_len;
+    for (uint8_t i = 0; i < header_len; i++) {
+        if (i >= size) {
+            return FRAMER_NEED_MORE;
+        }
+        if (Framer_Peek(framer, i) != framer->desc.header[i]) {
+            return FRAMER_NO_MATCH;
+        }
+    }
+    return FRAMER_MATCH;
+}
+
+/**
+ * @brief 计算 tail 处帧的长度
+ * @param framer 分帧器指针
+ * @param size 缓冲区中的数据量
+ * @param frame_len 输出帧长度
+ * @return 匹配结果，FRAMER_NO_MATCH 表示长度错误需要重新同步
+ */
+static FramerMatch_e Framer_Get_Length(UsartFramer_s* framer, uint32_t size, uint16_t* frame_len) {
+    const UsartFrameDesc_s* desc = &framer->desc;
+    switch (desc->type) {
+        case USART_FRAME_FIXED:
+            *frame_len = desc->frame_len;
+            return FRAMER_MATCH;
+
+        case USART_FRAME_HEADER_LENGTH: {
+            if (size < (uint32_t)desc->length_offset + desc->length_size) {
+                return FRAMER_NEED_MORE;
+            }
+            int32_t len = Framer_Peek(framer, desc->length_offset);
+            if (desc->length_size == 2) {
+                len |= (int32_t)Framer_Peek(framer, desc->length_offset + 1u) << 8;
+            }
+            len += desc->length_adjust;
+            if (len < (int32_t)desc->length_offset + desc->length_size || len > desc->max_frame_len) {
+                framer->stat.len_err++;
+                return FRAMER_NO_MATCH;
+            }
+            *frame_len = (uint16_t)len;
+            return FRAMER_MATCH;
+        }
+
+        case USART_FRAME_DELIMITER: {
+            const uint32_t limit = (size < desc->max_frame_len) ? size : desc->max_frame_len;
+            uint32_t i = (framer->delimiter_scan > desc->header_len) ? framer->delimiter_scan : desc->header_len;
+            for (; i < limit; i++) {
+                if (Framer_Peek(framer, i) == desc->delimiter) {
+                    *frame_len = (uint16_t)(i + 1u);
+                    return FRAMER_MATCH;
+                }
+            }
+            if (limit >= desc->max_frame_len) {
+                framer->stat.len_err++;
+                return FRAMER_NO_MATCH;
+            }
+            framer->delimiter_scan = (uint16_t)i;
+            return FRAMER_NEED_MORE;
+        }
+
+        default:
+            return FRAMER_NO_MATCH;
+    }
+}
+
+/**
+ * @brief 从环形缓冲区中切出所有完整帧
+ * @param framer 分帧器指针
+ */
+static void Framer_Process(UsartFramer_s* framer) {
+    for (;;) {
+        const uint32_t size = framer->head - framer->tail;
+        if (size == 0) {
+            return;
+        }
+
+        // 1. 对齐帧头
+        const FramerMatch_e header = Framer_Match_Header(framer, size);
+        if (header == FRAMER_NEED_MORE) {
+            return;
+        }
+        if (header == FRAMER_NO_MATCH) {
+            framer->stat.drop_bytes++;
+            Framer_Skip(framer, 1);
+            continue;
+        }
+
+        // 2. 确定帧长
+        uint16_t frame_len = 0;
+        const FramerMatch_e length = Framer_Get_Length(framer, size, &frame_len);
+        if (length == FRAMER_NEED_MORE) {
+            return;
+        }
+        if (length == FRAMER_NO_MATCH) {
+            framer->stat.drop_bytes++;
+            Framer_Skip(framer, 1);
+            continue;
+        }
+        if (size < frame_len) {
+            return;
+        }
+
+        // 3. 取出帧，未跨越回绕点时直接使用环形缓冲区中的数据
+        const uint32_t offset = framer->tail & framer->mask;
+        const uint32_t to_end = framer->mask + 1u - offset;
+        const uint8_t* frame = framer->ring + offset;
+        if (frame_len > to_end) {
+            memcpy(framer->frame_buf, frame, to_end);
+            memcpy(framer->frame_buf + to_end, framer->ring, frame_len - to_end);
+            frame = framer->frame_buf;
+        }
+
+        // 4. 校验并回调
+        if (framer->desc.validate != NULL && !framer->desc.validate(frame, frame_len)) {
+            framer->stat.validate_err++;
+            framer->stat.drop_bytes++;
+            Framer_Skip(framer, 1);
+            continue;
+        }
+        framer->stat.frame_cnt++;
+        if (framer->frame_callback != NULL) {
+            framer->frame_callback(framer, frame, frame_len);
+        }
+        Framer_Skip(framer, frame_len);
+    }
+}
+
+/**
+ * @brief 创建分帧器
+ * @param config 初始化配置
+ * @return 分帧器指针，失败返回NULL
+ */
+UsartFramer_s* Usart_Framer_Create(const UsartFramerInitConfig_s* config) {
+    if (config == NULL) {
+        Log_Error("Usart_Framer_Create config is NULL");
+        return NULL;
+    }
+    const UsartFrameDesc_s* desc = &config->desc;
+    if (desc->max_frame_len == 0 || desc->header_len > USART_FRAME_HEADER_MAX_LEN ||
+        (desc->type == USART_FRAME_FIXED && (desc->frame_len == 0 || desc->frame_len > desc->max_frame_len)) ||
+        (desc->type == USART_FRAME_HEADER_LENGTH && desc->length_size != 1 && desc->length_size != 2)) {
+        Log_Error("Usart_Framer_Create invalid frame descriptor");
+        return NULL;
+    }
+    if (config->ring_size < 2u * desc->max_frame_len || (config->ring_size & (config->ring_size - 1u)) != 0) {
+        Log_Error("Usart_Framer_Create ring_size %d must be a power of 2 and >= 2 * max_frame_len", config->ring_size);
+        return NULL;
+    }
+
+    UsartFramer_s* framer = user_malloc(sizeof(UsartFramer_s));
+    if (framer == NULL) {
+        Log_Error("Usart_Framer_Create framer malloc fail");
+        return NULL;
+    }
+    memset(framer, 0, sizeof(UsartFramer_s));
+    framer->ring = user_malloc(config->ring_size);
+    if (framer->ring == NULL) {
+        Log_Error("Usart_Framer_Create ring malloc fail");
+        user_free(framer);
+        return NULL;
+    }
+    framer->frame_buf = user_malloc(desc->max_frame_len);
+    if (framer->frame_buf == NULL) {
+        Log_Error("Usart_Framer_Create frame_buf malloc fail");
+        user_free(framer->ring);
+        user_free(framer);
+        return NULL;
+    }
+    framer->desc = *desc;
+    framer->mask = config->ring_size - 1u;
+    framer->frame_callback = config->frame_callback;
+    framer->parent_ptr = config->parent_ptr;
+    return framer;
+}
+
+/**
+ * @brief 输入接收到的数据块
+ * @param framer 分帧器指针
+ * @param data 数据块指针
+ * @param len 数据块长度
+ */
+void Usart_Framer_Feed(UsartFramer_s* framer, const uint8_t* data, uint16_t len) {
+    if (framer == NULL || data == NULL) {
+        return;
+    }
+    const uint32_t capacity = framer->mask + 1u;
+    while (len > 0) {
+        // 分段写入，每段后立即分帧，缓冲区满时丢弃最旧的数据
+        uint32_t n = (len < capacity) ? len : capacity;
+        const uint32_t space = capacity - (framer->head - framer->tail);
+        if (n > space) {
+            framer->stat.overflow_bytes += n - space;
+            Framer_Skip(framer, n - space);
+        }
+        const uint32_t offset = framer->head & framer->mask;
+        const uint32_t first = (n < capacity - offset) ? n : capacity - offset;
+        memcpy(framer->ring + offset, data, first);
+        if (n > first) {
+            memcpy(framer->ring, data + first, n - first);
+        }
+        framer->head += n;
+        data += n;
+        len -= (uint16_t)n;
+        Framer_Process(framer);
+    }
+}
+
+/**
+ * @brief 清空分帧器中缓存的数据
+ * @param framer 分帧器指针
+ */
+void Usart_Framer_Reset(UsartFramer_s* framer) {
+    if (framer == NULL) {
+        return;
+    }
+    framer->tail = framer->head;
+    framer->delimiter_scan = 0;
+}
+
+/**
+ * @brief 销毁分帧器，按创建的逆序释放帧缓冲、环形缓冲与分帧器本体
+ * @param framer 分帧器指针
+ */
+void Usart_Framer_Destroy(UsartFramer_s* framer) {
+    if (framer == NULL) {
+        return;
+    }
+    user_free(framer->frame_buf);
+    user_free(framer->ring);
+    user_free(framer);
+}
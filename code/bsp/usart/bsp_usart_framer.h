@@ -0,0 +1,99 @@
+/**
+ * @file bsp_usart_framer.h
+ * @brief USART 流式分帧器：DMA 接收到的数据块写入环形缓冲区，按帧描述符切出完整帧
+ * @note 支持三种帧格式：定长帧、帧头+长度字段、结束符；可选校验函数，校验失败时跳过一个字节重新同步。
+ *       帧跨越 DMA 数据块或一个数据块包含多帧时都能正确切分。
+ *       Feed 与帧回调在同一上下文(USART 中断)中执行，回调中的帧指针仅在回调内有效。
+ */
+#ifndef BSP_USART_FRAMER_H
+#define BSP_USART_FRAMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define USART_FRAME_HEADER_MAX_LEN 4 // 帧头最大长度
+
+/**
+ * @brief 帧格式
+ */
+typedef enum {
+    USART_FRAME_FIXED = 0,          // 定长帧，长度为 frame_len
+    USART_FRAME_HEADER_LENGTH = 1,  // 帧头+长度字段，帧长 = 长度字段值 + length_adjust
+    USART_FRAME_DELIMITER = 2       // 以 delimiter 结尾（包含结束符）
+} UsartFrameType_e;
+
+/**
+ * @brief 帧描述符
+ */
+typedef struct {
+    UsartFrameType_e type;                          // 帧格式
+    uint8_t header[USART_FRAME_HEADER_MAX_LEN];     // 帧头，header_len 为0时不检查帧头
+    uint8_t header_len;                             // 帧头长度
+    uint16_t frame_len;                             // 定长帧长度
+    uint16_t length_offset;                         // 长度字段在帧内的偏移
+    uint8_t length_size;                            // 长度字段字节数 1 或 2，小端
+    int16_t length_adjust;                          // 帧长 = 长度字段值 + length_adjust
+    uint8_t delimiter;                              // 结束符
+    uint16_t max_frame_len;                         // 最大帧长，超过视为错误，也是回调帧缓存的大小
+    bool (*validate)(const uint8_t* frame, uint16_t len); // 可选的整帧校验（帧尾、CRC等），可为NULL
+} UsartFrameDesc_s;
+
+/**
+ * @brief 分帧统计
+ */
+typedef struct {
+    uint32_t frame_cnt;     // 输出的帧数
+    uint32_t drop_bytes;    // 同步时丢弃的字节数
+    uint32_t overflow_bytes;// 环形缓冲区溢出丢弃的字节数
+    uint32_t len_err;       // 长度字段错误次数
+    uint32_t validate_err;  // 校验失败次数
+} UsartFramerStat_s;
+
+typedef struct UsartFramer_s {
+    UsartFrameDesc_s desc;                          // 帧描述符
+    uint8_t* ring;                                  // 环形缓冲区
+    uint32_t mask;                                  // 环形缓冲区大小 - 1
+    uint32_t head;                                  // 写入计数
+    uint32_t tail;                                  // 读取计数
+    uint16_t delimiter_scan;                        // 结束符已扫描到的帧内偏移，避免重复扫描
+    uint8_t* frame_buf;                             // 跨越回绕点的帧拷贝到这里再回调
+    UsartFramerStat_s stat;                         // 分帧统计
+    void (*frame_callback)(struct UsartFramer_s*, const uint8_t* frame, uint16_t len); // 帧回调
+    void* parent_ptr;                               // 父模块指针
+} UsartFramer_s;
+
+typedef struct {
+    UsartFrameDesc_s desc;                          // 帧描述符
+    uint16_t ring_size;                             // 环形缓冲区大小，2的幂且不小于 2 * max_frame_len
+    void (*frame_callback)(UsartFramer_s*, const uint8_t* frame, uint16_t len); // 帧回调
+    void* parent_ptr;                               // 父模块指针
+} UsartFramerInitConfig_s;
+
+/**
+ * @brief 创建分帧器
+ * @param config 初始化配置
+ * @return 分帧器指针，失败返回NULL
+ */
+UsartFramer_s* Usart_Framer_Create(const UsartFramerInitConfig_s* config);
+
+/**
+ * @brief 输入接收到的数据块，并回调其中所有完整帧
+ * @param framer 分帧器指针
+ * @param data 数据块指针
+ * @param len 数据块长度
+ */
+void Usart_Framer_Feed(UsartFramer_s* framer, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief 清空分帧器中缓存的数据
+ * @param framer 分帧器指针
+ */
+void Usart_Framer_Reset(UsartFramer_s* framer);
+
+/**
+ * @brief 销毁分帧器
+ * @param framer 分帧器指针
+ */
+void Usart_Framer_Destroy(UsartFramer_s* framer);
+
+#endif // BSP_USART_FRAMER_H
@@ -18,6 +18,8 @@
 /* 遥控器配置 */
 #define DJI_DT7    // 大疆遥控器
 //#define FLY_SKY_I6X // 富斯I6X遥控器
+//#define RD_AT10     // 云卓AT10遥控器
+#define RC_UART_HANDLE huart5 // 遥控器接收机使用的串口句柄
 
 /* CAN配置 */
 
@@ -45,6 +47,30 @@
 #define USER_SPI2
 
 #define SPI_IMU_HANDLE 2
+
+/* IMU配置 */
+#define IMU_CALIB_FLASH_ADDR 0x080E0000u // IMU 校准参数所在 Flash 扇区起始地址，该扇区不能存放程序
+
+/* 内存配置 */
+#define MEMORY_STATIC_ARENA               // user_malloc 从静态内存区分配，注释掉则使用 malloc/pvPortMalloc
+#define MEMORY_HEAP_SIZE    (32u * 1024u) // 初始化期对象内存区大小
+#define MEMORY_AXISRAM_SIZE (4u * 1024u)  // .axisram 段 DMA 内存区大小，0 表示不启用
+#define MEMORY_RAM_D1_SIZE  (4u * 1024u)  // .ram_d1 段 DMA 内存区大小，0 表示不启用
+
+/* PID配置 */
+#define PID_STATIC_POOL       // PID实例从静态内存池分配，注释掉则使用 user_malloc
+#define PID_POOL_SIZE 32      // PID静态内存池容量
+
+/* 卡尔曼滤波配置 */
+#define KALMAN_MAX_STATE_DIM 6 // 状态维数上限，决定每个卡尔曼实例中矩阵的静态存储大小
+#define KALMAN_MAX_MEAS_DIM  3 // 观测维数上限
+#define KALMAN_MAX_INPUT_DIM 2 // 控制输入维数上限
+
+/* CRC配置 */
+#define CRC_SLICING 8             // 软件CRC每次处理的字节数：1 / 4 / 8，越大越快，查找表占用 RAM 越多
+// #define USER_HW_CRC            // CRC32 使用硬件CRC单元计算，需要在 CubeMX 中使能 CRC
+#define CRC_HW_THRESHOLD 64u      // 长度不小于该值的 CRC32 使用硬件CRC单元
+// #define CRC_HW_DMA_HANDLE hdma_memtomem_dma2_stream0 // 硬件CRC使用的内存到内存DMA句柄（字节宽度，目标地址不递增）
 /* 配置检查 */
 
 /* 开发配置 */
@@ -56,8 +82,31 @@
 #error "只能选择一种底盘类型: MECANUM, OMNI, BALANCE 或 STEER"
 #endif
 /* 遥控器配置 */
-#if (defined(DJI_DT7) && defined(FLY_SKY_I6X))
-#error "只能选择一种遥控器类型: DJI_DT7 或 FLY_SKY_I6X"
+#if (defined(DJI_DT7) && defined(FLY_SKY_I6X)) || (defined(DJI_DT7) && defined(RD_AT10)) || (defined(FLY_SKY_I6X) && defined(RD_AT10))
+#error "只能选择一种遥控器类型: DJI_DT7, FLY_SKY_I6X 或 RD_AT10"
+#endif
+/* 内存配置 */
+#if defined(MEMORY_STATIC_ARENA) && (MEMORY_HEAP_SIZE == 0)
+#error "启用 MEMORY_STATIC_ARENA 时 MEMORY_HEAP_SIZE 不能为 0"
+#endif
+/* PID配置 */
+#if defined(PID_STATIC_POOL) && (PID_POOL_SIZE <= 0 || PID_POOL_SIZE > 65535)
+#error "PID_POOL_SIZE 必须在 1~65535 之间"
+#endif
+/* 卡尔曼滤波配置 */
+#if (KALMAN_MAX_STATE_DIM < 1 || KALMAN_MAX_STATE_DIM > 16) || (KALMAN_MAX_MEAS_DIM < 1 || KALMAN_MAX_MEAS_DIM > 16) || (KALMAN_MAX_INPUT_DIM < 1 || KALMAN_MAX_INPUT_DIM > 16)
+#error "KALMAN_MAX_STATE_DIM、KALMAN_MAX_MEAS_DIM、KALMAN_MAX_INPUT_DIM 必须在 1~16 之间"
+#endif
+/* CRC配置 */
+#if (CRC_SLICING != 1) && (CRC_SLICING != 4) && (CRC_SLICING != 8)
+#error "CRC_SLICING 只能为 1、4 或 8"
+#endif
+#if defined(CRC_HW_DMA_HANDLE) && !defined(USER_HW_CRC)
+#error "配置了 CRC_HW_DMA_HANDLE，但未启用 USER_HW_CRC"
+#endif
+/* IMU配置 */
+#if (IMU_CALIB_FLASH_ADDR % 0x20000u) != 0
+#error "IMU_CALIB_FLASH_ADDR 必须是 Flash 扇区(128KB)起始地址"
 #endif
 /* CAN配置 */
 #if (defined(USER_CAN_FD) && defined(USER_CAN_STD))
@@ -0,0 +1,692 @@
+#include "imu_calib.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include "robot_config.h"
+#include "bmi088.h"
+#include "bsp_flash.h"
+#include "alg_crc.h"
+#include "memory_management.h"
+#include "plf_log.h"
+
+#define IMU_CALIB_TEMP_STEP 0.125f  // BMI088 温度分辨率，温度变化不小于该值才重新计算零偏
+
+/**
+ * @brief 清空统计量
+ * @param stat 统计量指针
+ */
+static inline void Imu_Calib_Stat_Reset(ImuCalibStat_s* stat){
+    memset(stat, 0, sizeof(ImuCalibStat_s));
+}
+
+/**
+ * @brief 加入一个样本
+ * @param stat 统计量指针
+ * @param x 样本
+ */
+static inline void Imu_Calib_Stat_Push(ImuCalibStat_s* stat, const float x[3]){
+    stat->n++;
+    const float inv_n = 1.0f / (float)stat->n;
+    for (uint8_t i = 0; i < 3; i++){
+        const float delta = x[i] - stat->mean[i];
+        stat->mean[i] += delta * inv_n;
+        stat->m2[i] += delta * (x[i] - stat->mean[i]);
+    }
+}
+
+/**
+ * @brief 样本标准差
+ * @param stat 统计量指针
+ * @param axis 轴
+ * @return 标准差，样本不足时返回 0
+ */
+static inline float Imu_Calib_Stat_Std(const ImuCalibStat_s* stat, uint8_t axis){
+    if (stat->n < 2u){
+        return 0.0f;
+    }
+    return sqrtf(stat->m2[axis] / (float)(stat->n - 1u));
+}
+
+/**
+ * @brief 标称参数
+ * @param param 参数指针
+ */
+static void Imu_Calib_Param_Default(ImuCalibParam_s* param){
+    memset(param, 0, sizeof(ImuCalibParam_s));
+    param->ref_temp = 25.0f;
+    for (uint8_t i = 0; i < 3; i++){
+        param->accel_scale[i] = 1.0f;
+    }
+}
+
+/**
+ * @brief 计算参数的 CRC32
+ * @param param 参数指针
+ * @return CRC32
+ */
+static uint32_t Imu_Calib_Param_Crc(const ImuCalibParam_s* param){
+    return Crc32_Calculate(CRC32_INIT, (const uint8_t*)param, offsetof(ImuCalibParam_s, crc)) ^ CRC32_XOROUT;
+}
+
+/**
+ * @brief 从 Flash 读取参数
+ * @param param 参数指针，失败时填入标称参数
+ * @return true 成功  false Flash 中没有有效参数
+ */
+static bool Imu_Calib_Param_Load(ImuCalibParam_s* param){
+    Flash_Read(IMU_CALIB_FLASH_ADDR, param, sizeof(ImuCalibParam_s));
+    if (param->magic == IMU_CALIB_MAGIC && param->version == IMU_CALIB_VERSION &&
+        param->size == sizeof(ImuCalibParam_s) && param->crc == Imu_Calib_Param_Crc(param)){
+        return true;
+    }
+    Imu_Calib_Param_Default(param);
+    return false;
+}
+
+/**
+ * @brief 重新计算陀螺仪零偏修正量
+ * @param calib 校准实例指针
+ * @param temp 温度 ℃
+ */
+static void Imu_Calib_Update_Gyro_Coef(ImuCalib_s* calib, float temp){
+    Imu_Calib_Get_Gyro_Bias(calib, temp, calib->gyro_c);
+    calib->gyro_c_temp = temp;
+}
+
+/**
+ * @brief 参数变化后重新计算合并的换算系数
+ * @param calib 校准实例指针
+ */
+static void Imu_Calib_Update_Coef(ImuCalib_s* calib){
+    const ImuCalibParam_s* param = &calib->param;
+    calib->gyro_k = calib->imu->gyro_sen;
+    for (uint8_t i = 0; i < 3; i++){
+        calib->accel_k[i] = calib->imu->accel_sen * param->accel_scale[i];
+        calib->accel_c[i] = -param->accel_offset[i] * param->accel_scale[i];
+    }
+    Imu_Calib_Update_Gyro_Coef(calib, calib->gyro_c_temp);
+}
+
+/**
+ * @brief 把回归的参考温度移动到 ref_temp + shift
+ * @param calib 校准实例指针
+ * @param shift 参考温度变化量 ℃
+ */
+static void Imu_Calib_Shift_Ref(ImuCalib_s* calib, float shift){
+    // x' = x - shift
+    calib->reg_s2 += shift * (shift * calib->reg_s0 - 2.0f * calib->reg_s1);
+    calib->reg_s1 -= shift * calib->reg_s0;
+    for (uint8_t i = 0; i < 3; i++){
+        calib->reg_sxy[i] -= shift * calib->reg_sy[i];
+    }
+    calib->param.ref_temp += shift;
+}
+
+/**
+ * @brief 加入一个零偏观测并重新拟合零偏温度曲线
+ * @param calib 校准实例指针
+ * @param bias 观测到的零偏 rad/s
+ * @param temp 观测时的温度 ℃
+ * @param weight 观测权重
+ */
+static void Imu_Calib_Add_Bias(ImuCalib_s* calib, const float bias[3], float temp, float weight){
+    ImuCalibParam_s* param = &calib->param;
+    if (calib->reg_s0 <= 0.0f){
+        // 第一个观测，以当前温度为参考温度
+        param->ref_temp = temp;
+        calib->reg_t_min = temp;
+        calib->reg_t_max = temp;
+    }
+    calib->reg_t_min = fminf(calib->reg_t_min, temp);
+    calib->reg_t_max = fmaxf(calib->reg_t_max, temp);
+
+    // 参考温度跟随观测的加权平均温度，使回归的零偏项不受温度系数误差影响
+    if (calib->reg_s0 > 0.0f){
+        Imu_Calib_Shift_Ref(calib, calib->reg_s1 / calib->reg_s0);
+    }
+    const float x = temp - param->ref_temp;
+    calib->reg_s0 += weight;
+    calib->reg_s1 += weight * x;
+    calib->reg_s2 += weight * x * x;
+    for (uint8_t i = 0; i < 3; i++){
+        calib->reg_sy[i] += weight * bias[i];
+        calib->reg_sxy[i] += weight * x * bias[i];
+    }
+
+    const float det = calib->reg_s0 * calib->reg_s2 - calib->reg_s1 * calib->reg_s1;
+    const bool fit_slope = (calib->reg_t_max - calib->reg_t_min >= IMU_CALIB_TRACK_MIN_SPAN) && det > 0.0f;
+    for (uint8_t i = 0; i < 3; i++){
+        float k = param->gyro_temp_coef[i];
+        if (fit_slope){
+            k = (calib->reg_s0 * calib->reg_sxy[i] - calib->reg_s1 * calib->reg_sy[i]) / det;
+            k = fmaxf(fminf(k, IMU_CALIB_TEMP_COEF_MAX), -IMU_CALIB_TEMP_COEF_MAX);
+            param->gyro_temp_coef[i] = k;
+        }
+        // 温度跨度不足时沿用已有温度系数，只估计零偏
+        param->gyro_bias[i] = (calib->reg_sy[i] - k * calib->reg_s1) / calib->reg_s0;
+    }
+    if (fit_slope){
+        param->valid |= IMU_CALIB_VALID_TEMP;
+    }
+    param->valid |= IMU_CALIB_VALID_GYRO;
+    calib->dirty = true;
+    Imu_Calib_Update_Gyro_Coef(calib, calib->gyro_c_temp);
+}
+
+/**
+ * @brief 上电零偏采集
+ * @param calib 校准实例指针
+ * @param gyro 未校准的角速度 rad/s
+ * @param temp 温度 ℃
+ */
+static void Imu_Calib_Feed_Gyro(ImuCalib_s* calib, const float gyro[3], float temp){
+    ImuCalibStat_s* stat = &calib->gyro_stat;
+    bool restart = false;
+    bool reject = false;
+    for (uint8_t i = 0; i < 3; i++){
+        if (fabsf(gyro[i]) > IMU_CALIB_GYRO_MOTION){
+            // 运动时从头等待静止，不计入重试次数
+            Imu_Calib_Stat_Reset(stat);
+            calib->gyro_temp_sum = 0.0f;
+            calib->gyro_rejected = 0;
+            return;
+        }
+        if (stat->n >= IMU_CALIB_OUTLIER_WARMUP){
+            // 标准差不小于一个 LSB，避免量化导致误剔除
+            const float std = fmaxf(Imu_Calib_Stat_Std(stat, i), calib->gyro_k);
+            if (fabsf(gyro[i] - stat->mean[i]) > IMU_CALIB_OUTLIER_SIGMA * std){
+                reject = true;
+            }
+        }
+    }
+    if (reject){
+        calib->gyro_rejected++;
+        restart = (float)calib->gyro_rejected > IMU_CALIB_OUTLIER_MAX * (float)(stat->n + calib->gyro_rejected);
+    } else {
+        Imu_Calib_Stat_Push(stat, gyro);
+        calib->gyro_temp_sum += temp;
+        if (stat->n >= IMU_CALIB_GYRO_SAMPLES){
+            for (uint8_t i = 0; i < 3; i++){
+                if (Imu_Calib_Stat_Std(stat, i) > IMU_CALIB_GYRO_STD_MAX){
+                    restart = true;
+                }
+            }
+            if (!restart){
+                calib->reg_s0 = 0.0f;
+                calib->reg_s1 = 0.0f;
+                calib->reg_s2 = 0.0f;
+                memset(calib->reg_sy, 0, sizeof(calib->reg_sy));
+                memset(calib->reg_sxy, 0, sizeof(calib->reg_sxy));
+                Imu_Calib_Add_Bias(calib, stat->mean, calib->gyro_temp_sum / (float)stat->n,
+                                   (float)IMU_CALIB_GYRO_SAMPLES / (float)IMU_CALIB_TRACK_WINDOW);
+                calib->state = IMU_CALIB_IDLE;
+                Log_Passing("Imu Calib Gyro Bias Success");
+                return;
+            }
+        }
+    }
+    if (restart){
+        calib->gyro_retry++;
+        if (calib->gyro_retry > IMU_CALIB_GYRO_RETRY){
+            calib->state = IMU_CALIB_IDLE;
+            Log_Warning("Imu Calib Gyro Bias Failed, keep previous bias");
+            return;
+        }
+        Imu_Calib_Stat_Reset(stat);
+        calib->gyro_temp_sum = 0.0f;
+        calib->gyro_rejected = 0;
+    }
+}
+
+/**
+ * @brief 求解 6 元线性方程组(列主元高斯消元)
+ * @param a 系数矩阵，会被修改
+ * @param b 右端项，输出解
+ * @return true 成功  false 矩阵奇异
+ */
+static bool Imu_Calib_Solve6(float a[6][6], float b[6]){
+    for (uint8_t col = 0; col < 6; col++){
+        uint8_t pivot = col;
+        for (uint8_t row = col + 1u; row < 6; row++){
+            if (fabsf(a[row][col]) > fabsf(a[pivot][col])){
+                pivot = row;
+            }
+        }
+        if (fabsf(a[pivot][col]) < 1e-12f){
+            return false;
+        }
+        if (pivot != col){
+            for (uint8_t k = 0; k < 6; k++){
+                const float t = a[col][k];
+                a[col][k] = a[pivot][k];
+                a[pivot][k] = t;
+            }
+            const float t = b[col];
+            b[col] = b[pivot];
+            b[pivot] = t;
+        }
+        for (uint8_t row = col + 1u; row < 6; row++){
+            const float f = a[row][col] / a[col][col];
+            for (uint8_t k = col; k < 6; k++){
+                a[row][k] -= f * a[col][k];
+            }
+            b[row] -= f * b[col];
+        }
+    }
+    for (int8_t row = 5; row >= 0; row--){
+        for (uint8_t k = (uint8_t)row + 1u; k < 6; k++){
+            b[row] -= a[row][k] * b[k];
+        }
+        b[row] /= a[row][row];
+    }
+    return true;
+}
+
+/**
+ * @brief 由六个姿态的加速度均值拟合零偏和比例
+ * @param face 六个姿态的加速度均值 m/s^2
+ * @param offset 输出零偏
+ * @param scale 输出比例
+ * @return true 成功  false 拟合结果超出范围
+ * @note 残差 r = |(m - offset) .* scale|^2 - g^2，以 ±g 对称假设的闭式解为初值
+ */
+static bool Imu_Calib_Fit_Accel(const float face[6][3], float offset[3], float scale[3]){
+    const float g2 = IMU_CALIB_GRAVITY * IMU_CALIB_GRAVITY;
+    for (uint8_t i = 0; i < 3; i++){
+        const float pos = face[i * 2][i];
+        const float neg = face[i * 2 + 1][i];
+        offset[i] = 0.5f * (pos + neg);
+        scale[i] = 2.0f * IMU_CALIB_GRAVITY / (pos - neg);
+    }
+
+    for (uint8_t iter = 0; iter < IMU_CALIB_FIT_ITER; iter++){
+        float jtj[6][6] = {0};
+        float jtr[6] = {0};
+        for (uint8_t f = 0; f < 6; f++){
+            float jac[6];
+            float r = -g2;
+            for (uint8_t i = 0; i < 3; i++){
+                const float d = face[f][i] - offset[i];
+                r += d * d * scale[i] * scale[i];
+                jac[i] = -2.0f * d * scale[i] * scale[i];
+                jac[i + 3] = 2.0f * d * d * scale[i];
+            }
+            for (uint8_t m = 0; m < 6; m++){
+                jtr[m] -= jac[m] * r;
+                for (uint8_t n = 0; n < 6; n++){
+                    jtj[m][n] += jac[m] * jac[n];
+                }
+            }
+        }
+        if (!Imu_Calib_Solve6(jtj, jtr)){
+            return false;
+        }
+        float step = 0.0f;
+        for (uint8_t i = 0; i < 3; i++){
+            offset[i] += jtr[i];
+            scale[i] += jtr[i + 3];
+            step = fmaxf(step, fmaxf(fabsf(jtr[i]) * 1e-3f, fabsf(jtr[i + 3])));
+        }
+        if (step < 1e-6f){
+            break;
+        }
+    }
+
+    for (uint8_t i = 0; i < 3; i++){
+        if (!(fabsf(offset[i]) <= IMU_CALIB_OFFSET_MAX) ||
+            !(scale[i] >= IMU_CALIB_SCALE_MIN && scale[i] <= IMU_CALIB_SCALE_MAX)){
+            return false;
+        }
+    }
+    for (uint8_t f = 0; f < 6; f++){
+        float norm2 = 0.0f;
+        for (uint8_t i = 0; i < 3; i++){
+            const float a = (face[f][i] - offset[i]) * scale[i];
+            norm2 += a * a;
+        }
+        if (fabsf(sqrtf(norm2) - IMU_CALIB_GRAVITY) > IMU_CALIB_FIT_RESIDUAL){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 六面校准采集
+ * @param calib 校准实例指针
+ * @param gyro 未校准的角速度 rad/s
+ * @param accel 未校准的加速度 m/s^2
+ */
+static void Imu_Calib_Feed_Accel(ImuCalib_s* calib, const float gyro[3], const float accel[3]){
+    ImuCalibStat_s* stat = &calib->face_stat;
+    for (uint8_t i = 0; i < 3; i++){
+        if (fabsf(gyro[i] - calib->gyro_c[i]) > IMU_CALIB_GYRO_MOTION){
+            Imu_Calib_Stat_Reset(stat);
+            return;
+        }
+    }
+    Imu_Calib_Stat_Push(stat, accel);
+    if (stat->n < IMU_CALIB_FACE_SAMPLES){
+        return;
+    }
+
+    // 静止且有一个轴基本竖直时记录该姿态
+    uint8_t axis = 0;
+    for (uint8_t i = 0; i < 3; i++){
+        if (Imu_Calib_Stat_Std(stat, i) > IMU_CALIB_ACCEL_STD_MAX){
+            Imu_Calib_Stat_Reset(stat);
+            return;
+        }
+        if (fabsf(stat->mean[i]) > fabsf(stat->mean[axis])){
+            axis = i;
+        }
+    }
+    if (fabsf(stat->mean[axis]) >= IMU_CALIB_FACE_MIN * IMU_CALIB_GRAVITY){
+        const uint8_t face = axis * 2u + ((stat->mean[axis] < 0.0f) ? 1u : 0u);
+        memcpy(calib->face[face], stat->mean, sizeof(calib->face[face]));
+        if ((calib->face_mask & (1u << face)) == 0u){
+            calib->face_mask |= (uint8_t)(1u << face);
+            Log_Passing("Imu Calib Accel Face %d Captured", face);
+        }
+    }
+    Imu_Calib_Stat_Reset(stat);
+
+    if (calib->face_mask != 0x3Fu){
+        return;
+    }
+    float offset[3];
+    float scale[3];
+    if (Imu_Calib_Fit_Accel((const float (*)[3])calib->face, offset, scale)){
+        memcpy(calib->param.accel_offset, offset, sizeof(offset));
+        memcpy(calib->param.accel_scale, scale, sizeof(scale));
+        calib->param.valid |= IMU_CALIB_VALID_ACCEL;
+        calib->dirty = true;
+        Imu_Calib_Update_Coef(calib);
+        Log_Passing("Imu Calib Accel Success");
+    } else {
+        Log_Warning("Imu Calib Accel Fit Failed, keep previous parameters");
+    }
+    calib->state = IMU_CALIB_IDLE;
+}
+
+/**
+ * @brief 静止时跟踪零偏温度漂移
+ * @param calib 校准实例指针
+ * @param gyro 未校准的角速度 rad/s
+ * @param accel 未校准的加速度 m/s^2
+ * @param temp 温度 ℃
+ */
+static void Imu_Calib_Feed_Track(ImuCalib_s* calib, const float gyro[3], const float accel[3], float temp){
+    for (uint8_t i = 0; i < 3; i++){
+        if (fabsf(gyro[i] - calib->gyro_c[i]) > IMU_CALIB_GYRO_MOTION){
+            Imu_Calib_Stat_Reset(&calib->track_gyro);
+            Imu_Calib_Stat_Reset(&calib->track_accel);
+            calib->track_temp_sum = 0.0f;
+            return;
+        }
+    }
+    Imu_Calib_Stat_Push(&calib->track_gyro, gyro);
+    Imu_Calib_Stat_Push(&calib->track_accel, accel);
+    calib->track_temp_sum += temp;
+    if (calib->track_gyro.n < IMU_CALIB_TRACK_WINDOW){
+        return;
+    }
+
+    const float window_temp = calib->track_temp_sum / (float)calib->track_gyro.n;
+    float bias[3];
+    Imu_Calib_Get_Gyro_Bias(calib, window_temp, bias);
+    bool still = true;
+    float norm2 = 0.0f;
+    for (uint8_t i = 0; i < 3; i++){
+        const float a = (calib->track_accel.mean[i] - calib->param.accel_offset[i]) * calib->param.accel_scale[i];
+        norm2 += a * a;
+        still = still && Imu_Calib_Stat_Std(&calib->track_gyro, i) <= IMU_CALIB_GYRO_STD_MAX &&
+                Imu_Calib_Stat_Std(&calib->track_accel, i) <= IMU_CALIB_ACCEL_STD_MAX &&
+                fabsf(calib->track_gyro.mean[i] - bias[i]) <= IMU_CALIB_TRACK_MAX_DEV;
+    }
+    still = still && fabsf(sqrtf(norm2) - IMU_CALIB_GRAVITY) <= IMU_CALIB_TRACK_ACCEL_DEV;
+    if (still){
+        // 遗忘旧观测，使曲线跟随传感器老化
+        calib->reg_s0 *= IMU_CALIB_TRACK_FORGET;
+        calib->reg_s1 *= IMU_CALIB_TRACK_FORGET;
+        calib->reg_s2 *= IMU_CALIB_TRACK_FORGET;
+        for (uint8_t i = 0; i < 3; i++){
+            calib->reg_sy[i] *= IMU_CALIB_TRACK_FORGET;
+            calib->reg_sxy[i] *= IMU_CALIB_TRACK_FORGET;
+        }
+        Imu_Calib_Add_Bias(calib, calib->track_gyro.mean, window_temp, 1.0f);
+    }
+    Imu_Calib_Stat_Reset(&calib->track_gyro);
+    Imu_Calib_Stat_Reset(&calib->track_accel);
+    calib->track_temp_sum = 0.0f;
+}
+
+/**
+ * @brief 注册校准实例，从 Flash 读取参数
+ * @param config 初始化配置
+ * @return 实例指针，失败返回NULL
+ * @note 换算系数使用 BMI088 实例的量程灵敏度
+ */
+ImuCalib_s* Imu_Calib_Register(const ImuCalibInitConfig_s* config){
+    if (config == NULL || config->imu == NULL){
+        Log_Error("Imu_Calib_Register invalid config");
+        return NULL;
+    }
+    ImuCalib_s* calib = user_malloc(sizeof(ImuCalib_s));
+    if (calib == NULL){
+        Log_Error("imu_calib Malloc Failed");
+        return NULL;
+    }
+    memset(calib, 0, sizeof(ImuCalib_s));
+    calib->imu = config->imu;
+    if (Imu_Calib_Param_Load(&calib->param)){
+        Log_Passing("Imu Calib Load Success");
+    } else {
+        Log_Warning("Imu Calib Not Found In Flash, use default");
+    }
+    calib->temp_tracking = config->temp_tracking;
+    calib->gyro_c_temp = calib->param.ref_temp;
+    Imu_Calib_Update_Coef(calib);
+    if (config->boot_gyro_calib){
+        Imu_Calib_Start_Gyro(calib);
+    }
+    return calib;
+}
+
+/**
+ * @brief 开始采集陀螺仪零偏，采集期间需保持静止
+ * @param calib 校准实例指针
+ */
+void Imu_Calib_Start_Gyro(ImuCalib_s* calib){
+    if (calib == NULL){
+        return;
+    }
+    Imu_Calib_Stat_Reset(&calib->gyro_stat);
+    calib->gyro_temp_sum = 0.0f;
+    calib->gyro_rejected = 0;
+    calib->gyro_retry = 0;
+    calib->state = IMU_CALIB_GYRO;
+}
+
+/**
+ * @brief 开始六面校准，之后依次把六个面朝下静置
+ * @param calib 校准实例指针
+ */
+void Imu_Calib_Start_Accel(ImuCalib_s* calib){
+    if (calib == NULL){
+        return;
+    }
+    Imu_Calib_Stat_Reset(&calib->face_stat);
+    calib->face_mask = 0;
+    calib->state = IMU_CALIB_ACCEL;
+}
+
+/**
+ * @brief 原始值换算为校准后的物理量
+ * @param calib 校准实例指针
+ * @param gyro_raw 陀螺仪原始值
+ * @param accel_raw 加速度计原始值
+ * @param temp 温度 ℃
+ * @param gyro 校准后的角速度 rad/s
+ * @param accel 校准后的加速度 m/s^2
+ */
+void Imu_Calib_Correct(ImuCalib_s* calib, const int16_t gyro_raw[3], const int16_t accel_raw[3], float temp,
+                       float gyro[3], float accel[3]){
+    if (fabsf(temp - calib->gyro_c_temp) >= IMU_CALIB_TEMP_STEP){
+        Imu_Calib_Update_Gyro_Coef(calib, temp);
+    }
+    for (uint8_t i = 0; i < 3; i++){
+        gyro[i] = (float)gyro_raw[i] * calib->gyro_k - calib->gyro_c[i];
+        accel[i] = (float)accel_raw[i] * calib->accel_k[i] + calib->accel_c[i];
+    }
+}
+
+/**
+ * @brief 输入一个样本，推进正在进行的校准和温度跟踪
+ * @param calib 校准实例指针
+ * @param gyro_raw 陀螺仪原始值
+ * @param accel_raw 加速度计原始值
+ * @param temp 温度 ℃
+ */
+void Imu_Calib_Feed(ImuCalib_s* calib, const int16_t gyro_raw[3], const int16_t accel_raw[3], float temp){
+    if (calib == NULL){
+        return;
+    }
+    if (calib->state == IMU_CALIB_IDLE && !(calib->temp_tracking && (calib->param.valid & IMU_CALIB_VALID_GYRO))){
+        return;
+    }
+    float gyro[3];
+    float accel[3];
+    for (uint8_t i = 0; i < 3; i++){
+        gyro[i] = (float)gyro_raw[i] * calib->gyro_k;
+        accel[i] = (float)accel_raw[i] * calib->imu->accel_sen;
+    }
+    switch (calib->state){
+        case IMU_CALIB_GYRO:
+            Imu_Calib_Feed_Gyro(calib, gyro, temp);
+            break;
+        case IMU_CALIB_ACCEL:
+            Imu_Calib_Feed_Accel(calib, gyro, accel);
+            break;
+        default:
+            Imu_Calib_Feed_Track(calib, gyro, accel, temp);
+            break;
+    }
+}
+
+/**
+ * @brief 中断采样得到的单个样本换算为校准后的物理量
+ * @param calib 校准实例指针
+ * @param sample 陀螺仪或加速度计样本
+ * @param out 陀螺仪样本输出角速度 rad/s，加速度计样本输出加速度 m/s^2
+ */
+void Imu_Calib_Correct_Sample(ImuCalib_s* calib, const Bmi088Sample_s* sample, float out[3]){
+    if (sample->type == BMI088_SAMPLE_GYRO){
+        for (uint8_t i = 0; i < 3; i++){
+            out[i] = (float)sample->data[i] * calib->gyro_k - calib->gyro_c[i];
+        }
+        return;
+    }
+    if (fabsf(sample->temperate - calib->gyro_c_temp) >= IMU_CALIB_TEMP_STEP){
+        Imu_Calib_Update_Gyro_Coef(calib, sample->temperate);
+    }
+    for (uint8_t i = 0; i < 3; i++){
+        out[i] = (float)sample->data[i] * calib->accel_k[i] + calib->accel_c[i];
+    }
+}
+
+/**
+ * @brief 输入中断采样得到的单个样本，推进正在进行的校准和温度跟踪
+ * @param calib 校准实例指针
+ * @param sample 陀螺仪或加速度计样本
+ */
+void Imu_Calib_Feed_Sample(ImuCalib_s* calib, const Bmi088Sample_s* sample){
+    if (calib == NULL || sample == NULL || sample->type >= BMI088_SAMPLE_TYPE_CNT){
+        return;
+    }
+    if (sample->type == BMI088_SAMPLE_GYRO){
+        memcpy(calib->sample_gyro, sample->data, sizeof(calib->sample_gyro));
+    } else {
+        memcpy(calib->sample_accel, sample->data, sizeof(calib->sample_accel));
+        calib->sample_temp = sample->temperate;
+    }
+    calib->sample_mask |= (uint8_t)(1u << sample->type);
+    if (calib->sample_mask != (1u << BMI088_SAMPLE_TYPE_CNT) - 1u){
+        return;
+    }
+    // 每种状态只由一种样本推进，样本数和窗口长度按该传感器的输出频率计
+    const uint8_t driver = (calib->state == IMU_CALIB_ACCEL) ? BMI088_SAMPLE_ACCEL : BMI088_SAMPLE_GYRO;
+    if (sample->type == driver){
+        Imu_Calib_Feed(calib, calib->sample_gyro, calib->sample_accel, calib->sample_temp);
+    }
+}
+
+/**
+ * @brief 读取 BMI088 并输出校准后的数据，同时推进校准
+ * @param calib 校准实例指针
+ * @param gyro 校准后的角速度 rad/s
+ * @param accel 校准后的加速度 m/s^2
+ * @param temp 温度 ℃
+ * @return true 成功  false 读取失败，输出未更新
+ * @note 只适用于未启动中断采样的轮询方式
+ */
+bool Imu_Calib_Read(ImuCalib_s* calib, float gyro[3], float accel[3], float* temp){
+    if (calib == NULL || temp == NULL){
+        return false;
+    }
+    int16_t gyro_raw[3];
+    int16_t accel_raw[3];
+    float t;
+    if (!Bmi088_Read_Raw(calib->imu, gyro_raw, accel_raw, &t)){
+        return false;
+    }
+    Imu_Calib_Correct(calib, gyro_raw, accel_raw, t, gyro, accel);
+    Imu_Calib_Feed(calib, gyro_raw, accel_raw, t);
+    *temp = t;
+    return true;
+}
+
+/**
+ * @brief 当前温度下的陀螺仪零偏
+ * @param calib 校准实例指针
+ * @param temp 温度 ℃
+ * @param bias 输出零偏 rad/s
+ */
+void Imu_Calib_Get_Gyro_Bias(const ImuCalib_s* calib, float temp, float bias[3]){
+    const ImuCalibParam_s* param = &calib->param;
+    const float x = temp - param->ref_temp;
+    for (uint8_t i = 0; i < 3; i++){
+        bias[i] = param->gyro_bias[i] + param->gyro_temp_coef[i] * x;
+    }
+}
+
+/**
+ * @brief 将当前参数保存到 Flash
+ * @param calib 校准实例指针
+ * @return true 成功
+ * @note 需要擦除整个扇区，只能在停机状态下调用
+ */
+bool Imu_Calib_Save(ImuCalib_s* calib){
+    if (calib == NULL){
+        return false;
+    }
+    ImuCalibParam_s* param = &calib->param;
+    param->magic = IMU_CALIB_MAGIC;
+    param->version = IMU_CALIB_VERSION;
+    param->size = sizeof(ImuCalibParam_s);
+    param->crc = Imu_Calib_Param_Crc(param);
+    if (!Flash_Erase_Sector(IMU_CALIB_FLASH_ADDR) ||
+        !Flash_Program(IMU_CALIB_FLASH_ADDR, param, sizeof(ImuCalibParam_s))){
+        Log_Error("Imu Calib Save Failed");
+        return false;
+    }
+    ImuCalibParam_s check;
+    Flash_Read(IMU_CALIB_FLASH_ADDR, &check, sizeof(check));
+    if (memcmp(&check, param, sizeof(check)) != 0){
+        Log_Error("Imu Calib Save Verify Failed");
+        return false;
+    }
+    calib->dirty = false;
+    Log_Passing("Imu Calib Save Success");
+    return true;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file imu_calib.h
+ * @brief BMI088 校准：上电陀螺仪零偏、六面加速度计校准、零偏温度跟踪、Flash 保存
+ * @note 数据流：Imu_Calib_Read 读取原始值 -> Imu_Calib_Correct 一次乘加得到校准后的物理量
+ *       -> Imu_Calib_Feed 用未校准的物理量推进正在进行的校准。
+ *       启动中断采样后 Bmi088_Read_Raw 不可用，改用 Imu_Calib_Correct_Sample / Imu_Calib_Feed_Sample
+ *       逐个处理 Bmi088_Pop_Samples 取出的样本：陀螺仪和加速度计样本各自换算，
+ *       校准状态机与另一种传感器最新的样本配对后推进。
+ *       - 上电零偏：静止采集 IMU_CALIB_GYRO_SAMPLES 个样本，超过 IMU_CALIB_OUTLIER_SIGMA 倍标准差的样本剔除，
+ *         检测到运动或剔除过多时重新开始。
+ *       - 六面校准：依次把 IMU 六个面朝下静置，每个姿态静止 IMU_CALIB_FACE_SAMPLES 个样本后自动记录，
+ *         六个姿态齐全后用高斯牛顿法拟合各轴零偏和比例。
+ *       - 温度跟踪：每 IMU_CALIB_TRACK_WINDOW 个样本判断一次静止，静止窗口的陀螺仪均值作为零偏观测，
+ *         带遗忘因子线性回归得到 零偏 = gyro_bias + gyro_temp_coef * (温度 - ref_temp)。
+ *       - 参数带 CRC32 保存在 IMU_CALIB_FLASH_ADDR 扇区，上电读取校验失败时使用标称参数。
+ *       单位：陀螺仪 rad/s，加速度计 m/s^2，温度 ℃。
+ */
+#ifndef IMU_CALIB_H
+#define IMU_CALIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bmi088.h"
+
+#define IMU_CALIB_GRAVITY           9.80665f    // 重力加速度 m/s^2
+#define IMU_CALIB_MAGIC             0x494D5543u // "IMUC"
+#define IMU_CALIB_VERSION           1u
+
+/* 上电零偏采集 */
+#define IMU_CALIB_GYRO_SAMPLES      2000u       // 样本数
+#define IMU_CALIB_GYRO_MOTION       0.05f       // 任一轴超过该值视为运动，rad/s
+#define IMU_CALIB_GYRO_STD_MAX      0.005f      // 采集结束时各轴标准差上限，rad/s
+#define IMU_CALIB_OUTLIER_SIGMA     5.0f        // 剔除偏离均值超过该倍数标准差的样本
+#define IMU_CALIB_OUTLIER_WARMUP    100u        // 前若干样本只做运动判断，不剔除
+#define IMU_CALIB_OUTLIER_MAX       0.05f       // 剔除比例上限，超过后重新采集
+#define IMU_CALIB_GYRO_RETRY        10u         // 最大重新采集次数
+
+/* 六面校准 */
+#define IMU_CALIB_FACE_SAMPLES      500u        // 每个姿态的样本数
+#define IMU_CALIB_ACCEL_STD_MAX     0.05f       // 静止时加速度计各轴标准差上限，m/s^2
+#define IMU_CALIB_FACE_MIN          0.8f        // 朝下轴分量不小于该倍数 g 才记录
+#define IMU_CALIB_SCALE_MIN         0.9f        // 拟合得到的比例范围
+#define IMU_CALIB_SCALE_MAX         1.1f
+#define IMU_CALIB_OFFSET_MAX        1.0f        // 拟合得到的零偏上限，m/s^2
+#define IMU_CALIB_FIT_ITER          10u         // 高斯牛顿最大迭代次数
+#define IMU_CALIB_FIT_RESIDUAL      0.1f        // 拟合后各姿态加速度模长与 g 之差上限，m/s^2
+
+/* 温度跟踪 */
+#define IMU_CALIB_TRACK_WINDOW      500u        // 静止判断窗口样本数
+#define IMU_CALIB_TRACK_MAX_DEV     0.02f       // 窗口均值与当前零偏之差上限，超过视为在转动，rad/s
+#define IMU_CALIB_TRACK_ACCEL_DEV   0.3f        // 窗口加速度模长与 g 之差上限，m/s^2
+#define IMU_CALIB_TRACK_FORGET      0.998f      // 每个静止窗口的遗忘因子
+#define IMU_CALIB_TRACK_MIN_SPAN    2.0f        // 温度跨度不小于该值才估计温度系数，℃
+#define IMU_CALIB_TEMP_COEF_MAX     0.002f      // 温度系数上限，rad/s/℃
+
+/* valid 位定义 */
+#define IMU_CALIB_VALID_GYRO        (1u << 0)   // 陀螺仪零偏有效
+#define IMU_CALIB_VALID_ACCEL       (1u << 1)   // 加速度计零偏和比例有效
+#define IMU_CALIB_VALID_TEMP        (1u << 2)   // 零偏温度系数有效
+
+/**
+ * @brief 校准参数，整体保存到 Flash
+ */
+typedef struct {
+    uint32_t magic;             // IMU_CALIB_MAGIC
+    uint16_t version;           // IMU_CALIB_VERSION
+    uint16_t size;              // sizeof(ImuCalibParam_s)
+    float gyro_bias[3];         // ref_temp 下的陀螺仪零偏，rad/s
+    float gyro_temp_coef[3];    // 陀螺仪零偏温度系数，rad/s/℃
+    float ref_temp;             // 参考温度，℃
+    float accel_offset[3];      // 加速度计零偏，m/s^2
+    float accel_scale[3];       // 加速度计比例，校准值 = (测量值 - offset) * scale
+    uint32_t valid;             // IMU_CALIB_VALID_*
+    uint32_t crc;               // 之前所有字节的 CRC32
+} ImuCalibParam_s;
+
+/**
+ * @brief 校准状态
+ */
+typedef enum {
+    IMU_CALIB_IDLE = 0,         // 只做温度跟踪（若使能）
+    IMU_CALIB_GYRO = 1,         // 上电零偏采集中
+    IMU_CALIB_ACCEL = 2         // 六面校准中
+} ImuCalibState_e;
+
+/**
+ * @brief 三轴均值方差在线统计(Welford)
+ */
+typedef struct {
+    uint32_t n;
+    float mean[3];
+    float m2[3];
+} ImuCalibStat_s;
+
+/**
+ * @brief 校准实例
+ */
+typedef struct {
+    Bmi088Instance_s* imu;      // 被校准的 BMI088 实例
+    ImuCalibParam_s param;      // 当前参数
+    ImuCalibState_e state;      // 校准状态
+    bool temp_tracking;         // 是否跟踪零偏温度漂移
+    bool dirty;                 // 参数已更新但未保存
+
+    /* 合并后的换算系数：gyro = raw * gyro_k - gyro_c，accel = raw * accel_k + accel_c */
+    float gyro_k;
+    float gyro_c[3];
+    float gyro_c_temp;          // gyro_c 对应的温度
+    float accel_k[3];
+    float accel_c[3];
+
+    /* 上电零偏采集 */
+    ImuCalibStat_s gyro_stat;
+    float gyro_temp_sum;
+    uint32_t gyro_rejected;
+    uint8_t gyro_retry;
+
+    /* 六面校准 */
+    ImuCalibStat_s face_stat;
+    float face[6][3];           // 各姿态的加速度均值，下标 = 轴 * 2 + (负向 ? 1 : 0)
+    uint8_t face_mask;
+
+    /* 温度跟踪 */
+    ImuCalibStat_s track_gyro;
+    ImuCalibStat_s track_accel;
+    float track_temp_sum;
+    float reg_s0, reg_s1, reg_s2;   // 回归累加量 Σw, Σw·x, Σw·x²，x = 温度 - ref_temp
+    float reg_sy[3], reg_sxy[3];    // Σw·y, Σw·x·y
+    float reg_t_min, reg_t_max;     // 观测到的温度范围
+
+    /* 中断样本配对：缓存每种传感器最新的原始值 */
+    int16_t sample_gyro[3];
+    int16_t sample_accel[3];
+    float sample_temp;          // 最新加速度计样本的温度 ℃
+    uint8_t sample_mask;        // 已收到的样本类型，位 = Bmi088SampleType_e
+} ImuCalib_s;
+
+/**
+ * @brief 校准初始化配置
+ */
+typedef struct {
+    Bmi088Instance_s* imu;      // 被校准的 BMI088 实例，需已注册
+    bool boot_gyro_calib;       // 上电后采集陀螺仪零偏
+    bool temp_tracking;         // 静止时跟踪零偏温度漂移
+} ImuCalibInitConfig_s;
+
+/**
+ * @brief 注册校准实例，从 Flash 读取参数
+ * @param config 初始化配置
+ * @return 实例指针，失败返回NULL
+ * @note 换算系数使用 BMI088 实例的量程灵敏度
+ */
+ImuCalib_s* Imu_Calib_Register(const ImuCalibInitConfig_s* config);
+
+/**
+ * @brief 开始采集陀螺仪零偏，采集期间需保持静止
+ * @param calib 校准实例指针
+ */
+void Imu_Calib_Start_Gyro(ImuCalib_s* calib);
+
+/**
+ * @brief 开始六面校准，之后依次把六个面朝下静置
+ * @param calib 校准实例指针
+ */
+void Imu_Calib_Start_Accel(ImuCalib_s* calib);
+
+/**
+ * @brief 原始值换算为校准后的物理量
+ * @param calib 校准实例指针
+ * @param gyro_raw 陀螺仪原始值
+ * @param accel_raw 加速度计原始值
+ * @param temp 温度 ℃
+ * @param gyro 校准后的角速度 rad/s
+ * @param accel 校准后的加速度 m/s^2
+ */
+void Imu_Calib_Correct(ImuCalib_s* calib, const int16_t gyro_raw[3], const int16_t accel_raw[3], float temp,
+                       float gyro[3], float accel[3]);
+
+/**
+ * @brief 输入一个样本，推进正在进行的校准和温度跟踪
+ * @param calib 校准实例指针
+ * @param gyro_raw 陀螺仪原始值
+ * @param accel_raw 加速度计原始值
+ * @param temp 温度 ℃
+ */
+void Imu_Calib_Feed(ImuCalib_s* calib, const int16_t gyro_raw[3], const int16_t accel_raw[3], float temp);
+
+/**
+ * @brief 中断采样得到的单个样本换算为校准后的物理量
+ * @param calib 校准实例指针
+ * @param sample 陀螺仪或加速度计样本
+ * @param out 陀螺仪样本输出角速度 rad/s，加速度计样本输出加速度 m/s^2
+ * @note 陀螺仪零偏使用最近一个加速度计样本的温度
+ */
+void Imu_Calib_Correct_Sample(ImuCalib_s* calib, const Bmi088Sample_s* sample, float out[3]);
+
+/**
+ * @brief 输入中断采样得到的单个样本，推进正在进行的校准和温度跟踪
+ * @param calib 校准实例指针
+ * @param sample 陀螺仪或加速度计样本
+ * @note 六面校准时由加速度计样本推进，其余状态由陀螺仪样本推进，
+ *       与另一种传感器最新的样本配对；两种样本都收到之前不推进
+ */
+void Imu_Calib_Feed_Sample(ImuCalib_s* calib, const Bmi088Sample_s* sample);
+
+/**
+ * @brief 读取 BMI088 并输出校准后的数据，同时推进校准
+ * @param calib 校准实例指针
+ * @param gyro 校准后的角速度 rad/s
+ * @param accel 校准后的加速度 m/s^2
+ * @param temp 温度 ℃
+ * @return true 成功  false 读取失败，输出未更新
+ * @note 只适用于未启动中断采样的轮询方式
+ */
+bool Imu_Calib_Read(ImuCalib_s* calib, float gyro[3], float accel[3], float* temp);
+
+/**
+ * @brief 当前温度下的陀螺仪零偏
+ * @param calib 校准实例指针
+ * @param temp 温度 ℃
+ * @param bias 输出零偏 rad/s
+ */
+void Imu_Calib_Get_Gyro_Bias(const ImuCalib_s* calib, float temp, float bias[3]);
+
+/**
+ * @brief 将当前参数保存到 Flash
+ * @param calib 校准实例指针
+ * @return true 成功
+ * @note 需要擦除整个扇区，只能在停机状态下调用
+ */
+bool Imu_Calib_Save(ImuCalib_s* calib);
+
+#endif // IMU_CALIB_H
@@ -0,0 +1,107 @@
+#include "referee.h"
+#include "bsp_usart.h"
+#include "memory_management.h"
+#include "plf_log.h"
+#include "watch_dog.h"
+#include <string.h>
+
+/**
+ * @brief 帧回调，统计帧率
+ * @param parser 解码器指针
+ * @param cmd_id 命令码
+ * @param data 数据段指针
+ * @param len 数据段长度
+ */
+static void Referee_Frame_Callback(RefereeParser_s* parser, uint16_t cmd_id, const uint8_t* data, uint16_t len){
+    (void)cmd_id;
+    (void)data;
+    (void)len;
+    RefereeInstance_s* referee_instance = parser->parent_ptr;
+    referee_instance->rx_freq.cnt_1s++;
+}
+
+/**
+ * @brief 裁判系统接收回调函数，循环DMA每个半满/全满/空闲事件回调一次新数据段
+ * @param usart_instance USART实例指针
+ * @param data 数据段指针，直接指向DMA缓冲区
+ * @param len 数据段长度
+ */
+static void Referee_Usart_Callback(UsartInstance_s *usart_instance, const uint8_t* data, uint16_t len){
+    if (usart_instance == NULL || usart_instance->parent_ptr == NULL){
+        return;
+    }
+    RefereeInstance_s* referee_instance = usart_instance->parent_ptr;
+    Referee_Parser_Feed(&referee_instance->parser, data, len);
+}
+
+/**
+ * @brief 看门狗回调，更新帧率和在线状态
+ * @param watchdog_instance 看门狗实例指针
+ */
+static void Monitor_Referee(WatchDogInstance_s* watchdog_instance){
+    RefereeInstance_s* instance = (RefereeInstance_s*)watchdog_instance->parent_ptr;
+    instance->rx_freq.frequency = instance->rx_freq.cnt_1s;
+    instance->rx_freq.cnt_1s = 0;
+    instance->online = (instance->rx_freq.frequency > 0);
+}
+
+/**
+ * @brief 注册裁判系统实例
+ * @param huart UART句柄指针
+ * @return 裁判系统实例指针
+ */
+RefereeInstance_s* Referee_Register(UART_HandleTypeDef *huart){
+    RefereeInstance_s* referee_instance = user_malloc(sizeof(RefereeInstance_s));
+    if (referee_instance == NULL){
+        Log_Error("Referee referee_instance Malloc Failed");
+        return NULL;
+    }
+    memset(referee_instance, 0, sizeof(RefereeInstance_s));
+    Referee_Parser_Init(&referee_instance->parser, Referee_Frame_Callback, referee_instance);
+
+    UsartInitConfig_s usart_config = {0};
+    WatchDogInitConfig_s watch_dog_config = {0};
+    /* 循环DMA环形缓冲区，长度 rx_len * 2 */
+    uint8_t* rx_buff = Memory_Region_Malloc(MEMORY_REGION_RAM_D1, REFEREE_RX_LEN * 2);
+    if (rx_buff == NULL){
+        Log_Error("Referee Rx Buffer Malloc Failed");
+        user_free(referee_instance);
+        return NULL;
+    }
+    usart_config.topic_name = "Referee";
+    usart_config.huart_handle = huart;
+    usart_config.mode = DMA_MODE;
+    usart_config.direction = RX_MODE;
+    usart_config.rx_len = REFEREE_RX_LEN;
+    usart_config.rx_mode = USART_RX_CIRCULAR;
+    usart_config.first_rx_buf = rx_buff;
+    usart_config.parent_ptr = referee_instance;
+    usart_config.usart_rx_span_callback = Referee_Usart_Callback;
+    referee_instance->usart_instance = Usart_Register(&usart_config);
+    if (referee_instance->usart_instance == NULL){
+        Log_Error("Referee Usart Register Failed");
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_buff);
+        user_free(referee_instance);
+        return NULL;
+    }
+    Usart_RxDMA_Circular_Init(referee_instance->usart_instance);
+
+    watch_dog_config.topic_name = "Referee";
+    watch_dog_config.parent_ptr = referee_instance;
+    watch_dog_config.watchdog_callback = Monitor_Referee;
+    referee_instance->watchdog_instance = WatchDog_Register(&watch_dog_config);
+
+    return referee_instance;
+}
+
+/**
+ * @brief 获取解码数据
+ * @param instance 裁判系统实例指针
+ * @return 解码数据指针
+ */
+const RefereeData_s* Referee_Get_Data(const RefereeInstance_s *instance){
+    if (instance == NULL){
+        return NULL;
+    }
+    return &instance->parser.data;
+}
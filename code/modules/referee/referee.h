@@ -0,0 +1,41 @@
+/**
+ * @file referee.h
+ * @date 25-12-03
+ * @brief 裁判系统模块，USART 循环DMA接收 + 流式解码
+ * @note 解码在 DMA 半满/全满中断和 USART 空闲中断中完成；底盘功率限制、枪口热量控制直接读取 data 中的结构体，
+ *       通过 update_flag 判断是否有新数据，online 由看门狗每秒根据接收帧率更新。
+ */
+#ifndef REFEREE_H
+#define REFEREE_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "bsp_usart.h"
+#include "module_typedef.h"
+#include "watch_dog.h"
+#include "referee_protocol.h"
+
+#define REFEREE_RX_LEN 128 // 环形缓冲区大小为 REFEREE_RX_LEN * 2，半满时处理一次
+
+typedef struct{
+    RefereeParser_s parser;                 // 流式解码器，解码数据在 parser.data 中
+    Frequency_s rx_freq;                    // 校验通过的帧率
+    bool online;                            // 1秒内收到过有效帧
+    UsartInstance_s *usart_instance;
+    WatchDogInstance_s *watchdog_instance;
+}RefereeInstance_s;
+
+/**
+ * @brief 注册裁判系统实例
+ * @param huart USART句柄
+ * @return RefereeInstance_s* 裁判系统实例指针,失败返回NULL
+ */
+RefereeInstance_s* Referee_Register(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 获取解码数据
+ * @param instance 裁判系统实例指针
+ * @return 解码数据指针，instance 为NULL时返回NULL
+ */
+const RefereeData_s* Referee_Get_Data(const RefereeInstance_s *instance);
+
+#endif //REFEREE_H
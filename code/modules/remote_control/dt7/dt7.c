@@ -0,0 +1,208 @@
+#include "dt7.h"
+#include "memory_management.h"
+#include "plf_log.h"
+#include "main.h"
+#include <string.h>
+
+#define DT7_HALF_RANGE      (DBUS_CH_VALUE_MAX - DBUS_CH_VALUE_OFFSET)
+#define DT7_AXIS(ch)        {(ch), DBUS_CH_VALUE_OFFSET, DT7_HALF_RANGE, 0, false}
+#define DT7_SWITCH(ch)      {(ch), DBUS_CH_VALUE_OFFSET - DT7_HALF_RANGE / 2, DBUS_CH_VALUE_OFFSET + DT7_HALF_RANGE / 2}
+#define DT7_NONE            {-1, 0, 0}
+
+const RcChannelMap_s rc_map_dt7 = {
+    .axis = {
+        [RC_AXIS_RIGHT_X] = DT7_AXIS(0),
+        [RC_AXIS_RIGHT_Y] = DT7_AXIS(1),
+        [RC_AXIS_LEFT_X]  = DT7_AXIS(2),
+        [RC_AXIS_LEFT_Y]  = DT7_AXIS(3),
+        [RC_AXIS_AUX_A]   = DT7_AXIS(4),
+        [RC_AXIS_AUX_B]   = {-1, 0, 0, 0, false},
+    },
+    // 只有左右两个开关：左开关为使能，右开关同时选择底盘和云台模式
+    .sw = {
+        [RC_SWITCH_AUX]     = DT7_NONE,
+        [RC_SWITCH_ENABLE]  = DT7_SWITCH(DT7_RC_CH_SW_LEFT),
+        [RC_SWITCH_CHASSIS] = DT7_SWITCH(DT7_RC_CH_SW_RIGHT),
+        [RC_SWITCH_GIMBAL]  = DT7_SWITCH(DT7_RC_CH_SW_RIGHT),
+        DT7_NONE, DT7_NONE, DT7_NONE, DT7_NONE,
+    },
+};
+
+/**
+ * @brief 按键状态机，每帧调用一次
+ * @param key 按键信息指针
+ * @param pressed 本帧原始按下状态
+ */
+static void Dt7_Key_Update(KeyInfo_s* key, bool pressed){
+    key->LAST_KEY_PRESS = key->KEY_PRESS;
+    key->last_status = key->status;
+    // 原始状态连续 DT7_KEY_DEBOUNCE_CNT 帧与当前状态不同才翻转
+    if (pressed != key->KEY_PRESS){
+        if (++key->debounce_count >= DT7_KEY_DEBOUNCE_CNT){
+            key->KEY_PRESS = pressed;
+            key->debounce_count = 0;
+        }
+    } else {
+        key->debounce_count = 0;
+    }
+
+    if (key->KEY_PRESS){
+        if (!key->LAST_KEY_PRESS){
+            key->count = 0;
+            key->status = PRESS;
+        } else {
+            if (key->count < UINT16_MAX){
+                key->count++;
+            }
+            key->status = (key->count >= DT7_KEY_LONG_PRESS_CNT) ? LONG_DOWN : SHORT_DOWN;
+        }
+    } else {
+        key->status = key->LAST_KEY_PRESS ? RELEASE : UP;
+    }
+}
+
+/**
+ * @brief 更新键鼠数据
+ * @param data DT7数据结构体指针
+ */
+static void Dt7_Km_Update(Dt7Data_s* data){
+    for (uint8_t i = 0; i < KEY_CNT; i++){
+        Dt7_Key_Update(&data->km.keyboard.keys[i], (data->rc.key & (1u << i)) != 0);
+    }
+    data->km.mouse.mouse_x = data->rc.mouse_x;
+    data->km.mouse.mouse_y = data->rc.mouse_y;
+    data->km.mouse.mouse_wheel = data->rc.mouse_z;
+    Dt7_Key_Update(&data->km.mouse.left_button, data->rc.press_l != 0);
+    Dt7_Key_Update(&data->km.mouse.right_button, data->rc.press_r != 0);
+}
+
+/**
+ * @brief 数据复位为中值，离线时调用
+ * @param data DT7数据结构体指针
+ */
+static void Dt7_Data_Reset(Dt7Data_s* data){
+    memset(&data->joy, 0, sizeof(data->joy));
+    memset(&data->km, 0, sizeof(data->km));
+    data->rc.key = 0;
+    data->rc.press_l = 0;
+    data->rc.press_r = 0;
+    data->rc.mouse_x = 0;
+    data->rc.mouse_y = 0;
+    data->rc.mouse_z = 0;
+}
+
+/**
+ * @brief DT7接收回调函数，每个空闲中断处理一帧
+ * @param usart_instance USART实例指针
+ * @param Size 接收数据长度，未使用，以切换缓冲区时 DMA 的实际计数为准
+ */
+static void Dt7_Usart_Callback(UsartInstance_s *usart_instance, uint16_t Size){
+    (void)Size;
+    Dt7Instance_s* instance = usart_instance->parent_ptr;
+    Dt7Data_s* data = &instance->data;
+    uint16_t len = 0;
+    const uint8_t* rx_buf = Usart_RxDMA_Swap_Buffer(usart_instance, &len);
+
+    if (!Dbus_Frame_Parse(&data->rc, rx_buf, len)){
+        data->error_cnt++;
+        return;
+    }
+    instance->last_frame_tick = HAL_GetTick();
+    instance->online = true;
+    data->frame_cnt++;
+    data->rx_freq.cnt_1s++;
+    data->joy.right_x = (int16_t)(data->rc.ch[0] - DBUS_CH_VALUE_OFFSET);
+    data->joy.right_y = (int16_t)(data->rc.ch[1] - DBUS_CH_VALUE_OFFSET);
+    data->joy.left_x = (int16_t)(data->rc.ch[2] - DBUS_CH_VALUE_OFFSET);
+    data->joy.left_y = (int16_t)(data->rc.ch[3] - DBUS_CH_VALUE_OFFSET);
+    data->joy.wheel = (int16_t)(data->rc.ch[4] - DBUS_CH_VALUE_OFFSET);
+    data->sw.left = data->rc.s1;
+    data->sw.right = data->rc.s2;
+    Dt7_Km_Update(data);
+    if (instance->frame_callback != NULL){
+        instance->frame_callback(instance);
+    }
+}
+
+/**
+ * @brief 看门狗回调，更新帧率和在线状态，离线时复位数据
+ * @param watchdog_instance 看门狗实例指针
+ */
+static void Monitor_Dt7(WatchDogInstance_s* watchdog_instance){
+    Dt7Instance_s* instance = (Dt7Instance_s*)watchdog_instance->parent_ptr;
+    instance->data.rx_freq.frequency = instance->data.rx_freq.cnt_1s;
+    instance->data.rx_freq.cnt_1s = 0;
+    if (instance->data.rx_freq.frequency == 0){
+        instance->online = false;
+        Dt7_Data_Reset(&instance->data);
+    }
+}
+
+/**
+ * @brief 判断遥控器数据是否新鲜
+ * @param instance DT7遥控器实例指针
+ * @return true 最近 DT7_OFFLINE_TIMEOUT_MS 内收到过有效帧
+ */
+bool Dt7_Is_Online(const Dt7Instance_s *instance){
+    if (instance == NULL || !instance->online){
+        return false;
+    }
+    // 毫秒计数按无符号数相减，溢出后仍然正确
+    return HAL_GetTick() - instance->last_frame_tick < DT7_OFFLINE_TIMEOUT_MS;
+}
+
+/**
+ * @brief 注册DT7遥控器实例
+ * @param huart UART句柄指针
+ * @return DT7遥控器实例指针，失败返回NULL
+ */
+Dt7Instance_s* Dt7_Register(UART_HandleTypeDef *huart){
+    Dt7Instance_s* dt7_instance = user_malloc(sizeof(Dt7Instance_s));
+    if (dt7_instance == NULL){
+        Log_Error("DT7 dt7_instance Malloc Failed");
+        return NULL;
+    }
+    memset(dt7_instance, 0, sizeof(Dt7Instance_s));
+
+    UsartInitConfig_s usart_config = {0};
+    WatchDogInitConfig_s watch_dog_config = {0};
+    /* 接收缓冲区，DMA 每个缓冲区的传输长度为 rx_len * 2，正常每次空闲中断收到一帧 */
+    uint8_t* rx_first_buff = Memory_Region_Malloc(MEMORY_REGION_RAM_D1, DBUS_FRAME_SIZE * 2);
+    if (rx_first_buff == NULL){
+        Log_Error("DT7 Rx Buffer Malloc Failed");
+        user_free(dt7_instance);
+        return NULL;
+    }
+    uint8_t* rx_second_buff = Memory_Region_Malloc(MEMORY_REGION_RAM_D1, DBUS_FRAME_SIZE * 2);
+    if (rx_second_buff == NULL){
+        Log_Error("DT7 Rx Buffer Malloc Failed");
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_first_buff);
+        user_free(dt7_instance);
+        return NULL;
+    }
+    usart_config.topic_name = "DT7";
+    usart_config.huart_handle = huart;
+    usart_config.mode = DMA_MODE;
+    usart_config.direction = RX_MODE;
+    usart_config.rx_len = DBUS_FRAME_SIZE;
+    usart_config.first_rx_buf = rx_first_buff;
+    usart_config.second_rx_buf = rx_second_buff;
+    usart_config.parent_ptr = dt7_instance;
+    usart_config.usart_module_callback = Dt7_Usart_Callback;
+    dt7_instance->usart_instance = Usart_Register(&usart_config);
+    if (dt7_instance->usart_instance == NULL){
+        Log_Error("DT7 Usart Register Failed");
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_second_buff);
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_first_buff);
+        user_free(dt7_instance);
+        return NULL;
+    }
+    Usart_RxDMA_DoubleBuffer_Init(dt7_instance->usart_instance);
+
+    watch_dog_config.topic_name = "DT7";
+    watch_dog_config.parent_ptr = dt7_instance;
+    watch_dog_config.watchdog_callback = Monitor_Dt7;
+    dt7_instance->watchdog_instance = WatchDog_Register(&watch_dog_config);
+
+    return dt7_instance;
+}
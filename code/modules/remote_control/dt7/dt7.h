@@ -0,0 +1,75 @@
+/**
+ * @file dt7.h
+ * @date 25-12-05
+ * @brief DJI DT7/DR16 遥控器模块，USART DMA 双缓冲接收 + DBUS 解码 + 键鼠状态机
+ * @note 每个空闲中断处理一帧，耗时固定：解析18字节 + 16个按键和2个鼠标键各一次状态更新。
+ *       按键状态需连续 DT7_KEY_DEBOUNCE_CNT 帧一致才生效，按下超过 DT7_KEY_LONG_PRESS_CNT 帧为长按。
+ *       超过 DT7_OFFLINE_TIMEOUT_MS 未收到有效帧视为离线，看门狗每秒更新帧率，离线时数据复位为中值。
+ *       通过 remote_control 注册时，每个有效帧回调 frame_callback，摇杆和开关按 rc_map_dt7 归一化。
+ */
+#ifndef DT7_H
+#define DT7_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "dbus.h"
+#include "bsp_usart.h"
+#include "module_typedef.h"
+#include "watch_dog.h"
+#include "remote_control.h"
+
+#define DT7_KEY_DEBOUNCE_CNT    2       // 按键消抖帧数，约 28ms
+#define DT7_KEY_LONG_PRESS_CNT  36      // 长按判定帧数，约 500ms
+#define DT7_OFFLINE_TIMEOUT_MS  100     // 离线判定时间，单位ms
+#define DT7_RC_CHANNELS         7       // 交给 remote_control 的通道数：ch0~ch4 + 左右开关
+#define DT7_RC_CH_SW_LEFT       5       // 左开关通道，档位按 DBUS_CH_VALUE_MIN / OFFSET / MAX 编码
+#define DT7_RC_CH_SW_RIGHT      6       // 右开关通道
+
+typedef struct{
+    DbusData_s rc;                      // DBUS原始数据
+    Frequency_s rx_freq;                // 有效帧率
+    struct{
+        int16_t right_x;
+        int16_t right_y;
+        int16_t left_x;
+        int16_t left_y;
+        int16_t wheel;
+    }joy;                               // 摇杆和拨轮，已减去中值，-660~660
+    struct{
+        uint8_t left;
+        uint8_t right;
+    }sw;                                // 开关 DBUS_SW_UP / MID / DOWN
+    KeyboardMouseOperation_s km;        // 键鼠数据
+    uint32_t frame_cnt;                 // 有效帧计数
+    uint32_t error_cnt;                 // 错帧计数
+}Dt7Data_s;
+
+typedef struct Dt7Instance_s{
+    Dt7Data_s data;
+    uint32_t last_frame_tick;           // 最近一次有效帧的 HAL_GetTick 毫秒计数
+    bool online;                        // 收到有效帧时置位，看门狗周期内无帧时清除
+    UsartInstance_s *usart_instance;
+    WatchDogInstance_s *watchdog_instance;
+    void (*frame_callback)(struct Dt7Instance_s*);  // 有效帧回调，在接收中断中执行，可为NULL
+    void *parent_ptr;                   // 父模块指针
+}Dt7Instance_s;
+
+/**
+ * @brief DT7 通道映射表
+ */
+extern const RcChannelMap_s rc_map_dt7;
+
+/**
+ * @brief 注册DT7遥控器实例
+ * @param huart UART句柄指针
+ * @return DT7遥控器实例指针，失败返回NULL
+ */
+Dt7Instance_s* Dt7_Register(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 判断遥控器数据是否新鲜
+ * @param instance DT7遥控器实例指针
+ * @return true 最近 DT7_OFFLINE_TIMEOUT_MS 内收到过有效帧
+ */
+bool Dt7_Is_Online(const Dt7Instance_s *instance);
+
+#endif //DT7_H
@@ -1,52 +1,21 @@
+/**
+ * @file rd_at10.h
+ * @brief 云卓 RD-AT10 遥控器通道映射，接收和处理由 remote_control 完成
+ * @note 通道：ch0 右X，ch1 右Y，ch2 左Y，ch3 左X，ch4~ch11 开关 SWA~SWH（SWC、SWG 为三档，其余为两档）
+ */
 #ifndef RD_AT10_H
 #define RD_AT10_H
 #include <stdint.h>
-#include "sbus.h"
-#include "bsp_usart.h"
-#include "module_typedef.h"
-#include "watch_dog.h"
-#include "basic_math.h"
+#include "remote_control.h"
 
 #define RD_REMOTER_DEADLINE 10  //摇杆死区
 #define RD_RC_CH_VALUE_MIN ((uint16_t)0x0132)
 #define RD_RC_CH_VALUE_OFFSET ((uint16_t)0x03E8)
 #define RD_RC_CH_VALUE_MAX ((uint16_t)0x069E)
 
-#define RD_RC_JOY_TO_VAL_COFE 1.0f//0.006377f  //5/784
-#define RD_RC_JOY_TO_PI_COFE  0.0040071f  //PI/784
-
-typedef struct
-{
-    struct
-    {
-        uint8_t a;
-        uint8_t b;
-        uint8_t c;
-        uint8_t d;
-        uint8_t e;
-        uint8_t f;
-        uint8_t g;
-        uint8_t h;
-    } sw;
-    Frequency_s rx_freq;
-    SbusData_s rc;
-    struct
-    {
-        int16_t right_x;
-        int16_t right_y;
-        int16_t left_y;
-        int16_t left_x;
-    } joy;
-} At10Data_s;
-typedef struct{
-    At10Data_s data;
-    UsartInstance_s *usart_instance;
-    WatchDogInstance_s *watchdog_instance;
-}At10Instance_s;
 /**
- * @brief 注册RD-AT10遥控器实例
- * @param huart USART句柄
- * @return At10Instance_s* 遥控器实例指针,失败返回NULL
+ * @brief RD-AT10 通道映射表
  */
-At10Instance_s* At10_Register(UART_HandleTypeDef *huart);
+extern const RcChannelMap_s rc_map_rd_at10;
+
 #endif //RD_AT10_H
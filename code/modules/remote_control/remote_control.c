@@ -0,0 +1,331 @@
+#include "remote_control.h"
+#include "fs_i6x.h"
+#include "rd_at10.h"
+#include "dt7.h"
+#include "sbus.h"
+#include "bsp_dwt.h"
+#include "memory_management.h"
+#include "plf_log.h"
+#include "main.h"
+#include <string.h>
+
+/* 各遥控器的通道映射表和名称 */
+static const RcChannelMap_s* const rc_map_table[RC_TYPE_CNT] = {
+    [RC_TYPE_FS_I6X] = &rc_map_fs_i6x,
+    [RC_TYPE_RD_AT10] = &rc_map_rd_at10,
+    [RC_TYPE_DT7] = &rc_map_dt7,
+};
+static char* const rc_name_table[RC_TYPE_CNT] = {
+    [RC_TYPE_FS_I6X] = "FS-I6X",
+    [RC_TYPE_RD_AT10] = "RD-AT10",
+    [RC_TYPE_DT7] = "DT7",
+};
+
+/**
+ * @brief 限幅到 [-1, 1]
+ * @param x 输入
+ * @return 限幅结果
+ */
+static inline float Rc_Clamp_Unit(float x){
+    if (x > 1.0f){
+        return 1.0f;
+    }
+    if (x < -1.0f){
+        return -1.0f;
+    }
+    return x;
+}
+
+/**
+ * @brief 原始通道值归一化并整形
+ * @param instance 遥控器实例指针
+ * @param axis 轴下标
+ * @param raw 原始通道值
+ * @return 整形后的目标值 -1~1
+ */
+static float Rc_Shape_Axis(const RcInstance_s* instance, uint8_t axis, int16_t raw){
+    const RcAxisMap_s* map = &instance->map->axis[axis];
+    float x = Rc_Clamp_Unit((float)(raw - map->center) / (float)map->half_range);
+    if (map->invert){
+        x = -x;
+    }
+    // 死区外重新缩放，避免出死区时输出跳变
+    const float deadband = instance->deadband[axis];
+    const float mag = (x >= 0.0f) ? x : -x;
+    if (mag <= deadband){
+        return 0.0f;
+    }
+    const float scaled = (mag - deadband) / (1.0f - deadband);
+    x = (x >= 0.0f) ? scaled : -scaled;
+    const float expo = instance->shape[axis].expo;
+    return (1.0f - expo) * x + expo * x * x * x;
+}
+
+/**
+ * @brief 开关通道归一化
+ * @param map 开关映射
+ * @param raw 原始通道值
+ * @return RcSwitch_e
+ */
+static inline uint8_t Rc_Parse_Switch(const RcSwitchMap_s* map, int16_t raw){
+    if (raw < map->low){
+        return RC_SW_UP;
+    }
+    if (raw >= map->high){
+        return RC_SW_DOWN;
+    }
+    return RC_SW_MID;
+}
+
+/**
+ * @brief 输入一帧原始通道，由接收端在接收中断中调用
+ * @param instance 遥控器实例指针
+ * @param ch 原始通道值
+ * @param ch_cnt 通道数量
+ * @param failsafe 接收机是否报告失控保护
+ */
+void Rc_Update(RcInstance_s* instance, const int16_t* ch, uint8_t ch_cnt, bool failsafe){
+    if (instance == NULL || ch == NULL){
+        return;
+    }
+    // DWT 约 9s 溢出一次，先用毫秒计数判断间隔，DWT 只用于计算短间隔
+    const uint32_t now_tick = HAL_GetTick();
+    const uint32_t now = Dwt_Get_Cycle();
+    float dt = (float)Dwt_Cycle_To_Us(now - instance->last_frame_cycle) * 1e-6f;
+    if (instance->cmd.frame_cnt == 0 || dt > RC_MAX_FRAME_DT ||
+        now_tick - instance->last_frame_tick >= (uint32_t)(RC_MAX_FRAME_DT * 1000.0f)){
+        dt = RC_MAX_FRAME_DT;
+    }
+    instance->last_frame_tick = now_tick;
+    instance->last_frame_cycle = now;
+    instance->rx_freq.cnt_1s++;
+
+    RcCommand_s* cmd = &instance->cmd;
+    cmd->failsafe = failsafe;
+    if (failsafe){
+        // 恢复后从零开始按速率限制增长
+        memset(cmd->axis, 0, sizeof(cmd->axis));
+        cmd->frame_cnt++;
+        return;
+    }
+    for (uint8_t i = 0; i < RC_AXIS_CNT; i++){
+        const int8_t src = instance->map->axis[i].src;
+        if (src < 0 || src >= ch_cnt){
+            continue;
+        }
+        const float target = Rc_Shape_Axis(instance, i, ch[src]);
+        const float rate_limit = instance->shape[i].rate_limit;
+        if (rate_limit > 0.0f){
+            const float max_step = rate_limit * dt;
+            const float step = target - cmd->axis[i];
+            if (step > max_step){
+                cmd->axis[i] += max_step;
+            } else if (step < -max_step){
+                cmd->axis[i] -= max_step;
+            } else {
+                cmd->axis[i] = target;
+            }
+        } else {
+            cmd->axis[i] = target;
+        }
+    }
+    for (uint8_t i = 0; i < RC_SW_CNT; i++){
+        const int8_t src = instance->map->sw[i].src;
+        if (src < 0 || src >= ch_cnt){
+            continue;
+        }
+        cmd->sw[i] = Rc_Parse_Switch(&instance->map->sw[i], ch[src]);
+    }
+    cmd->online = true;
+    cmd->frame_cnt++;
+}
+
+/**
+ * @brief 获取遥控指令
+ * @param instance 遥控器实例指针
+ * @return 指令指针；离线或失控保护时返回失控保护指令
+ */
+const RcCommand_s* Rc_Get_Command(const RcInstance_s* instance){
+    if (instance == NULL){
+        return NULL;
+    }
+    // 收到第一帧之前为离线；毫秒计数约 49 天溢出一次，按无符号数相减不受溢出影响
+    if (instance->cmd.frame_cnt == 0 || !instance->cmd.online || instance->cmd.failsafe ||
+        HAL_GetTick() - instance->last_frame_tick >= instance->timeout_ms){
+        return &instance->failsafe_cmd;
+    }
+    return &instance->cmd;
+}
+
+/**
+ * @brief SBUS帧回调函数
+ * @param framer 分帧器指针
+ * @param frame 完整的SBUS帧
+ * @param len 帧长度
+ */
+static void Rc_Sbus_Callback(UsartFramer_s* framer, const uint8_t* frame, uint16_t len){
+    (void)len;
+    RcInstance_s* instance = framer->parent_ptr;
+    SbusData_s* sbus = instance->receiver;
+    if (!Sbus_Frame_Parse(sbus, frame)){
+        return;
+    }
+    Rc_Update(instance, sbus->ch, SBUS_CHANNELS, sbus->failsafe);
+}
+
+/**
+ * @brief DT7有效帧回调，左右开关按通道值编码后与摇杆一起输入
+ * @param dt7 DT7实例指针
+ */
+static void Rc_Dt7_Callback(Dt7Instance_s* dt7){
+    static const int16_t sw_value[4] = {
+        DBUS_CH_VALUE_OFFSET, DBUS_CH_VALUE_MIN, DBUS_CH_VALUE_MAX, DBUS_CH_VALUE_OFFSET
+    };
+    int16_t ch[DT7_RC_CHANNELS];
+    for (uint8_t i = 0; i < DBUS_CHANNELS; i++){
+        ch[i] = dt7->data.rc.ch[i];
+    }
+    ch[DT7_RC_CH_SW_LEFT] = sw_value[dt7->data.rc.s1 & 0x03];
+    ch[DT7_RC_CH_SW_RIGHT] = sw_value[dt7->data.rc.s2 & 0x03];
+    Rc_Update(dt7->parent_ptr, ch, DT7_RC_CHANNELS, false);
+}
+
+/**
+ * @brief 看门狗回调，更新帧率和在线标志
+ * @param watchdog_instance 看门狗实例指针
+ */
+static void Monitor_Rc(WatchDogInstance_s* watchdog_instance){
+    RcInstance_s* instance = watchdog_instance->parent_ptr;
+    instance->rx_freq.frequency = instance->rx_freq.cnt_1s;
+    instance->rx_freq.cnt_1s = 0;
+    // 一个周期内没有帧时清除在线标志，只能由下一帧重新置位
+    if (instance->rx_freq.frequency == 0){
+        instance->cmd.online = false;
+    }
+}
+
+/**
+ * @brief 注册SBUS接收端
+ * @param instance 遥控器实例指针
+ * @param huart UART句柄指针
+ * @return true 成功
+ */
+static bool Rc_Sbus_Register(RcInstance_s* instance, UART_HandleTypeDef* huart){
+    char* name = rc_name_table[instance->type];
+    UsartInitConfig_s usart_config = {0};
+    UsartFramerInitConfig_s framer_config = {0};
+
+    SbusData_s* receiver = user_malloc(sizeof(SbusData_s));
+    if (receiver == NULL){
+        Log_Error("%s receiver Malloc Failed", name);
+        return false;
+    }
+    /* 接收缓冲区，DMA 每个缓冲区的传输长度为 rx_len * 2 */
+    uint8_t* rx_first_buff = Memory_Region_Malloc(MEMORY_REGION_RAM_D1, SBUS_FRAME_SIZE * 2);
+    if (rx_first_buff == NULL){
+        Log_Error("%s Rx Buffer Malloc Failed", name);
+        user_free(receiver);
+        return false;
+    }
+    uint8_t* rx_second_buff = Memory_Region_Malloc(MEMORY_REGION_RAM_D1, SBUS_FRAME_SIZE * 2);
+    if (rx_second_buff == NULL){
+        Log_Error("%s Rx Buffer Malloc Failed", name);
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_first_buff);
+        user_free(receiver);
+        return false;
+    }
+    instance->receiver = receiver;
+    memset(instance->receiver, 0, sizeof(SbusData_s));
+    framer_config.desc = sbus_frame_desc;
+    framer_config.ring_size = SBUS_RING_SIZE;
+    framer_config.frame_callback = Rc_Sbus_Callback;
+    framer_config.parent_ptr = instance;
+    usart_config.framer = Usart_Framer_Create(&framer_config);
+    if (usart_config.framer == NULL){
+        Log_Error("%s Framer Create Failed", name);
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_second_buff);
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_first_buff);
+        user_free(receiver);
+        instance->receiver = NULL;
+        return false;
+    }
+    usart_config.topic_name = name;
+    usart_config.huart_handle = huart;
+    usart_config.mode = DMA_MODE;
+    usart_config.direction = RX_MODE;
+    usart_config.rx_len = SBUS_FRAME_SIZE;
+    usart_config.first_rx_buf = rx_first_buff;
+    usart_config.second_rx_buf = rx_second_buff;
+    usart_config.parent_ptr = instance;
+    instance->usart_instance = Usart_Register(&usart_config);
+    if (instance->usart_instance == NULL){
+        Log_Error("%s Usart Register Failed", name);
+        // 逆序释放，使静态内存池可按后进先出回收
+        Usart_Framer_Destroy(usart_config.framer);
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_second_buff);
+        Memory_Region_Free(MEMORY_REGION_RAM_D1, rx_first_buff);
+        user_free(receiver);
+        instance->receiver = NULL;
+        return false;
+    }
+    Usart_RxDMA_DoubleBuffer_Init(instance->usart_instance);
+    return true;
+}
+
+/**
+ * @brief 注册遥控器实例
+ * @param config 初始化配置
+ * @return 遥控器实例指针，失败返回NULL
+ */
+RcInstance_s* Rc_Register(const RcInitConfig_s* config){
+    if (config == NULL || config->type >= RC_TYPE_CNT){
+        Log_Error("Rc_Register invalid config");
+        return NULL;
+    }
+    RcInstance_s* instance = user_malloc(sizeof(RcInstance_s));
+    if (instance == NULL){
+        Log_Error("%s rc_instance Malloc Failed", rc_name_table[config->type]);
+        return NULL;
+    }
+    memset(instance, 0, sizeof(RcInstance_s));
+    instance->type = config->type;
+    instance->map = rc_map_table[config->type];
+    instance->timeout_ms = (config->timeout_ms != 0) ? config->timeout_ms : RC_OFFLINE_TIMEOUT_MS;
+    for (uint8_t i = 0; i < RC_AXIS_CNT; i++){
+        instance->shape[i] = config->shape[i];
+        // 生效死区取整形参数和遥控器固有死区的较大值
+        const RcAxisMap_s* map = &instance->map->axis[i];
+        const float noise = (map->half_range > 0) ? (float)map->noise_deadband / (float)map->half_range : 0.0f;
+        instance->deadband[i] = (config->shape[i].deadband > noise) ? config->shape[i].deadband : noise;
+        if (instance->deadband[i] >= 1.0f){
+            Log_Error("%s axis %d deadband must be less than 1", rc_name_table[config->type], i);
+            user_free(instance);
+            return NULL;
+        }
+    }
+    memcpy(instance->failsafe_cmd.sw, config->failsafe_sw, sizeof(instance->failsafe_cmd.sw));
+    instance->failsafe_cmd.failsafe = true;
+    instance->failsafe_cmd.online = false;
+
+    if (config->type == RC_TYPE_DT7){
+        Dt7Instance_s* dt7 = Dt7_Register(config->huart);
+        if (dt7 == NULL){
+            user_free(instance);
+            return NULL;
+        }
+        dt7->parent_ptr = instance;
+        dt7->frame_callback = Rc_Dt7_Callback;
+        instance->receiver = dt7;
+        instance->usart_instance = dt7->usart_instance;
+    } else if (!Rc_Sbus_Register(instance, config->huart)){
+        user_free(instance);
+        return NULL;
+    }
+
+    WatchDogInitConfig_s watch_dog_config = {0};
+    watch_dog_config.topic_name = rc_name_table[config->type];
+    watch_dog_config.parent_ptr = instance;
+    watch_dog_config.watchdog_callback = Monitor_Rc;
+    instance->watchdog_instance = WatchDog_Register(&watch_dog_config);
+    return instance;
+}
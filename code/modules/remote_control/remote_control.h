@@ -0,0 +1,171 @@
+/**
+ * @file remote_control.h
+ * @date 25-12-06
+ * @brief 统一遥控器层：各遥控器的通道按映射表归一化为 RcCommand_s，每帧在接收中断中计算一次
+ * @note 处理流程：原始通道 -> 映射(中值、半量程、反向) -> 死区 -> expo 曲线 -> 速率限制；
+ *       开关按阈值归一化为 RC_SW_UP / MID / DOWN。
+ *       接收机报告失控保护或超过 timeout_ms 未收到有效帧时，Rc_Get_Command 返回失控保护指令：
+ *       摇杆归零、开关为配置的安全档位，online 为 false。
+ *       FS-I6X、RD-AT10 使用 SBUS，由本层直接接收；DT7 使用 DBUS，由 dt7 模块接收后回调本层。
+ */
+#ifndef REMOTE_CONTROL_H
+#define REMOTE_CONTROL_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "robot_config.h"
+#include "bsp_usart.h"
+#include "module_typedef.h"
+#include "watch_dog.h"
+
+#define RC_MAX_RAW_CHANNELS     16      // 原始通道最大数量
+#define RC_OFFLINE_TIMEOUT_MS   100     // 默认离线判定时间，单位ms
+#define RC_MAX_FRAME_DT         0.1f    // 速率限制使用的最大帧间隔，单位s，避免离线恢复后一步跳变
+
+/**
+ * @brief 遥控器类型
+ */
+typedef enum{
+    RC_TYPE_FS_I6X = 0,     // 富斯 FS-I6X，SBUS
+    RC_TYPE_RD_AT10,        // 云卓 RD-AT10，SBUS
+    RC_TYPE_DT7,            // 大疆 DT7/DR16，DBUS
+    RC_TYPE_CNT
+}RcType_e;
+
+#if defined(DJI_DT7)
+#define RC_DEFAULT_TYPE RC_TYPE_DT7
+#elif defined(FLY_SKY_I6X)
+#define RC_DEFAULT_TYPE RC_TYPE_FS_I6X
+#elif defined(RD_AT10)
+#define RC_DEFAULT_TYPE RC_TYPE_RD_AT10
+#endif
+
+/**
+ * @brief 归一化摇杆轴
+ */
+typedef enum{
+    RC_AXIS_RIGHT_X = 0,
+    RC_AXIS_RIGHT_Y,
+    RC_AXIS_LEFT_X,
+    RC_AXIS_LEFT_Y,
+    RC_AXIS_AUX_A,          // 旋钮/拨轮
+    RC_AXIS_AUX_B,          // 旋钮
+    RC_AXIS_CNT
+}RcAxis_e;
+
+/**
+ * @brief 归一化开关档位
+ */
+typedef enum{
+    RC_SW_UP = 0,
+    RC_SW_MID = 1,
+    RC_SW_DOWN = 2
+}RcSwitch_e;
+
+/**
+ * @brief 归一化开关下标，各遥控器映射表按该约定放置开关，其余下标为遥控器自有开关
+ */
+typedef enum{
+    RC_SWITCH_AUX = 0,      // 辅助开关
+    RC_SWITCH_ENABLE,       // 使能/模式开关
+    RC_SWITCH_CHASSIS,      // 底盘模式开关
+    RC_SWITCH_GIMBAL,       // 云台模式开关
+}RcSwitchIndex_e;
+
+#define RC_SW_CNT 8             // 归一化开关数量
+
+/**
+ * @brief 摇杆轴映射
+ */
+typedef struct{
+    int8_t src;                 // 原始通道下标，-1 表示该遥控器没有此轴
+    int16_t center;             // 中值
+    int16_t half_range;         // 半量程，原始值 center ± half_range 映射为 ±1
+    int16_t noise_deadband;     // 该遥控器摇杆的固有死区，原始值
+    bool invert;                // 反向
+}RcAxisMap_s;
+
+/**
+ * @brief 开关映射
+ */
+typedef struct{
+    int8_t src;                 // 原始通道下标，-1 表示该遥控器没有此开关
+    int16_t low;                // 低于该值为 RC_SW_UP
+    int16_t high;               // 不低于该值为 RC_SW_DOWN，介于两者之间为 RC_SW_MID（两档开关 low == high）
+}RcSwitchMap_s;
+
+/**
+ * @brief 遥控器通道映射表，每种遥控器一张，定义在各遥控器目录下
+ */
+typedef struct{
+    RcAxisMap_s axis[RC_AXIS_CNT];
+    RcSwitchMap_s sw[RC_SW_CNT];
+}RcChannelMap_s;
+
+/**
+ * @brief 摇杆轴输入整形参数，全为0时不整形
+ */
+typedef struct{
+    float deadband;             // 归一化死区 0~1，与映射表固有死区取较大值，死区外重新缩放到 0~1
+    float expo;                 // expo 系数 0~1，y = (1 - expo) * x + expo * x^3
+    float rate_limit;           // 输出变化速率上限，单位 1/s，0 表示不限制
+}RcShape_s;
+
+/**
+ * @brief 归一化遥控指令
+ */
+typedef struct{
+    float axis[RC_AXIS_CNT];    // 摇杆轴 -1~1
+    uint8_t sw[RC_SW_CNT];      // 开关 RcSwitch_e
+    bool online;                // 数据有效
+    bool failsafe;              // 接收机报告失控保护
+    uint32_t frame_cnt;         // 有效帧计数
+}RcCommand_s;
+
+typedef struct{
+    RcType_e type;
+    const RcChannelMap_s* map;                  // 通道映射表
+    RcShape_s shape[RC_AXIS_CNT];               // 输入整形参数
+    float deadband[RC_AXIS_CNT];                // 生效的归一化死区
+    uint32_t timeout_ms;                        // 离线判定时间
+    uint32_t last_frame_tick;                   // 最近一次帧的 HAL_GetTick 毫秒计数，用于离线判定
+    uint32_t last_frame_cycle;                  // 最近一次帧的DWT周期，只用于速率限制的帧间隔
+    RcCommand_s cmd;                            // 当前指令，接收中断中更新
+    RcCommand_s failsafe_cmd;                   // 失控保护指令
+    Frequency_s rx_freq;                        // 有效帧率
+    void* receiver;                             // 接收端实例（SbusData_s 或 Dt7Instance_s）
+    UsartInstance_s* usart_instance;
+    WatchDogInstance_s* watchdog_instance;
+}RcInstance_s;
+
+typedef struct{
+    RcType_e type;                              // 遥控器类型
+    UART_HandleTypeDef* huart;                  // UART句柄
+    RcShape_s shape[RC_AXIS_CNT];               // 输入整形参数
+    uint8_t failsafe_sw[RC_SW_CNT];             // 失控保护时各开关的档位
+    uint16_t timeout_ms;                        // 离线判定时间，0 使用 RC_OFFLINE_TIMEOUT_MS
+}RcInitConfig_s;
+
+/**
+ * @brief 注册遥控器实例
+ * @param config 初始化配置
+ * @return 遥控器实例指针，失败返回NULL
+ */
+RcInstance_s* Rc_Register(const RcInitConfig_s* config);
+
+/**
+ * @brief 输入一帧原始通道，由接收端在接收中断中调用
+ * @param instance 遥控器实例指针
+ * @param ch 原始通道值
+ * @param ch_cnt 通道数量
+ * @param failsafe 接收机是否报告失控保护
+ */
+void Rc_Update(RcInstance_s* instance, const int16_t* ch, uint8_t ch_cnt, bool failsafe);
+
+/**
+ * @brief 获取遥控指令
+ * @param instance 遥控器实例指针
+ * @return 指令指针；离线或失控保护时返回失控保护指令
+ */
+const RcCommand_s* Rc_Get_Command(const RcInstance_s* instance);
+
+#endif //REMOTE_CONTROL_H
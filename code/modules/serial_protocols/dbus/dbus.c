@@ -1 +1,72 @@
-#include "dbus.h"
\ No newline at end of file
+#include "dbus.h"
+#include <stddef.h>
+
+/**
+ * @brief 读取小端16位数
+ * @param p 地址
+ * @return 16位数
+ */
+static inline uint16_t Dbus_Load16(const uint8_t* p){
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief 检查通道值范围
+ * @param ch 通道值
+ * @return true 在范围内
+ */
+static inline bool Dbus_Channel_Valid(int16_t ch){
+    return ch >= DBUS_CH_VALUE_MIN && ch <= DBUS_CH_VALUE_MAX;
+}
+
+/**
+ * @brief 检查开关值
+ * @param sw 开关值
+ * @return true 为 DBUS_SW_UP / MID / DOWN 之一
+ */
+static inline bool Dbus_Switch_Valid(uint8_t sw){
+    return sw == DBUS_SW_UP || sw == DBUS_SW_MID || sw == DBUS_SW_DOWN;
+}
+
+/**
+ * @brief 解析DBUS数据帧
+ * @param data DBUS数据结构体指针
+ * @param buffer 帧缓冲区指针
+ * @param len 本次空闲中断接收到的长度，不等于 DBUS_FRAME_SIZE 时视为错帧
+ * @return true 解析成功  false 长度、通道范围或开关值错误，data 不被修改
+ * @note DBUS 没有帧头和校验，错位或噪声帧只能靠长度、通道范围和开关取值剔除
+ */
+bool Dbus_Frame_Parse(DbusData_s* data, const uint8_t* buffer, uint16_t len){
+    if (data == NULL || buffer == NULL || len != DBUS_FRAME_SIZE){
+        return false;
+    }
+    int16_t ch[DBUS_CHANNELS];
+    ch[0] = (int16_t)(Dbus_Load16(buffer + 0) & 0x07FF);
+    ch[1] = (int16_t)((Dbus_Load16(buffer + 1) >> 3) & 0x07FF);
+    ch[2] = (int16_t)(((buffer[2] >> 6) | (buffer[3] << 2) | (buffer[4] << 10)) & 0x07FF);
+    ch[3] = (int16_t)((Dbus_Load16(buffer + 4) >> 1) & 0x07FF);
+    ch[4] = (int16_t)(Dbus_Load16(buffer + 16) & 0x07FF);
+    const uint8_t s1 = (uint8_t)((buffer[5] >> 6) & 0x03);
+    const uint8_t s2 = (uint8_t)((buffer[5] >> 4) & 0x03);
+    for (uint8_t i = 0; i < DBUS_CHANNELS; i++){
+        if (!Dbus_Channel_Valid(ch[i])){
+            return false;
+        }
+    }
+    if (!Dbus_Switch_Valid(s1) || !Dbus_Switch_Valid(s2)){
+        return false;
+    }
+
+    for (uint8_t i = 0; i < DBUS_CHANNELS; i++){
+        data->ch[i] = ch[i];
+    }
+    data->s1 = s1;
+    data->s2 = s2;
+    data->mouse_x = (int16_t)Dbus_Load16(buffer + 6);
+    data->mouse_y = (int16_t)Dbus_Load16(buffer + 8);
+    data->mouse_z = (int16_t)Dbus_Load16(buffer + 10);
+    data->press_l = buffer[12];
+    data->press_r = buffer[13];
+    data->key = Dbus_Load16(buffer + 14);
+    return true;
+}
@@ -1,6 +1,65 @@
+/**
+ * @file dbus.h
+ * @date 25-12-05
+ * @brief DJI DT7/DR16 DBUS 解码
+ * @note 100000bps 8E1 反相，每 14ms 一帧 18 字节，无帧头，帧间有空闲间隔，由空闲中断分帧：
+ *       ch0~ch3 各11位（364~1684，中值1024） + s1/s2 各2位 + 鼠标 x/y/z int16 + 左右键各1字节 + 键盘16位 + ch4(拨轮) 11位
+ */
 #ifndef DBUS_H
 #define DBUS_H
 
+#include <stdint.h>
+#include <stdbool.h>
 
+#define DBUS_FRAME_SIZE         18      // DBUS帧长度
+#define DBUS_CH_VALUE_MIN       364     // 通道最小值
+#define DBUS_CH_VALUE_OFFSET    1024    // 通道中值
+#define DBUS_CH_VALUE_MAX       1684    // 通道最大值
+#define DBUS_CHANNELS           5       // 通道数量，ch4 为左上角拨轮
 
-#endif //DBUS_H
\ No newline at end of file
+/* 三位开关值 */
+#define DBUS_SW_UP              1
+#define DBUS_SW_MID             3
+#define DBUS_SW_DOWN            2
+
+/* 键盘位定义，与 Keyboard_s 成员顺序一致 */
+#define DBUS_KEY_W              (1u << 0)
+#define DBUS_KEY_S              (1u << 1)
+#define DBUS_KEY_A              (1u << 2)
+#define DBUS_KEY_D              (1u << 3)
+#define DBUS_KEY_SHIFT          (1u << 4)
+#define DBUS_KEY_CTRL           (1u << 5)
+#define DBUS_KEY_Q              (1u << 6)
+#define DBUS_KEY_E              (1u << 7)
+#define DBUS_KEY_R              (1u << 8)
+#define DBUS_KEY_F              (1u << 9)
+#define DBUS_KEY_G              (1u << 10)
+#define DBUS_KEY_Z              (1u << 11)
+#define DBUS_KEY_X              (1u << 12)
+#define DBUS_KEY_C              (1u << 13)
+#define DBUS_KEY_V              (1u << 14)
+#define DBUS_KEY_B              (1u << 15)
+#define DBUS_KEY_CNT            16
+
+typedef struct{
+    int16_t ch[DBUS_CHANNELS];  // 通道原始值，364~1684
+    uint8_t s1;                 // 左开关 DBUS_SW_UP / MID / DOWN
+    uint8_t s2;                 // 右开关
+    int16_t mouse_x;            // 鼠标X轴速度
+    int16_t mouse_y;            // 鼠标Y轴速度
+    int16_t mouse_z;            // 鼠标滚轮速度
+    uint8_t press_l;            // 鼠标左键
+    uint8_t press_r;            // 鼠标右键
+    uint16_t key;               // 键盘按键位图，DBUS_KEY_*
+} DbusData_s;
+
+/**
+ * @brief 解析DBUS数据帧
+ * @param data DBUS数据结构体指针
+ * @param buffer 帧缓冲区指针
+ * @param len 本次空闲中断接收到的长度，不等于 DBUS_FRAME_SIZE 时视为错帧
+ * @return true 解析成功  false 长度、通道范围或开关值错误，data 不被修改
+ */
+bool Dbus_Frame_Parse(DbusData_s* data, const uint8_t* buffer, uint16_t len);
+
+#endif //DBUS_H
@@ -0,0 +1,169 @@
+#include "referee_protocol.h"
+#include <stddef.h>
+#include <string.h>
+#include "alg_crc.h"
+
+/**
+ * @brief 命令表项
+ */
+typedef struct{
+    uint16_t cmd_id;    // 命令码
+    uint16_t size;      // 结构体大小
+    uint16_t offset;    // 结构体在 RefereeData_s 中的偏移
+    uint32_t flag;      // 对应的 update_flag 位
+} RefereeCmdEntry_s;
+
+/* 命令表，新增命令只需添加结构体和表项 */
+static const RefereeCmdEntry_s referee_cmd_table[] = {
+    {REFEREE_CMD_GAME_STATUS,          sizeof(RefereeGameStatus_s),          offsetof(RefereeData_s, game_status),          REFEREE_UPDATE_GAME_STATUS},
+    {REFEREE_CMD_ROBOT_STATUS,         sizeof(RefereeRobotStatus_s),         offsetof(RefereeData_s, robot_status),         REFEREE_UPDATE_ROBOT_STATUS},
+    {REFEREE_CMD_POWER_HEAT,           sizeof(RefereePowerHeat_s),           offsetof(RefereeData_s, power_heat),           REFEREE_UPDATE_POWER_HEAT},
+    {REFEREE_CMD_HURT,                 sizeof(RefereeHurt_s),                offsetof(RefereeData_s, hurt),                 REFEREE_UPDATE_HURT},
+    {REFEREE_CMD_SHOOT,                sizeof(RefereeShoot_s),               offsetof(RefereeData_s, shoot),                REFEREE_UPDATE_SHOOT},
+    {REFEREE_CMD_PROJECTILE_ALLOWANCE, sizeof(RefereeProjectileAllowance_s), offsetof(RefereeData_s, projectile_allowance), REFEREE_UPDATE_PROJECTILE_ALLOWANCE},
+};
+
+#define REFEREE_CMD_TABLE_SIZE (sizeof(referee_cmd_table) / sizeof(referee_cmd_table[0]))
+
+/**
+ * @brief 丢弃缓存中 start 之前的数据，从下一个 SOF 重新开始
+ * @param parser 解码器指针
+ * @param start 开始查找 SOF 的位置
+ */
+static void Referee_Parser_Resync(RefereeParser_s* parser, uint16_t start){
+    parser->expect_len = 0;
+    const uint8_t* sof = NULL;
+    if (start < parser->frame_len){
+        sof = memchr(parser->frame + start, REFEREE_SOF, parser->frame_len - start);
+    }
+    if (sof == NULL){
+        parser->stat.drop_bytes += parser->frame_len;
+        parser->frame_len = 0;
+        return;
+    }
+    const uint16_t offset = (uint16_t)(sof - parser->frame);
+    parser->stat.drop_bytes += offset;
+    parser->frame_len -= offset;
+    memmove(parser->frame, sof, parser->frame_len);
+}
+
+/**
+ * @brief 按命令表分发校验通过的帧
+ * @param parser 解码器指针
+ */
+static void Referee_Parser_Dispatch(RefereeParser_s* parser){
+    const uint16_t cmd_id = (uint16_t)(parser->frame[REFEREE_HEADER_LEN] | (parser->frame[REFEREE_HEADER_LEN + 1] << 8));
+    const uint16_t data_len = parser->expect_len - REFEREE_HEADER_LEN - REFEREE_CMD_ID_LEN - REFEREE_TAIL_LEN;
+    const uint8_t* data = parser->frame + REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN;
+
+    parser->stat.frame_cnt++;
+    uint8_t i = 0;
+    for (; i < REFEREE_CMD_TABLE_SIZE; i++){
+        if (referee_cmd_table[i].cmd_id == cmd_id){
+            break;
+        }
+    }
+    if (i == REFEREE_CMD_TABLE_SIZE){
+        parser->stat.unknown_cmd++;
+    } else if (data_len < referee_cmd_table[i].size){
+        parser->stat.len_err++;
+    } else {
+        memcpy((uint8_t*)&parser->data + referee_cmd_table[i].offset, data, referee_cmd_table[i].size);
+        parser->data.update_flag |= referee_cmd_table[i].flag;
+    }
+    if (parser->frame_callback != NULL){
+        parser->frame_callback(parser, cmd_id, data, data_len);
+    }
+}
+
+/**
+ * @brief 处理缓存中的数据，直到需要更多输入
+ * @param parser 解码器指针
+ */
+static void Referee_Parser_Process(RefereeParser_s* parser){
+    while (parser->frame_len > 0){
+        if (parser->expect_len == 0){
+            if (parser->frame_len < REFEREE_HEADER_LEN){
+                return;
+            }
+            if (!Crc8_Verify(parser->frame, REFEREE_HEADER_LEN)){
+                parser->stat.crc8_err++;
+                Referee_Parser_Resync(parser, 1);
+                continue;
+            }
+            const uint16_t data_len = (uint16_t)(parser->frame[1] | (parser->frame[2] << 8));
+            if (data_len > REFEREE_DATA_MAX_LEN){
+                parser->stat.len_err++;
+                Referee_Parser_Resync(parser, 1);
+                continue;
+            }
+            parser->expect_len = REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN + data_len + REFEREE_TAIL_LEN;
+        }
+        if (parser->frame_len < parser->expect_len){
+            return;
+        }
+        if (!Crc16_Verify(parser->frame, parser->expect_len)){
+            parser->stat.crc16_err++;
+            Referee_Parser_Resync(parser, 1);
+            continue;
+        }
+        Referee_Parser_Dispatch(parser);
+        // 重新同步后缓存中可能残留下一帧的开头
+        const uint16_t frame_len = parser->expect_len;
+        parser->expect_len = 0;
+        parser->frame_len -= frame_len;
+        if (parser->frame_len > 0){
+            memmove(parser->frame, parser->frame + frame_len, parser->frame_len);
+            Referee_Parser_Resync(parser, 0);
+        }
+    }
+}
+
+/**
+ * @brief 初始化解码器
+ * @param parser 解码器指针
+ * @param frame_callback 帧回调，可为NULL
+ * @param parent_ptr 父模块指针
+ */
+void Referee_Parser_Init(RefereeParser_s* parser, RefereeFrameCallback frame_callback, void* parent_ptr){
+    if (parser == NULL){
+        return;
+    }
+    memset(parser, 0, sizeof(RefereeParser_s));
+    parser->frame_callback = frame_callback;
+    parser->parent_ptr = parent_ptr;
+}
+
+/**
+ * @brief 输入接收到的数据块
+ * @param parser 解码器指针
+ * @param buffer 数据块指针
+ * @param len 数据块长度
+ */
+void Referee_Parser_Feed(RefereeParser_s* parser, const uint8_t* buffer, uint16_t len){
+    if (parser == NULL || buffer == NULL){
+        return;
+    }
+    while (len > 0){
+        if (parser->frame_len == 0){
+            // 等待帧头时直接在输入中查找 SOF，不逐字节拷贝
+            const uint8_t* sof = memchr(buffer, REFEREE_SOF, len);
+            if (sof == NULL){
+                parser->stat.drop_bytes += len;
+                return;
+            }
+            parser->stat.drop_bytes += (uint32_t)(sof - buffer);
+            len -= (uint16_t)(sof - buffer);
+            buffer = sof;
+        }
+        // 只拷贝完成当前阶段(帧头或整帧)所需的字节
+        const uint16_t target = (parser->expect_len == 0) ? REFEREE_HEADER_LEN : parser->expect_len;
+        const uint16_t need = target - parser->frame_len;
+        const uint16_t n = (len < need) ? len : need;
+        memcpy(parser->frame + parser->frame_len, buffer, n);
+        parser->frame_len += n;
+        buffer += n;
+        len -= n;
+        Referee_Parser_Process(parser);
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * @file referee_protocol.h
+ * @date 25-12-03
+ * @brief 裁判系统串口协议流式解码
+ * @note 帧格式：frame_header(5) + cmd_id(2) + data(n) + frame_tail(2)
+ *       frame_header = SOF(0xA5) + data_length(2) + seq(1) + CRC8(1)，frame_tail 为整帧 CRC16，均为小端。
+ *       Referee_Parser_Feed 可以输入任意长度的 DMA 数据块，帧可以跨块；
+ *       帧头 CRC8、长度或整帧 CRC16 校验失败时，从已缓存数据中的下一个 SOF 继续，不回退已输入的数据。
+ *       校验通过的帧按 cmd_id 查表拷贝到 RefereeData_s 中对应的结构体，并置位 update_flag。
+ */
+#ifndef REFEREE_PROTOCOL_H
+#define REFEREE_PROTOCOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define REFEREE_SOF             0xA5    // 帧起始字节
+#define REFEREE_HEADER_LEN      5       // 帧头长度
+#define REFEREE_CMD_ID_LEN      2       // 命令码长度
+#define REFEREE_TAIL_LEN        2       // 帧尾CRC16长度
+#define REFEREE_DATA_MAX_LEN    128     // 数据段最大长度，超过视为错误帧
+#define REFEREE_FRAME_MAX_LEN   (REFEREE_HEADER_LEN + REFEREE_CMD_ID_LEN + REFEREE_DATA_MAX_LEN + REFEREE_TAIL_LEN)
+
+/* 命令码 */
+#define REFEREE_CMD_GAME_STATUS         0x0001  // 比赛状态，1Hz
+#define REFEREE_CMD_ROBOT_STATUS        0x0201  // 机器人性能体系数据，10Hz
+#define REFEREE_CMD_POWER_HEAT          0x0202  // 实时底盘功率和枪口热量，50Hz
+#define REFEREE_CMD_HURT                0x0206  // 伤害状态，伤害发生后发送
+#define REFEREE_CMD_SHOOT               0x0207  // 实时射击信息，射击后发送
+#define REFEREE_CMD_PROJECTILE_ALLOWANCE 0x0208 // 允许发弹量，10Hz
+
+/* update_flag 位定义 */
+#define REFEREE_UPDATE_GAME_STATUS          (1u << 0)
+#define REFEREE_UPDATE_ROBOT_STATUS         (1u << 1)
+#define REFEREE_UPDATE_POWER_HEAT           (1u << 2)
+#define REFEREE_UPDATE_HURT                 (1u << 3)
+#define REFEREE_UPDATE_SHOOT                (1u << 4)
+#define REFEREE_UPDATE_PROJECTILE_ALLOWANCE (1u << 5)
+
+/**
+ * @brief 0x0001 比赛状态
+ */
+typedef struct __attribute__((packed)){
+    uint8_t game_type : 4;          // 比赛类型
+    uint8_t game_progress : 4;      // 当前比赛阶段，4 为比赛中
+    uint16_t stage_remain_time;     // 当前阶段剩余时间，单位s
+    uint64_t sync_timestamp;        // UNIX时间
+} RefereeGameStatus_s;
+
+/**
+ * @brief 0x0201 机器人性能体系数据
+ */
+typedef struct __attribute__((packed)){
+    uint8_t robot_id;                       // 本机器人ID
+    uint8_t robot_level;                    // 机器人等级
+    uint16_t current_hp;                    // 当前血量
+    uint16_t maximum_hp;                    // 血量上限
+    uint16_t shooter_barrel_cooling_value;  // 枪口每秒冷却值
+    uint16_t shooter_barrel_heat_limit;     // 枪口热量上限
+    uint16_t chassis_power_limit;           // 底盘功率上限，单位W
+    uint8_t power_management_gimbal_output : 1;  // 电源管理模块gimbal口输出
+    uint8_t power_management_chassis_output : 1; // 电源管理模块chassis口输出
+    uint8_t power_management_shooter_output : 1; // 电源管理模块shooter口输出
+} RefereeRobotStatus_s;
+
+/**
+ * @brief 0x0202 实时底盘功率和枪口热量
+ */
+typedef struct __attribute__((packed)){
+    uint16_t chassis_voltage;               // 底盘输出电压，单位mV
+    uint16_t chassis_current;               // 底盘输出电流，单位mA
+    float chassis_power;                    // 底盘功率，单位W
+    uint16_t buffer_energy;                 // 缓冲能量，单位J
+    uint16_t shooter_17mm_1_barrel_heat;    // 第1个17mm发射机构枪口热量
+    uint16_t shooter_17mm_2_barrel_heat;    // 第2个17mm发射机构枪口热量
+    uint16_t shooter_42mm_barrel_heat;      // 42mm发射机构枪口热量
+} RefereePowerHeat_s;
+
+/**
+ * @brief 0x0206 伤害状态
+ */
+typedef struct __attribute__((packed)){
+    uint8_t armor_id : 4;               // 受击装甲模块ID
+    uint8_t hp_deduction_reason : 4;    // 血量变化类型
+} RefereeHurt_s;
+
+/**
+ * @brief 0x0207 实时射击信息
+ */
+typedef struct __attribute__((packed)){
+    uint8_t bullet_type;        // 弹丸类型，1 为17mm，2 为42mm
+    uint8_t shooter_number;     // 发射机构ID
+    uint8_t launching_frequency;// 射频，单位Hz
+    float initial_speed;        // 弹丸初速度，单位m/s
+} RefereeShoot_s;
+
+/**
+ * @brief 0x0208 允许发弹量
+ */
+typedef struct __attribute__((packed)){
+    uint16_t projectile_allowance_17mm; // 17mm弹丸允许发弹量
+    uint16_t projectile_allowance_42mm; // 42mm弹丸允许发弹量
+    uint16_t remaining_gold_coin;       // 剩余金币数量
+} RefereeProjectileAllowance_s;
+
+/**
+ * @brief 解码得到的裁判系统数据
+ */
+typedef struct{
+    RefereeGameStatus_s game_status;
+    RefereeRobotStatus_s robot_status;
+    RefereePowerHeat_s power_heat;
+    RefereeHurt_s hurt;
+    RefereeShoot_s shoot;
+    RefereeProjectileAllowance_s projectile_allowance;
+    volatile uint32_t update_flag;  // 收到对应命令后置位，由使用者清除
+} RefereeData_s;
+
+/**
+ * @brief 解码统计
+ */
+typedef struct{
+    uint32_t frame_cnt;     // 校验通过的帧数
+    uint32_t crc8_err;      // 帧头CRC8错误次数
+    uint32_t crc16_err;     // 整帧CRC16错误次数
+    uint32_t len_err;       // 数据长度错误次数（超过最大长度或短于命令结构体）
+    uint32_t unknown_cmd;   // 未在命令表中的帧数
+    uint32_t drop_bytes;    // 重新同步时丢弃的字节数
+} RefereeStat_s;
+
+struct RefereeParser_s;
+
+/**
+ * @brief 帧回调函数类型，每个校验通过的帧都会调用，可用于处理命令表之外的命令(如0x0301)
+ * @param parser 解码器指针
+ * @param cmd_id 命令码
+ * @param data 数据段指针，仅在回调内有效
+ * @param len 数据段长度
+ */
+typedef void (*RefereeFrameCallback)(struct RefereeParser_s* parser, uint16_t cmd_id, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief 流式解码器
+ */
+typedef struct RefereeParser_s{
+    uint8_t frame[REFEREE_FRAME_MAX_LEN];   // 当前帧缓存
+    uint16_t frame_len;                     // 已缓存字节数
+    uint16_t expect_len;                    // 当前帧总长度，0 表示帧头尚未校验
+    RefereeData_s data;                     // 解码数据
+    RefereeStat_s stat;                     // 解码统计
+    RefereeFrameCallback frame_callback;    // 帧回调，可为NULL
+    void* parent_ptr;                       // 父模块指针
+} RefereeParser_s;
+
+/**
+ * @brief 初始化解码器
+ * @param parser 解码器指针
+ * @param frame_callback 帧回调，可为NULL
+ * @param parent_ptr 父模块指针
+ */
+void Referee_Parser_Init(RefereeParser_s* parser, RefereeFrameCallback frame_callback, void* parent_ptr);
+
+/**
+ * @brief 输入接收到的数据块
+ * @param parser 解码器指针
+ * @param buffer 数据块指针
+ * @param len 数据块长度
+ */
+void Referee_Parser_Feed(RefereeParser_s* parser, const uint8_t* buffer, uint16_t len);
+
+#endif //REFEREE_PROTOCOL_H
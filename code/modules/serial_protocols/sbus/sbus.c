@@ -1,48 +1,61 @@
 #include "sbus.h"
 #include <stdbool.h>
 #include <string.h>
+
+/**
+ * @brief 校验SBUS帧尾和标志字节保留位，减少数据中出现 0x0F 时的误同步
+ * @param frame 帧指针
+ * @param len 帧长度
+ * @return true 校验通过
+ */
+static bool Sbus_Frame_Validate(const uint8_t* frame, uint16_t len){
+    return len == SBUS_FRAME_SIZE && frame[SBUS_FRAME_SIZE - 1] == SBUS_FOOTER &&
+           (frame[SBUS_FRAME_SIZE - 2] & SBUS_FLAG_RESERVED) == 0;
+}
+
+const UsartFrameDesc_s sbus_frame_desc = {
+    .type = USART_FRAME_FIXED,
+    .header = {SBUS_HEADER},
+    .header_len = 1,
+    .frame_len = SBUS_FRAME_SIZE,
+    .max_frame_len = SBUS_FRAME_SIZE,
+    .validate = Sbus_Frame_Validate,
+};
+
+/**
+ * @brief 读取小端32位字，允许非对齐地址
+ * @param p 地址
+ * @return 32位字
+ */
+static inline uint32_t Sbus_Load32(const uint8_t* p){
+    uint32_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
 /**
  * @brief 解析SBUS数据帧
  * @param frame SBUS数据结构体指针
- * @param buffer SBUS数据帧缓冲区指针
+ * @param buffer 以帧头开始的完整SBUS帧，长度 SBUS_FRAME_SIZE
+ * @return true 解析成功  false 帧头、帧尾或保留位错误，frame 不被修改
+ * @note 第 i 个通道从第 11*i 位开始，所在字节偏移不超过 20、字节内位移不超过 7，
+ *       因此每个通道只需一次非对齐32位读取加移位和掩码，最后一次读取 buffer[21]~buffer[24]，不越过帧尾
  */
-// ReSharper disable once CppParameterMayBeConstPtrOrRef
-void Sbus_Frame_Parse(SbusData_s* frame, uint8_t* buffer){
-    uint8_t header = 0;
-    uint8_t buffer_temp[SBUS_FRAME_SIZE] = {0};
-    if (buffer[0] != SBUS_HEADER || buffer[24] != SBUS_FOOTER){
-        // frame->state = SBUS_FRAME_ERROR;
-        while (buffer[header] != SBUS_HEADER && buffer[header-1] != SBUS_FRAME_SIZE){
-            header++;
-        }
-    }
-    if (header == 0){
-        memcpy(buffer_temp, buffer, SBUS_FRAME_SIZE);
-    }
-    else{
-        memcpy(&buffer_temp[0], &buffer[header], SBUS_FRAME_SIZE - header);
-        memcpy(&buffer_temp[SBUS_FRAME_SIZE - header], &buffer[0], header);
+bool Sbus_Frame_Parse(SbusData_s* frame, const uint8_t* buffer){
+    if (buffer[0] != SBUS_HEADER || !Sbus_Frame_Validate(buffer, SBUS_FRAME_SIZE)){
+        return false;
     }
-    if (buffer_temp[23] == SBUS_NO_ONLINE){
-        frame->state = SBUS_LOST;
+    const uint8_t* payload = buffer + 1;
+    for (uint32_t i = 0; i < SBUS_CHANNELS; i++){
+        const uint32_t bit = i * 11u;
+        frame->ch[i] = (int16_t)((Sbus_Load32(payload + (bit >> 3)) >> (bit & 7u)) & 0x07FFu);
     }
-    frame->state = SBUS_OK;
-    frame->ch[0]  = (int16_t)(((uint16_t)buffer_temp[1]         | ((uint16_t)buffer_temp[2]  << 8)) & 0x07FF);
-    frame->ch[1]  = (int16_t)((((uint16_t)buffer_temp[2]  >> 3) | ((uint16_t)buffer_temp[3]  << 5)) & 0x07FF);
-    frame->ch[2]  = (int16_t)((((uint16_t)buffer_temp[3]  >> 6) | ((uint16_t)buffer_temp[4]  << 2)  | ((uint16_t)buffer_temp[5] << 10)) & 0x07FF);
-    frame->ch[3]  = (int16_t)((((uint16_t)buffer_temp[5]  >> 1) | ((uint16_t)buffer_temp[6]  << 7)) & 0x07FF);
-    frame->ch[4]  = (int16_t)((((uint16_t)buffer_temp[6]  >> 4) | ((uint16_t)buffer_temp[7]  << 4)) & 0x07FF);
-    frame->ch[5]  = (int16_t)((((uint16_t)buffer_temp[7]  >> 7) | ((uint16_t)buffer_temp[8]  << 1)  | ((uint16_t)buffer_temp[9] << 9)) & 0x07FF);
-    frame->ch[6]  = (int16_t)((((uint16_t)buffer_temp[9]  >> 2) | ((uint16_t)buffer_temp[10] << 6)) & 0x07FF);
-    frame->ch[7]  = (int16_t)((((uint16_t)buffer_temp[10] >> 5) | ((uint16_t)buffer_temp[11] << 3)) & 0x07FF);
-    frame->ch[8]  = (int16_t)(((uint16_t)buffer_temp[12]        | ((uint16_t)buffer_temp[13] << 8)) & 0x07FF);
-    frame->ch[9]  = (int16_t)((((uint16_t)buffer_temp[13] >> 3) | ((uint16_t)buffer_temp[14] << 5)) & 0x07FF);
-    frame->ch[10] = (int16_t)((((uint16_t)buffer_temp[14] >> 6) | ((uint16_t)buffer_temp[15] << 2)  | ((uint16_t)buffer_temp[16] << 10)) & 0x07FF);
-    frame->ch[11] = (int16_t)((((uint16_t)buffer_temp[16] >> 1) | ((uint16_t)buffer_temp[17] << 7)) & 0x07FF);
-    frame->ch[12] = (int16_t)((((uint16_t)buffer_temp[17] >> 4) | ((uint16_t)buffer_temp[18] << 4)) & 0x07FF);
-    frame->ch[13] = (int16_t)((((uint16_t)buffer_temp[18] >> 7) | ((uint16_t)buffer_temp[19] << 1)  | ((uint16_t)buffer_temp[20] << 9)) & 0x07FF);
-    frame->ch[14] = (int16_t)((((uint16_t)buffer_temp[20] >> 2) | ((uint16_t)buffer_temp[21] << 6)) & 0x07FF);
-    frame->ch[15] = (int16_t)((((uint16_t)buffer_temp[21] >> 5) | ((uint16_t)buffer_temp[22] << 3)) & 0x07FF);
-}
-
 
+    const uint8_t flags = buffer[SBUS_FRAME_SIZE - 2];
+    frame->ch17 = (flags & SBUS_FLAG_CH17) ? 1u : 0u;
+    frame->ch18 = (flags & SBUS_FLAG_CH18) ? 1u : 0u;
+    frame->frame_lost = (flags & SBUS_FLAG_FRAME_LOST) != 0;
+    frame->failsafe = (flags & SBUS_FLAG_FAILSAFE) != 0;
+    frame->state = frame->failsafe ? SBUS_LOST : SBUS_OK;
+    return true;
+}
@@ -3,36 +3,56 @@
  * @author Adonis Jin
  * @date 25-10-13
  * @brief sbus解码
+ * @note 帧格式：0x0F + 16个11位通道(22字节，小端位序) + 标志字节 + 0x00
+ *       标志字节 bit0 数字通道17，bit1 数字通道18，bit2 丢帧，bit3 失控保护，bit4~7 恒为0。
+ *       流式重同步由 bsp_usart_framer 按 sbus_frame_desc 完成，校验失败时跳过一个字节继续查找帧头。
  */
 #ifndef SBUS_H
 #define SBUS_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "bsp_usart_framer.h"
 
 #define SBUS_FRAME_SIZE      25      // SBUS帧长度
+#define SBUS_RING_SIZE       64      // 分帧环形缓冲区大小
 #define SBUS_HEADER          0x0F    // 帧头
 #define SBUS_FOOTER          0x00    // 帧尾
 #define SBUS_NO_ONLINE       0x0C    // 无线失联标志
+#define SBUS_FLAG_CH17       0x01    // 数字通道17
+#define SBUS_FLAG_CH18       0x02    // 数字通道18
+#define SBUS_FLAG_FRAME_LOST 0x04    // 接收机丢帧
+#define SBUS_FLAG_FAILSAFE   0x08    // 失控保护，通道值为接收机预设值
+#define SBUS_FLAG_RESERVED   0xF0    // 保留位，必须为0
 #define SBUS_CHANNELS        16      // 通道数量
 #define SBUS_MIN_VALUE       172     // 通道最小值
 #define SBUS_MID_VALUE       992     // 通道中间值
 #define SBUS_MAX_VALUE       1811    // 通道最大值
 
 typedef enum{
-    SBUS_LOST = 0, // 失联
+    SBUS_LOST = 0, // 失联，接收机进入失控保护
     SBUS_OK, // 正常
 } SBUS_Status_e;
 
 typedef struct{
     SBUS_Status_e state;
-    int16_t ch[16];
+    int16_t ch[SBUS_CHANNELS];
+    uint8_t ch17;           // 数字通道17
+    uint8_t ch18;           // 数字通道18
+    bool frame_lost;        // 接收机报告丢帧，通道值为上一帧
+    bool failsafe;          // 接收机进入失控保护
 } SbusData_s;
+/**
+ * @brief SBUS帧描述符，定长25字节，帧头0x0F，校验帧尾0x00
+ */
+extern const UsartFrameDesc_s sbus_frame_desc;
+
 /**
  * @brief 解析SBUS数据帧
  * @param frame SBUS数据结构体指针
- * @param buffer SBUS数据帧缓冲区指针
+ * @param buffer 以帧头开始的完整SBUS帧，长度 SBUS_FRAME_SIZE
+ * @return true 解析成功  false 帧头、帧尾或保留位错误，frame 不被修改
  */
-// ReSharper disable once CppParameterMayBeConstPtrOrRef
-void Sbus_Frame_Parse(SbusData_s* frame, uint8_t* buffer);
+bool Sbus_Frame_Parse(SbusData_s* frame, const uint8_t* buffer);
 
 #endif //SBUS_H
@@ -40,6 +40,7 @@ typedef struct
     KeyStatus_e last_status;    //!< Previous key status
     bool LAST_KEY_PRESS;        //!< Previous key press state
     bool KEY_PRESS;             //!< Current key press state
+    uint8_t debounce_count;     //!< Frames the raw state has differed from KEY_PRESS
 } KeyInfo_s;
 
 /**
@@ -58,31 +59,44 @@ typedef struct
     KeyInfo_s right_button;     //!< Right mouse button information
 } Mouse_s;
 
+/**
+ * @brief Keyboard key index enumeration
+ * @author Adonis Jin
+ * @date 2025/08/08
+ * @version 1.0.0
+ * @note Index into Keyboard_s::keys, same order as the DBUS key bitmap (bit i is key i)
+ */
+typedef enum
+{
+    KEY_W = 0,          //!< W key
+    KEY_S,              //!< S key
+    KEY_A,              //!< A key
+    KEY_D,              //!< D key
+    KEY_SHIFT,          //!< SHIFT key
+    KEY_CTRL,           //!< CTRL key
+    KEY_Q,              //!< Q key
+    KEY_E,              //!< E key
+    KEY_R,              //!< R key
+    KEY_F,              //!< F key
+    KEY_G,              //!< G key
+    KEY_Z,              //!< Z key
+    KEY_X,              //!< X key
+    KEY_C,              //!< C key
+    KEY_V,              //!< V key
+    KEY_B,              //!< B key
+    KEY_CNT             //!< Number of keys
+} KeyIndex_e;
+
 /**
  * @brief Keyboard data structure
  * @author Adonis Jin
  * @date 2025/08/08
  * @version 1.0.0
- * @note Contains information for all supported keyboard keys
+ * @note Contains information for all supported keyboard keys, indexed by KeyIndex_e
  */
 typedef struct
 {
-    KeyInfo_s W;        //!< W key information
-    KeyInfo_s S;        //!< S key information
-    KeyInfo_s A;        //!< A key information
-    KeyInfo_s D;        //!< D key information
-    KeyInfo_s SHIFT;    //!< SHIFT key information
-    KeyInfo_s CTRL;     //!< CTRL key information
-    KeyInfo_s Q;        //!< Q key information
-    KeyInfo_s E;        //!< E key information
-    KeyInfo_s R;        //!< R key information
-    KeyInfo_s F;        //!< F key information
-    KeyInfo_s G;        //!< G key information
-    KeyInfo_s Z;        //!< Z key information
-    KeyInfo_s X;        //!< X key information
-    KeyInfo_s C;        //!< C key information
-    KeyInfo_s V;        //!< V key information
-    KeyInfo_s B;        //!< B key information
+    KeyInfo_s keys[KEY_CNT];    //!< Key information, e.g. keys[KEY_W]
 } Keyboard_s;
 
 /**
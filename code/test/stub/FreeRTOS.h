@@ -0,0 +1,13 @@
+/**
+ * @file FreeRTOS.h
+ * @brief 主机测试用的 FreeRTOS 替身，堆接口映射到 C 库
+ */
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdlib.h>
+
+#define pvPortMalloc malloc
+#define vPortFree free
+
+#endif // FREERTOS_H
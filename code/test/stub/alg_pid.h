@@ -0,0 +1,19 @@
+/**
+ * @file alg_pid.h
+ * @brief 主机测试用的 PID 替身，只提供 alg_chassis_calc 用到的类型和接口，函数由测试程序定义
+ */
+#ifndef ALG_PID_H
+#define ALG_PID_H
+
+typedef struct {
+    float kp;
+} PidInitConfig_s;
+
+typedef struct {
+    float output;
+} PidInstance_s;
+
+PidInstance_s* Pid_Register(PidInitConfig_s* config);
+float Pid_Calculate(PidInstance_s* pid, float measure, float target);
+
+#endif // ALG_PID_H
@@ -0,0 +1,8 @@
+/**
+ * @file bsp_can.h
+ * @brief 主机测试用的 CAN 替身，被测模块不直接使用 CAN 接口
+ */
+#ifndef BSP_CAN_H
+#define BSP_CAN_H
+
+#endif // BSP_CAN_H
@@ -0,0 +1,29 @@
+/**
+ * @file dev_motor_dji.h
+ * @brief 主机测试用的 DJI 电机替身，只提供 alg_chassis_calc 用到的类型和接口，函数由测试程序定义
+ */
+#ifndef DEV_MOTOR_DJI_H
+#define DEV_MOTOR_DJI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t rx_id;
+    uint8_t can_number;
+} DjiMotorCanConfig_s;
+
+typedef struct {
+    uint32_t id;
+    DjiMotorCanConfig_s can_config;
+} DjiMotorInitConfig_s;
+
+typedef struct {
+    float out;
+} DjiMotorInstance_s;
+
+DjiMotorInstance_s* Motor_Dji_Register(DjiMotorInitConfig_s* config);
+void Motor_Dji_Control(DjiMotorInstance_s* motor, float target);
+void Motor_Dji_Transmit(DjiMotorInstance_s* motor);
+
+#endif // DEV_MOTOR_DJI_H
@@ -0,0 +1,12 @@
+/**
+ * @file gpio.h
+ * @brief 主机测试用的 HAL GPIO 替身，只提供外设头文件中用到的类型
+ */
+#ifndef GPIO_H
+#define GPIO_H
+
+#include "main.h"
+
+typedef struct GPIO_TypeDef GPIO_TypeDef;
+
+#endif // GPIO_H
@@ -0,0 +1,19 @@
+/**
+ * @file main.h
+ * @brief 主机测试用的 HAL 替身，只提供被测模块用到的临界区和时基接口
+ */
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <stdint.h>
+
+static inline uint32_t __get_PRIMASK(void){ return 0u; }
+static inline void __set_PRIMASK(uint32_t primask){ (void)primask; }
+static inline void __disable_irq(void){}
+
+/**
+ * @brief 毫秒时基，由测试程序定义
+ */
+uint32_t HAL_GetTick(void);
+
+#endif // MAIN_H
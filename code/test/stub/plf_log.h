@@ -0,0 +1,18 @@
+/**
+ * @file plf_log.h
+ * @brief 主机测试用的日志替身，输出到标准输出
+ */
+#ifndef PLF_LOG_H
+#define PLF_LOG_H
+
+#include <stdio.h>
+
+#define Log_Init()                  ((void)0)
+#define Log(fmt, ...)               printf(fmt "\n", ##__VA_ARGS__)
+#define Log_Information(fmt, ...)   printf(fmt "\n", ##__VA_ARGS__)
+#define Log_Passing(fmt, ...)       printf(fmt "\n", ##__VA_ARGS__)
+#define Log_Debug(fmt, ...)         printf(fmt "\n", ##__VA_ARGS__)
+#define Log_Warning(fmt, ...)       printf(fmt "\n", ##__VA_ARGS__)
+#define Log_Error(fmt, ...)         printf(fmt "\n", ##__VA_ARGS__)
+
+#endif // PLF_LOG_H
@@ -0,0 +1,13 @@
+/**
+ * @file spi.h
+ * @brief 主机测试用的 HAL SPI 替身，只提供外设头文件中用到的类型
+ */
+#ifndef SPI_H
+#define SPI_H
+
+#include "main.h"
+#include "gpio.h"
+
+typedef struct SPI_HandleTypeDef SPI_HandleTypeDef;
+
+#endif // SPI_H
@@ -0,0 +1,237 @@
+/**
+ * @file test_ahrs.c
+ * @brief 姿态解算主机测试：合成 120 s、1 kHz 的转动数据（陀螺仪零偏、噪声、周期性冲击），
+ *        检查 Mahony/Madgwick 6 轴和 9 轴的姿态误差、加速度门控效果、批量接口与单个接口一致，并输出单次更新耗时
+ */
+#include "MahonyAHRS.h"
+#include "test_common.h"
+#include <math.h>
+#include <string.h>
+
+#define SAMPLE_FREQ 1000.0
+#define SAMPLE_CNT 120000
+#define WARMUP_CNT 10000        // 前 10 s 收敛，不计入误差
+#define GRAVITY 9.80665
+#define BENCH_REPEAT 7
+
+typedef struct {
+    double rms;                 // 误差均方根 deg
+    double max;                 // 最大误差 deg
+    uint32_t gated;             // 门控跳过次数
+} AhrsError_s;
+
+static float gyro_data[SAMPLE_CNT][3];
+static float accel_data[SAMPLE_CNT][3];
+static float mag_data[SAMPLE_CNT][3];
+static double truth[SAMPLE_CNT][4];
+
+static const double gravity_nav[3] = {0.0, 0.0, GRAVITY};
+static const double mag_nav[3] = {0.4, 0.0, -0.3};
+
+/**
+ * @brief 完整姿态误差 deg
+ */
+static double Attitude_Error(const double q_true[4], const float q[4]){
+    const double d = fabs(q_true[0] * q[0] + q_true[1] * q[1] + q_true[2] * q[2] + q_true[3] * q[3]);
+    return 2.0 * acos(fmin(d, 1.0)) * 180.0 / M_PI;
+}
+
+/**
+ * @brief 倾角误差 deg，6 轴解算航向不可观
+ */
+static double Tilt_Error(const double q_true[4], const float q[4]){
+    const double up[3] = {0.0, 0.0, 1.0};
+    double up_true[3];
+    Test_Nav_To_Body(q_true, up, up_true);
+    const double up_est[3] = {2.0 * (q[1] * q[3] - q[0] * q[2]),
+                              2.0 * (q[0] * q[1] + q[2] * q[3]),
+                              q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]};
+    const double d = up_true[0] * up_est[0] + up_true[1] * up_est[1] + up_true[2] * up_est[2];
+    return acos(fmin(d, 1.0)) * 180.0 / M_PI;
+}
+
+/**
+ * @brief 生成数据：三轴正弦角速度，真值 10 倍细分积分；shocks 为真时每 5 s 有 0.4 s 的 12 m/s^2 线加速度
+ */
+static void Generate(bool shocks){
+    srand(1);
+    double q[4] = {1.0, 0.0, 0.0, 0.0};
+    const double bias[3] = {0.01, -0.008, 0.005};
+    for (int k = 0; k < SAMPLE_CNT; k++){
+        const double t = k / SAMPLE_FREQ;
+        const double w[3] = {1.5 * sin(0.7 * t), 1.2 * sin(0.5 * t + 1.0), 2.0 * sin(0.3 * t + 2.0)};
+        const double w_norm = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+        for (int s = 0; s < 10; s++){
+            double dq[4] = {1.0, 0.0, 0.0, 0.0};
+            if (w_norm > 0.0){
+                const double half = w_norm / SAMPLE_FREQ / 10.0 / 2.0;
+                dq[0] = cos(half);
+                for (int i = 0; i < 3; i++){
+                    dq[i + 1] = sin(half) * w[i] / w_norm;
+                }
+            }
+            double next[4];
+            Test_Quat_Mul(q, dq, next);
+            memcpy(q, next, sizeof(q));
+        }
+        memcpy(truth[k], q, sizeof(q));
+
+        double force[3] = {gravity_nav[0], gravity_nav[1], gravity_nav[2]};
+        if (shocks && fmod(t, 5.0) < 0.4){
+            force[0] += 12.0 * sin(40.0 * t);
+            force[1] += 8.0 * cos(33.0 * t);
+            force[2] += 6.0 * sin(27.0 * t);
+        }
+        double force_body[3], mag_body[3];
+        Test_Nav_To_Body(q, force, force_body);
+        Test_Nav_To_Body(q, mag_nav, mag_body);
+        for (int i = 0; i < 3; i++){
+            gyro_data[k][i] = (float)(w[i] + bias[i] + 0.003 * Test_Gauss());
+            accel_data[k][i] = (float)(force_body[i] + 0.05 * Test_Gauss());
+            mag_data[k][i] = (float)(mag_body[i] + 0.005 * Test_Gauss());
+        }
+    }
+}
+
+/**
+ * @brief 从真值初始姿态开始运行一次滤波，统计收敛后的误差
+ */
+static AhrsError_s Run(const AhrsInitConfig_s* config, bool use_mag){
+    AhrsInstance_s ahrs;
+    Ahrs_Init(&ahrs, config);
+    double accel0[3], mag0[3];
+    Test_Nav_To_Body(truth[0], gravity_nav, accel0);
+    Test_Nav_To_Body(truth[0], mag_nav, mag0);
+    const float accel0_f[3] = {(float)accel0[0], (float)accel0[1], (float)accel0[2]};
+    const float mag0_f[3] = {(float)mag0[0], (float)mag0[1], (float)mag0[2]};
+    Ahrs_Reset(&ahrs, accel0_f, use_mag ? mag0_f : NULL);
+
+    AhrsError_s result = {0};
+    double sum2 = 0.0;
+    for (int k = 0; k < SAMPLE_CNT; k++){
+        Ahrs_Update(&ahrs, gyro_data[k], accel_data[k], use_mag ? mag_data[k] : NULL);
+        const double err = use_mag ? Attitude_Error(truth[k], ahrs.q) : Tilt_Error(truth[k], ahrs.q);
+        if (k > WARMUP_CNT){
+            sum2 += err * err;
+            result.max = fmax(result.max, err);
+        }
+    }
+    result.rms = sqrt(sum2 / (SAMPLE_CNT - WARMUP_CNT - 1));
+    result.gated = ahrs.gated;
+    return result;
+}
+
+static AhrsError_s Run_Case(const char* name, AhrsType_e type, float acc_gate, bool use_mag){
+    const AhrsInitConfig_s config = {
+        .type = type,
+        .kp = 0.5f,
+        .ki = 0.02f,
+        .beta = 0.03f,
+        .sample_freq = (float)SAMPLE_FREQ,
+        .gravity = (float)GRAVITY,
+        .acc_gate = acc_gate,
+    };
+    const AhrsError_s result = Run(&config, use_mag);
+    printf("  %-32s rms %.3f deg, max %.3f deg, gated %u\n", name, result.rms, result.max, (unsigned)result.gated);
+    return result;
+}
+
+/**
+ * @brief 无冲击时的精度：6 轴为倾角误差，9 轴为完整姿态误差
+ * @note Madgwick 不估计零偏，9 轴时航向受陀螺仪零偏影响较大
+ */
+static void Test_Accuracy(void){
+    Generate(false);
+    printf("accuracy, no shocks:\n");
+    const AhrsError_s mahony6 = Run_Case("mahony 6 axis", AHRS_MAHONY, 0.0f, false);
+    const AhrsError_s madgwick6 = Run_Case("madgwick 6 axis", AHRS_MADGWICK, 0.0f, false);
+    const AhrsError_s mahony9 = Run_Case("mahony 9 axis", AHRS_MAHONY, 0.0f, true);
+    const AhrsError_s madgwick9 = Run_Case("madgwick 9 axis", AHRS_MADGWICK, 0.0f, true);
+    TEST_CHECK_MSG(mahony6.rms < 1.0, "rms=%.3f", mahony6.rms);
+    TEST_CHECK_MSG(madgwick6.rms < 0.3, "rms=%.3f", madgwick6.rms);
+    TEST_CHECK_MSG(mahony9.rms < 1.0, "rms=%.3f", mahony9.rms);
+    TEST_CHECK_MSG(madgwick9.rms < 1.5, "rms=%.3f", madgwick9.rms);
+}
+
+/**
+ * @brief 周期性冲击下，门控后误差不大于不门控，且确实跳过了冲击样本
+ */
+static void Test_Gate(void){
+    Generate(true);
+    printf("accuracy, shocks:\n");
+    const AhrsError_s mahony = Run_Case("mahony 6 axis no gate", AHRS_MAHONY, 0.0f, false);
+    const AhrsError_s mahony_gate = Run_Case("mahony 6 axis gate 0.1", AHRS_MAHONY, 0.1f, false);
+    const AhrsError_s madgwick = Run_Case("madgwick 6 axis no gate", AHRS_MADGWICK, 0.0f, false);
+    const AhrsError_s madgwick_gate = Run_Case("madgwick 6 axis gate 0.1", AHRS_MADGWICK, 0.1f, false);
+    TEST_CHECK(mahony.gated == 0u && madgwick.gated == 0u);
+    TEST_CHECK(mahony_gate.gated > 0u && madgwick_gate.gated > 0u);
+    TEST_CHECK_MSG(mahony_gate.rms < mahony.rms, "gate %.3f, no gate %.3f", mahony_gate.rms, mahony.rms);
+    TEST_CHECK_MSG(madgwick_gate.rms < madgwick.rms, "gate %.3f, no gate %.3f", madgwick_gate.rms, madgwick.rms);
+}
+
+/**
+ * @brief 批量接口与逐个调用 Ahrs_Update_Imu 的结果完全相同
+ */
+static void Test_Batch(void){
+    const AhrsInitConfig_s config = {.type = AHRS_MAHONY, .kp = 0.5f, .ki = 0.02f, .sample_freq = (float)SAMPLE_FREQ,
+                                     .gravity = (float)GRAVITY, .acc_gate = 0.1f};
+    AhrsInstance_s batch[4], single[4];
+    for (int i = 0; i < 4; i++){
+        Ahrs_Init(&batch[i], &config);
+        Ahrs_Init(&single[i], &config);
+    }
+    for (int k = 0; k + 4 <= SAMPLE_CNT; k += 4){
+        Ahrs_Update_Imu_Batch(batch, (const float (*)[3])gyro_data[k], (const float (*)[3])accel_data[k], 4);
+        for (int i = 0; i < 4; i++){
+            Ahrs_Update_Imu(&single[i], gyro_data[k + i], accel_data[k + i]);
+        }
+    }
+    TEST_CHECK(memcmp(batch, single, sizeof(batch)) == 0);
+}
+
+/**
+ * @brief 输出单次更新耗时（7 次取最小），只作参考，不判定结果
+ */
+static void Bench_Update(void){
+    AhrsInitConfig_s config = {.type = AHRS_MAHONY, .kp = 0.5f, .beta = 0.03f, .sample_freq = (float)SAMPLE_FREQ,
+                               .gravity = (float)GRAVITY};
+    AhrsInstance_s ahrs[4];
+    double best[3] = {1e9, 1e9, 1e9};
+    for (int rep = 0; rep < BENCH_REPEAT; rep++){
+        config.type = AHRS_MAHONY;
+        Ahrs_Init(&ahrs[0], &config);
+        uint64_t start = Test_Now_Ns();
+        for (int k = 0; k < SAMPLE_CNT; k++){
+            Ahrs_Update_Imu(&ahrs[0], gyro_data[k], accel_data[k]);
+        }
+        best[0] = fmin(best[0], (double)(Test_Now_Ns() - start) / SAMPLE_CNT);
+
+        config.type = AHRS_MADGWICK;
+        Ahrs_Init(&ahrs[1], &config);
+        start = Test_Now_Ns();
+        for (int k = 0; k < SAMPLE_CNT; k++){
+            Ahrs_Update_Imu(&ahrs[1], gyro_data[k], accel_data[k]);
+        }
+        best[1] = fmin(best[1], (double)(Test_Now_Ns() - start) / SAMPLE_CNT);
+
+        config.type = AHRS_MAHONY;
+        for (int i = 0; i < 4; i++){
+            Ahrs_Init(&ahrs[i], &config);
+        }
+        start = Test_Now_Ns();
+        for (int k = 0; k + 4 <= SAMPLE_CNT; k += 4){
+            Ahrs_Update_Imu_Batch(ahrs, (const float (*)[3])gyro_data[k], (const float (*)[3])accel_data[k], 4);
+        }
+        best[2] = fmin(best[2], (double)(Test_Now_Ns() - start) / SAMPLE_CNT);
+    }
+    printf("update: mahony %.1f ns, madgwick %.1f ns, batch of 4 mahony %.1f ns per sample (q0 %f)\n",
+           best[0], best[1], best[2], (double)ahrs[0].q[0]);
+}
+
+int main(void){
+    Test_Accuracy();
+    Test_Gate();
+    Test_Batch();
+    Bench_Update();
+    return Test_Report("ahrs");
+}
@@ -0,0 +1,240 @@
+/**
+ * @file test_attitude_ekf.c
+ * @brief 姿态 EKF 主机测试：合成陀螺（20 rad/s 自转、1.2 rad/s 进动、章动）数据，带时变零偏、噪声和周期性大加速度，
+ *        与 Mahony 对比倾角误差，检查零偏估计和卡方门控，并输出预测/更新耗时
+ */
+#include "attitude_ekf.h"
+#include "MahonyAHRS.h"
+#include "test_common.h"
+#include <math.h>
+#include <string.h>
+
+#define SAMPLE_FREQ 1000.0
+#define SAMPLE_CNT 120000
+#define WARMUP_CNT 10000        // 前 10 s 收敛，不计入误差
+#define GRAVITY 9.80665
+#define CHI2_GATE 11.34f        // 3 自由度 99%
+#define BENCH_REPEAT 5
+
+typedef struct {
+    double rms;                 // 倾角误差均方根 deg
+    double max;                 // 最大倾角误差 deg
+    double rms_shock;           // 冲击期间的倾角误差均方根 deg
+    float bias[3];              // 结束时的零偏估计 rad/s，只有 EKF 使用
+    uint32_t rejected;          // 门控跳过/拒绝次数
+} TiltError_s;
+
+static float gyro_data[SAMPLE_CNT][3];
+static float accel_data[SAMPLE_CNT][3];
+static double truth[SAMPLE_CNT][4];
+static double bias_end[3];
+
+static void Axis_Quat(int axis, double angle, double out[4]){
+    out[0] = cos(angle / 2.0);
+    out[1] = out[2] = out[3] = 0.0;
+    out[axis + 1] = sin(angle / 2.0);
+}
+
+/**
+ * @brief 陀螺真值，ZXZ 欧拉角：绕导航系 z 进动，倾角带章动，绕机体 z 自转
+ */
+static void Spin_Top(double t, double q[4]){
+    double precession[4], nutation[4], spin[4], tmp[4];
+    Axis_Quat(2, 1.2 * t, precession);
+    Axis_Quat(0, 0.35 + 0.08 * sin(6.0 * t), nutation);
+    Axis_Quat(2, 20.0 * t + 0.5 * sin(0.2 * t), spin);
+    Test_Quat_Mul(precession, nutation, tmp);
+    Test_Quat_Mul(tmp, spin, q);
+}
+
+static bool In_Shock(double t){
+    return fmod(t, 2.0) > 1.8;
+}
+
+/**
+ * @brief 生成数据：陀螺仪输出上一周期的平均角速度；shocks 为真时每 2 s 有 200 ms 的约 3.5 g 冲击
+ */
+static void Generate(bool shocks){
+    srand(2);
+    const double gravity_nav[3] = {0.0, 0.0, GRAVITY};
+    for (int k = 0; k < SAMPLE_CNT; k++){
+        const double t = k / SAMPLE_FREQ;
+        double q[4], q_last[4], delta[4];
+        Spin_Top(t, q);
+        Spin_Top(t - 1.0 / SAMPLE_FREQ, q_last);
+        const double conj[4] = {q_last[0], -q_last[1], -q_last[2], -q_last[3]};
+        Test_Quat_Mul(conj, q, delta);
+        const double sin_half = sqrt(delta[1] * delta[1] + delta[2] * delta[2] + delta[3] * delta[3]);
+        const double rate_scale = sin_half > 0.0 ? 2.0 * atan2(sin_half, delta[0]) / sin_half * SAMPLE_FREQ : 2.0 * SAMPLE_FREQ;
+        memcpy(truth[k], q, sizeof(q));
+
+        const double bias[3] = {0.02 + 0.005 * sin(0.05 * t), -0.015, 0.01};
+        memcpy(bias_end, bias, sizeof(bias));
+        double force[3] = {gravity_nav[0], gravity_nav[1], gravity_nav[2]};
+        if (shocks && In_Shock(t)){
+            force[0] += 25.0 * sin(45.0 * t);
+            force[1] += 18.0 * cos(38.0 * t);
+            force[2] += 15.0 * sin(29.0 * t);
+        }
+        double force_body[3];
+        Test_Nav_To_Body(q, force, force_body);
+        for (int i = 0; i < 3; i++){
+            gyro_data[k][i] = (float)(rate_scale * delta[i + 1] + bias[i] + 0.003 * Test_Gauss());
+            accel_data[k][i] = (float)(force_body[i] + 0.05 * Test_Gauss());
+        }
+    }
+}
+
+static double Tilt_Error(const double q_true[4], const float q[4]){
+    const double up[3] = {0.0, 0.0, 1.0};
+    double up_true[3];
+    Test_Nav_To_Body(q_true, up, up_true);
+    const double up_est[3] = {2.0 * (q[1] * q[3] - q[0] * q[2]),
+                              2.0 * (q[0] * q[1] + q[2] * q[3]),
+                              q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]};
+    const double d = up_true[0] * up_est[0] + up_true[1] * up_est[1] + up_true[2] * up_est[2];
+    return acos(fmin(d, 1.0)) * 180.0 / M_PI;
+}
+
+typedef struct {
+    double sum2;
+    double sum2_shock;
+    int cnt;
+    int cnt_shock;
+} ErrorAcc_s;
+
+static void Error_Add(ErrorAcc_s* acc, TiltError_s* result, int k, double err){
+    if (k <= WARMUP_CNT){
+        return;
+    }
+    acc->sum2 += err * err;
+    acc->cnt++;
+    result->max = fmax(result->max, err);
+    if (In_Shock(k / SAMPLE_FREQ)){
+        acc->sum2_shock += err * err;
+        acc->cnt_shock++;
+    }
+}
+
+static void Error_Finish(const ErrorAcc_s* acc, TiltError_s* result, const char* name){
+    result->rms = sqrt(acc->sum2 / acc->cnt);
+    result->rms_shock = acc->cnt_shock > 0 ? sqrt(acc->sum2_shock / acc->cnt_shock) : 0.0;
+    printf("  %-24s tilt rms %.3f deg, max %.3f deg, rms in shocks %.3f deg, rejected %u\n",
+           name, result->rms, result->max, result->rms_shock, (unsigned)result->rejected);
+}
+
+static AttitudeEkfInitConfig_s Ekf_Config(float chi2_gate){
+    const AttitudeEkfInitConfig_s config = {
+        .gyro_noise = 0.003f,
+        .bias_walk = 1e-4f,
+        .accel_noise = 0.3f,
+        .gravity = (float)GRAVITY,
+        .chi2_gate = chi2_gate,
+        .reject_limit = 200,
+        .init_angle_std = 0.1f,
+        .init_bias_std = 0.05f,
+    };
+    return config;
+}
+
+static TiltError_s Run_Ekf(const char* name, float chi2_gate){
+    const AttitudeEkfInitConfig_s config = Ekf_Config(chi2_gate);
+    AttitudeEkfInstance_s ekf;
+    Attitude_Ekf_Init(&ekf, &config);
+    Attitude_Ekf_Reset(&ekf, accel_data[0]);
+    TiltError_s result = {0};
+    ErrorAcc_s acc = {0};
+    for (int k = 1; k < SAMPLE_CNT; k++){
+        Attitude_Ekf_Predict(&ekf, gyro_data[k], (float)(1.0 / SAMPLE_FREQ));
+        Attitude_Ekf_Update_Accel(&ekf, accel_data[k]);
+        Error_Add(&acc, &result, k, Tilt_Error(truth[k], ekf.q));
+    }
+    memcpy(result.bias, ekf.bias, sizeof(result.bias));
+    result.rejected = ekf.reject_cnt;
+    Error_Finish(&acc, &result, name);
+    return result;
+}
+
+static TiltError_s Run_Mahony(const char* name, float acc_gate){
+    const AhrsInitConfig_s config = {.type = AHRS_MAHONY, .kp = 0.5f, .ki = 0.02f, .sample_freq = (float)SAMPLE_FREQ,
+                                     .gravity = (float)GRAVITY, .acc_gate = acc_gate};
+    AhrsInstance_s ahrs;
+    Ahrs_Init(&ahrs, &config);
+    Ahrs_Reset(&ahrs, accel_data[0], NULL);
+    TiltError_s result = {0};
+    ErrorAcc_s acc = {0};
+    for (int k = 1; k < SAMPLE_CNT; k++){
+        Ahrs_Update_Imu(&ahrs, gyro_data[k], accel_data[k]);
+        Error_Add(&acc, &result, k, Tilt_Error(truth[k], ahrs.q));
+    }
+    result.rejected = ahrs.gated;
+    Error_Finish(&acc, &result, name);
+    return result;
+}
+
+/**
+ * @brief 无冲击：EKF 倾角误差远小于 Mahony，零偏估计收敛到真值
+ */
+static void Test_Spin_Top(void){
+    Generate(false);
+    printf("spin top:\n");
+    const TiltError_s mahony = Run_Mahony("mahony", 0.0f);
+    const TiltError_s ekf = Run_Ekf("ekf chi2 11.34", CHI2_GATE);
+    TEST_CHECK_MSG(ekf.rms < 0.05, "rms=%.3f", ekf.rms);
+    TEST_CHECK_MSG(ekf.max < 0.2, "max=%.3f", ekf.max);
+    TEST_CHECK(ekf.rms < mahony.rms / 5.0);
+    printf("  ekf bias [%.4f %.4f %.4f], true [%.4f %.4f %.4f]\n", (double)ekf.bias[0], (double)ekf.bias[1], (double)ekf.bias[2],
+           bias_end[0], bias_end[1], bias_end[2]);
+    for (int i = 0; i < 3; i++){
+        TEST_CHECK_MSG(fabs(ekf.bias[i] - bias_end[i]) < 2e-3, "bias[%d] %.4f, true %.4f", i, (double)ekf.bias[i], bias_end[i]);
+    }
+}
+
+/**
+ * @brief 周期性冲击：卡方门控拒绝冲击期间的观测，精度与无冲击时相当，优于不门控
+ */
+static void Test_Shock(void){
+    Generate(true);
+    printf("spin top with shocks:\n");
+    Run_Mahony("mahony gate 0.1", 0.1f);
+    const TiltError_s ekf = Run_Ekf("ekf no gate", 0.0f);
+    const TiltError_s ekf_gate = Run_Ekf("ekf chi2 11.34", CHI2_GATE);
+    TEST_CHECK(ekf.rejected == 0u);
+    TEST_CHECK(ekf_gate.rejected > 0u);
+    TEST_CHECK_MSG(ekf_gate.rms < 0.05, "rms=%.3f", ekf_gate.rms);
+    TEST_CHECK_MSG(ekf_gate.max < 0.2, "max=%.3f", ekf_gate.max);
+    TEST_CHECK(ekf_gate.rms < ekf.rms);
+}
+
+/**
+ * @brief 输出预测、预测+更新的单次耗时（5 次取最小），只作参考，不判定结果
+ */
+static void Bench_Ekf(void){
+    const AttitudeEkfInitConfig_s config = Ekf_Config(CHI2_GATE);
+    AttitudeEkfInstance_s ekf;
+    double best[2] = {1e9, 1e9};
+    for (int rep = 0; rep < BENCH_REPEAT; rep++){
+        Attitude_Ekf_Init(&ekf, &config);
+        uint64_t start = Test_Now_Ns();
+        for (int k = 0; k < SAMPLE_CNT; k++){
+            Attitude_Ekf_Predict(&ekf, gyro_data[k], 1e-3f);
+        }
+        best[0] = fmin(best[0], (double)(Test_Now_Ns() - start) / SAMPLE_CNT);
+
+        Attitude_Ekf_Init(&ekf, &config);
+        start = Test_Now_Ns();
+        for (int k = 0; k < SAMPLE_CNT; k++){
+            Attitude_Ekf_Predict(&ekf, gyro_data[k], 1e-3f);
+            Attitude_Ekf_Update_Accel(&ekf, accel_data[k]);
+        }
+        best[1] = fmin(best[1], (double)(Test_Now_Ns() - start) / SAMPLE_CNT);
+    }
+    printf("ekf: predict %.0f ns, predict + update %.0f ns (q0 %f)\n", best[0], best[1], (double)ekf.q[0]);
+}
+
+int main(void){
+    Test_Spin_Top();
+    Test_Shock();
+    Bench_Ekf();
+    return Test_Report("attitude_ekf");
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_chassis_power.c
+ * @brief 底盘功率限制主机仿真：4 轮 1 kHz 控制，50 Hz 裁判系统数据，功率上限阶跃变化，
+ *        检查缓冲能量不耗尽、缓冲能量降到保留值后实际功率不超过上限
+ */
+#include "alg_chassis_calc.h"
+#include "test_common.h"
+#include <math.h>
+
+#define SIM_DT 0.001f            // 控制周期 s
+#define SIM_TICKS 120000         // 仿真总周期数
+#define SIM_WHEEL_CNT 4
+#define SIM_REFEREE_DIV 20       // 裁判系统数据周期 = 20 个控制周期
+#define SIM_BUFFER_MAX 60.0f     // 裁判系统缓冲能量上限 J
+#define SIM_CURRENT_MAX 20.0f    // 电流指令限幅 A
+
+/* 底盘模块依赖的电机和 PID 接口，功率限制不使用 */
+DjiMotorInstance_s* Motor_Dji_Register(DjiMotorInitConfig_s* config){ (void)config; return NULL; }
+void Motor_Dji_Control(DjiMotorInstance_s* motor, float target){ (void)motor; (void)target; }
+void Motor_Dji_Transmit(DjiMotorInstance_s* motor){ (void)motor; }
+PidInstance_s* Pid_Register(PidInitConfig_s* config){ (void)config; return NULL; }
+float Pid_Calculate(PidInstance_s* pid, float measure, float target){ (void)pid; return target - measure; }
+
+typedef struct {
+    float min_buffer;            // 仿真过程中的最小缓冲能量 J
+    float worst_over;            // 缓冲能量不高于保留值时功率超出上限的最大值 W
+    long over_cnt;               // 缓冲能量不高于保留值时功率超出上限 0.5 W 的周期数
+} SimResult_s;
+
+static const ChassisPowerConfig_s power_config = {
+    .k_torque = 0.0156f * 6.2832f / 60.0f,
+    .k_copper = 0.3f,
+    .k_speed = 2.5e-7f,
+    .p_static = 3.0f,
+    .buffer_reserve = 10.0f,
+    .buffer_horizon = 1.0f,
+};
+
+/**
+ * @brief 运行一次仿真
+ * @param plant_gain 实际功率相对模型的倍数，用于模拟模型误差
+ */
+static SimResult_s Simulate(float plant_gain){
+    static const float limit_steps[] = {45.0f, 80.0f, 120.0f, 60.0f, 45.0f, 100.0f};
+    ChassisPowerLimit_s limiter;
+    Chassis_Power_Limit_Init(&limiter, &power_config);
+
+    SimResult_s result = {.min_buffer = SIM_BUFFER_MAX};
+    float speed[SIM_WHEEL_CNT] = {0};
+    float buffer = SIM_BUFFER_MAX;
+    float limit = limit_steps[0];
+    float measured = 0.0f;
+    for (long k = 0; k < SIM_TICKS; k++){
+        limit = limit_steps[k / (SIM_TICKS / 6)];
+        // 加速、反转、减速、停止循环
+        const int phase = (int)((k / 1500) % 4);
+        const float target = (phase == 0) ? 9000.0f : (phase == 1) ? -9000.0f : (phase == 2) ? 4000.0f : 0.0f;
+        if (k % SIM_REFEREE_DIV == 0){
+            Chassis_Power_Set_Limit(&limiter, limit, buffer);
+            Chassis_Power_Update_Measure(&limiter, measured);
+        }
+
+        float current[SIM_WHEEL_CNT];
+        for (int i = 0; i < SIM_WHEEL_CNT; i++){
+            const float wheel_target = (i & 1) ? target : -target;
+            current[i] = fmaxf(-SIM_CURRENT_MAX, fminf(SIM_CURRENT_MAX, 0.02f * (wheel_target - speed[i])));
+        }
+        Chassis_Power_Limit(&limiter, current, speed, SIM_WHEEL_CNT);
+
+        // 电机功率按模型乘以 plant_gain 计算，回馈功率不给电池充电
+        float power = power_config.p_static * plant_gain;
+        for (int i = 0; i < SIM_WHEEL_CNT; i++){
+            const float p = plant_gain * (power_config.k_torque * current[i] * speed[i]
+                                          + power_config.k_copper * current[i] * current[i]
+                                          + power_config.k_speed * speed[i] * speed[i]);
+            if (p > 0.0f){
+                power += p;
+            }
+            speed[i] += (900.0f * current[i] - 2.0f * speed[i]) * SIM_DT * 10.0f;
+        }
+        measured = power;
+
+        buffer = fminf(buffer + (limit - power) * SIM_DT, SIM_BUFFER_MAX);
+        result.min_buffer = fminf(result.min_buffer, buffer);
+        if (buffer <= power_config.buffer_reserve && power > limit + 0.5f){
+            result.over_cnt++;
+            result.worst_over = fmaxf(result.worst_over, power - limit);
+        }
+    }
+    printf("plant %.2fx model: min buffer %.2f J, %ld ticks over limit at reserve, worst %.2f W\n",
+           (double)plant_gain, (double)result.min_buffer, result.over_cnt, (double)result.worst_over);
+    return result;
+}
+
+int main(void){
+    // 模型准确：缓冲能量降到保留值后不超功率
+    SimResult_s exact = Simulate(1.0f);
+    TEST_CHECK(exact.over_cnt == 0);
+    TEST_CHECK_MSG(exact.min_buffer > 0.0f, "min_buffer=%.2f", (double)exact.min_buffer);
+
+    // 实际功率比模型大 10% / 25%：测量校正使超出量有界，缓冲能量不耗尽
+    SimResult_s over10 = Simulate(1.10f);
+    TEST_CHECK_MSG(over10.worst_over < 2.0f, "worst_over=%.2f", (double)over10.worst_over);
+    TEST_CHECK_MSG(over10.min_buffer > 0.0f, "min_buffer=%.2f", (double)over10.min_buffer);
+    SimResult_s over25 = Simulate(1.25f);
+    TEST_CHECK_MSG(over25.worst_over < 10.0f, "worst_over=%.2f", (double)over25.worst_over);
+    TEST_CHECK_MSG(over25.min_buffer > 0.0f, "min_buffer=%.2f", (double)over25.min_buffer);
+    return Test_Report("chassis_power");
+}
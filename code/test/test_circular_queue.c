@@ -0,0 +1,272 @@
+/**
+ * @file test_circular_queue.c
+ * @brief CircularQueue 主机测试：两种满队列策略下单个、批量、Peek_Span/Skip、Reserve/Commit 接口的随机操作
+ *        与参考模型逐元素对比(含 drop_count)，以及批量与逐个接口的吞吐量
+ */
+#include "circular_queue.h"
+#include "test_common.h"
+#include <string.h>
+
+#define MODEL_CAPACITY 37u      // 非 2 的幂，覆盖任意位置回绕
+#define MODEL_OPS 200000
+#define BENCH_CAPACITY 1024u
+#define BENCH_CHUNK 64u
+#define BENCH_BYTES (256u * 1024u * 1024u)
+
+/**
+ * @brief 测试元素，校验字段用于发现错位或部分拷贝
+ */
+typedef struct {
+    uint32_t seq;
+    uint32_t check;
+} Item_s;
+
+/**
+ * @brief 参考模型：按入队顺序保存序号，队头在下标 0
+ */
+typedef struct {
+    uint32_t seq[MODEL_CAPACITY];
+    uint16_t count;
+    uint32_t drop_count;
+} Model_s;
+
+static Item_s Item_Make(uint32_t seq){
+    const Item_s item = {.seq = seq, .check = ~seq * 2654435761u};
+    return item;
+}
+
+static bool Item_Valid(const Item_s* item, uint32_t seq){
+    const Item_s expect = Item_Make(seq);
+    return item->seq == expect.seq && item->check == expect.check;
+}
+
+static void Model_Push(Model_s* model, uint32_t seq, CircularQueuePolicy_e policy){
+    if (model->count == MODEL_CAPACITY){
+        model->drop_count++;
+        if (policy == CIRCULAR_QUEUE_REJECT){
+            return;
+        }
+        memmove(model->seq, model->seq + 1, (MODEL_CAPACITY - 1u) * sizeof(uint32_t));
+        model->count--;
+    }
+    model->seq[model->count++] = seq;
+}
+
+static void Model_Pop(Model_s* model, uint16_t count){
+    memmove(model->seq, model->seq + count, (uint32_t)(model->count - count) * sizeof(uint32_t));
+    model->count -= count;
+}
+
+/**
+ * @brief 检查出队的元素与模型队头一致，并从模型中移除
+ */
+static void Model_Check_Pop(Model_s* model, const Item_s* items, uint16_t count, int op){
+    TEST_CHECK_MSG(count <= model->count, "op %d: popped %u, model has %u", op, count, model->count);
+    if (count > model->count){
+        count = model->count;
+    }
+    for (uint16_t i = 0; i < count; i++){
+        TEST_CHECK_MSG(Item_Valid(&items[i], model->seq[i]), "op %d: item %u seq %u expect %u",
+                       op, i, (unsigned)items[i].seq, (unsigned)model->seq[i]);
+    }
+    Model_Pop(model, count);
+}
+
+/**
+ * @brief 随机混合全部接口，每步后对比元素数和丢弃计数
+ * @param policy 队列满时的入队策略
+ */
+static void Test_Model(CircularQueuePolicy_e policy){
+    CircularQueue_s* queue = CircularQueue_Create(MODEL_CAPACITY, sizeof(Item_s));
+    TEST_CHECK(queue != NULL);
+    if (queue == NULL){
+        return;
+    }
+    CircularQueue_Set_Policy(queue, policy);
+    Model_s model = {0};
+    uint32_t next_seq = 0;
+    Item_s items[2u * MODEL_CAPACITY + 5u];
+    int wrapped_bulk = 0;
+    for (int op = 0; op < MODEL_OPS; op++){
+        const int kind = rand() % 100;
+        if (kind < 20){
+            const Item_s item = Item_Make(next_seq);
+            const bool full = model.count == MODEL_CAPACITY;
+            const bool ok = CircularQueue_Enqueue(queue, &item);
+            TEST_CHECK_MSG(ok == !(full && policy == CIRCULAR_QUEUE_REJECT), "op %d: enqueue returned %d", op, ok);
+            Model_Push(&model, next_seq++, policy);
+        } else if (kind < 40){
+            Item_s item;
+            const bool ok = CircularQueue_Dequeue(queue, &item);
+            TEST_CHECK_MSG(ok == (model.count > 0u), "op %d: dequeue returned %d", op, ok);
+            if (ok){
+                Model_Check_Pop(&model, &item, 1, op);
+            }
+        } else if (kind < 55){
+            // 批量入队数量可超过容量，覆盖 drop 分支
+            const uint16_t count = (uint16_t)(rand() % (int)(sizeof(items) / sizeof(items[0])));
+            for (uint16_t i = 0; i < count; i++){
+                items[i] = Item_Make(next_seq + i);
+            }
+            wrapped_bulk += (queue->rear + count > MODEL_CAPACITY && count <= MODEL_CAPACITY - model.count);
+            const uint16_t space = MODEL_CAPACITY - model.count;
+            const uint16_t expect = (policy == CIRCULAR_QUEUE_REJECT) ? ((count < space) ? count : space)
+                                                                     : ((count < MODEL_CAPACITY) ? count : MODEL_CAPACITY);
+            const uint16_t written = CircularQueue_Enqueue_Bulk(queue, items, count);
+            TEST_CHECK_MSG(written == expect, "op %d: bulk enqueue %u of %u, expect %u", op, written, count, expect);
+            for (uint16_t i = 0; i < count; i++){
+                Model_Push(&model, next_seq++, policy);
+            }
+        } else if (kind < 70){
+            const uint16_t count = (uint16_t)(rand() % (int)(MODEL_CAPACITY + 5u));
+            const uint16_t expect = (count < model.count) ? count : model.count;
+            const uint16_t read = CircularQueue_Dequeue_Bulk(queue, items, count);
+            TEST_CHECK_MSG(read == expect, "op %d: bulk dequeue %u, expect %u", op, read, expect);
+            Model_Check_Pop(&model, items, read, op);
+        } else if (kind < 82){
+            // 零拷贝读：连续区域不跨越回绕点，只丢弃其中一部分
+            uint16_t count = 0;
+            const Item_s* span = CircularQueue_Peek_Span(queue, &count);
+            const uint16_t to_end = MODEL_CAPACITY - queue->front;
+            TEST_CHECK_MSG(count == ((model.count < to_end) ? model.count : to_end), "op %d: span %u", op, count);
+            TEST_CHECK((span == NULL) == (count == 0u));
+            if (count > 0u){
+                const uint16_t skip = (uint16_t)(1 + rand() % count);
+                Model_Check_Pop(&model, span, skip, op);
+                CircularQueue_Skip(queue, skip);
+            }
+        } else if (kind < 97){
+            // 零拷贝写：预留区域不覆盖未读数据，可只提交一部分
+            uint16_t count = 0;
+            Item_s* slot = CircularQueue_Reserve(queue, &count);
+            const uint16_t space = MODEL_CAPACITY - model.count;
+            const uint16_t to_end = MODEL_CAPACITY - queue->rear;
+            TEST_CHECK_MSG(count == ((space < to_end) ? space : to_end), "op %d: reserve %u", op, count);
+            TEST_CHECK((slot == NULL) == (count == 0u));
+            if (count > 0u){
+                const uint16_t commit = (uint16_t)(rand() % (count + 1));
+                for (uint16_t i = 0; i < commit; i++){
+                    slot[i] = Item_Make(next_seq);
+                    Model_Push(&model, next_seq++, policy);
+                }
+                CircularQueue_Commit(queue, commit);
+            }
+        } else {
+            CircularQueue_Clear(queue);
+            model.count = 0;
+        }
+        TEST_CHECK_MSG(CircularQueue_Get_Size(queue) == model.count, "op %d: size %u, model %u",
+                       op, CircularQueue_Get_Size(queue), model.count);
+        TEST_CHECK_MSG(CircularQueue_Get_Drop_Count(queue) == model.drop_count, "op %d: drop %u, model %u",
+                       op, (unsigned)CircularQueue_Get_Drop_Count(queue), (unsigned)model.drop_count);
+        if (test_fail_cnt > 20u){
+            break;
+        }
+    }
+    printf("%s: %d ops, %u enqueued, %u dropped, %d bulk writes across the wrap point\n",
+           policy == CIRCULAR_QUEUE_REJECT ? "reject" : "overwrite", MODEL_OPS, (unsigned)next_seq,
+           (unsigned)model.drop_count, wrapped_bulk);
+    TEST_CHECK(wrapped_bulk > 0);
+    CircularQueue_Destroy(queue);
+}
+
+/**
+ * @brief 边界条件：非法参数、满队列的两种策略、超过容量的批量入队只保留最新元素
+ */
+static void Test_Edge(void){
+    TEST_CHECK(CircularQueue_Create(0, 4) == NULL);
+    TEST_CHECK(CircularQueue_Create(4, 0) == NULL);
+    TEST_CHECK(CircularQueue_Get_Drop_Count(NULL) == 0u);
+
+    CircularQueue_s* queue = CircularQueue_Create(4, sizeof(uint32_t));
+    TEST_CHECK(queue != NULL);
+    if (queue == NULL){
+        return;
+    }
+    TEST_CHECK(queue->policy == CIRCULAR_QUEUE_OVERWRITE);
+    const uint32_t in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint32_t out[10] = {0};
+    TEST_CHECK(CircularQueue_Enqueue_Bulk(queue, in, 10) == 4u);
+    TEST_CHECK(CircularQueue_Get_Drop_Count(queue) == 6u);
+    TEST_CHECK(CircularQueue_Dequeue_Bulk(queue, out, 10) == 4u);
+    TEST_CHECK(out[0] == 6u && out[3] == 9u);
+
+    CircularQueue_Set_Policy(queue, CIRCULAR_QUEUE_REJECT);
+    TEST_CHECK(CircularQueue_Enqueue_Bulk(queue, in, 10) == 4u);
+    TEST_CHECK(!CircularQueue_Enqueue(queue, &in[4]));
+    TEST_CHECK(CircularQueue_Get_Drop_Count(queue) == 13u);
+    uint16_t count = 0;
+    TEST_CHECK(CircularQueue_Reserve(queue, &count) == NULL && count == 0u);
+    TEST_CHECK(CircularQueue_Dequeue_Bulk(queue, out, 10) == 4u);
+    TEST_CHECK(out[0] == 0u && out[3] == 3u);
+    TEST_CHECK(CircularQueue_Peek_Span(queue, &count) == NULL && count == 0u);
+    CircularQueue_Destroy(queue);
+}
+
+/**
+ * @brief 输出逐个、批量、零拷贝接口的吞吐量，只作参考，不判定结果
+ */
+static void Bench_Throughput(void){
+    typedef struct {
+        uint8_t bytes[16];
+    } Sample_s;
+    CircularQueue_s* queue = CircularQueue_Create(BENCH_CAPACITY, sizeof(Sample_s));
+    TEST_CHECK(queue != NULL);
+    if (queue == NULL){
+        return;
+    }
+    static Sample_s chunk[BENCH_CHUNK];
+    const uint32_t rounds = BENCH_BYTES / (BENCH_CHUNK * sizeof(Sample_s));
+    volatile uint8_t sink = 0;
+
+    uint64_t start = Test_Now_Ns();
+    for (uint32_t r = 0; r < rounds; r++){
+        for (uint16_t i = 0; i < BENCH_CHUNK; i++){
+            chunk[i].bytes[0] = (uint8_t)(r + i);
+            CircularQueue_Enqueue(queue, &chunk[i]);
+        }
+        for (uint16_t i = 0; i < BENCH_CHUNK; i++){
+            CircularQueue_Dequeue(queue, &chunk[i]);
+        }
+        sink ^= chunk[BENCH_CHUNK - 1u].bytes[0];
+    }
+    const double single_ns = (double)(Test_Now_Ns() - start);
+
+    start = Test_Now_Ns();
+    for (uint32_t r = 0; r < rounds; r++){
+        chunk[0].bytes[0] = (uint8_t)r;
+        CircularQueue_Enqueue_Bulk(queue, chunk, BENCH_CHUNK);
+        CircularQueue_Dequeue_Bulk(queue, chunk, BENCH_CHUNK);
+        sink ^= chunk[BENCH_CHUNK - 1u].bytes[0];
+    }
+    const double bulk_ns = (double)(Test_Now_Ns() - start);
+
+    start = Test_Now_Ns();
+    for (uint32_t r = 0; r < rounds; r++){
+        uint16_t count = 0;
+        Sample_s* slot = CircularQueue_Reserve(queue, &count);
+        count = (count < BENCH_CHUNK) ? count : BENCH_CHUNK;
+        memcpy(slot, chunk, count * sizeof(Sample_s));
+        CircularQueue_Commit(queue, count);
+        const Sample_s* span = CircularQueue_Peek_Span(queue, &count);
+        sink ^= span[count - 1u].bytes[0];
+        CircularQueue_Skip(queue, count);
+    }
+    const double span_ns = (double)(Test_Now_Ns() - start);
+    TEST_CHECK(CircularQueue_Get_Size(queue) == 0u);
+
+    const double bytes = (double)rounds * BENCH_CHUNK * sizeof(Sample_s);
+    printf("throughput (16 B elements, %u per call): single %.1f MB/s, bulk %.1f MB/s (%.1fx), reserve/span %.1f MB/s\n",
+           BENCH_CHUNK, bytes / single_ns * 1e3, bytes / bulk_ns * 1e3, single_ns / bulk_ns, bytes / span_ns * 1e3);
+    (void)sink;
+    CircularQueue_Destroy(queue);
+}
+
+int main(void){
+    srand(1);
+    Test_Edge();
+    Test_Model(CIRCULAR_QUEUE_OVERWRITE);
+    Test_Model(CIRCULAR_QUEUE_REJECT);
+    Bench_Throughput();
+    return Test_Report("circular_queue");
+}
@@ -0,0 +1,90 @@
+/**
+ * @file test_common.h
+ * @brief 主机测试公用的检查宏、计时函数，以及合成传感器数据用的噪声和四元数函数，每个测试程序只包含一次
+ */
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static uint32_t test_fail_cnt = 0;
+
+/**
+ * @brief 检查条件，失败时输出位置并计数，不中断测试
+ */
+#define TEST_CHECK(cond) do {                                               \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);          \
+            test_fail_cnt++;                                                \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief 检查条件并输出实际值
+ */
+#define TEST_CHECK_MSG(cond, fmt, ...) do {                                 \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: %s, " fmt "\n", __FILE__, __LINE__, #cond,  \
+                   ##__VA_ARGS__);                                          \
+            test_fail_cnt++;                                                \
+        }                                                                   \
+    } while (0)
+
+/**
+ * @brief 输出测试结果
+ * @param name 测试名称
+ * @return 进程返回值，0 表示全部通过
+ */
+static inline int Test_Report(const char* name){
+    printf("%s: %s (%u failures)\n", name, test_fail_cnt == 0u ? "PASSED" : "FAILED", (unsigned)test_fail_cnt);
+    return test_fail_cnt == 0u ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief 单调时钟，单位 ns，用于基准测试
+ */
+static inline uint64_t Test_Now_Ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 标准正态分布随机数(Box-Muller)，由 rand() 驱动，结果随 srand 种子复现
+ */
+static inline double Test_Gauss(void){
+    const double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    const double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+/**
+ * @brief 四元数乘法 out = a * b，分量顺序 [w, x, y, z]
+ */
+static inline void Test_Quat_Mul(const double a[4], const double b[4], double out[4]){
+    out[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    out[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    out[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    out[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+}
+
+/**
+ * @brief 导航系向量转到机体系，q 为机体系到导航系的旋转
+ */
+static inline void Test_Nav_To_Body(const double q[4], const double v[3], double out[3]){
+    const double conj[4] = {q[0], -q[1], -q[2], -q[3]};
+    const double vq[4] = {0.0, v[0], v[1], v[2]};
+    double tmp[4], res[4];
+    Test_Quat_Mul(conj, vq, tmp);
+    Test_Quat_Mul(tmp, q, res);
+    out[0] = res[1];
+    out[1] = res[2];
+    out[2] = res[3];
+}
+
+#endif // TEST_COMMON_H
@@ -0,0 +1,137 @@
+/**
+ * @file test_crc.c
+ * @brief CRC 主机测试：标准校验值、与逐位算法对比、分段计算、帧追加/校验，以及 4 KiB 数据的吞吐量
+ */
+#include "alg_crc.h"
+#include "test_common.h"
+#include <string.h>
+
+#define BENCH_LEN 4096u
+#define BENCH_ROUNDS 20000u
+
+static uint8_t data_buf[BENCH_LEN];
+
+/**
+ * @brief 逐位计算的 CRC8 参考实现（多项式 0x31 反射为 0x8C）
+ */
+static uint8_t Crc8_Bitwise(uint8_t crc, const uint8_t* buffer, size_t len){
+    while (len--){
+        crc ^= *buffer++;
+        for (int i = 0; i < 8; i++){
+            crc = (crc & 1u) ? (uint8_t)((crc >> 1) ^ 0x8Cu) : (uint8_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 逐位计算的 CRC32 参考实现（多项式 0x04C11DB7 反射为 0xEDB88320）
+ */
+static uint32_t Crc32_Bitwise(uint32_t crc, const uint8_t* buffer, size_t len){
+    while (len--){
+        crc ^= *buffer++;
+        for (int i = 0; i < 8; i++){
+            crc = (crc & 1u) ? ((crc >> 1) ^ 0xEDB88320u) : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief "123456789" 的标准校验值
+ */
+static void Test_Check_Value(void){
+    const uint8_t* check = (const uint8_t*)"123456789";
+    TEST_CHECK(Crc8_Calculate(0, check, 9) == 0xA1u);
+    TEST_CHECK(Crc16_Calculate(0xFFFF, check, 9) == 0x6F91u);
+    TEST_CHECK(Crc_Ccitt_Calculate(0xFFFF, check, 9) == 0x6F91u);
+    TEST_CHECK(Crc16_False_Calculate(0xFFFF, check, 9) == 0x29B1u);
+
+    CrcStream_s stream;
+    Crc_Stream_Init(&stream, CRC_TYPE_CRC32);
+    Crc_Stream_Update(&stream, check, 4);
+    Crc_Stream_Update(&stream, check + 4, 5);
+    TEST_CHECK(Crc_Stream_Final(&stream) == 0xCBF43926u);
+}
+
+/**
+ * @brief 非对齐起始地址、0~199 字节长度下与逐位算法一致，分两段计算与一次计算结果相同
+ */
+static void Test_Lengths(void){
+    for (size_t n = 0; n < 200u; n++){
+        TEST_CHECK_MSG(Crc8_Calculate(CRC8_INIT, data_buf + 3, n) == Crc8_Bitwise(CRC8_INIT, data_buf + 3, n), "n=%zu", n);
+        TEST_CHECK_MSG(Crc32_Calculate(CRC32_INIT, data_buf + 1, n) == Crc32_Bitwise(CRC32_INIT, data_buf + 1, n), "n=%zu", n);
+        const size_t split = n / 3u;
+        const uint16_t whole = Crc16_Calculate(CRC16_INIT, data_buf + 1, n);
+        const uint16_t head = Crc16_Calculate(CRC16_INIT, data_buf + 1, split);
+        TEST_CHECK_MSG(whole == Crc16_Calculate(head, data_buf + 1 + split, n - split), "n=%zu", n);
+        const uint16_t whole_false = Crc16_False_Calculate(CRC16_FALSE_INIT, data_buf + 5, n);
+        const uint16_t head_false = Crc16_False_Calculate(CRC16_FALSE_INIT, data_buf + 5, split);
+        TEST_CHECK_MSG(whole_false == Crc16_False_Calculate(head_false, data_buf + 5 + split, n - split), "n=%zu", n);
+    }
+}
+
+/**
+ * @brief 裁判系统帧的追加与校验
+ */
+static void Test_Frame(void){
+    uint8_t frame[32];
+    memcpy(frame, data_buf, 30);
+    Crc16_Append(frame, sizeof(frame));
+    TEST_CHECK(Crc16_Verify(frame, sizeof(frame)));
+    frame[5] ^= 1u;
+    TEST_CHECK(!Crc16_Verify(frame, sizeof(frame)));
+
+    Crc8_Append(frame, 5);
+    TEST_CHECK(Crc8_Verify(frame, 5));
+    frame[0] ^= 0x80u;
+    TEST_CHECK(!Crc8_Verify(frame, 5));
+}
+
+/**
+ * @brief 输出各算法的吞吐量，只作参考，不判定结果
+ */
+static void Bench_Throughput(void){
+    volatile uint32_t sink = 0;
+    uint64_t start;
+    const double bytes = (double)BENCH_LEN * BENCH_ROUNDS;
+    printf("CRC_SLICING = %d, %u bytes x %u rounds\n", CRC_SLICING, BENCH_LEN, BENCH_ROUNDS);
+
+    start = Test_Now_Ns();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++){
+        sink += Crc8_Calculate(CRC8_INIT, data_buf, BENCH_LEN);
+    }
+    printf("  CRC8        %8.1f MB/s\n", bytes * 1e3 / (double)(Test_Now_Ns() - start));
+
+    start = Test_Now_Ns();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++){
+        sink += Crc16_Calculate(CRC16_INIT, data_buf, BENCH_LEN);
+    }
+    printf("  CRC16       %8.1f MB/s\n", bytes * 1e3 / (double)(Test_Now_Ns() - start));
+
+    start = Test_Now_Ns();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++){
+        sink += Crc16_False_Calculate(CRC16_FALSE_INIT, data_buf, BENCH_LEN);
+    }
+    printf("  CRC16-FALSE %8.1f MB/s\n", bytes * 1e3 / (double)(Test_Now_Ns() - start));
+
+    start = Test_Now_Ns();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++){
+        sink += Crc32_Calculate(CRC32_INIT, data_buf, BENCH_LEN);
+    }
+    printf("  CRC32       %8.1f MB/s\n", bytes * 1e3 / (double)(Test_Now_Ns() - start));
+    (void)sink;
+}
+
+int main(void){
+    srand(1);
+    for (uint32_t i = 0; i < BENCH_LEN; i++){
+        data_buf[i] = (uint8_t)rand();
+    }
+    Crc_Init();
+    Test_Check_Value();
+    Test_Lengths();
+    Test_Frame();
+    Bench_Throughput();
+    return Test_Report("crc");
+}
@@ -0,0 +1,198 @@
+/**
+ * @file test_dbus.c
+ * @brief DBUS 解码主机测试：随机合法数据经逐位参考编码器往返解码、随机噪声帧的剔除率与参考判断对比，
+ *        以及单帧解码耗时
+ */
+#include "dbus.h"
+#include "test_common.h"
+#include <math.h>
+#include <string.h>
+
+#define ROUND_TRIP_FRAMES 1000000L
+#define NOISE_FRAMES 2000000L
+#define BENCH_FRAMES 20000000L
+#define BENCH_POOL 256u
+
+/* 各通道在帧中的起始位，低位在前；ch4 单独占 16~17 字节的低 11 位 */
+static const int ch_bit[DBUS_CHANNELS] = {0, 11, 22, 33, 128};
+#define DBUS_S2_BIT 44
+#define DBUS_S1_BIT 46
+
+static void Bits_Put(uint8_t* frame, int bit, int width, uint32_t value){
+    for (int k = 0; k < width; k++, bit++){
+        frame[bit / 8] = (uint8_t)((frame[bit / 8] & ~(1u << (bit % 8))) | (((value >> k) & 1u) << (bit % 8)));
+    }
+}
+
+static uint32_t Bits_Get(const uint8_t* frame, int bit, int width){
+    uint32_t value = 0;
+    for (int k = 0; k < width; k++, bit++){
+        value |= (uint32_t)((frame[bit / 8] >> (bit % 8)) & 1u) << k;
+    }
+    return value;
+}
+
+/**
+ * @brief 逐位编码的参考实现，frame 中未定义的位保持原值
+ */
+static void Dbus_Reference_Encode(const DbusData_s* data, uint8_t* frame){
+    for (int i = 0; i < DBUS_CHANNELS; i++){
+        Bits_Put(frame, ch_bit[i], 11, (uint32_t)data->ch[i]);
+    }
+    Bits_Put(frame, DBUS_S2_BIT, 2, data->s2);
+    Bits_Put(frame, DBUS_S1_BIT, 2, data->s1);
+    Bits_Put(frame, 48, 16, (uint16_t)data->mouse_x);
+    Bits_Put(frame, 64, 16, (uint16_t)data->mouse_y);
+    Bits_Put(frame, 80, 16, (uint16_t)data->mouse_z);
+    Bits_Put(frame, 96, 8, data->press_l);
+    Bits_Put(frame, 104, 8, data->press_r);
+    Bits_Put(frame, 112, 16, data->key);
+}
+
+/**
+ * @brief 逐位解码的参考实现
+ * @return true 通道值和开关值合法
+ */
+static bool Dbus_Reference_Decode(const uint8_t* frame, DbusData_s* data){
+    bool valid = true;
+    for (int i = 0; i < DBUS_CHANNELS; i++){
+        data->ch[i] = (int16_t)Bits_Get(frame, ch_bit[i], 11);
+        valid = valid && data->ch[i] >= DBUS_CH_VALUE_MIN && data->ch[i] <= DBUS_CH_VALUE_MAX;
+    }
+    data->s2 = (uint8_t)Bits_Get(frame, DBUS_S2_BIT, 2);
+    data->s1 = (uint8_t)Bits_Get(frame, DBUS_S1_BIT, 2);
+    valid = valid && data->s1 != 0u && data->s2 != 0u;
+    data->mouse_x = (int16_t)Bits_Get(frame, 48, 16);
+    data->mouse_y = (int16_t)Bits_Get(frame, 64, 16);
+    data->mouse_z = (int16_t)Bits_Get(frame, 80, 16);
+    data->press_l = (uint8_t)Bits_Get(frame, 96, 8);
+    data->press_r = (uint8_t)Bits_Get(frame, 104, 8);
+    data->key = (uint16_t)Bits_Get(frame, 112, 16);
+    return valid;
+}
+
+static bool Dbus_Data_Equal(const DbusData_s* a, const DbusData_s* b){
+    return memcmp(a->ch, b->ch, sizeof(a->ch)) == 0 && a->s1 == b->s1 && a->s2 == b->s2
+        && a->mouse_x == b->mouse_x && a->mouse_y == b->mouse_y && a->mouse_z == b->mouse_z
+        && a->press_l == b->press_l && a->press_r == b->press_r && a->key == b->key;
+}
+
+static void Random_Bytes(uint8_t* frame, int len){
+    for (int i = 0; i < len; i++){
+        frame[i] = (uint8_t)rand();
+    }
+}
+
+/**
+ * @brief 生成随机合法数据，通道值包含两端极值
+ */
+static void Random_Data(DbusData_s* data){
+    static const uint8_t sw[3] = {DBUS_SW_UP, DBUS_SW_MID, DBUS_SW_DOWN};
+    for (int i = 0; i < DBUS_CHANNELS; i++){
+        const int pick = rand() % 16;
+        data->ch[i] = (int16_t)(pick == 0 ? DBUS_CH_VALUE_MIN : pick == 1 ? DBUS_CH_VALUE_MAX
+                              : DBUS_CH_VALUE_MIN + rand() % (DBUS_CH_VALUE_MAX - DBUS_CH_VALUE_MIN + 1));
+    }
+    data->s1 = sw[rand() % 3];
+    data->s2 = sw[rand() % 3];
+    data->mouse_x = (int16_t)rand();
+    data->mouse_y = (int16_t)rand();
+    data->mouse_z = (int16_t)rand();
+    data->press_l = (uint8_t)(rand() & 1);
+    data->press_r = (uint8_t)(rand() & 1);
+    data->key = (uint16_t)rand();
+}
+
+/**
+ * @brief 随机合法数据编码到随机底噪的帧中再解码，必须原样恢复；长度错误的同一帧必须拒绝
+ */
+static void Test_Round_Trip(void){
+    uint8_t frame[DBUS_FRAME_SIZE];
+    DbusData_s expect;
+    DbusData_s data;
+    DbusData_s reference;
+    long mismatch = 0;
+    long length_accepted = 0;
+    for (long it = 0; it < ROUND_TRIP_FRAMES; it++){
+        Random_Bytes(frame, DBUS_FRAME_SIZE);
+        Random_Data(&expect);
+        Dbus_Reference_Encode(&expect, frame);
+        memset(&data, 0x55, sizeof(data));
+        if (!Dbus_Frame_Parse(&data, frame, DBUS_FRAME_SIZE) || !Dbus_Data_Equal(&data, &expect)
+            || !Dbus_Reference_Decode(frame, &reference) || !Dbus_Data_Equal(&reference, &expect)){
+            mismatch++;
+        }
+        const uint16_t bad_len = (uint16_t)((it & 1) ? DBUS_FRAME_SIZE - 1 - rand() % DBUS_FRAME_SIZE
+                                                      : DBUS_FRAME_SIZE + 1 + rand() % 64);
+        length_accepted += Dbus_Frame_Parse(&data, frame, bad_len);
+    }
+    printf("round trip: %ld frames, %ld mismatches, %ld wrong-length frames accepted\n",
+           ROUND_TRIP_FRAMES, mismatch, length_accepted);
+    TEST_CHECK(mismatch == 0);
+    TEST_CHECK(length_accepted == 0);
+}
+
+/**
+ * @brief 随机字节帧：接受/拒绝与参考判断一致，拒绝时输出不变，剔除率与理论值一致
+ * @note DBUS 无帧头和校验，随机帧被接受的概率 = (1321/2048)^5 * (3/4)^2，约 6.3%
+ */
+static void Test_Noise(void){
+    uint8_t frame[DBUS_FRAME_SIZE];
+    DbusData_s data;
+    DbusData_s untouched;
+    DbusData_s reference;
+    long mismatch = 0;
+    long rejected = 0;
+    for (long it = 0; it < NOISE_FRAMES; it++){
+        Random_Bytes(frame, DBUS_FRAME_SIZE);
+        memset(&data, 0x55, sizeof(data));
+        memset(&untouched, 0x55, sizeof(untouched));
+        const bool ok = Dbus_Frame_Parse(&data, frame, DBUS_FRAME_SIZE);
+        const bool valid = Dbus_Reference_Decode(frame, &reference);
+        if (ok != valid){
+            mismatch++;
+        } else if (!ok){
+            rejected++;
+            mismatch += memcmp(&data, &untouched, sizeof(data)) != 0;
+        } else {
+            mismatch += !Dbus_Data_Equal(&data, &reference);
+        }
+    }
+    const double rate = (double)rejected / (double)NOISE_FRAMES;
+    const double expect = 1.0 - pow((DBUS_CH_VALUE_MAX - DBUS_CH_VALUE_MIN + 1) / 2048.0, DBUS_CHANNELS) * 0.75 * 0.75;
+    printf("noise: %ld frames, rejection rate %.4f (expected %.4f), %ld mismatches\n",
+           NOISE_FRAMES, rate, expect, mismatch);
+    TEST_CHECK(mismatch == 0);
+    TEST_CHECK_MSG(fabs(rate - expect) < 0.002, "rate=%.4f expect=%.4f", rate, expect);
+    TEST_CHECK(!Dbus_Frame_Parse(NULL, frame, DBUS_FRAME_SIZE));
+    TEST_CHECK(!Dbus_Frame_Parse(&data, NULL, DBUS_FRAME_SIZE));
+}
+
+/**
+ * @brief 输出单帧解码耗时，只作参考，不判定结果
+ */
+static void Bench_Parse(void){
+    static uint8_t frames[BENCH_POOL][DBUS_FRAME_SIZE];
+    for (uint32_t k = 0; k < BENCH_POOL; k++){
+        DbusData_s data;
+        Random_Data(&data);
+        Dbus_Reference_Encode(&data, frames[k]);
+    }
+    DbusData_s data;
+    volatile uint32_t sink = 0;
+    const uint64_t start = Test_Now_Ns();
+    for (long i = 0; i < BENCH_FRAMES; i++){
+        Dbus_Frame_Parse(&data, frames[i & (BENCH_POOL - 1u)], DBUS_FRAME_SIZE);
+        sink += (uint32_t)data.ch[i % DBUS_CHANNELS];
+    }
+    printf("parse: %.2f ns/frame\n", (double)(Test_Now_Ns() - start) / (double)BENCH_FRAMES);
+    (void)sink;
+}
+
+int main(void){
+    srand(1);
+    Test_Round_Trip();
+    Test_Noise();
+    Bench_Parse();
+    return Test_Report("dbus");
+}
@@ -0,0 +1,309 @@
+/**
+ * @file test_imu_calib.c
+ * @brief IMU 校准主机测试：用带量化、噪声、尖峰、运动和温漂的合成数据检查上电零偏、六面校准、
+ *        温度跟踪、Flash 保存/读取和中断样本逐个输入，以及 Imu_Calib_Correct 的耗时
+ */
+#include "imu_calib.h"
+#include "bsp_flash.h"
+#include "robot_config.h"
+#include "test_common.h"
+#include <math.h>
+#include <string.h>
+
+#define FLASH_SECTOR_SIZE 0x20000u
+#define REF_TEMP 30.0
+#define BENCH_CALLS 10000000
+
+/* 合成传感器误差：陀螺仪零偏和温度系数，加速度计零偏和比例 */
+static const double true_gyro_bias[3] = {0.01, -0.02, 0.005};
+static const double true_temp_coef[3] = {1e-3, -5e-4, 2e-4};
+static const double true_accel_offset[3] = {0.1, -0.15, 0.2};
+static const double true_accel_scale[3] = {1.02, 0.98, 1.01};
+
+static const double still[3] = {0.0, 0.0, 0.0};
+static const double rotating[3] = {0.5, 0.2, 0.0};
+static const double level[3] = {0.0, 0.0, IMU_CALIB_GRAVITY};
+
+/* 6G 量程，陀螺仪 2000dps 量程 */
+static Bmi088Instance_s imu = {
+    .accel_sen = 6.0f / 32768.0f * IMU_CALIB_GRAVITY,
+    .gyro_sen = 2000.0f / 32768.0f * 0.0174532925f,
+};
+
+/* 用内存模拟校准参数所在的 Flash 扇区 */
+static uint8_t flash_sector[FLASH_SECTOR_SIZE];
+
+bool Flash_Erase_Sector(uint32_t addr){
+    if (addr != IMU_CALIB_FLASH_ADDR){
+        return false;
+    }
+    memset(flash_sector, 0xFF, sizeof(flash_sector));
+    return true;
+}
+
+bool Flash_Program(uint32_t addr, const void* data, uint32_t len){
+    memcpy(flash_sector + (addr - IMU_CALIB_FLASH_ADDR), data, len);
+    return true;
+}
+
+void Flash_Read(uint32_t addr, void* data, uint32_t len){
+    memcpy(data, flash_sector + (addr - IMU_CALIB_FLASH_ADDR), len);
+}
+
+bool Bmi088_Read_Raw(Bmi088Instance_s* bmi088, int16_t gyro[3], int16_t accel[3], float* temperate){
+    (void)bmi088;
+    (void)gyro;
+    (void)accel;
+    (void)temperate;
+    return false;
+}
+
+static int16_t Quantize(double value, float sen){
+    return (int16_t)fmax(-32768.0, fmin(32767.0, round(value / sen)));
+}
+
+/**
+ * @brief 生成一组原始数据
+ * @param gyro_noise 陀螺仪噪声标准差 rad/s
+ * @param accel_noise 加速度计噪声标准差 m/s^2
+ */
+static void Sample(const double rate[3], const double accel[3], double temp, double gyro_noise, double accel_noise,
+                   int16_t gyro_raw[3], int16_t accel_raw[3]){
+    for (int i = 0; i < 3; i++){
+        const double bias = true_gyro_bias[i] + true_temp_coef[i] * (temp - REF_TEMP);
+        gyro_raw[i] = Quantize(rate[i] + bias + gyro_noise * Test_Gauss(), imu.gyro_sen);
+        accel_raw[i] = Quantize(accel[i] / true_accel_scale[i] + true_accel_offset[i] + accel_noise * Test_Gauss(), imu.accel_sen);
+    }
+}
+
+/**
+ * @brief 上电零偏：先转动 300 个样本，静止阶段 1% 的样本带尖峰
+ */
+static void Test_Boot_Gyro(ImuCalib_s* calib){
+    int16_t gyro_raw[3], accel_raw[3];
+    float gyro[3], accel[3];
+    for (int n = 0; n < 300; n++){
+        Sample(rotating, level, REF_TEMP, 0.002, 0.02, gyro_raw, accel_raw);
+        Imu_Calib_Correct(calib, gyro_raw, accel_raw, (float)REF_TEMP, gyro, accel);
+        Imu_Calib_Feed(calib, gyro_raw, accel_raw, (float)REF_TEMP);
+    }
+    int n;
+    for (n = 0; calib->state == IMU_CALIB_GYRO && n < 20000; n++){
+        Sample(still, level, REF_TEMP, 0.002, 0.02, gyro_raw, accel_raw);
+        if (rand() % 100 == 0){
+            gyro_raw[rand() % 3] += (int16_t)(0.03f / imu.gyro_sen);
+        }
+        Imu_Calib_Correct(calib, gyro_raw, accel_raw, (float)REF_TEMP, gyro, accel);
+        Imu_Calib_Feed(calib, gyro_raw, accel_raw, (float)REF_TEMP);
+    }
+    double err = 0.0;
+    for (int i = 0; i < 3; i++){
+        err = fmax(err, fabs(calib->param.gyro_bias[i] - true_gyro_bias[i]));
+    }
+    printf("boot gyro: bias error %.2e rad/s after %d still samples\n", err, n);
+    TEST_CHECK(calib->state == IMU_CALIB_IDLE);
+    TEST_CHECK(calib->param.valid & IMU_CALIB_VALID_GYRO);
+    TEST_CHECK_MSG(err < 2e-4, "err=%.2e", err);
+}
+
+/**
+ * @brief 六面校准：每面倾斜约 4.6°，面之间有转动和大噪声；校准后任意姿态的加速度误差
+ */
+static void Test_Six_Face(ImuCalib_s* calib){
+    int16_t gyro_raw[3], accel_raw[3];
+    float gyro[3], accel[3];
+    const double tilt = 0.08;
+    Imu_Calib_Start_Accel(calib);
+    for (int face = 0; face < 6; face++){
+        const int axis = face / 2;
+        const double sign = (face & 1) ? -1.0 : 1.0;
+        double face_accel[3] = {0.0, 0.0, 0.0};
+        face_accel[axis] = sign * IMU_CALIB_GRAVITY * cos(tilt);
+        face_accel[(axis + 1) % 3] = IMU_CALIB_GRAVITY * sin(tilt);
+        for (int k = 0; k < 200; k++){
+            Sample(rotating, level, REF_TEMP, 0.002, 0.5, gyro_raw, accel_raw);
+            Imu_Calib_Feed(calib, gyro_raw, accel_raw, (float)REF_TEMP);
+        }
+        for (int k = 0; k < 1100; k++){
+            Sample(still, face_accel, REF_TEMP, 0.002, 0.02, gyro_raw, accel_raw);
+            Imu_Calib_Feed(calib, gyro_raw, accel_raw, (float)REF_TEMP);
+        }
+    }
+    double offset_err = 0.0;
+    double scale_err = 0.0;
+    for (int i = 0; i < 3; i++){
+        offset_err = fmax(offset_err, fabs(calib->param.accel_offset[i] - true_accel_offset[i]));
+        scale_err = fmax(scale_err, fabs(calib->param.accel_scale[i] - true_accel_scale[i]));
+    }
+    printf("six face: offset error %.2e m/s^2, scale error %.2e\n", offset_err, scale_err);
+    TEST_CHECK(calib->state == IMU_CALIB_IDLE);
+    TEST_CHECK(calib->param.valid & IMU_CALIB_VALID_ACCEL);
+    TEST_CHECK_MSG(offset_err < 0.01, "offset_err=%.2e", offset_err);
+    TEST_CHECK_MSG(scale_err < 0.002, "scale_err=%.2e", scale_err);
+
+    const double norm = sqrt(3.0 * 3.0 + 4.0 * 4.0 + 8.3 * 8.3);
+    const double attitude[3] = {3.0 * IMU_CALIB_GRAVITY / norm, -4.0 * IMU_CALIB_GRAVITY / norm, 8.3 * IMU_CALIB_GRAVITY / norm};
+    double mean[3] = {0.0, 0.0, 0.0};
+    for (int k = 0; k < 1000; k++){
+        Sample(still, attitude, REF_TEMP, 0.002, 0.02, gyro_raw, accel_raw);
+        Imu_Calib_Correct(calib, gyro_raw, accel_raw, (float)REF_TEMP, gyro, accel);
+        for (int i = 0; i < 3; i++){
+            mean[i] += accel[i] / 1000.0;
+        }
+    }
+    double err = 0.0;
+    for (int i = 0; i < 3; i++){
+        err = fmax(err, fabs(mean[i] - attitude[i]));
+    }
+    TEST_CHECK_MSG(err < 0.01, "corrected accel err=%.2e", err);
+}
+
+/**
+ * @brief 温度跟踪：30℃ 升到 50℃，温度按 0.125℃ 量化，每 20000 个样本有一段转动
+ */
+static void Test_Temp_Tracking(ImuCalib_s* calib){
+    int16_t gyro_raw[3], accel_raw[3];
+    float gyro[3], accel[3];
+    int moving = 0;
+    for (int k = 0; k < 200000; k++){
+        const double temp = REF_TEMP + 20.0 * k / 200000.0;
+        const float temp_lsb = roundf((float)temp * 8.0f) / 8.0f;
+        if (k % 20000 == 0){
+            moving = 300;
+        }
+        Sample(moving > 0 ? rotating : still, level, temp, 0.002, 0.02, gyro_raw, accel_raw);
+        if (moving > 0){
+            moving--;
+        }
+        Imu_Calib_Correct(calib, gyro_raw, accel_raw, temp_lsb, gyro, accel);
+        Imu_Calib_Feed(calib, gyro_raw, accel_raw, temp_lsb);
+    }
+    double coef_err = 0.0;
+    for (int i = 0; i < 3; i++){
+        coef_err = fmax(coef_err, fabs(calib->param.gyro_temp_coef[i] - true_temp_coef[i]));
+    }
+    printf("temp tracking: coefficient error %.2e rad/s/C\n", coef_err);
+    TEST_CHECK(calib->param.valid & IMU_CALIB_VALID_TEMP);
+    TEST_CHECK_MSG(coef_err < 1e-4, "coef_err=%.2e", coef_err);
+
+    // 50℃ 下静止时校准后的陀螺仪残差
+    double mean[3] = {0.0, 0.0, 0.0};
+    for (int k = 0; k < 2000; k++){
+        Sample(still, level, 50.0, 0.002, 0.02, gyro_raw, accel_raw);
+        Imu_Calib_Correct(calib, gyro_raw, accel_raw, 50.0f, gyro, accel);
+        for (int i = 0; i < 3; i++){
+            mean[i] += gyro[i] / 2000.0;
+        }
+    }
+    double residual = 0.0;
+    for (int i = 0; i < 3; i++){
+        residual = fmax(residual, fabs(mean[i]));
+    }
+    TEST_CHECK_MSG(residual < 3e-4, "residual at 50C=%.2e", residual);
+
+    // 外推到 20℃
+    float bias[3];
+    Imu_Calib_Get_Gyro_Bias(calib, 20.0f, bias);
+    double bias_err = 0.0;
+    for (int i = 0; i < 3; i++){
+        bias_err = fmax(bias_err, fabs(bias[i] - (true_gyro_bias[i] + true_temp_coef[i] * (20.0 - REF_TEMP))));
+    }
+    TEST_CHECK_MSG(bias_err < 1e-3, "bias at 20C err=%.2e", bias_err);
+}
+
+/**
+ * @brief 保存后重新注册读回相同参数，CRC 错误时使用默认值
+ */
+static void Test_Save_Load(ImuCalib_s* calib){
+    TEST_CHECK(Imu_Calib_Save(calib));
+    TEST_CHECK(!calib->dirty);
+    const ImuCalibInitConfig_s config = {.imu = &imu, .boot_gyro_calib = false, .temp_tracking = false};
+    ImuCalib_s* loaded = Imu_Calib_Register(&config);
+    TEST_CHECK(loaded != NULL && memcmp(&loaded->param, &calib->param, sizeof(calib->param)) == 0);
+
+    flash_sector[20] ^= 1u;
+    ImuCalib_s* corrupted = Imu_Calib_Register(&config);
+    TEST_CHECK(corrupted != NULL && corrupted->param.valid == 0u && corrupted->param.accel_scale[0] == 1.0f);
+}
+
+/**
+ * @brief 中断样本：陀螺仪 2 倍于加速度计的频率交替输入，只有陀螺仪样本时不推进；
+ *        上电零偏按陀螺仪样本数完成，单样本换算与成对换算结果一致
+ */
+static void Test_Samples(void){
+    const ImuCalibInitConfig_s config = {.imu = &imu, .boot_gyro_calib = true, .temp_tracking = true};
+    ImuCalib_s* calib = Imu_Calib_Register(&config);
+    TEST_CHECK(calib != NULL);
+    if (calib == NULL){
+        return;
+    }
+    Bmi088Sample_s gyro_sample = {.type = BMI088_SAMPLE_GYRO};
+    Bmi088Sample_s accel_sample = {.type = BMI088_SAMPLE_ACCEL, .temperate = (float)REF_TEMP};
+    for (int n = 0; n < 10; n++){
+        Sample(still, level, REF_TEMP, 0.002, 0.02, gyro_sample.data, accel_sample.data);
+        Imu_Calib_Feed_Sample(calib, &gyro_sample);
+    }
+    TEST_CHECK(calib->gyro_stat.n == 0u);
+
+    int gyro_cnt = 0;
+    for (int n = 0; calib->state == IMU_CALIB_GYRO && n < 20000; n++){
+        Sample(still, level, REF_TEMP, 0.002, 0.02, gyro_sample.data, accel_sample.data);
+        if (n % 2 == 0){
+            Imu_Calib_Feed_Sample(calib, &accel_sample);
+        }
+        Imu_Calib_Feed_Sample(calib, &gyro_sample);
+        gyro_cnt++;
+    }
+    double err = 0.0;
+    for (int i = 0; i < 3; i++){
+        err = fmax(err, fabs(calib->param.gyro_bias[i] - true_gyro_bias[i]));
+    }
+    printf("samples: boot gyro bias error %.2e rad/s after %d gyro samples\n", err, gyro_cnt);
+    TEST_CHECK(calib->state == IMU_CALIB_IDLE);
+    TEST_CHECK(calib->param.valid & IMU_CALIB_VALID_GYRO);
+    TEST_CHECK_MSG(gyro_cnt <= (int)IMU_CALIB_GYRO_SAMPLES + 100, "gyro_cnt=%d", gyro_cnt);
+    TEST_CHECK_MSG(err < 2e-4, "err=%.2e", err);
+
+    float gyro[3], accel[3], gyro_one[3], accel_one[3];
+    accel_sample.temperate = 42.0f;
+    Imu_Calib_Correct_Sample(calib, &accel_sample, accel_one);
+    Imu_Calib_Correct_Sample(calib, &gyro_sample, gyro_one);
+    Imu_Calib_Correct(calib, gyro_sample.data, accel_sample.data, 42.0f, gyro, accel);
+    TEST_CHECK(memcmp(gyro, gyro_one, sizeof(gyro)) == 0 && memcmp(accel, accel_one, sizeof(accel)) == 0);
+}
+
+/**
+ * @brief 输出 Imu_Calib_Correct 单次耗时，只作参考，不判定结果
+ */
+static void Bench_Correct(ImuCalib_s* calib){
+    int16_t gyro_raw[3] = {0, 0, 0};
+    int16_t accel_raw[3] = {0, 0, 2048};
+    float gyro[3], accel[3];
+    volatile float sink = 0.0f;
+    const uint64_t start = Test_Now_Ns();
+    for (int k = 0; k < BENCH_CALLS; k++){
+        gyro_raw[0] = (int16_t)k;
+        Imu_Calib_Correct(calib, gyro_raw, accel_raw, 30.0f, gyro, accel);
+        sink += gyro[0] + accel[2];
+    }
+    printf("correct: %.2f ns\n", (double)(Test_Now_Ns() - start) / BENCH_CALLS);
+    (void)sink;
+}
+
+int main(void){
+    srand(1);
+    memset(flash_sector, 0xFF, sizeof(flash_sector));
+    const ImuCalibInitConfig_s config = {.imu = &imu, .boot_gyro_calib = true, .temp_tracking = true};
+    ImuCalib_s* calib = Imu_Calib_Register(&config);
+    TEST_CHECK(calib != NULL);
+    if (calib == NULL){
+        return Test_Report("imu_calib");
+    }
+    Test_Boot_Gyro(calib);
+    Test_Six_Face(calib);
+    Test_Temp_Tracking(calib);
+    Test_Save_Load(calib);
+    Test_Samples();
+    Bench_Correct(calib);
+    return Test_Report("imu_calib");
+}
@@ -0,0 +1,348 @@
+/**
+ * @file test_kalman.c
+ * @brief 卡尔曼滤波主机测试：三个典型模型下，完整形式的向量/顺序更新和 UD 形式与双精度参考滤波对比；
+ *        病态先验下协方差保持正定；以及各接口单次调用耗时
+ */
+#include "Kalman.h"
+#include "test_common.h"
+#include <math.h>
+#include <string.h>
+
+#define STEPS 20000
+#define BENCH_REPEAT 20
+#define BENCH_CALLS 1000
+
+/**
+ * @brief 双精度参考滤波，教科书形式，逐个分量做标量更新
+ */
+typedef struct {
+    int n;
+    double x[KALMAN_MAX_STATE_DIM];
+    double P[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];
+} RefFilter_s;
+
+typedef struct {
+    const char* name;
+    uint8_t n, m, l;
+    float F[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];
+    float B[KALMAN_MAX_STATE_DIM * KALMAN_MAX_INPUT_DIM];
+    float Q[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];
+    float H[KALMAN_MAX_MEAS_DIM * KALMAN_MAX_STATE_DIM];
+    float R[KALMAN_MAX_MEAS_DIM * KALMAN_MAX_MEAS_DIM];
+    float P0[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];
+} Model_s;
+
+static float meas_data[STEPS][KALMAN_MAX_MEAS_DIM];
+static float input_data[STEPS][KALMAN_MAX_INPUT_DIM];
+
+static void Ref_Predict(RefFilter_s* ref, const Model_s* model, const float* u){
+    const int n = ref->n;
+    double x[KALMAN_MAX_STATE_DIM] = {0};
+    double FP[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM] = {0};
+    double P[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM] = {0};
+    for (int i = 0; i < n; i++){
+        for (int j = 0; j < n; j++){
+            x[i] += model->F[i * n + j] * ref->x[j];
+        }
+        for (int j = 0; j < model->l; j++){
+            x[i] += model->B[i * model->l + j] * u[j];
+        }
+    }
+    for (int i = 0; i < n; i++){
+        for (int j = 0; j < n; j++){
+            for (int k = 0; k < n; k++){
+                FP[i * n + j] += model->F[i * n + k] * ref->P[k * n + j];
+            }
+        }
+    }
+    for (int i = 0; i < n; i++){
+        for (int j = 0; j < n; j++){
+            for (int k = 0; k < n; k++){
+                P[i * n + j] += FP[i * n + k] * model->F[j * n + k];
+            }
+            P[i * n + j] += model->Q[i * n + j];
+        }
+    }
+    memcpy(ref->x, x, sizeof(x));
+    memcpy(ref->P, P, sizeof(P));
+}
+
+static void Ref_Update_Scalar(RefFilter_s* ref, const float* h, double z, double r){
+    const int n = ref->n;
+    double PHt[KALMAN_MAX_STATE_DIM] = {0};
+    double s = r;
+    double y = z;
+    for (int i = 0; i < n; i++){
+        for (int j = 0; j < n; j++){
+            PHt[i] += ref->P[i * n + j] * h[j];
+        }
+        s += h[i] * PHt[i];
+        y -= h[i] * ref->x[i];
+    }
+    for (int i = 0; i < n; i++){
+        ref->x[i] += PHt[i] / s * y;
+    }
+    for (int i = 0; i < n; i++){
+        for (int j = 0; j < n; j++){
+            ref->P[i * n + j] -= PHt[i] * PHt[j] / s;
+        }
+    }
+}
+
+/**
+ * @brief 电机：角度、速度、扰动加速度，编码器角度观测，电流输入
+ */
+static void Model_Motor(Model_s* model){
+    memset(model, 0, sizeof(*model));
+    const float dt = 1e-3f;
+    const float F[9] = {1.0f, dt, 0.5f * dt * dt, 0.0f, 1.0f, dt, 0.0f, 0.0f, 1.0f};
+    model->name = "motor 3x1x1";
+    model->n = 3;
+    model->m = 1;
+    model->l = 1;
+    memcpy(model->F, F, sizeof(F));
+    model->B[0] = 0.5f * dt * dt * 50.0f;
+    model->B[1] = dt * 50.0f;
+    model->Q[8] = 1e-1f;
+    model->H[0] = 1.0f;
+    model->R[0] = 1e-6f;
+    for (int i = 0; i < 3; i++){
+        model->P0[i * 4] = 1.0f;
+    }
+}
+
+/**
+ * @brief 目标跟踪：平面匀速模型，观测位置
+ */
+static void Model_Track(Model_s* model){
+    memset(model, 0, sizeof(*model));
+    const float dt = 5e-3f;
+    model->name = "track 4x2x0";
+    model->n = 4;
+    model->m = 2;
+    model->l = 0;
+    for (int i = 0; i < 4; i++){
+        model->F[i * 5] = 1.0f;
+        model->P0[i * 5] = 10.0f;
+    }
+    model->F[0 * 4 + 2] = dt;
+    model->F[1 * 4 + 3] = dt;
+    model->Q[0] = model->Q[5] = 1e-7f;
+    model->Q[10] = model->Q[15] = 1e-2f;
+    model->H[0] = 1.0f;
+    model->H[1 * 4 + 1] = 1.0f;
+    model->R[0] = model->R[3] = 4e-4f;
+}
+
+/**
+ * @brief 底盘里程计：x y yaw vx vy wz，观测轮速 vx vy 和陀螺仪 wz，输入加速度指令
+ */
+static void Model_Odom(Model_s* model){
+    memset(model, 0, sizeof(*model));
+    const float dt = 1e-3f;
+    model->name = "odom 6x3x2";
+    model->n = 6;
+    model->m = 3;
+    model->l = 2;
+    for (int i = 0; i < 6; i++){
+        model->F[i * 7] = 1.0f;
+        model->P0[i * 7] = 1.0f;
+    }
+    for (int i = 0; i < 3; i++){
+        model->F[i * 6 + i + 3] = dt;
+        model->Q[i * 7] = 1e-9f;
+        model->Q[(i + 3) * 7] = 1e-3f;
+        model->H[i * 6 + 3 + i] = 1.0f;
+    }
+    model->B[3 * 2 + 0] = dt;
+    model->B[4 * 2 + 1] = dt;
+    model->R[0] = model->R[4] = 1e-2f;
+    model->R[8] = 1e-4f;
+}
+
+static bool Model_Init(KalmanInstance_s* kf, const Model_s* model, KalmanCovForm_e cov_form){
+    const KalmanInitConfig_s config = {
+        .state_dim = model->n,
+        .meas_dim = model->m,
+        .input_dim = model->l,
+        .cov_form = cov_form,
+        .F = model->F,
+        .B = model->l ? model->B : NULL,
+        .Q = model->Q,
+        .H = model->H,
+        .R = model->R,
+        .P0 = model->P0,
+        .x0 = NULL,
+    };
+    return Kalman_Init(kf, &config);
+}
+
+/**
+ * @brief P 的最大误差，按参考标准差归一化：|P_ij - P_ref_ij| / sqrt(P_ref_ii * P_ref_jj)
+ */
+static double Cov_Error(const KalmanInstance_s* kf, const RefFilter_s* ref){
+    float P[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];
+    Kalman_Get_Covariance(kf, P);
+    const int n = ref->n;
+    double err = 0.0;
+    for (int i = 0; i < n; i++){
+        for (int j = 0; j < n; j++){
+            const double scale = sqrt(ref->P[i * n + i] * ref->P[j * n + j]);
+            err = fmax(err, fabs(P[i * n + j] - ref->P[i * n + j]) / scale);
+        }
+    }
+    return err;
+}
+
+static double Min_Diag(const KalmanInstance_s* kf){
+    float P[KALMAN_MAX_STATE_DIM * KALMAN_MAX_STATE_DIM];
+    Kalman_Get_Covariance(kf, P);
+    double min = INFINITY;
+    for (int i = 0; i < kf->state_dim; i++){
+        min = fmin(min, P[i * kf->state_dim + i]);
+    }
+    return min;
+}
+
+/**
+ * @brief 向量更新、顺序更新、UD 形式与双精度参考滤波的状态误差（以参考标准差为单位）和归一化协方差误差
+ */
+static void Test_Accuracy(const Model_s* model){
+    srand(3);
+    for (int t = 0; t < STEPS; t++){
+        for (int i = 0; i < model->m; i++){
+            meas_data[t][i] = sinf((float)t * 1e-3f * (float)(i + 1)) + sqrtf(model->R[i * model->m + i]) * (float)Test_Gauss();
+        }
+        for (int i = 0; i < KALMAN_MAX_INPUT_DIM; i++){
+            input_data[t][i] = (float)Test_Gauss();
+        }
+    }
+    KalmanInstance_s kf[3];
+    const char* form_name[3] = {"vector", "sequential", "UD"};
+    TEST_CHECK(Model_Init(&kf[0], model, KALMAN_COV_FULL));
+    TEST_CHECK(Model_Init(&kf[1], model, KALMAN_COV_FULL));
+    TEST_CHECK(Model_Init(&kf[2], model, KALMAN_COV_UD));
+    RefFilter_s ref = {.n = model->n};
+    for (int i = 0; i < model->n * model->n; i++){
+        ref.P[i] = model->P0[i];
+    }
+
+    double x_err[3] = {0};
+    double P_err[3] = {0};
+    for (int t = 0; t < STEPS; t++){
+        const float* u = model->l ? input_data[t] : NULL;
+        for (int a = 0; a < 3; a++){
+            Kalman_Predict(&kf[a], u);
+        }
+        Ref_Predict(&ref, model, input_data[t]);
+        Kalman_Update(&kf[0], meas_data[t]);
+        Kalman_Update_Sequential(&kf[1], meas_data[t]);
+        Kalman_Update(&kf[2], meas_data[t]);
+        for (int i = 0; i < model->m; i++){
+            Ref_Update_Scalar(&ref, &model->H[i * model->n], meas_data[t][i], model->R[i * model->m + i]);
+        }
+        for (int a = 0; a < 3; a++){
+            for (int i = 0; i < model->n; i++){
+                x_err[a] = fmax(x_err[a], fabs(kf[a].x[i] - ref.x[i]) / sqrt(ref.P[i * model->n + i]));
+            }
+            P_err[a] = fmax(P_err[a], Cov_Error(&kf[a], &ref));
+        }
+    }
+    printf("  %-12s max |x - x_ref| / sigma: %.2e %.2e %.2e, max normalized P error: %.2e %.2e %.2e\n", model->name,
+           x_err[0], x_err[1], x_err[2], P_err[0], P_err[1], P_err[2]);
+    for (int a = 0; a < 3; a++){
+        TEST_CHECK_MSG(x_err[a] < 1e-2, "%s %s x_err=%.2e", model->name, form_name[a], x_err[a]);
+        TEST_CHECK_MSG(P_err[a] < 1e-3, "%s %s P_err=%.2e", model->name, form_name[a], P_err[a]);
+    }
+}
+
+/**
+ * @brief 病态：先验 1e8、观测噪声 1e-8，两种形式的 P 对角元素都保持为正
+ */
+static void Test_Ill_Conditioned(void){
+    Model_s model;
+    Model_Track(&model);
+    for (int i = 0; i < 4; i++){
+        model.P0[i * 5] = 1e8f;
+    }
+    model.R[0] = model.R[3] = 1e-8f;
+    model.Q[0] = model.Q[5] = 0.0f;
+    model.Q[10] = model.Q[15] = 1e-12f;
+    KalmanInstance_s full, ud;
+    TEST_CHECK(Model_Init(&full, &model, KALMAN_COV_FULL));
+    TEST_CHECK(Model_Init(&ud, &model, KALMAN_COV_UD));
+    double min_full = INFINITY;
+    double min_ud = INFINITY;
+    bool finite = true;
+    srand(5);
+    for (int t = 0; t < STEPS; t++){
+        const float z[2] = {(float)(1e-4 * Test_Gauss()), (float)(1e-4 * Test_Gauss())};
+        Kalman_Predict(&full, NULL);
+        Kalman_Predict(&ud, NULL);
+        Kalman_Update(&full, z);
+        Kalman_Update(&ud, z);
+        min_full = fmin(min_full, Min_Diag(&full));
+        min_ud = fmin(min_ud, Min_Diag(&ud));
+        finite &= isfinite(full.x[0]) && isfinite(ud.x[0]);
+    }
+    printf("  P0 = 1e8, R = 1e-8: min diag(P) full %.3e, UD %.3e\n", min_full, min_ud);
+    TEST_CHECK(finite);
+    TEST_CHECK(min_full > 0.0);
+    TEST_CHECK(min_ud > 0.0);
+}
+
+/**
+ * @brief 单次调用耗时 ns（20 x 1000 次取最小）
+ */
+static double Bench(KalmanInstance_s* kf, int op){
+    const float z[3] = {0.1f, 0.2f, 0.3f};
+    const float u[2] = {0.1f, -0.1f};
+    double best = INFINITY;
+    for (int rep = 0; rep < BENCH_REPEAT; rep++){
+        const uint64_t start = Test_Now_Ns();
+        for (int i = 0; i < BENCH_CALLS; i++){
+            if (op == 0){
+                Kalman_Predict(kf, kf->input_dim ? u : NULL);
+            } else if (op == 1){
+                Kalman_Update(kf, z);
+            } else {
+                Kalman_Update_Sequential(kf, z);
+            }
+        }
+        best = fmin(best, (double)(Test_Now_Ns() - start) / BENCH_CALLS);
+    }
+    return best;
+}
+
+/**
+ * @brief 输出各模型各接口的耗时，只作参考，不判定结果
+ */
+static void Bench_Models(const Model_s* models, int cnt){
+    printf("ns per call (storage sized %d/%d/%d):\n  %-12s %9s %9s %9s %9s %9s\n", KALMAN_MAX_STATE_DIM,
+           KALMAN_MAX_MEAS_DIM, KALMAN_MAX_INPUT_DIM, "model", "predict", "update", "seq", "UD pred", "UD upd");
+    for (int i = 0; i < cnt; i++){
+        KalmanInstance_s full, ud;
+        Model_Init(&full, &models[i], KALMAN_COV_FULL);
+        Model_Init(&ud, &models[i], KALMAN_COV_UD);
+        const double predict = Bench(&full, 0);
+        const double update = Bench(&full, 1);
+        const double sequential = Bench(&full, 2);
+        const double ud_predict = Bench(&ud, 0);
+        const double ud_update = Bench(&ud, 1);
+        printf("  %-12s %9.1f %9.1f %9.1f %9.1f %9.1f\n", models[i].name, predict, update, sequential, ud_predict, ud_update);
+    }
+}
+
+int main(void){
+    Model_s models[3];
+    Model_Motor(&models[0]);
+    Model_Track(&models[1]);
+    Model_Odom(&models[2]);
+    printf("accuracy vs double reference, %d steps:\n", STEPS);
+    for (int i = 0; i < 3; i++){
+        Test_Accuracy(&models[i]);
+    }
+    Test_Ill_Conditioned();
+    Bench_Models(models, 3);
+    return Test_Report("kalman");
+}
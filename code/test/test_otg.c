@@ -0,0 +1,183 @@
+/**
+ * @file test_otg.c
+ * @brief 在线轨迹生成主机测试：随机限制下的到达与限幅、与解析最优时间对比、移动目标、运动中降低限制，以及单次更新耗时
+ */
+#include "otg.h"
+#include "test_common.h"
+#include <math.h>
+
+#define RANDOM_TRIALS 2000
+#define TRIAL_MAX_TICKS 200000
+#define BENCH_UPDATES 1000000
+
+typedef struct {
+    double vel;         // |v| / max_vel 最大值
+    double acc;         // |a| / max_acc 最大值
+    double jerk;        // |da/dt| / max_jerk 最大值
+} PeakRatio_s;
+
+static double Random_Range(double min, double max){
+    return min + (max - min) * rand() / (double)RAND_MAX;
+}
+
+static void Peak_Update(PeakRatio_s* peak, const OtgInstance_s* otg, float last_acc, double dt){
+    peak->vel = fmax(peak->vel, fabs(otg->vel) / otg->max_vel);
+    peak->acc = fmax(peak->acc, fabs(otg->acc) / otg->max_acc);
+    peak->jerk = fmax(peak->jerk, fabs(otg->acc - last_acc) / (otg->max_jerk * dt));
+}
+
+/**
+ * @brief 峰值速度为 v 时加速再减速到静止所需时间
+ */
+static double Rest_To_Rest_Time(double v, double acc, double jerk){
+    return (v * jerk <= acc * acc) ? 2.0 * sqrt(v / jerk) : v / acc + acc / jerk;
+}
+
+/**
+ * @brief 静止到静止移动距离 dist 的解析最短时间
+ */
+static double Optimal_Time(double dist, double vel, double acc, double jerk){
+    const double t_vel = Rest_To_Rest_Time(vel, acc, jerk);
+    if (dist >= vel * t_vel){
+        return 2.0 * t_vel + (dist - vel * t_vel) / vel;
+    }
+    // 达不到最大速度，二分峰值速度
+    double lo = 0.0;
+    double hi = vel;
+    for (int i = 0; i < 100; i++){
+        const double mid = 0.5 * (lo + hi);
+        if (mid * Rest_To_Rest_Time(mid, acc, jerk) < dist){
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return 2.0 * Rest_To_Rest_Time(lo, acc, jerk);
+}
+
+/**
+ * @brief 随机限制和初末位置：每次都精确到达目标，不超限；
+ *        每 3 次中 1 次周期抖动 0.3~1.7 倍，一半在运动中改变目标，其余与解析最优时间对比
+ */
+static void Test_Random(void){
+    PeakRatio_s peak = {0};
+    double worst_extra = 0.0;
+    for (int trial = 0; trial < RANDOM_TRIALS; trial++){
+        const bool jitter = (trial % 3) == 0;
+        const bool retarget = (trial % 2) != 0;
+        const double dt = jitter ? Random_Range(0.0002, 0.002) : 0.001;
+        const OtgInitConfig_s config = {
+            .max_vel = (float)Random_Range(0.5, 20.0),
+            .max_acc = (float)Random_Range(1.0, 200.0),
+            .max_jerk = (float)Random_Range(10.0, 5000.0),
+            .init_pos = (float)Random_Range(-5.0, 5.0),
+        };
+        OtgInstance_s otg;
+        Otg_Init(&otg, &config);
+        float target = (float)Random_Range(-10.0, 10.0);
+        Otg_Set_Target(&otg, target);
+        const double dist = fabs((double)target - config.init_pos);
+
+        double time = 0.0;
+        float last_acc = otg.acc;
+        int tick;
+        for (tick = 0; tick < TRIAL_MAX_TICKS && !otg.reached; tick++){
+            const double step = jitter ? Random_Range(0.3, 1.7) * dt : dt;
+            if (retarget && tick == (int)(0.4 / dt)){
+                target = (float)Random_Range(-10.0, 10.0);
+                Otg_Set_Target(&otg, target);
+            }
+            Otg_Update(&otg, (float)step);
+            time += step;
+            Peak_Update(&peak, &otg, last_acc, step);
+            last_acc = otg.acc;
+        }
+        TEST_CHECK_MSG(otg.reached && otg.pos == target, "trial %d: pos %f target %f", trial, (double)otg.pos, (double)target);
+        if (!retarget && !jitter){
+            const double optimal = Optimal_Time(dist, config.max_vel, config.max_acc, config.max_jerk);
+            worst_extra = fmax(worst_extra, (time - optimal) / optimal);
+            TEST_CHECK_MSG(time <= optimal * 1.01 + 3.0 * dt, "trial %d: %f s, optimal %f s", trial, time, optimal);
+        }
+    }
+    printf("random: peak v/V %.6f a/A %.6f jerk/J %.6f, worst extra time vs optimal %.4f\n",
+           peak.vel, peak.acc, peak.jerk, worst_extra);
+    TEST_CHECK(peak.vel <= 1.0 + 1e-4);
+    TEST_CHECK(peak.acc <= 1.0 + 1e-4);
+    TEST_CHECK(peak.jerk <= 1.0 + 1e-3);
+}
+
+/**
+ * @brief 正弦移动目标叠加方波跳变：不超限，方波后半段跟踪误差有界
+ * @note 生成器按静止目标规划，跟踪移动目标有滞后，误差上限只用于发现发散
+ */
+static void Test_Moving_Target(void){
+    const OtgInitConfig_s config = {.max_vel = 5.0f, .max_acc = 50.0f, .max_jerk = 1000.0f, .init_pos = 0.0f};
+    OtgInstance_s otg;
+    Otg_Init(&otg, &config);
+    PeakRatio_s peak = {0};
+    double settled_error = 0.0;
+    float last_acc = 0.0f;
+    for (int n = 0; n < 20000; n++){
+        const float t = (float)n * 1e-3f;
+        Otg_Set_Target(&otg, 0.8f * sinf(6.0f * t) + (((n / 3000) % 2) ? 1.0f : -1.0f));
+        Otg_Update(&otg, 1e-3f);
+        TEST_CHECK(!isnan(otg.pos));
+        Peak_Update(&peak, &otg, last_acc, 1e-3);
+        last_acc = otg.acc;
+        if (n % 3000 > 1500){
+            settled_error = fmax(settled_error, fabs(otg.error));
+        }
+    }
+    printf("moving target: peak v/V %.6f a/A %.6f jerk/J %.6f, settled error %.4f\n",
+           peak.vel, peak.acc, peak.jerk, settled_error);
+    TEST_CHECK(peak.vel <= 1.0 + 1e-4);
+    TEST_CHECK(peak.acc <= 1.0 + 1e-4);
+    TEST_CHECK(peak.jerk <= 1.0 + 1e-3);
+    TEST_CHECK_MSG(settled_error < 0.5, "settled_error=%f", settled_error);
+}
+
+/**
+ * @brief 运动中把最大速度降到当前速度以下，仍能到达目标
+ */
+static void Test_Lower_Limits(void){
+    const OtgInitConfig_s config = {.max_vel = 5.0f, .max_acc = 50.0f, .max_jerk = 1000.0f, .init_pos = 0.0f};
+    OtgInstance_s otg;
+    Otg_Init(&otg, &config);
+    Otg_Reset(&otg, 0.0f, 4.5f, 0.0f);
+    Otg_Set_Target(&otg, 10.0f);
+    Otg_Set_Limits(&otg, 2.0f, 50.0f, 1000.0f);
+    int n;
+    for (n = 0; n < 20000 && !otg.reached; n++){
+        Otg_Update(&otg, 1e-3f);
+    }
+    printf("lowered limits: reached after %d ticks, pos %f, vel %f\n", n, (double)otg.pos, (double)otg.vel);
+    TEST_CHECK(otg.reached && otg.pos == 10.0f && otg.vel == 0.0f);
+}
+
+/**
+ * @brief 输出单次更新耗时，只作参考，不判定结果
+ */
+static void Bench_Update(void){
+    const OtgInitConfig_s config = {.max_vel = 5.0f, .max_acc = 50.0f, .max_jerk = 1000.0f, .init_pos = 0.0f};
+    OtgInstance_s otg;
+    Otg_Init(&otg, &config);
+    volatile float sink = 0.0f;
+    const uint64_t start = Test_Now_Ns();
+    for (int k = 0; k < BENCH_UPDATES; k++){
+        if (k % 1500 == 0){
+            Otg_Set_Target(&otg, ((k / 1500) % 2) ? 3.0f : -3.0f);
+        }
+        sink += Otg_Update(&otg, 1e-3f);
+    }
+    printf("update: %.1f ns\n", (double)(Test_Now_Ns() - start) / BENCH_UPDATES);
+    (void)sink;
+}
+
+int main(void){
+    srand(1);
+    Test_Random();
+    Test_Moving_Target();
+    Test_Lower_Limits();
+    Bench_Update();
+    return Test_Report("otg");
+}
@@ -0,0 +1,186 @@
+/**
+ * @file test_ramp.c
+ * @brief 斜坡发生器主机测试：静止到静止的到达与限幅、每周期先更新目标再读取的移动目标跟踪、
+ *        运动中目标反向，以及每周期重新规划的耗时
+ */
+#include "ramp.h"
+#include "bsp_dwt.h"
+#include "test_common.h"
+#include <math.h>
+
+#define SIM_CPU_FREQ_HZ 480000000u
+#define SIM_TICK_CYCLES (SIM_CPU_FREQ_HZ / 1000u)
+#define BENCH_UPDATES 1000000
+
+static uint32_t sim_cycle = 0;
+
+uint32_t Dwt_Get_Cycle(void){
+    return sim_cycle;
+}
+
+float Dwt_Cycle_To_S(uint32_t cycle){
+    return (float)cycle / (float)SIM_CPU_FREQ_HZ;
+}
+
+static const char* const profile_name[] = {"linear", "trapezoid", "s_curve"};
+
+typedef struct {
+    double vel;         // |v| / max_vel 最大值
+    double acc;         // 相邻周期速度差 / (max_acc * dt) 最大值
+    double jerk;        // 相邻周期加速度差 / (max_jerk * dt) 最大值
+} PeakRatio_s;
+
+/**
+ * @brief 推进一个 1ms 周期并更新峰值
+ */
+static float Tick(RampInstance_s* ramp, PeakRatio_s* peak){
+    const float last_vel = ramp->output_vel;
+    const float last_acc = ramp->output_acc;
+    sim_cycle += SIM_TICK_CYCLES;
+    const float value = Ramp_Read(ramp);
+    const double dt = 1e-3;
+    peak->vel = fmax(peak->vel, fabs(ramp->output_vel) / ramp->max_vel);
+    if (ramp->max_acc > 0.0f){
+        peak->acc = fmax(peak->acc, fabs(ramp->output_vel - last_vel) / (ramp->max_acc * dt));
+    }
+    if (ramp->max_jerk > 0.0f){
+        peak->jerk = fmax(peak->jerk, fabs(ramp->output_acc - last_acc) / (ramp->max_jerk * dt));
+    }
+    return value;
+}
+
+static void Ramp_Start(RampInstance_s* ramp, RampProfile_e profile, float init_value){
+    const RampInitConfig_s config = {
+        .profile = profile,
+        .max_vel = 2.0f,
+        .max_acc = 5.0f,
+        .max_jerk = 50.0f,
+        .init_value = init_value,
+    };
+    Ramp_Init(ramp, &config);
+}
+
+/**
+ * @brief 静止到静止：按规划时长到达目标，速度、加速度、加加速度不超限
+ */
+static void Test_Rest_To_Rest(void){
+    for (int profile = RAMP_LINEAR; profile <= RAMP_S_CURVE; profile++){
+        RampInstance_s ramp;
+        Ramp_Start(&ramp, (RampProfile_e)profile, -1.0f);
+        Ramp_Update(&ramp, 2.0f);
+        const float duration = ramp.duration;
+        PeakRatio_s peak = {0};
+        int n;
+        for (n = 0; n < 10000 && ramp.output_value != 2.0f; n++){
+            Tick(&ramp, &peak);
+        }
+        printf("%s rest to rest: %d ticks, planned %.4f s, peak v/V %.4f\n",
+               profile_name[profile], n, (double)duration, peak.vel);
+        TEST_CHECK_MSG(ramp.output_value == 2.0f && ramp.output_vel == 0.0f, "%s: value %f", profile_name[profile], (double)ramp.output_value);
+        TEST_CHECK_MSG(fabs(n * 1e-3 - duration) <= 1.5e-3, "%s: %d ticks, planned %f s", profile_name[profile], n, (double)duration);
+        TEST_CHECK(peak.vel <= 1.0 + 1e-4);
+        if (profile != RAMP_LINEAR){
+            TEST_CHECK_MSG(peak.acc <= 1.0 + 1e-3, "%s: a/A %f", profile_name[profile], peak.acc);
+        }
+        if (profile == RAMP_S_CURVE){
+            TEST_CHECK_MSG(peak.jerk <= 1.0 + 1e-2, "jerk/J %f", peak.jerk);
+        }
+    }
+}
+
+/**
+ * @brief 目标以 1.8/s 移动到 3 后停住，每周期先 Ramp_Update 再 Ramp_Read：
+ *        输出持续跟随且速度连续，目标停住后无超调地到达
+ */
+static void Test_Moving_Target(void){
+    for (int profile = RAMP_LINEAR; profile <= RAMP_S_CURVE; profile++){
+        RampInstance_s ramp;
+        Ramp_Start(&ramp, (RampProfile_e)profile, 0.0f);
+        PeakRatio_s peak = {0};
+        float value = 0.0f;
+        float value_at_stop = 0.0f;
+        float max_value = 0.0f;
+        int n;
+        for (n = 1; n <= 5000; n++){
+            const float target = fminf(1.8f * (float)n * 1e-3f, 3.0f);
+            Ramp_Update(&ramp, target);
+            value = Tick(&ramp, &peak);
+            max_value = fmaxf(max_value, value);
+            if (target < 3.0f){
+                value_at_stop = value;
+            }
+        }
+        printf("%s moving target: %.4f when target stops at 3, final %.6f, peak v/V %.4f a/A %.4f jerk/J %.4f\n",
+               profile_name[profile], (double)value_at_stop, (double)value, peak.vel, peak.acc, peak.jerk);
+        // 目标停住时输出应只落后于加减速带来的滞后，而不是停在起点附近
+        TEST_CHECK_MSG(value_at_stop > 2.0f, "%s: %f when target stops", profile_name[profile], (double)value_at_stop);
+        TEST_CHECK_MSG(value == 3.0f && ramp.output_vel == 0.0f, "%s: final %f", profile_name[profile], (double)value);
+        TEST_CHECK_MSG(max_value <= 3.0f, "%s: overshoot %f", profile_name[profile], (double)max_value);
+        TEST_CHECK(peak.vel <= 1.0 + 1e-3);
+        if (profile != RAMP_LINEAR){
+            TEST_CHECK_MSG(peak.acc <= 1.0 + 1e-2, "%s: a/A %f", profile_name[profile], peak.acc);
+        }
+        if (profile == RAMP_S_CURVE){
+            TEST_CHECK_MSG(peak.jerk <= 1.0 + 1e-2, "jerk/J %f", peak.jerk);
+        }
+    }
+}
+
+/**
+ * @brief 巡航中目标跳到后方：先按加速度限制减速再折返，速度不跳变
+ */
+static void Test_Reverse(void){
+    for (int profile = RAMP_TRAPEZOID; profile <= RAMP_S_CURVE; profile++){
+        RampInstance_s ramp;
+        Ramp_Start(&ramp, (RampProfile_e)profile, 0.0f);
+        Ramp_Update(&ramp, 10.0f);
+        PeakRatio_s peak = {0};
+        for (int n = 0; n < 2000; n++){
+            Tick(&ramp, &peak);
+        }
+        const float vel_before = ramp.output_vel;
+        const float value_before = ramp.output_value;
+        Ramp_Update(&ramp, 0.0f);
+        TEST_CHECK_MSG(ramp.output_vel == vel_before, "%s: vel %f -> %f", profile_name[profile], (double)vel_before, (double)ramp.output_vel);
+        float max_value = ramp.output_value;
+        int n;
+        for (n = 0; n < 20000 && ramp.output_value != 0.0f; n++){
+            max_value = fmaxf(max_value, Tick(&ramp, &peak));
+        }
+        printf("%s reverse: vel %.4f at reverse, peak %.4f, arrived after %d ticks, a/A %.4f\n",
+               profile_name[profile], (double)vel_before, (double)max_value, n, peak.acc);
+        TEST_CHECK_MSG(ramp.output_value == 0.0f, "%s: value %f", profile_name[profile], (double)ramp.output_value);
+        // 速度连续，输出先越过反向时刻的位置再折返
+        TEST_CHECK_MSG(max_value > value_before, "%s: peak %f, at reverse %f", profile_name[profile], (double)max_value, (double)value_before);
+        TEST_CHECK_MSG(peak.acc <= 1.0 + 1e-2, "%s: a/A %f", profile_name[profile], peak.acc);
+        if (profile == RAMP_S_CURVE){
+            TEST_CHECK_MSG(peak.jerk <= 1.0 + 1e-2, "jerk/J %f", peak.jerk);
+        }
+    }
+}
+
+/**
+ * @brief 输出每周期更新目标并推进的耗时，只作参考，不判定结果
+ */
+static void Bench_Update(void){
+    for (int profile = RAMP_LINEAR; profile <= RAMP_S_CURVE; profile++){
+        RampInstance_s ramp;
+        Ramp_Start(&ramp, (RampProfile_e)profile, 0.0f);
+        volatile float sink = 0.0f;
+        const uint64_t start = Test_Now_Ns();
+        for (int k = 0; k < BENCH_UPDATES; k++){
+            Ramp_Update(&ramp, 3.0f * sinf((float)(k % 6283) * 1e-3f));
+            sink += Ramp_Step(&ramp, 1e-3f);
+        }
+        printf("%s update + step: %.1f ns\n", profile_name[profile], (double)(Test_Now_Ns() - start) / BENCH_UPDATES);
+        (void)sink;
+    }
+}
+
+int main(void){
+    Test_Rest_To_Rest();
+    Test_Moving_Target();
+    Test_Reverse();
+    Bench_Update();
+    return Test_Report("ramp");
+}
@@ -0,0 +1,107 @@
+/**
+ * @file test_sbus.c
+ * @brief SBUS 解码主机测试：随机帧与逐位参考解码器对比，以及单帧解码耗时
+ */
+#include "sbus.h"
+#include "test_common.h"
+#include <string.h>
+
+#define FUZZ_FRAMES 2000000L
+#define BENCH_FRAMES 20000000L
+#define BENCH_POOL 256u
+
+/**
+ * @brief 逐位解码的参考实现，通道 i 从第 11*i 位开始，低位在前
+ */
+static void Sbus_Reference(const uint8_t* buffer, int16_t* ch){
+    for (int i = 0; i < SBUS_CHANNELS; i++){
+        int value = 0;
+        for (int k = 0; k < 11; k++){
+            const int bit = i * 11 + k;
+            value |= ((buffer[1 + bit / 8] >> (bit % 8)) & 1) << k;
+        }
+        ch[i] = (int16_t)value;
+    }
+}
+
+/**
+ * @brief 生成随机帧，valid 为真时帧头、帧尾和保留位合法
+ */
+static void Random_Frame(uint8_t* frame, bool valid){
+    for (int i = 0; i < SBUS_FRAME_SIZE; i++){
+        frame[i] = (uint8_t)rand();
+    }
+    if (valid){
+        frame[0] = SBUS_HEADER;
+        frame[24] = SBUS_FOOTER;
+        frame[23] &= (uint8_t)~SBUS_FLAG_RESERVED;
+    }
+}
+
+/**
+ * @brief 约四分之一为随机字节帧，检查接受/拒绝判断、通道值和标志位，拒绝时输出不变
+ */
+static void Test_Fuzz(void){
+    uint8_t frame[SBUS_FRAME_SIZE];
+    int16_t expect[SBUS_CHANNELS];
+    SbusData_s data;
+    SbusData_s untouched;
+    long mismatch = 0;
+    long rejected = 0;
+    for (long it = 0; it < FUZZ_FRAMES; it++){
+        Random_Frame(frame, (rand() % 4) != 0);
+        memset(&data, 0x55, sizeof(data));
+        memset(&untouched, 0x55, sizeof(untouched));
+        const bool ok = Sbus_Frame_Parse(&data, frame);
+        const bool valid = frame[0] == SBUS_HEADER && frame[24] == SBUS_FOOTER && !(frame[23] & SBUS_FLAG_RESERVED);
+        if (ok != valid){
+            mismatch++;
+            continue;
+        }
+        if (!ok){
+            rejected++;
+            mismatch += memcmp(&data, &untouched, sizeof(data)) != 0;
+            continue;
+        }
+        Sbus_Reference(frame, expect);
+        const uint8_t flags = frame[23];
+        const bool failsafe = (flags & SBUS_FLAG_FAILSAFE) != 0u;
+        if (memcmp(expect, data.ch, sizeof(expect)) != 0
+            || data.ch17 != (flags & SBUS_FLAG_CH17)
+            || data.ch18 != ((flags & SBUS_FLAG_CH18) >> 1)
+            || data.frame_lost != ((flags & SBUS_FLAG_FRAME_LOST) != 0u)
+            || data.failsafe != failsafe
+            || data.state != (failsafe ? SBUS_LOST : SBUS_OK)){
+            mismatch++;
+        }
+    }
+    printf("fuzz: %ld frames, %ld rejected, %ld mismatches\n", FUZZ_FRAMES, rejected, mismatch);
+    TEST_CHECK(mismatch == 0);
+    TEST_CHECK(rejected > 0);
+}
+
+/**
+ * @brief 输出单帧解码耗时，只作参考，不判定结果
+ */
+static void Bench_Parse(void){
+    static uint8_t frames[BENCH_POOL][SBUS_FRAME_SIZE];
+    for (uint32_t k = 0; k < BENCH_POOL; k++){
+        Random_Frame(frames[k], true);
+    }
+    SbusData_s data;
+    volatile uint32_t sink = 0;
+    const uint64_t start = Test_Now_Ns();
+    for (long i = 0; i < BENCH_FRAMES; i++){
+        Sbus_Frame_Parse(&data, frames[i & (BENCH_POOL - 1u)]);
+        sink += (uint32_t)data.ch[i & (SBUS_CHANNELS - 1)];
+    }
+    printf("parse: %.2f ns/frame\n", (double)(Test_Now_Ns() - start) / (double)BENCH_FRAMES);
+    (void)sink;
+}
+
+int main(void){
+    srand(1);
+    Test_Fuzz();
+    Bench_Parse();
+    return Test_Report("sbus");
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_spsc_queue.c
+ * @brief SpscQueue 主机测试：边界条件，以及生产者/消费者线程混合使用单个、批量、零拷贝接口的压力测试
+ */
+#include "spsc_queue.h"
+#include "test_common.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define STRESS_COUNT 100000000u // 压力测试传递的元素总数
+#define STRESS_CAPACITY 1024u
+
+static SpscQueue_s stress_queue;
+static uint32_t stress_buf[STRESS_CAPACITY];
+
+/**
+ * @brief 边界条件：容量检查、满/空、回绕后的批量读写
+ */
+static void Test_Basic(void){
+    uint32_t buf[8];
+    SpscQueue_s queue;
+    TEST_CHECK(!SpscQueue_Init(&queue, buf, 6, sizeof(uint32_t)));
+    TEST_CHECK(!SpscQueue_Init(&queue, buf, 1, sizeof(uint32_t)));
+    TEST_CHECK(SpscQueue_Init(&queue, buf, 8, sizeof(uint32_t)));
+    TEST_CHECK(SpscQueue_Get_Capacity(&queue) == 8u);
+
+    uint32_t value = 0;
+    TEST_CHECK(!SpscQueue_Dequeue(&queue, &value));
+    for (uint32_t i = 0; i < 8u; i++){
+        TEST_CHECK(SpscQueue_Enqueue(&queue, &i));
+    }
+    TEST_CHECK(!SpscQueue_Enqueue(&queue, &value));
+    TEST_CHECK(SpscQueue_Get_Size(&queue) == 8u);
+
+    // 读出 5 个后写入 5 个，写指针回绕
+    uint32_t out[8];
+    TEST_CHECK(SpscQueue_Dequeue_Bulk(&queue, out, 5) == 5u);
+    TEST_CHECK(out[0] == 0u && out[4] == 4u);
+    const uint32_t in[6] = {8, 9, 10, 11, 12, 13};
+    TEST_CHECK(SpscQueue_Enqueue_Bulk(&queue, in, 6) == 5u);
+
+    // Peek 不跨越回绕点
+    uint32_t count = 0;
+    const uint32_t* head = SpscQueue_Peek(&queue, &count);
+    TEST_CHECK(head != NULL && count == 3u && head[0] == 5u);
+    SpscQueue_Release(&queue, count);
+    TEST_CHECK(SpscQueue_Dequeue_Bulk(&queue, out, 8) == 5u);
+    for (uint32_t i = 0; i < 5u; i++){
+        TEST_CHECK(out[i] == 8u + i);
+    }
+    TEST_CHECK(SpscQueue_Get_Size(&queue) == 0u);
+}
+
+/**
+ * @brief 生产者线程：交替使用 Reserve/Commit 与 Enqueue_Bulk，写入连续递增的序号
+ */
+static void* Stress_Producer(void* arg){
+    uint32_t next = 0;
+    uint32_t tmp[37];
+    while (next < STRESS_COUNT){
+        uint32_t want = (next % 3u == 0u) ? 37u : 1u;
+        if (want > STRESS_COUNT - next){
+            want = STRESS_COUNT - next;
+        }
+        uint32_t done;
+        if (next % 5u == 0u){
+            uint32_t count;
+            uint32_t* slot = SpscQueue_Reserve(&stress_queue, &count);
+            done = (slot == NULL) ? 0u : ((count < want) ? count : want);
+            for (uint32_t i = 0; i < done; i++){
+                slot[i] = next + i;
+            }
+            SpscQueue_Commit(&stress_queue, done);
+        } else {
+            for (uint32_t i = 0; i < want; i++){
+                tmp[i] = next + i;
+            }
+            done = SpscQueue_Enqueue_Bulk(&stress_queue, tmp, want);
+        }
+        next += done;
+        if (done == 0u){
+            sched_yield();
+        }
+    }
+    return arg;
+}
+
+/**
+ * @brief 压力测试：消费者交替使用 Peek/Release 与 Dequeue_Bulk，检查序号连续且无重复
+ */
+static void Test_Stress(void){
+    TEST_CHECK(SpscQueue_Init(&stress_queue, stress_buf, STRESS_CAPACITY, sizeof(uint32_t)));
+    pthread_t producer;
+    TEST_CHECK(pthread_create(&producer, NULL, Stress_Producer, NULL) == 0);
+
+    uint32_t expect = 0;
+    uint32_t tmp[29];
+    bool order_ok = true;
+    while (expect < STRESS_COUNT && order_ok){
+        uint32_t count = 0;
+        if (expect & 1u){
+            const uint32_t* head = SpscQueue_Peek(&stress_queue, &count);
+            for (uint32_t i = 0; i < count; i++){
+                order_ok &= (head[i] == expect + i);
+            }
+            SpscQueue_Release(&stress_queue, count);
+        } else {
+            count = SpscQueue_Dequeue_Bulk(&stress_queue, tmp, 29);
+            for (uint32_t i = 0; i < count; i++){
+                order_ok &= (tmp[i] == expect + i);
+            }
+        }
+        expect += count;
+        if (count == 0u){
+            sched_yield();
+        }
+    }
+    TEST_CHECK(order_ok);
+    if (!order_ok){
+        // 消费者提前退出，生产者可能阻塞在满队列上
+        exit(Test_Report("spsc_queue"));
+    }
+    pthread_join(producer, NULL);
+    TEST_CHECK(expect == STRESS_COUNT);
+    TEST_CHECK(SpscQueue_Get_Size(&stress_queue) == 0u);
+}
+
+int main(void){
+    Test_Basic();
+    Test_Stress();
+    return Test_Report("spsc_queue");
+}